@@ -23,9 +23,15 @@
 #include "crypto/identity.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace fetch {
+namespace crypto {
+
+class VerificationEngine;
+
+}  // namespace crypto
 namespace chain {
 
 /**
@@ -39,6 +45,8 @@ public:
   using TokenAmount    = uint64_t;
   using BlockIndex     = uint64_t;
   using Counter        = uint64_t;
+  using TransactionPtr = std::shared_ptr<Transaction>;
+  using Transactions   = std::vector<TransactionPtr>;
 
   constexpr static uint64_t   MAXIMUM_TX_CHARGE_LIMIT    = 10000000000;
   constexpr static BlockIndex MAXIMUM_TX_VALIDITY_PERIOD = 40000;
@@ -135,8 +143,11 @@ public:
   /// @name Validation / Verification
   /// @{
   bool Verify();
+  bool Verify(crypto::VerificationEngine &engine);
   bool IsVerified() const;
   bool IsSignedByFromAddress() const;
+
+  static void VerifyBatch(Transactions const &transactions, crypto::VerificationEngine &engine);
   /// @}
 
   // Operators
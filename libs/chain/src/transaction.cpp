@@ -19,10 +19,12 @@
 #include "chain/transaction.hpp"
 #include "chain/transaction_serializer.hpp"
 #include "chain/transaction_validity_period.hpp"
-#include "crypto/verifier.hpp"
+#include "crypto/verification_engine.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 namespace fetch {
 namespace chain {
@@ -50,6 +52,17 @@ uint64_t Transaction::GetTotalTransferAmount() const
  * @return
  */
 bool Transaction::Verify()
+{
+  return Verify(crypto::VerificationEngine::Default());
+}
+
+/**
+ * Verify the contents of the transaction
+ *
+ * @param engine The verification engine used to check the signatures
+ * @return
+ */
+bool Transaction::Verify(crypto::VerificationEngine &engine)
 {
   if (!verification_completed_)
   {
@@ -67,7 +80,7 @@ bool Transaction::Verify()
       for (auto const &signatory : signatories_)
       {
         // verify the signature
-        if (!crypto::Verifier::Verify(signatory.identity, payload, signatory.signature))
+        if (!engine.Verify(signatory.identity, payload, signatory.signature))
         {
           // exit as soon as the first non valid signature is detected
           all_verified = false;
@@ -90,6 +103,63 @@ bool Transaction::Verify()
   return verified_;
 }
 
+/**
+ * Verify the contents of a batch of transactions. The signatures of all the transactions which
+ * have not already been verified are submitted to the verification engine as a single batch.
+ *
+ * @param transactions The transactions to be verified
+ * @param engine The verification engine used to check the signatures
+ */
+void Transaction::VerifyBatch(Transactions const &transactions, crypto::VerificationEngine &engine)
+{
+  crypto::VerificationEngine::Requests requests{};
+  std::vector<std::size_t>             offsets(transactions.size(), 0);
+
+  // collect the signatures of all the pending transactions
+  for (std::size_t i = 0; i < transactions.size(); ++i)
+  {
+    auto const &tx = *transactions[i];
+
+    offsets[i] = requests.size();
+    if (tx.verification_completed_)
+    {
+      continue;
+    }
+
+    ConstByteArray const payload = TransactionSerializer::SerializePayload(tx);
+    for (auto const &signatory : tx.signatories_)
+    {
+      if (!signatory.identity)
+      {
+        // an invalid identity can never be verified
+        requests.push_back({});
+        continue;
+      }
+
+      requests.push_back({signatory.identity.identifier(), payload, signatory.signature});
+    }
+  }
+
+  auto const results = engine.Verify(requests);
+
+  // update the verification status of the transactions
+  for (std::size_t i = 0; i < transactions.size(); ++i)
+  {
+    auto &tx = *transactions[i];
+    if (tx.verification_completed_)
+    {
+      continue;
+    }
+
+    auto const begin = results.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+    auto const end   = begin + static_cast<std::ptrdiff_t>(tx.signatories_.size());
+
+    tx.verified_ = !tx.signatories_.empty() &&
+                   std::all_of(begin, end, [](uint8_t result) { return result != 0; });
+    tx.verification_completed_ = true;
+  }
+}
+
 bool Transaction::IsSignedByFromAddress() const
 {
   auto const it = std::find_if(
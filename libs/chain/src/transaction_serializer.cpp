@@ -444,11 +444,19 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
       Decode(buffer, transfer.amount);
     }
   }
+  else
+  {
+    tx.transfers_.clear();
+  }
 
   if (valid_from_flag != 0u)
   {
     Decode(buffer, tx.valid_from_);
   }
+  else
+  {
+    tx.valid_from_ = 0;
+  }
 
   Decode(buffer, tx.valid_until_);
 
@@ -490,6 +498,9 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
     tx.contract_mode_    = Transaction::ContractMode::NOT_PRESENT;
     tx.contract_address_ = Address{};
     tx.chain_code_       = ConstByteArray{};
+    tx.shard_mask_       = BitVector{};
+    tx.action_           = ConstByteArray{};
+    tx.data_             = ConstByteArray{};
   }
   else
   {
@@ -599,6 +610,10 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   // compute the hash function
   tx.digest_ = hash_function.Final();
 
+  // the transaction object might be reused, ensure that no previous verification result is retained
+  tx.verification_completed_ = false;
+  tx.verified_               = false;
+
   return true;
 }
 
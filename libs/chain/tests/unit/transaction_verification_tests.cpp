@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "chain/transaction_serializer.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/verification_engine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::chain::Address;
+using fetch::chain::Transaction;
+using fetch::chain::TransactionBuilder;
+using fetch::chain::TransactionSerializer;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::VerificationEngine;
+
+using TransactionPtr = Transaction::TransactionPtr;
+using Transactions   = Transaction::Transactions;
+
+class TransactionVerificationTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    signer_.GenerateKeys();
+    other_signer_.GenerateKeys();
+  }
+
+  TransactionPtr CreateTransaction(uint64_t amount) const
+  {
+    return TransactionBuilder()
+        .From(Address{signer_.identity()})
+        .Transfer(Address{other_signer_.identity()}, amount)
+        .Signer(signer_.identity())
+        .Seal()
+        .Sign(signer_)
+        .Build();
+  }
+
+  TransactionPtr CreateMultiSignedTransaction(uint64_t amount) const
+  {
+    return TransactionBuilder()
+        .From(Address{signer_.identity()})
+        .Transfer(Address{other_signer_.identity()}, amount)
+        .Signer(signer_.identity())
+        .Signer(other_signer_.identity())
+        .Seal()
+        .Sign(signer_)
+        .Sign(other_signer_)
+        .Build();
+  }
+
+  static TransactionPtr CorruptSignature(Transaction const &tx)
+  {
+    TransactionSerializer serializer{};
+    serializer << tx;
+
+    // the signatures are the last element of the serialised transaction
+    ByteArray data = serializer.data().Copy();
+    data[data.size() - 8] ^= 0xFFu;
+
+    auto corrupted = std::make_shared<Transaction>();
+    TransactionSerializer{data} >> *corrupted;
+
+    return corrupted;
+  }
+
+  ECDSASigner signer_;
+  ECDSASigner other_signer_;
+};
+
+TEST_F(TransactionVerificationTests, CheckBatchMatchesIndividualVerification)
+{
+  Transactions batch{};
+  batch.push_back(CreateTransaction(100));
+  batch.push_back(CorruptSignature(*CreateTransaction(200)));
+  batch.push_back(CreateMultiSignedTransaction(300));
+  batch.push_back(CorruptSignature(*CreateMultiSignedTransaction(400)));
+  batch.push_back(CreateTransaction(500));
+
+  VerificationEngine engine{2};
+  Transaction::VerifyBatch(batch, engine);
+
+  EXPECT_TRUE(batch[0]->IsVerified());
+  EXPECT_FALSE(batch[1]->IsVerified());
+  EXPECT_TRUE(batch[2]->IsVerified());
+  EXPECT_FALSE(batch[3]->IsVerified());
+  EXPECT_TRUE(batch[4]->IsVerified());
+
+  // the results are retained by the transactions
+  auto const verifications = engine.num_verifications();
+  for (auto const &tx : batch)
+  {
+    EXPECT_EQ(tx->Verify(engine), tx->IsVerified());
+  }
+  EXPECT_EQ(engine.num_verifications(), verifications);
+}
+
+TEST_F(TransactionVerificationTests, CheckAlreadyVerifiedTransactionsAreSkipped)
+{
+  auto const verified = CreateTransaction(100);
+
+  VerificationEngine engine{0};
+  ASSERT_TRUE(verified->Verify(engine));
+  EXPECT_EQ(engine.num_verifications(), 1u);
+
+  Transaction::VerifyBatch({verified, CreateTransaction(200)}, engine);
+  EXPECT_EQ(engine.num_verifications(), 2u);
+}
+
+}  // namespace
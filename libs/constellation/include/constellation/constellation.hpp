@@ -35,6 +35,7 @@
 #include "ledger/protocols/main_chain_rpc_client.hpp"
 #include "ledger/protocols/main_chain_rpc_service.hpp"
 #include "ledger/storage_unit/lane_remote_control.hpp"
+#include "ledger/storage_unit/state_prefetch_cache.hpp"
 #include "ledger/storage_unit/storage_unit_bundled_service.hpp"
 #include "ledger/storage_unit/storage_unit_client.hpp"
 #include "ledger/transaction_processor.hpp"
@@ -150,6 +151,7 @@ private:
   using Flag                     = std::atomic<bool>;
   using ExecutionManager         = ledger::ExecutionManager;
   using ExecutionManagerPtr      = std::shared_ptr<ExecutionManager>;
+  using StatePrefetchCachePtr    = std::shared_ptr<ledger::StatePrefetchCache>;
   using LaneRemoteControl        = ledger::LaneRemoteControl;
   using LaneRemoteControlPtr     = std::unique_ptr<LaneRemoteControl>;
   using HttpServer               = http::HTTPServer;
@@ -241,7 +243,8 @@ private:
 
   /// @name Block Processing
   /// @{
-  ExecutionManagerPtr execution_manager_;  ///< The transaction execution manager
+  StatePrefetchCachePtr state_cache_;        ///< The state cache shared by the executors
+  ExecutionManagerPtr   execution_manager_;  ///< The transaction execution manager
   /// @}
 
   /// @name Blockchain and Mining
@@ -31,6 +31,7 @@
 #include "http/middleware/telemetry.hpp"
 #include "ledger/chaincode/contract_context.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/consensus/consensus.hpp"
 #include "ledger/consensus/simulated_pow_consensus.hpp"
 #include "ledger/consensus/stake_snapshot.hpp"
@@ -89,6 +90,7 @@ using StakeManagerPtr       = std::shared_ptr<ledger::StakeManager>;
 constexpr char const *LOGGING_NAME = "constellation";
 
 const std::size_t HTTP_THREADS{4};
+const std::size_t BLOCK_PIPELINE_DEPTH{4};
 char const *      GENESIS_FILENAME = "genesis_file.json";
 
 class Defer
@@ -508,9 +510,22 @@ bool Constellation::OnRestorePreviousData(ledger::GenesisFileCreator::ConsensusP
   chain_ = std::make_unique<MainChain>(ledger::MainChain::Mode::LOAD_PERSISTENT_DB, true);
 
   // necessary when doing state validity checks
+  state_cache_       = std::make_shared<ledger::StatePrefetchCache>(storage_);
   execution_manager_ = std::make_shared<ExecutionManager>(
       cfg_.num_executors, cfg_.log2_num_lanes, storage_,
-      [this] { return std::make_shared<Executor>(storage_); }, tx_status_cache_);
+      [this] { return std::make_shared<Executor>(state_cache_); }, tx_status_cache_,
+      state_cache_);
+
+  if (cfg_.features.IsEnabled("dependency-scheduling"))
+  {
+    execution_manager_->SetSchedulingMode(ExecutionManager::SchedulingMode::DEPENDENCY_GRAPH);
+  }
+
+  if (cfg_.features.IsEnabled("persistent-executable-cache"))
+  {
+    ledger::ExecutableCache::Instance().EnablePersistence("executable_cache.db",
+                                                          "executable_cache_index.db");
+  }
 
   if (!GenesisSanityChecks(genesis_status))
   {
@@ -581,6 +596,11 @@ bool Constellation::OnBringUpExternalNetwork(
       std::make_unique<ledger::SynergeticExecutionManager>(
           dag_, 1u, [this]() { return std::make_shared<ledger::SynergeticExecutor>(*storage_); }));
 
+  if (cfg_.features.IsEnabled("pipelined-block-processing"))
+  {
+    block_coordinator_->SetPipelineDepth(BLOCK_PIPELINE_DEPTH);
+  }
+
   tx_processor_ = std::make_unique<ledger::TransactionProcessor>(
       dag_, *storage_, *block_packer_, tx_status_cache_, cfg_.processor_threads);
 
@@ -729,6 +749,11 @@ bool Constellation::OnBringUpExternalNetwork(
   main_chain_service_    = std::make_shared<MainChainRpcService>(
       muddle_->GetEndpoint(), *main_chain_rpc_client_, *chain_, trust_, consensus_);
 
+  if (cfg_.features.IsEnabled("parallel-block-sync"))
+  {
+    main_chain_service_->SetSyncMode(MainChainRpcService::SyncMode::MULTI_PEER);
+  }
+
   // the health check module needs the latest chain service
   health_check_module_->UpdateChainService(*main_chain_service_);
 
@@ -862,6 +887,7 @@ void Constellation::OnTearDownExternalNetwork()
   ResetItem(block_coordinator_);
   ResetItem(block_packer_);
   ResetItem(execution_manager_);
+  ResetItem(state_cache_);
   ResetItem(consensus_);
   ResetItem(stake_);
   ResetItem(beacon_);
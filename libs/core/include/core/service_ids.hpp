@@ -46,6 +46,7 @@ static constexpr uint16_t CHANNEL_RPC = 1;  // for convenience we essentially
 // Muddle Service Channels
 static constexpr uint16_t CHANNEL_ROUTING      = 256;  // direct only
 static constexpr uint16_t CHANNEL_ANNOUNCEMENT = 257;
+static constexpr uint16_t CHANNEL_GOSSIP       = 258;  // direct only
 
 // P2P Service Channels
 
@@ -0,0 +1,157 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/openssl_ecdsa_public_key.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Verification engine for ECDSA signatures
+ *
+ * The engine keeps two caches in front of the OpenSSL verification:
+ *
+ * - Public key objects are cached by their raw bytes so that the (relatively expensive) point
+ *   decoding is only performed once per signer.
+ * - Successfully verified (signer, signature, payload digest) triples are remembered so that
+ *   duplicate messages, for example broadcasts received from several peers or re-gossiped
+ *   transactions, are not verified twice.
+ *
+ * Both caches are bounded. Each one keeps the current and the previous generation of entries, and
+ * once the current generation is full the previous generation is discarded.
+ *
+ * Single signatures are verified on the calling thread. Batches are split across the shared
+ * worker pool of the engine, with the calling thread taking part in the work.
+ */
+class VerificationEngine
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  struct Request
+  {
+    ConstByteArray identity;   ///< The raw public key of the signer
+    ConstByteArray data;       ///< The signed payload
+    ConstByteArray signature;  ///< The signature to be checked
+  };
+
+  using Requests = std::vector<Request>;
+  using Results  = std::vector<uint8_t>;  ///< Non-zero when the corresponding request is valid
+
+  static constexpr std::size_t DEFAULT_KEY_CACHE_SIZE       = 1u << 12u;  // 4K
+  static constexpr std::size_t DEFAULT_SIGNATURE_CACHE_SIZE = 1u << 16u;  // 65K
+
+  static VerificationEngine &Default();
+
+  // Construction / Destruction
+  explicit VerificationEngine(std::size_t num_threads,
+                              std::size_t key_cache_size       = DEFAULT_KEY_CACHE_SIZE,
+                              std::size_t signature_cache_size = DEFAULT_SIGNATURE_CACHE_SIZE);
+  VerificationEngine(VerificationEngine const &) = delete;
+  VerificationEngine(VerificationEngine &&)      = delete;
+  ~VerificationEngine();
+
+  /// @name Verification
+  /// @{
+  bool    Verify(Identity const &identity, ConstByteArray const &data,
+                 ConstByteArray const &signature);
+  bool    Verify(Request const &request);
+  Results Verify(Requests const &requests);
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  std::size_t num_threads() const;
+  uint64_t    num_verifications() const;
+  uint64_t    num_key_cache_hits() const;
+  uint64_t    num_signature_cache_hits() const;
+  /// @}
+
+  // Operators
+  VerificationEngine &operator=(VerificationEngine const &) = delete;
+  VerificationEngine &operator=(VerificationEngine &&) = delete;
+
+private:
+  using PublicKey    = openssl::ECDSAPublicKey<>;
+  using PublicKeyPtr = std::shared_ptr<PublicKey const>;
+  using KeyCache     = std::unordered_map<ConstByteArray, PublicKeyPtr>;
+  using VerifiedSet  = std::unordered_set<ConstByteArray>;
+  using Task         = std::function<void()>;
+  using Tasks        = std::deque<Task>;
+  using Threads      = std::vector<std::thread>;
+  using Counter      = std::atomic<uint64_t>;
+
+  PublicKeyPtr LookupPublicKey(ConstByteArray const &identity);
+  bool         IsRecentlyVerified(ConstByteArray const &key) const;
+  void         RecordVerified(ConstByteArray const &key);
+
+  void StartWorkers();
+  void Post(Task task);
+  void WorkerLoop();
+
+  std::size_t const num_threads_;
+  std::size_t const key_cache_size_;
+  std::size_t const signature_cache_size_;
+
+  /// @name Public key cache
+  /// @{
+  mutable Mutex key_cache_lock_;
+  KeyCache      key_cache_;
+  KeyCache      previous_key_cache_;
+  /// @}
+
+  /// @name Recently verified signatures
+  /// @{
+  mutable Mutex verified_lock_;
+  VerifiedSet   verified_;
+  VerifiedSet   previously_verified_;
+  /// @}
+
+  /// @name Worker pool
+  /// @{
+  std::mutex              tasks_lock_;
+  std::condition_variable tasks_available_;
+  Tasks                   tasks_;
+  Threads                 workers_;
+  bool                    shutdown_{false};
+  /// @}
+
+  Counter verifications_{0};
+  Counter key_cache_hits_{0};
+  Counter signature_cache_hits_{0};
+};
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,385 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "crypto/ecdsa_signature.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "crypto/verification_engine.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+using Signature = openssl::ECDSASignature<>;
+using byte_array::ConstByteArray;
+
+/**
+ * Build the key under which a successful verification is remembered
+ *
+ * @param identity The raw public key of the signer
+ * @param signature The signature
+ * @param digest The digest of the signed payload
+ * @return The cache key
+ */
+ConstByteArray CreateVerifiedKey(ConstByteArray const &identity, ConstByteArray const &signature,
+                                 ConstByteArray const &digest)
+{
+  SHA256 hasher{};
+  hasher.Reset();
+  hasher.Update(identity);
+  hasher.Update(signature);
+  hasher.Update(digest);
+  return hasher.Final();
+}
+
+/**
+ * Insert an element into a two generation cache. When the current generation has reached its
+ * capacity it replaces the previous generation and a new, empty, generation is started.
+ *
+ * @param current The current generation
+ * @param previous The previous generation
+ * @param capacity The capacity of a generation
+ * @param args The arguments used to construct the element
+ */
+template <typename Container, typename... Args>
+void InsertIntoGeneration(Container &current, Container &previous, std::size_t capacity,
+                          Args &&... args)
+{
+  if (current.size() >= capacity)
+  {
+    previous = std::move(current);
+    current.clear();
+  }
+
+  current.emplace(std::forward<Args>(args)...);
+}
+
+}  // namespace
+
+/**
+ * Get the verification engine shared across the process
+ *
+ * @return The shared verification engine
+ */
+VerificationEngine &VerificationEngine::Default()
+{
+  static VerificationEngine engine{std::max(std::thread::hardware_concurrency(), 1u)};
+  return engine;
+}
+
+/**
+ * Construct a verification engine
+ *
+ * @param num_threads The number of worker threads used for batched verification
+ * @param key_cache_size The maximum number of cached public keys
+ * @param signature_cache_size The maximum number of remembered verified signatures
+ */
+VerificationEngine::VerificationEngine(std::size_t num_threads, std::size_t key_cache_size,
+                                       std::size_t signature_cache_size)
+  : num_threads_{num_threads}
+  , key_cache_size_{std::max<std::size_t>(key_cache_size / 2, 1)}
+  , signature_cache_size_{std::max<std::size_t>(signature_cache_size / 2, 1)}
+{}
+
+VerificationEngine::~VerificationEngine()
+{
+  {
+    std::lock_guard<std::mutex> lock(tasks_lock_);
+    shutdown_ = true;
+  }
+  tasks_available_.notify_all();
+
+  for (auto &worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+/**
+ * Verify a single signature on the calling thread
+ *
+ * @param identity The identity of the signer
+ * @param data The signed payload
+ * @param signature The signature to verify
+ * @return true if the signature is valid for the payload, otherwise false
+ */
+bool VerificationEngine::Verify(Identity const &identity, ConstByteArray const &data,
+                                ConstByteArray const &signature)
+{
+  if (!identity)
+  {
+    return false;
+  }
+
+  return Verify(Request{identity.identifier(), data, signature});
+}
+
+/**
+ * Verify a single signature on the calling thread
+ *
+ * @param request The signature verification request
+ * @return true if the signature is valid for the payload, otherwise false
+ */
+bool VerificationEngine::Verify(Request const &request)
+{
+  if (!Identity{request.identity} || request.signature.empty())
+  {
+    return false;
+  }
+
+  try
+  {
+    ConstByteArray const digest = Hash<Signature::HasherType>(request.data);
+    ConstByteArray const key    = CreateVerifiedKey(request.identity, request.signature, digest);
+
+    if (IsRecentlyVerified(key))
+    {
+      ++signature_cache_hits_;
+      return true;
+    }
+
+    auto const public_key = LookupPublicKey(request.identity);
+
+    ++verifications_;
+    Signature const signature{request.signature};
+    if (!signature.VerifyHash(*public_key, digest))
+    {
+      return false;
+    }
+
+    RecordVerified(key);
+    return true;
+  }
+  catch (std::exception const &)
+  {
+    // malformed keys and signatures are simply not genuine
+    return false;
+  }
+}
+
+/**
+ * Verify a batch of signatures. The requests are shared out between the worker threads of the
+ * engine and the calling thread, which blocks until the whole batch has been verified.
+ *
+ * @param requests The signature verification requests
+ * @return The verification results, in the order of the requests
+ */
+VerificationEngine::Results VerificationEngine::Verify(Requests const &requests)
+{
+  Results results(requests.size(), 0);
+
+  std::atomic<std::size_t> next{0};
+  auto verify_requests = [this, &requests, &results, &next]() {
+    for (std::size_t i = next++; i < requests.size(); i = next++)
+    {
+      results[i] = static_cast<uint8_t>(Verify(requests[i]));
+    }
+  };
+
+  // the calling thread verifies alongside the helpers
+  std::size_t const num_helpers =
+      requests.empty() ? 0 : std::min(num_threads_, requests.size() - 1);
+
+  std::mutex              helpers_lock;
+  std::condition_variable helpers_done;
+  std::size_t             remaining_helpers{num_helpers};
+
+  if (num_helpers > 0)
+  {
+    StartWorkers();
+  }
+
+  for (std::size_t i = 0; i < num_helpers; ++i)
+  {
+    Post([&verify_requests, &helpers_lock, &helpers_done, &remaining_helpers]() {
+      verify_requests();
+
+      std::lock_guard<std::mutex> lock(helpers_lock);
+      if (--remaining_helpers == 0)
+      {
+        helpers_done.notify_one();
+      }
+    });
+  }
+
+  verify_requests();
+
+  // the helpers reference this stack frame so we must wait for all of them to complete
+  std::unique_lock<std::mutex> lock(helpers_lock);
+  helpers_done.wait(lock, [&remaining_helpers]() { return remaining_helpers == 0; });
+
+  return results;
+}
+
+std::size_t VerificationEngine::num_threads() const
+{
+  return num_threads_;
+}
+
+uint64_t VerificationEngine::num_verifications() const
+{
+  return verifications_;
+}
+
+uint64_t VerificationEngine::num_key_cache_hits() const
+{
+  return key_cache_hits_;
+}
+
+uint64_t VerificationEngine::num_signature_cache_hits() const
+{
+  return signature_cache_hits_;
+}
+
+/**
+ * Internal: Lookup (or create) the public key object for the specified raw key
+ *
+ * @param identity The raw public key
+ * @return The public key object
+ */
+VerificationEngine::PublicKeyPtr VerificationEngine::LookupPublicKey(ConstByteArray const &identity)
+{
+  PublicKeyPtr public_key{};
+
+  {
+    FETCH_LOCK(key_cache_lock_);
+
+    auto it = key_cache_.find(identity);
+    if (it != key_cache_.end())
+    {
+      ++key_cache_hits_;
+      return it->second;
+    }
+
+    it = previous_key_cache_.find(identity);
+    if (it != previous_key_cache_.end())
+    {
+      ++key_cache_hits_;
+      public_key = it->second;
+
+      // keep frequently seen keys in the current generation
+      InsertIntoGeneration(key_cache_, previous_key_cache_, key_cache_size_, identity, public_key);
+      return public_key;
+    }
+  }
+
+  // decode the key outside of the lock
+  public_key = std::make_shared<PublicKey const>(identity);
+
+  {
+    FETCH_LOCK(key_cache_lock_);
+    InsertIntoGeneration(key_cache_, previous_key_cache_, key_cache_size_, identity, public_key);
+  }
+
+  return public_key;
+}
+
+/**
+ * Internal: Determine if the specified verification has been successfully completed recently
+ *
+ * @param key The verification key
+ * @return true if the verification has been completed recently, otherwise false
+ */
+bool VerificationEngine::IsRecentlyVerified(ConstByteArray const &key) const
+{
+  FETCH_LOCK(verified_lock_);
+  return (verified_.find(key) != verified_.end()) ||
+         (previously_verified_.find(key) != previously_verified_.end());
+}
+
+/**
+ * Internal: Record a successful verification
+ *
+ * @param key The verification key
+ */
+void VerificationEngine::RecordVerified(ConstByteArray const &key)
+{
+  FETCH_LOCK(verified_lock_);
+  InsertIntoGeneration(verified_, previously_verified_, signature_cache_size_, key);
+}
+
+/**
+ * Internal: Start the worker threads (if not already running)
+ */
+void VerificationEngine::StartWorkers()
+{
+  std::lock_guard<std::mutex> lock(tasks_lock_);
+
+  if (!workers_.empty() || shutdown_)
+  {
+    return;
+  }
+
+  workers_.reserve(num_threads_);
+  for (std::size_t i = 0; i < num_threads_; ++i)
+  {
+    workers_.emplace_back([this, i]() {
+      SetThreadName("Verifier", i);
+      WorkerLoop();
+    });
+  }
+}
+
+/**
+ * Internal: Add a task to the worker queue
+ *
+ * @param task The task to be executed
+ */
+void VerificationEngine::Post(Task task)
+{
+  {
+    std::lock_guard<std::mutex> lock(tasks_lock_);
+    tasks_.emplace_back(std::move(task));
+  }
+
+  tasks_available_.notify_one();
+}
+
+/**
+ * Internal: Thread process for the worker threads
+ */
+void VerificationEngine::WorkerLoop()
+{
+  for (;;)
+  {
+    Task task;
+
+    {
+      std::unique_lock<std::mutex> lock(tasks_lock_);
+      tasks_available_.wait(lock, [this]() { return shutdown_ || !tasks_.empty(); });
+
+      if (tasks_.empty())
+      {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/ecdsa.hpp"
+#include "crypto/verification_engine.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <string>
+
+namespace fetch {
+namespace crypto {
+
+namespace {
+
+using ConstByteArray = fetch::byte_array::ConstByteArray;
+using Request        = VerificationEngine::Request;
+using Requests       = VerificationEngine::Requests;
+using Results        = VerificationEngine::Results;
+
+class VerificationEngineTests : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    signer_.GenerateKeys();
+    other_signer_.GenerateKeys();
+  }
+
+  Request CreateRequest(ECDSASigner &signer, std::string const &message)
+  {
+    ConstByteArray data{message};
+    return {signer.identity().identifier(), data, signer.Sign(data)};
+  }
+
+  ECDSASigner signer_;
+  ECDSASigner other_signer_;
+};
+
+TEST_F(VerificationEngineTests, CheckValidAndInvalidSignatures)
+{
+  VerificationEngine engine{0};
+
+  auto const request = CreateRequest(signer_, "hello");
+
+  EXPECT_TRUE(engine.Verify(request));
+  EXPECT_TRUE(engine.Verify(signer_.identity(), request.data, request.signature));
+
+  // wrong payload, wrong signer and malformed inputs are all rejected
+  ConstByteArray const other_data{"world"};
+  ConstByteArray const other_identity{other_signer_.identity().identifier()};
+
+  EXPECT_FALSE(engine.Verify(Request{request.identity, other_data, request.signature}));
+  EXPECT_FALSE(engine.Verify(Request{other_identity, request.data, request.signature}));
+  EXPECT_FALSE(engine.Verify(Request{request.identity, request.data, ConstByteArray{"bad"}}));
+  EXPECT_FALSE(engine.Verify(Request{ConstByteArray{"bad"}, request.data, request.signature}));
+  EXPECT_FALSE(engine.Verify(Request{request.identity, request.data, ConstByteArray{}}));
+}
+
+TEST_F(VerificationEngineTests, CheckDuplicateSignaturesAreOnlyVerifiedOnce)
+{
+  VerificationEngine engine{0};
+
+  auto const first  = CreateRequest(signer_, "first");
+  auto const second = CreateRequest(signer_, "second");
+
+  EXPECT_TRUE(engine.Verify(first));
+  EXPECT_TRUE(engine.Verify(first));
+  EXPECT_TRUE(engine.Verify(second));
+
+  EXPECT_EQ(engine.num_verifications(), 2u);
+  EXPECT_EQ(engine.num_signature_cache_hits(), 1u);
+  EXPECT_EQ(engine.num_key_cache_hits(), 1u);
+
+  // failed verifications are never remembered
+  Request const forged{first.identity, ConstByteArray{"forged"}, first.signature};
+  EXPECT_FALSE(engine.Verify(forged));
+  EXPECT_FALSE(engine.Verify(forged));
+  EXPECT_EQ(engine.num_verifications(), 4u);
+}
+
+TEST_F(VerificationEngineTests, CheckVerifiedSignatureCacheIsBounded)
+{
+  VerificationEngine engine{0, VerificationEngine::DEFAULT_KEY_CACHE_SIZE, 2};
+
+  auto const first  = CreateRequest(signer_, "first");
+  auto const second = CreateRequest(signer_, "second");
+  auto const third  = CreateRequest(signer_, "third");
+
+  EXPECT_TRUE(engine.Verify(first));
+  EXPECT_TRUE(engine.Verify(second));
+  EXPECT_TRUE(engine.Verify(third));
+  EXPECT_EQ(engine.num_verifications(), 3u);
+
+  // the first signature has been dropped with the oldest generation
+  EXPECT_TRUE(engine.Verify(third));
+  EXPECT_TRUE(engine.Verify(first));
+  EXPECT_EQ(engine.num_verifications(), 4u);
+  EXPECT_EQ(engine.num_signature_cache_hits(), 1u);
+}
+
+TEST_F(VerificationEngineTests, CheckBatchResultsMatchTheRequests)
+{
+  for (std::size_t threads : {0u, 1u, 4u})
+  {
+    VerificationEngine engine{threads};
+
+    Requests requests{};
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+      auto request = CreateRequest((i % 2 == 0) ? signer_ : other_signer_, std::to_string(i));
+
+      // corrupt every third request
+      if (i % 3 == 0)
+      {
+        request.data = ConstByteArray{"corrupted"};
+      }
+
+      requests.push_back(request);
+    }
+
+    Results const results = engine.Verify(requests);
+
+    ASSERT_EQ(results.size(), requests.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      EXPECT_EQ(results[i] != 0, i % 3 != 0);
+    }
+  }
+
+  VerificationEngine engine{2};
+  EXPECT_TRUE(engine.Verify(Requests{}).empty());
+}
+
+}  // namespace
+
+}  // namespace crypto
+}  // namespace fetch
@@ -26,10 +26,16 @@
 #include "ledger/chaincode/token_contract.hpp"
 #include "ledger/executor.hpp"
 #include "ledger/state_sentinel_adapter.hpp"
+#include "telemetry/registry.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <new>
 
 namespace {
 
@@ -42,6 +48,9 @@ using fetch::ledger::StateSentinelAdapter;
 using fetch::crypto::ECDSASigner;
 using fetch::BitVector;
 
+// The total number of heap allocations made by the benchmark binary (see operator new below)
+std::atomic<std::size_t> allocation_count{0};
+
 std::shared_ptr<Transaction> CreateSampleTransaction()
 {
   ECDSASigner entity1{};
@@ -61,8 +70,46 @@ std::shared_ptr<Transaction> CreateSampleTransaction()
       .Build();
 }
 
+/**
+ * The executor looks up its metrics which are normally created by the execution manager
+ */
+void CreateExecutorMetrics()
+{
+  static bool created{false};
+
+  if (!created)
+  {
+    auto &registry = fetch::telemetry::Registry::Instance();
+
+    for (char const *name :
+         {"ledger_executor_overall_duration", "ledger_executor_tx_retrieve_duration",
+          "ledger_executor_validation_checks_duration",
+          "ledger_executor_contract_execution_duration", "ledger_executor_transfers_duration",
+          "ledger_executor_deduct_fees_duration", "ledger_executor_settle_fees_duration"})
+    {
+      registry.CreateHistogram({0.000001, 0.00001, 0.0001, 0.001, 0.01, 0.1, 1}, name, name);
+    }
+
+    created = true;
+  }
+}
+
+void AddFunds(InMemoryStorageUnit &storage, Transaction const &tx, BitVector const &shards,
+              uint64_t amount)
+{
+  StateSentinelAdapter adapter{storage, "fetch.token", shards};
+
+  TokenContract tokens{};
+
+  fetch::ledger::ContractContext context{&tokens, tx.contract_address(), nullptr, &adapter, 0};
+  fetch::ledger::ContractContextAttacher raii(tokens, context);
+  tokens.AddTokens(tx.from(), amount);
+}
+
 void Executor_BasicBenchmark(benchmark::State &state)
 {
+  CreateExecutorMetrics();
+
   auto     storage = std::make_shared<InMemoryStorageUnit>();
   Executor executor{storage};
 
@@ -74,22 +121,73 @@ void Executor_BasicBenchmark(benchmark::State &state)
   shards.SetAllOne();
 
   // add funds to ensure the transaction passes
+  AddFunds(*storage, *tx, shards, 500000);
+
+  for (auto _ : state)
   {
-    StateSentinelAdapter adapter{*storage, "fetch.token", shards};
+    executor.Execute(tx->digest(), 1, 1, shards);
+  }
+}
 
-    TokenContract tokens{};
+void Executor_AllocationsPerTransaction(benchmark::State &state)
+{
+  CreateExecutorMetrics();
 
-    fetch::ledger::ContractContext context{&tokens, tx->contract_address(), nullptr, &adapter, 0};
-    fetch::ledger::ContractContextAttacher raii(tokens, context);
-    tokens.AddTokens(tx->from(), 500000);
-  }
+  auto     storage = std::make_shared<InMemoryStorageUnit>();
+  Executor executor{storage};
+
+  // create and add the transaction to storage
+  auto tx = CreateSampleTransaction();
+  storage->AddTransaction(*tx);
+
+  BitVector shards{1};
+  shards.SetAllOne();
+
+  // add enough funds for the transaction to succeed in every iteration
+  AddFunds(*storage, *tx, shards, 1000000000000ull);
+
+  // the first execution populates state which is then reused
+  executor.Execute(tx->digest(), 1, 1, shards);
+
+  std::size_t const initial_allocations = allocation_count;
 
   for (auto _ : state)
   {
     executor.Execute(tx->digest(), 1, 1, shards);
   }
+
+  auto const allocations = static_cast<double>(allocation_count - initial_allocations);
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["allocs/tx"] = benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
 }
 
 }  // namespace
 
+// Replace the global allocation functions in order to count the allocations made while executing
+// transactions. This applies to the whole benchmark binary, but only adds an atomic increment.
+void *operator new(std::size_t size)
+{
+  ++allocation_count;
+
+  void *ptr = std::malloc((size == 0) ? 1 : size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
 BENCHMARK(Executor_BasicBenchmark);
+BENCHMARK(Executor_AllocationsPerTransaction);
@@ -17,13 +17,21 @@
 //------------------------------------------------------------------------------
 
 #include "bloom_filter/bloom_filter.hpp"
+#include "chain/constants.hpp"
+#include "chain/transaction_layout.hpp"
+#include "core/bitvector.hpp"
+#include "core/random/lfg.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/testing/block_generator.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -31,8 +39,11 @@ namespace {
 using fetch::ledger::MainChain;
 using fetch::ledger::testing::BlockGenerator;
 
+using fetch::chain::TransactionLayout;
+
 using MainChainPtr = std::unique_ptr<MainChain>;
 using BlockArray   = std::vector<BlockGenerator::BlockPtr>;
+using Rng          = fetch::random::LaggedFibonacciGenerator<>;
 
 BlockArray GenerateBlocks(benchmark::State const &state)
 {
@@ -40,6 +51,8 @@ BlockArray GenerateBlocks(benchmark::State const &state)
   static constexpr std::size_t NUM_SLICES      = 2;
   static constexpr std::size_t ITERATION_MULTI = 10;
 
+  fetch::chain::InitialiseTestConstants();
+
   std::size_t const total_blocks = (ITERATION_MULTI * state.max_iterations) + 1;
 
   BlockArray array(total_blocks);
@@ -135,9 +148,189 @@ void MainChain_Persistent_AddBlocksOutOfOrder(benchmark::State &state)
   }
 }
 
+TransactionLayout GenerateLayout(Rng &rng, uint64_t block_number)
+{
+  static constexpr uint64_t VALIDITY_PERIOD = 100;
+
+  fetch::byte_array::ByteArray digest{};
+  digest.Resize(32);
+
+  for (std::size_t i = 0; i < digest.size(); i += sizeof(uint64_t))
+  {
+    auto const value = rng();
+    std::memcpy(digest.pointer() + i, &value, sizeof(value));
+  }
+
+  fetch::BitVector mask{1};
+  mask.set(0, 1);
+
+  return TransactionLayout{digest, mask, 1, 0, block_number + VALIDITY_PERIOD};
+}
+
+/**
+ * Measure the latency of adding transaction bearing blocks to the heaviest branch, while a
+ * competing branch is also being mined. A percentage of the transactions in each heaviest branch
+ * block have also been included in the competing branch. These transactions are (correctly) not
+ * duplicates on the heaviest branch, but must be distinguished from transactions which are.
+ *
+ * Arguments: number of transactions per block, percentage of transactions shared with the
+ * competing branch
+ */
+void MainChain_InMemory_AddBlocksWithTransactions(benchmark::State &state)
+{
+  static constexpr std::size_t NUM_BLOCKS = 100;
+
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+
+  auto const num_txs        = static_cast<std::size_t>(state.range(0));
+  auto const shared_percent = static_cast<std::size_t>(state.range(1));
+  auto const num_shared     = (num_txs * shared_percent) / 100u;
+
+  Rng            rng{};
+  BlockGenerator gen{1, 1};
+
+  BlockArray heaviest{};
+  BlockArray competing{};
+
+  heaviest.push_back(gen.Generate());
+
+  for (std::size_t i = 1; i <= NUM_BLOCKS; ++i)
+  {
+    auto const &previous = heaviest.back();
+
+    auto main_block  = gen.Generate(previous, 2u);
+    auto other_block = gen.Generate(previous, 1u);
+
+    for (std::size_t j = 0; j < num_txs; ++j)
+    {
+      auto const layout = GenerateLayout(rng, main_block->block_number);
+
+      main_block->slices[0].push_back(layout);
+
+      if (j < num_shared)
+      {
+        other_block->slices[0].push_back(layout);
+      }
+    }
+
+    main_block->UpdateDigest();
+    other_block->UpdateDigest();
+
+    heaviest.push_back(main_block);
+    competing.push_back(other_block);
+  }
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto chain = std::make_unique<MainChain>(MainChain::Mode::IN_MEMORY_DB);
+
+    for (std::size_t i = 1; i < heaviest.size(); ++i)
+    {
+      chain->AddBlock(*competing[i - 1]);
+      state.ResumeTiming();
+
+      chain->AddBlock(*heaviest[i]);
+
+      state.PauseTiming();
+    }
+
+    state.ResumeTiming();
+  }
+
+  state.counters["blocks/s"] = benchmark::Counter(static_cast<double>(NUM_BLOCKS),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/**
+ * Measure the rate at which blocks can be added to the chain while a number of reader threads
+ * continuously query it. The reader threads look up blocks which have already been added as well
+ * as the recent part of the heaviest chain.
+ *
+ * Arguments: number of reader threads
+ */
+void MainChain_InMemory_AddBlocksWithConcurrentReaders(benchmark::State &state)
+{
+  static constexpr uint64_t RECENT_CHAIN_LENGTH = 10;
+
+  fetch::crypto::mcl::details::MCLInitialiser();
+
+  auto const num_readers = static_cast<std::size_t>(state.range(0));
+  auto const array       = GenerateBlocks(state);
+
+  std::atomic<std::size_t> total_reads{0};
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto chain = std::make_unique<MainChain>(MainChain::Mode::IN_MEMORY_DB);
+
+    std::atomic<std::size_t> num_added{1};
+    std::atomic<bool>        running{true};
+
+    std::vector<std::thread> readers{};
+    for (std::size_t i = 0; i < num_readers; ++i)
+    {
+      readers.emplace_back([&chain, &array, &num_added, &running, &total_reads, i]() {
+        Rng         rng{i + 1};
+        std::size_t reads{0};
+
+        while (running)
+        {
+          auto const index = rng() % num_added.load();
+
+          chain->GetBlock(array[index]->hash);
+          chain->GetHeaviestChain(RECENT_CHAIN_LENGTH);
+
+          reads += 2;
+        }
+
+        total_reads += reads;
+      });
+    }
+    state.ResumeTiming();
+
+    for (std::size_t i = 1; i < array.size(); ++i)
+    {
+      chain->AddBlock(*array[i]);
+      num_added = i + 1;
+    }
+
+    state.PauseTiming();
+    running = false;
+    for (auto &reader : readers)
+    {
+      reader.join();
+    }
+    state.ResumeTiming();
+  }
+
+  state.counters["blocks/s"] = benchmark::Counter(static_cast<double>(array.size() - 1),
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["reads/s"] =
+      benchmark::Counter(static_cast<double>(total_reads.load()), benchmark::Counter::kIsRate);
+}
+
 }  // namespace
 
 BENCHMARK(MainChain_InMemory_AddBlocksSequentially);
 BENCHMARK(MainChain_Persistent_AddBlocksSequentially);
 BENCHMARK(MainChain_InMemory_AddBlocksOutOfOrder);
 BENCHMARK(MainChain_Persistent_AddBlocksOutOfOrder);
+BENCHMARK(MainChain_InMemory_AddBlocksWithTransactions)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({100, 10})
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({1000, 10})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(MainChain_InMemory_AddBlocksWithConcurrentReaders)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
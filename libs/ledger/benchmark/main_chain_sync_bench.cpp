@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/constants.hpp"
+#include "core/mutex.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/consensus/simulated_pow_consensus.hpp"
+#include "ledger/protocols/main_chain_rpc_client.hpp"
+#include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/testing/block_generator.hpp"
+#include "logging/logging.hpp"
+#include "muddle/create_muddle_fake.hpp"
+#include "muddle/muddle_interface.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/p2pservice/p2ptrust_bayrank.hpp"
+#include "network/service/promise.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::Digest;
+using fetch::ledger::MainChain;
+using fetch::ledger::MainChainRpcClient;
+using fetch::ledger::MainChainRpcClientInterface;
+using fetch::ledger::MainChainRpcService;
+using fetch::ledger::SimulatedPowConsensus;
+using fetch::ledger::testing::BlockGenerator;
+using fetch::muddle::MuddleEndpoint;
+
+using BlockPtrs      = BlockGenerator::BlockPtrs;
+using CertificatePtr = std::shared_ptr<fetch::crypto::ECDSASigner>;
+using Clock          = std::chrono::steady_clock;
+using Promise        = fetch::service::Promise;
+using SyncMode       = MainChainRpcService::SyncMode;
+using TrustSystem    = fetch::p2p::P2PTrustBayRank<fetch::muddle::Address>;
+
+constexpr std::size_t CHAIN_LENGTH   = 2000;
+constexpr std::size_t NUM_LANES      = 1;
+constexpr std::size_t NUM_SLICES     = 2;
+constexpr uint64_t    LINK_BANDWIDTH = 256 * 1024;  // bytes per second
+constexpr auto        LINK_LATENCY   = std::chrono::milliseconds{50};
+constexpr auto        SYNC_TIMEOUT   = std::chrono::seconds{120};
+
+CertificatePtr CreateCertificate()
+{
+  auto certificate = std::make_shared<fetch::crypto::ECDSASigner>();
+  certificate->GenerateKeys();
+  return certificate;
+}
+
+/**
+ * Main chain RPC client which delays the responses of each peer as if they had been sent over a
+ * link with a fixed latency and a limited bandwidth. The fake muddle itself delivers all messages
+ * instantly.
+ */
+class SimulatedLinkRpcClient : public MainChainRpcClientInterface
+{
+public:
+  explicit SimulatedLinkRpcClient(MuddleEndpoint &endpoint)
+    : client_{endpoint}
+  {}
+
+  ~SimulatedLinkRpcClient() override
+  {
+    for (auto &delivery : deliveries_)
+    {
+      delivery.join();
+    }
+  }
+
+  BlocksPromise GetHeaviestChain(MuddleAddress peer, uint64_t max_size) override
+  {
+    return BlocksPromise{Deliver(peer, client_.GetHeaviestChain(peer, max_size))};
+  }
+
+  BlocksPromise GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
+                                  uint64_t limit) override
+  {
+    auto response = client_.GetCommonSubChain(peer, std::move(start), std::move(last_seen), limit);
+    return BlocksPromise{Deliver(peer, response)};
+  }
+
+  TraveloguePromise TimeTravel(MuddleAddress peer, Digest start) override
+  {
+    return TraveloguePromise{Deliver(peer, client_.TimeTravel(peer, std::move(start)))};
+  }
+
+  DigestsPromise TimeTravelDigests(MuddleAddress peer, Digest start, uint64_t limit) override
+  {
+    return DigestsPromise{Deliver(peer, client_.TimeTravelDigests(peer, std::move(start), limit))};
+  }
+
+  TraveloguePromise TimeTravelRange(MuddleAddress peer, Digest start, uint64_t limit) override
+  {
+    return TraveloguePromise{
+        Deliver(peer, client_.TimeTravelRange(peer, std::move(start), limit))};
+  }
+
+private:
+  template <typename T>
+  Promise Deliver(MuddleAddress const &peer, fetch::network::PromiseOf<T> const &response)
+  {
+    auto delivered = fetch::service::MakePromise();
+    auto inner     = response.GetInnerPromise();
+
+    FETCH_LOCK(lock_);
+    deliveries_.emplace_back([this, peer, inner, delivered]() {
+      if (!inner->Wait(false) || !inner->IsSuccessful())
+      {
+        delivered->Fail();
+        return;
+      }
+
+      // responses from the same peer share the bandwidth of its link
+      auto const transfer =
+          std::chrono::microseconds{(inner->value().size() * 1000000u) / LINK_BANDWIDTH};
+
+      Clock::time_point arrival{};
+      {
+        FETCH_LOCK(lock_);
+        auto &busy_until = links_[peer];
+        busy_until       = std::max(busy_until, Clock::now()) + transfer;
+        arrival          = busy_until + LINK_LATENCY;
+      }
+
+      std::this_thread::sleep_until(arrival);
+      delivered->Fulfill(inner->value());
+    });
+
+    return delivered;
+  }
+
+  MainChainRpcClient                         client_;
+  fetch::Mutex                               lock_;
+  std::map<MuddleAddress, Clock::time_point> links_;
+  std::vector<std::thread>                   deliveries_;
+};
+
+struct SyncNode
+{
+  SyncNode(std::size_t index, BlockPtrs const &blocks)
+    : network_manager{"NetworkManager" + std::to_string(index), 1}
+    , certificate{CreateCertificate()}
+    , muddle{fetch::muddle::CreateMuddleFake("Test", certificate, network_manager, "127.0.0.1")}
+    , rpc_client{muddle->GetEndpoint()}
+    , consensus{std::make_shared<SimulatedPowConsensus>(certificate->identity(), 0, chain)}
+    , service{std::make_shared<MainChainRpcService>(muddle->GetEndpoint(), rpc_client, chain,
+                                                    trust, consensus)}
+  {
+    for (auto const &block : blocks)
+    {
+      chain.AddBlock(*block);
+    }
+
+    muddle->Start({});
+  }
+
+  ~SyncNode()
+  {
+    muddle->Stop();
+  }
+
+  fetch::network::NetworkManager         network_manager;
+  CertificatePtr                         certificate;
+  fetch::muddle::MuddlePtr               muddle;
+  MainChain                              chain{};
+  TrustSystem                            trust{};
+  SimulatedLinkRpcClient                 rpc_client;
+  std::shared_ptr<SimulatedPowConsensus> consensus;
+  std::shared_ptr<MainChainRpcService>   service;
+};
+
+void MainChainRpcService_SyncFreshNode(benchmark::State &state)
+{
+  fetch::crypto::mcl::details::MCLInitialiser();
+  fetch::chain::InitialiseTestConstants();
+  fetch::SetGlobalLogLevel(fetch::LogLevel::ERROR);
+
+  auto const sync_mode = static_cast<SyncMode>(state.range(0));
+  auto const num_peers = static_cast<std::size_t>(state.range(1));
+
+  BlockGenerator generator{NUM_LANES, NUM_SLICES};
+  auto const     blocks = generator(CHAIN_LENGTH, generator());
+  auto const     target = blocks.back()->hash;
+
+  // the peers all hold the complete chain
+  std::vector<std::unique_ptr<SyncNode>> peers{};
+  for (std::size_t i = 0; i < num_peers; ++i)
+  {
+    peers.emplace_back(std::make_unique<SyncNode>(i, blocks));
+  }
+
+  std::size_t index{num_peers};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto node = std::make_unique<SyncNode>(index++, BlockPtrs{});
+    node->service->SetSyncMode(sync_mode);
+
+    for (auto const &peer : peers)
+    {
+      node->muddle->ConnectTo(peer->muddle->GetAddress());
+    }
+
+    auto state_machine = node->service->GetWeakRunnable().lock();
+    state.ResumeTiming();
+
+    auto const deadline = Clock::now() + SYNC_TIMEOUT;
+    while (node->chain.GetHeaviestBlockHash() != target)
+    {
+      if (Clock::now() >= deadline)
+      {
+        state.SkipWithError("Timed out waiting for the node to sync");
+        break;
+      }
+
+      if (state_machine->IsReadyToExecute())
+      {
+        state_machine->Execute();
+      }
+      else
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+    }
+
+    state.PauseTiming();
+    state_machine.reset();
+    node.reset();
+    state.ResumeTiming();
+  }
+
+  state.counters["blocks"] = static_cast<double>(CHAIN_LENGTH);
+}
+
+}  // namespace
+
+// clang-format off
+BENCHMARK(MainChainRpcService_SyncFreshNode)
+    ->Args({static_cast<int64_t>(SyncMode::SINGLE_PEER), 4})
+    ->Args({static_cast<int64_t>(SyncMode::MULTI_PEER), 2})
+    ->Args({static_cast<int64_t>(SyncMode::MULTI_PEER), 4})
+    ->Args({static_cast<int64_t>(SyncMode::MULTI_PEER), 8})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+// clang-format on
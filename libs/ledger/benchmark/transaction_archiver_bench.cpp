@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "core/reactor.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/storage_unit/transaction_archiver.hpp"
+#include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "ledger/storage_unit/transaction_pool_interface.hpp"
+#include "ledger/storage_unit/transaction_store.hpp"
+#include "tx_generation.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using fetch::Digest;
+using fetch::DigestMap;
+using fetch::chain::Transaction;
+using fetch::core::Reactor;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::TransactionArchiver;
+using fetch::ledger::TransactionMemoryPool;
+using fetch::ledger::TransactionPoolInterface;
+using fetch::ledger::TransactionStore;
+
+namespace {
+
+using Clock     = std::chrono::steady_clock;
+using Timestamp = Clock::time_point;
+using Latencies = std::vector<double>;
+
+constexpr std::size_t NUM_TRANSACTIONS = 2000;
+
+/**
+ * Wrapper around the memory pool which records the time taken between the confirmation of a
+ * transaction and its removal from the pool (i.e. after it has been flushed to the archive)
+ */
+class LatencyRecordingPool : public TransactionPoolInterface
+{
+public:
+  void Add(Transaction const &tx) override
+  {
+    pool_.Add(tx);
+  }
+
+  bool Has(Digest const &tx_digest) const override
+  {
+    return pool_.Has(tx_digest);
+  }
+
+  bool Get(Digest const &tx_digest, Transaction &tx) const override
+  {
+    return pool_.Get(tx_digest, tx);
+  }
+
+  uint64_t GetCount() const override
+  {
+    return pool_.GetCount();
+  }
+
+  void Remove(Digest const &tx_digest) override
+  {
+    auto const now = Clock::now();
+
+    pool_.Remove(tx_digest);
+
+    FETCH_LOCK(lock_);
+    auto const it = confirmed_.find(tx_digest);
+    if (it != confirmed_.end())
+    {
+      latencies_.push_back(std::chrono::duration<double, std::micro>(now - it->second).count());
+      confirmed_.erase(it);
+    }
+  }
+
+  void MarkConfirmed(Digest const &tx_digest)
+  {
+    FETCH_LOCK(lock_);
+    confirmed_[tx_digest] = Clock::now();
+  }
+
+  Latencies TakeLatencies()
+  {
+    FETCH_LOCK(lock_);
+    Latencies latencies{};
+    std::swap(latencies, latencies_);
+    return latencies;
+  }
+
+private:
+  TransactionMemoryPool pool_;
+  fetch::Mutex          lock_;
+  DigestMap<Timestamp>  confirmed_;
+  Latencies             latencies_;
+};
+
+double Percentile(Latencies &latencies, double fraction)
+{
+  if (latencies.empty())
+  {
+    return 0.0;
+  }
+
+  auto const index = static_cast<std::size_t>(fraction * static_cast<double>(latencies.size() - 1));
+  std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(index),
+                   latencies.end());
+
+  return latencies[index];
+}
+
+/**
+ * Sustained archival of confirmed transactions
+ *
+ * Arg 0: archiver driven by its state machine on a reactor
+ * Arg 1: archiver running on its dedicated I/O thread
+ */
+void TransactionArchiver_SustainedThroughput(benchmark::State &state)
+{
+  bool const dedicated_thread = state.range(0) != 0;
+
+  ECDSASigner signer;
+
+  LatencyRecordingPool pool;
+  TransactionStore     store;
+  store.New("transaction_archiver_bench.db", "transaction_archiver_bench.index.db", true);
+
+  TransactionArchiver archiver{0, pool, store};
+  Reactor             reactor{"Archiver"};
+
+  if (dedicated_thread)
+  {
+    archiver.StartThread();
+  }
+  else
+  {
+    reactor.Attach(archiver.GetStateMachine());
+    reactor.Start();
+  }
+
+  Latencies latencies{};
+  for (auto _ : state)
+  {
+    // the archiver ignores transactions which are already present in the archive, therefore a
+    // fresh set of transactions is needed for each iteration
+    state.PauseTiming();
+    auto const txs = GenerateTransactions(NUM_TRANSACTIONS, signer);
+    for (auto const &tx : txs)
+    {
+      pool.Add(*tx);
+    }
+    state.ResumeTiming();
+
+    for (auto const &tx : txs)
+    {
+      pool.MarkConfirmed(tx->digest());
+      archiver.Confirm(tx->digest());
+    }
+
+    // wait for all the transactions to have been archived
+    while (pool.GetCount() != 0)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+
+    auto const batch = pool.TakeLatencies();
+    latencies.insert(latencies.end(), batch.begin(), batch.end());
+  }
+
+  if (dedicated_thread)
+  {
+    archiver.StopThread();
+  }
+  else
+  {
+    reactor.Stop();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_TRANSACTIONS));
+  state.counters["p50_us"] = Percentile(latencies, 0.5);
+  state.counters["p99_us"] = Percentile(latencies, 0.99);
+}
+
+}  // namespace
+
+BENCHMARK(TransactionArchiver_SustainedThroughput)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "tx_generation.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using fetch::chain::Transaction;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::TransactionMemoryPool;
+
+namespace {
+
+constexpr std::size_t NUM_TRANSACTIONS = 4096;
+
+TransactionList const &GetTransactions()
+{
+  static ECDSASigner const     signer{};
+  static TransactionList const txs = GenerateTransactions(NUM_TRANSACTIONS, signer);
+
+  return txs;
+}
+
+/**
+ * Contention on the memory pool
+ *
+ * Producers add their share of the transactions to the pool, while consumers concurrently look up
+ * (and retrieve) all of the transactions, in the same way as the executors and the archiver do.
+ *
+ * Arg 0: number of producer threads
+ * Arg 1: number of consumer threads
+ */
+void TransactionMemoryPool_Contention(benchmark::State &state)
+{
+  auto const num_producers = static_cast<std::size_t>(state.range(0));
+  auto const num_consumers = static_cast<std::size_t>(state.range(1));
+
+  auto const &txs = GetTransactions();
+
+  TransactionMemoryPool pool;
+
+  for (auto _ : state)
+  {
+    std::vector<std::thread> threads{};
+    threads.reserve(num_producers + num_consumers);
+
+    for (std::size_t producer = 0; producer < num_producers; ++producer)
+    {
+      threads.emplace_back([&pool, &txs, producer, num_producers]() {
+        for (std::size_t i = producer; i < txs.size(); i += num_producers)
+        {
+          pool.Add(*txs[i]);
+        }
+      });
+    }
+
+    for (std::size_t consumer = 0; consumer < num_consumers; ++consumer)
+    {
+      threads.emplace_back([&pool, &txs]() {
+        Transaction tx{};
+        for (auto const &entry : txs)
+        {
+          if (pool.Has(entry->digest()))
+          {
+            pool.Get(entry->digest(), tx);
+          }
+        }
+      });
+    }
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    state.PauseTiming();
+    for (auto const &tx : txs)
+    {
+      pool.Remove(tx->digest());
+    }
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<int64_t>(txs.size() * (1 + num_consumers)));
+}
+
+}  // namespace
+
+BENCHMARK(TransactionMemoryPool_Contention)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({2, 2})
+    ->Args({4, 4})
+    ->Args({8, 8})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
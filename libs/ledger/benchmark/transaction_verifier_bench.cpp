@@ -16,7 +16,9 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/transaction_serializer.hpp"
 #include "crypto/ecdsa.hpp"
+#include "crypto/verification_engine.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "tx_generation.hpp"
@@ -24,10 +26,14 @@
 #include "benchmark/benchmark.h"
 
 #include <condition_variable>
+#include <memory>
 #include <thread>
+#include <vector>
 
 using fetch::ledger::TransactionVerifier;
 using fetch::crypto::ECDSASigner;
+using fetch::crypto::VerificationEngine;
+using fetch::chain::TransactionSerializer;
 
 namespace {
 
@@ -66,24 +72,57 @@ public:
   }
 };
 
+/**
+ * Create fresh copies of the transactions, which have not been verified yet
+ */
+TransactionList CopyTransactions(std::vector<fetch::byte_array::ConstByteArray> const &encoded)
+{
+  TransactionList txs{};
+  txs.reserve(encoded.size());
+
+  for (auto const &data : encoded)
+  {
+    auto tx = std::make_shared<Transaction>();
+    TransactionSerializer{data} >> *tx;
+    txs.emplace_back(std::move(tx));
+  }
+
+  return txs;
+}
+
 void TransactionVerifierBench(benchmark::State &state)
 {
-  //  std::cout << "Tx Verification - threads: " << state.range(0) << " num txs: " << state.range(1)
-  //  << std::endl;
+  auto const threads    = static_cast<std::size_t>(state.range(0));
+  auto const num_txs    = static_cast<std::size_t>(state.range(1));
+  auto const batch_size = static_cast<std::size_t>(state.range(2));
 
   // generate the transactions
   ECDSASigner signer;
-  auto const  txs = GenerateTransactions(static_cast<std::size_t>(state.range(1)), signer);
+
+  std::vector<fetch::byte_array::ConstByteArray> encoded{};
+  for (auto const &tx : GenerateTransactions(num_txs, signer))
+  {
+    TransactionSerializer serializer{};
+    serializer << *tx;
+    encoded.emplace_back(serializer.data());
+  }
 
   // wait for the
   for (auto _ : state)
   {
     state.PauseTiming();
 
-    DummySink sink{txs.size()};
+    DummySink sink{num_txs};
+
+    // a new engine (with empty caches) and unverified copies of the transactions for every run. In
+    // batched mode a single verifier thread hands the batches to the engine workers instead.
+    bool const         batched = batch_size > 1;
+    VerificationEngine engine{batched ? threads - 1 : 0};
+    auto const         txs = CopyTransactions(encoded);
 
     // needs to be created on the heap because of memory use
-    auto verifier = std::make_unique<TransactionVerifier>(sink, state.range(0), "Verifier");
+    auto verifier = std::make_unique<TransactionVerifier>(sink, batched ? 1 : threads, "Verifier",
+                                                          batch_size, engine);
 
     // front load the verifier
     for (auto const &tx : txs)
@@ -99,24 +138,31 @@ void TransactionVerifierBench(benchmark::State &state)
 
     state.PauseTiming();
     verifier->Stop();
+    state.ResumeTiming();
   }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_txs));
 }
 
 void CreateRanges(benchmark::internal::Benchmark *b)
 {
   auto const max_threads = static_cast<int>(std::thread::hardware_concurrency());
 
-  for (int i = 1; i <= max_threads; ++i)
+  // the last argument is the batch size, where 1 selects the single transaction mode
+  for (int batch_size : {1, 64})
   {
-    b->Args({i, 1});
-    b->Args({i, 10});
-    b->Args({i, 100});
-    b->Args({i, 1000});
-    b->Args({i, 10000});
-    b->Args({i, 100000});
+    for (int i = 1; i <= max_threads; ++i)
+    {
+      b->Args({i, 1, batch_size});
+      b->Args({i, 10, batch_size});
+      b->Args({i, 100, batch_size});
+      b->Args({i, 1000, batch_size});
+      b->Args({i, 10000, batch_size});
+      b->Args({i, 100000, batch_size});
+    }
   }
 }
 
 }  // namespace
 
-BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges);
+BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges)->UseRealTime();
@@ -33,7 +33,7 @@ using TransactionList = std::vector<TransactionBuilder::TransactionPtr>;
 
 template <typename Word = uint64_t>
 fetch::meta::IfIsUnsignedInteger<Word, ByteArray> GenerateRandomArray(
-    std::size_t num_of_words, fetch::random::LinearCongruentialGenerator rng)
+    std::size_t num_of_words, fetch::random::LinearCongruentialGenerator &rng)
 {
   ByteArray array(sizeof(Word) * num_of_words);
   auto      raw_array = reinterpret_cast<Word *>(array.pointer());
@@ -66,6 +66,7 @@ inline TransactionList GenerateTransactions(std::size_t count, ECDSASigner const
     auto tx = TransactionBuilder()
                   .From(Address{signer.identity()})
                   .TargetChainCode("fetch.token", BitVector{})
+                  .Action("transfer")
                   .Data(GenerateRandomArray<Word>(large_packets ? TX_SIZE_IN_WORDS : 1ull, rng))
                   .Signer(signer.identity())
                   .Seal()
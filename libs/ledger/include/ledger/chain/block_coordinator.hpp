@@ -235,6 +235,12 @@ public:
   BlockCoordinator &operator=(BlockCoordinator const &) = delete;
   BlockCoordinator &operator=(BlockCoordinator &&) = delete;
 
+  /// @name Pipelining
+  /// @{
+  void        SetPipelineDepth(std::size_t depth);
+  std::size_t pipeline_depth() const;
+  /// @}
+
 private:
   enum class ExecutionStatus
   {
@@ -260,6 +266,20 @@ private:
   using DeadlineTimer     = fetch::moment::DeadlineTimer;
   using SynExecStatus     = SynergeticExecutionManagerInterface::ExecStatus;
 
+  /**
+   * An upcoming block in the look-ahead window which is prepared while the current block is still
+   * being processed
+   */
+  struct PipelinedBlock
+  {
+    BlockPtr       block;            ///< The upcoming block
+    TxDigestSetPtr missing_txs{};    ///< The txs not present when the block was prepared
+    bool           prepared{false};  ///< Flag to signal the block has been pre-validated
+    bool           valid{true};      ///< The result of the stateless pre-validation
+  };
+
+  using Pipeline = std::deque<PipelinedBlock>;
+
   /// @name Monitor State
   /// @{
   State OnReloadState();
@@ -291,6 +311,11 @@ private:
   void RemoveBlock(BlockPtrType &block);
   bool RevertToBlock(Block const &block);
   void Panic();
+  bool ValidateBlockLayout(Block const &block) const;
+  void FillPipeline();
+  void AdvancePipeline();
+  void TakePipelinedTransactions();
+  void RecordStage(char const *stage, Timepoint const &start);
 
   static char const *ToString(ExecutionStatus state);
 
@@ -335,6 +360,14 @@ private:
   DeadlineTimer wait_before_asking_for_missing_tx_{"bc:deadline"};
   /// true if a request for missing Txs has been issued for the current block
   bool have_asked_for_missing_txs_{};
+  Timepoint start_block_processing_{};  ///< The time at which the current block was started
+  Timepoint start_block_execution_{};   ///< The time at which the current block was scheduled
+  /// @}
+
+  /// @name Pipelining
+  /// @{
+  std::atomic<std::size_t> pipeline_depth_{0};  ///< The size of the look-ahead window (0 disabled)
+  Pipeline                 pipeline_{};         ///< The upcoming blocks after the current block
   /// @}
 
   /// @name Synergetic Contracts
@@ -366,7 +399,10 @@ private:
   telemetry::CounterPtr         unable_to_find_tx_count_;
   telemetry::CounterPtr         blocks_minted_;
   telemetry::CounterPtr         consensus_update_failure_total_;
+  telemetry::CounterPtr         pipeline_prefetch_count_;
+  telemetry::CounterPtr         pipeline_hit_count_;
   telemetry::HistogramPtr       tx_sync_times_;
+  telemetry::HistogramMapPtr    stage_times_;
   telemetry::GaugePtr<uint64_t> current_block_num_;
   telemetry::GaugePtr<uint64_t> next_block_num_;
   telemetry::GaugePtr<uint64_t> block_hash_;
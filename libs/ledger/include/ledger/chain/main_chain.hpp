@@ -17,7 +17,6 @@
 //
 //------------------------------------------------------------------------------
 
-#include "bloom_filter/progressive_bloom_filter.hpp"
 #include "chain/constants.hpp"
 #include "chain/transaction_layout.hpp"
 #include "core/byte_array/byte_array.hpp"
@@ -26,6 +25,7 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_index.hpp"
 #include "meta/type_util.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "storage/object_store.hpp"
@@ -37,6 +37,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -57,6 +58,15 @@ namespace ledger {
  *
  * Loose blocks are blocks where the previous hash/block isn't found.
  * Tips keep track of all non loose chains.
+ *
+ * Locking: Queries of the chain are performed under a shared lock, allowing them to proceed
+ * concurrently with each other, while operations which modify the chain take the lock exclusively.
+ * Internal functions assume that the lock is already held. The small amount of state which is
+ * updated as a side effect of a query (i.e. loading blocks from the store) is additionally guarded
+ * by a separate cache lock. The heaviest block is published as an immutable snapshot after each
+ * update and can be retrieved without taking either lock. Writers pass through a gate which is also
+ * briefly taken by readers when acquiring the shared lock, so that a steady stream of queries can
+ * not starve block insertion.
  */
 struct Tip
 {
@@ -133,8 +143,9 @@ public:
   using Travelogue           = TimeTravelogue;
   using DirtyMap = std::map<BlockHash, uint64_t>;  // Map of hash to the time until is becomes valid
 
-  static constexpr char const *LOGGING_NAME = "MainChain";
-  static constexpr uint64_t    UPPER_BOUND  = 5000ull;
+  static constexpr char const *LOGGING_NAME       = "MainChain";
+  static constexpr uint64_t    UPPER_BOUND        = 5000ull;
+  static constexpr uint64_t    DIGEST_UPPER_BOUND = 20000ull;
 
   enum class Mode
   {
@@ -171,14 +182,16 @@ public:
 
   /// @name Chain Queries
   /// @{
-  BlockPtr   GetHeaviestBlock() const;
-  BlockHash  GetHeaviestBlockHash() const;
-  Blocks     GetHeaviestChain(uint64_t limit = UPPER_BOUND) const;
-  Blocks     GetChainPreceding(BlockHash start, uint64_t limit = UPPER_BOUND) const;
-  Travelogue TimeTravel(BlockHash current_hash, std::size_t limit = UPPER_BOUND) const;
-  bool       GetPathToCommonAncestor(
-            Blocks &blocks, BlockHash tip_hash, BlockHash node_hash, uint64_t limit = UPPER_BOUND,
-            BehaviourWhenLimit behaviour = BehaviourWhenLimit::RETURN_MOST_RECENT) const;
+  BlockPtr    GetHeaviestBlock() const;
+  BlockHash   GetHeaviestBlockHash() const;
+  Blocks      GetHeaviestChain(uint64_t limit = UPPER_BOUND) const;
+  Blocks      GetChainPreceding(BlockHash start, uint64_t limit = UPPER_BOUND) const;
+  Travelogue  TimeTravel(BlockHash current_hash, std::size_t limit = UPPER_BOUND) const;
+  BlockHashes TimeTravelDigests(BlockHash   current_hash,
+                                std::size_t limit = DIGEST_UPPER_BOUND) const;
+  bool        GetPathToCommonAncestor(
+             Blocks &blocks, BlockHash tip_hash, BlockHash node_hash, uint64_t limit = UPPER_BOUND,
+             BehaviourWhenLimit behaviour = BehaviourWhenLimit::RETURN_MOST_RECENT) const;
   /// @}
 
   /// @name Tips
@@ -215,8 +228,9 @@ private:
   using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
   using BlockStore    = fetch::storage::ObjectStore<DbRecord>;
   using BlockStorePtr = std::unique_ptr<BlockStore>;
+  using SharedMutex   = std::shared_timed_mutex;
+  using ReadLock      = std::shared_lock<SharedMutex>;
   using RMutex        = std::recursive_mutex;
-  using RLock         = std::unique_lock<RMutex>;
 
   class HeaviestTip : Tip
   {
@@ -274,7 +288,7 @@ private:
                                   BlockHash *next_hash = nullptr) const;
   bool     IsBlockInCache(BlockHash const &hash) const;
   void     AddBlockToCache(BlockPtr const &block) const;
-  void     AddBlockToBloomFilter(Block const &block) const;
+  void     AddBlockToTransactionIndex(Block const &block) const;
   void CacheReference(BlockHash const &hash, BlockHash const &next_hash, bool unique = false) const;
   void ForgetReference(BlockHash const &hash, BlockHash const &next_hash = {}) const;
   bool LookupReference(BlockHash const &hash, BlockHash &next_hash) const;
@@ -294,8 +308,19 @@ private:
   bool     UpdateTips(BlockPtr const &block);
   bool     DetermineHeaviestTip();
   bool     UpdateHeaviestTip(BlockPtr const &block);
+  void     PublishHeaviestBlock(BlockPtr const &block);
   BlockPtr HeaviestChainBlockAbove(uint64_t limit) const;
   BlockPtr GetLabeledSubchainStart() const;
+  ReadLock LockForReading() const;
+  /// @}
+
+  /// @name Lockless implementations
+  /// @{
+  void      LocklessReset();
+  Blocks    LocklessGetChainPreceding(BlockHash start, uint64_t limit) const;
+  bool      LocklessReindexTips();
+  DigestSet LocklessDetectDuplicateTransactions(BlockHash const &           starting_hash,
+                                                TransactionLayoutSet const &transactions) const;
   /// @}
 
   BlockHash GetHeadHash();
@@ -303,7 +328,7 @@ private:
 
   bool RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalidated_blocks);
 
-  void FlushToDisk(bool flush_bloom = false);
+  void FlushToDisk(bool flush_index = false);
 
   Mode          mode_{Mode::IN_MEMORY_DB};
   bool const    dirty_block_functionality_;
@@ -311,8 +336,11 @@ private:
   BlockStorePtr block_store_;  ///< Long term storage and backup
   std::fstream  head_store_;
 
-  mutable RMutex   lock_;         ///< Mutex protecting block_chain_, tips_ & heaviest_
-  mutable BlockMap block_chain_;  ///< All recent blocks are kept in memory
+  mutable SharedMutex lock_;            ///< Lock protecting block_chain_, tips_ & heaviest_
+  mutable Mutex       writer_gate_;     ///< Gate ensuring pending writers are not starved
+  mutable RMutex      cache_lock_;      ///< Lock protecting state updated by queries
+  mutable BlockMap    block_chain_;     ///< All recent blocks are kept in memory
+  BlockPtr            heaviest_block_;  ///< Snapshot of the heaviest block (atomic access only)
 
   // The whole tree of previous-next relations among cached blocks
   mutable References forward_references_;
@@ -322,11 +350,11 @@ private:
   ///< The earliest block known of current heaveiest chain.
   mutable BlockPtr labeled_subchain_start_;
 
-  mutable ProgressiveBloomFilter   bloom_filter_;
-  telemetry::GaugePtr<std::size_t> bloom_filter_queried_bit_count_;
-  telemetry::CounterPtr            bloom_filter_query_count_;
-  telemetry::CounterPtr            bloom_filter_positive_count_;
-  telemetry::CounterPtr            bloom_filter_false_positive_count_;
+  mutable TransactionIndex         tx_index_;  ///< Recent transactions and their blocks
+  telemetry::GaugePtr<std::size_t> tx_index_size_;
+  telemetry::CounterPtr            tx_index_query_count_;
+  telemetry::CounterPtr            tx_index_match_count_;
+  telemetry::CounterPtr            tx_index_duplicate_count_;
   telemetry::CounterPtr            block_loads_from_disk_;
   telemetry::CounterPtr            dirty_blocks_attempt_add_;
 };
@@ -0,0 +1,172 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/serializers/group_definitions.hpp"
+#include "ledger/chain/block.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Reverse index from transaction digest to the block(s) in which the transaction has been
+ * included.
+ *
+ * Since a transaction can only be included in a block whose number is below its valid until
+ * field, entries are only retained for as long as the transaction could still be (re)included in
+ * a block. This bounds the size of the index to the transactions of the recent validity window,
+ * independently of the length of the chain.
+ *
+ * The same transaction can appear in blocks on different branches, therefore all the locations
+ * are recorded. It is the responsibility of the caller to determine which (if any) of these
+ * locations are ancestors of the block being evaluated.
+ */
+class TransactionIndex
+{
+public:
+  struct Location
+  {
+    Block::Hash block_hash{};
+    uint64_t    block_number{0};
+  };
+
+  using Locations = std::vector<Location>;
+
+  struct Entry
+  {
+    uint64_t  valid_until{0};
+    Locations locations{};
+  };
+
+  // Construction / Destruction
+  TransactionIndex()                         = default;
+  TransactionIndex(TransactionIndex const &) = delete;
+  TransactionIndex(TransactionIndex &&)      = delete;
+  ~TransactionIndex()                        = default;
+
+  void             Add(Block const &block);
+  Locations const *Lookup(Digest const &digest) const;
+  void             Prune(uint64_t block_number);
+  void             Reset();
+  std::size_t      size() const;
+
+  // Operators
+  TransactionIndex &operator=(TransactionIndex const &) = delete;
+  TransactionIndex &operator=(TransactionIndex &&) = delete;
+
+private:
+  using Index  = DigestMap<Entry>;
+  using Expiry = std::map<uint64_t, DigestSet>;
+
+  void RebuildExpiry();
+
+  Index  index_;   ///< Map of transaction digest to the locations of the transaction
+  Expiry expiry_;  ///< Map of valid until to the transactions which expire at that block number
+
+  template <typename, typename>
+  friend struct fetch::serializers::MapSerializer;
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndex::Location, D>
+{
+public:
+  using Type       = ledger::TransactionIndex::Location;
+  using DriverType = D;
+
+  static uint8_t const BLOCK_HASH   = 1;
+  static uint8_t const BLOCK_NUMBER = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &location)
+  {
+    auto map = map_constructor(2);
+    map.Append(BLOCK_HASH, location.block_hash);
+    map.Append(BLOCK_NUMBER, location.block_number);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &location)
+  {
+    map.ExpectKeyGetValue(BLOCK_HASH, location.block_hash);
+    map.ExpectKeyGetValue(BLOCK_NUMBER, location.block_number);
+  }
+};
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndex::Entry, D>
+{
+public:
+  using Type       = ledger::TransactionIndex::Entry;
+  using DriverType = D;
+
+  static uint8_t const VALID_UNTIL = 1;
+  static uint8_t const LOCATIONS   = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &entry)
+  {
+    auto map = map_constructor(2);
+    map.Append(VALID_UNTIL, entry.valid_until);
+    map.Append(LOCATIONS, entry.locations);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &entry)
+  {
+    map.ExpectKeyGetValue(VALID_UNTIL, entry.valid_until);
+    map.ExpectKeyGetValue(LOCATIONS, entry.locations);
+  }
+};
+
+template <typename D>
+struct MapSerializer<ledger::TransactionIndex, D>
+{
+public:
+  using Type       = ledger::TransactionIndex;
+  using DriverType = D;
+
+  static uint8_t const ENTRIES = 1;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &index)
+  {
+    auto map = map_constructor(1);
+    map.Append(ENTRIES, index.index_);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &index)
+  {
+    map.ExpectKeyGetValue(ENTRIES, index.index_);
+    index.RebuildExpiry();
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -0,0 +1,119 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "storage/object_store.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+namespace fetch {
+namespace vm {
+
+struct Executable;
+
+}  // namespace vm
+
+namespace ledger {
+
+/**
+ * Process wide cache of compiled smart contract executables, keyed by the digest of the contract
+ * source.
+ *
+ * Compiling a contract (tokenise, parse, analyse and generate) is expensive, while the resulting
+ * executable is immutable and independent of the contract instance. Entries are evicted in least
+ * recently used order, bounded by the approximate memory footprint of the cached executables.
+ *
+ * Optionally the executables can also be persisted to disk, so that a restarted node does not need
+ * to recompile every deployed contract on first use. A persisted executable is only reused when it
+ * was generated against a module with the same number of system types.
+ */
+class ExecutableCache
+{
+public:
+  using Executable    = vm::Executable;
+  using ExecutablePtr = std::shared_ptr<Executable>;
+
+  static constexpr uint64_t DEFAULT_MAX_BYTES = 64ull << 20u;
+
+  static ExecutableCache &Instance();
+
+  // Construction / Destruction
+  explicit ExecutableCache(uint64_t max_bytes = DEFAULT_MAX_BYTES);
+  ExecutableCache(ExecutableCache const &) = delete;
+  ExecutableCache(ExecutableCache &&)      = delete;
+  ~ExecutableCache();
+
+  /// @name Persistence
+  /// @{
+  void EnablePersistence(std::string const &doc_file, std::string const &index_file);
+  bool IsPersistent() const;
+  /// @}
+
+  ExecutablePtr Lookup(Digest const &digest, uint16_t num_system_types);
+  void          Add(Digest const &digest, ExecutablePtr const &executable);
+  void          Reset();
+
+  std::size_t size() const;
+  uint64_t    size_in_bytes() const;
+
+  static uint64_t EstimateSize(Executable const &executable);
+
+  // Operators
+  ExecutableCache &operator=(ExecutableCache const &) = delete;
+  ExecutableCache &operator=(ExecutableCache &&) = delete;
+
+private:
+  using LruList    = std::list<Digest>;
+  using Archive    = storage::ObjectStore<Executable>;
+  using ArchivePtr = std::unique_ptr<Archive>;
+
+  struct Entry
+  {
+    ExecutablePtr     executable;
+    uint64_t          size{0};
+    LruList::iterator position;
+  };
+
+  using Entries = DigestMap<Entry>;
+
+  void LocklessInsert(Digest const &digest, ExecutablePtr const &executable);
+
+  uint64_t const max_bytes_;
+
+  mutable Mutex lock_;
+  Entries       entries_;
+  LruList       lru_;  ///< Most recently used entries at the front
+  uint64_t      size_in_bytes_{0};
+  ArchivePtr    archive_;
+
+  // telemetry
+  telemetry::CounterPtr hits_total_;
+  telemetry::CounterPtr disk_hits_total_;
+  telemetry::CounterPtr misses_total_;
+  telemetry::CounterPtr evictions_total_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
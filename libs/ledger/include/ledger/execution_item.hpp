@@ -55,6 +55,7 @@ public:
   TokenAmount      fee() const;
   /// @}
 
+  void Reset(Digest digest, BlockIndex block, SliceIndex slice, BitVector const &shards);
   void Execute(ExecutorInterface &executor);
   void AggregateStakeUpdates(StakeUpdateEvents &events);
 
@@ -101,6 +102,26 @@ inline uint64_t ExecutionItem::fee() const
   return fee_;
 }
 
+/**
+ * Reinitialise the item for the execution of another transaction, allowing items to be reused
+ * between blocks
+ *
+ * @param digest The digest of the transaction
+ * @param block The index of the block being executed
+ * @param slice The index of the slice containing the transaction
+ * @param shards The shards used by the transaction
+ */
+inline void ExecutionItem::Reset(Digest digest, BlockIndex block, SliceIndex slice,
+                                 BitVector const &shards)
+{
+  digest_ = std::move(digest);
+  block_  = block;
+  slice_  = slice;
+  shards_ = shards;
+  result_ = Result{};
+  fee_    = 0;
+}
+
 inline void ExecutionItem::Execute(ExecutorInterface &executor)
 {
   try
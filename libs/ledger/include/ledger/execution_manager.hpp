@@ -26,6 +26,7 @@
 #include "ledger/execution_item.hpp"
 #include "ledger/execution_manager_interface.hpp"
 #include "ledger/executor.hpp"
+#include "ledger/storage_unit/state_prefetch_cache.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "network/details/thread_pool.hpp"
 #include "storage/object_store.hpp"
@@ -47,18 +48,33 @@ namespace ledger {
 /**
  * The Execution Manager is the object which orchestrates the execution of a
  * specified block across a series of executors and lanes.
+ *
+ * By default the block is executed slice by slice, waiting for all the transactions of a slice to
+ * complete before the next one is started. Alternatively the manager can build a dependency graph
+ * from the lane masks of the transactions, dispatching each transaction as soon as all of the
+ * preceding transactions which share a lane with it have completed. Since each lane observes the
+ * same sequence of transactions, the resulting state is identical to that of slice by slice
+ * execution.
  */
 class ExecutionManager : public ExecutionManagerInterface,
                          public std::enable_shared_from_this<ExecutionManager>
 {
 public:
-  using StorageUnitPtr  = std::shared_ptr<StorageUnitInterface>;
-  using ExecutorPtr     = std::shared_ptr<ExecutorInterface>;
-  using ExecutorFactory = std::function<ExecutorPtr()>;
+  using StorageUnitPtr   = std::shared_ptr<StorageUnitInterface>;
+  using PrefetchCachePtr = std::shared_ptr<StatePrefetchCache>;
+  using ExecutorPtr      = std::shared_ptr<ExecutorInterface>;
+  using ExecutorFactory  = std::function<ExecutorPtr()>;
+
+  enum class SchedulingMode
+  {
+    SLICE_BY_SLICE,   ///< Wait for each slice to complete before starting the next
+    DEPENDENCY_GRAPH  ///< Start each transaction once its conflicting predecessors complete
+  };
 
   // Construction / Destruction
   ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes, StorageUnitPtr storage,
-                   ExecutorFactory const &factory, TransactionStatusCache::ShrdPtr tx_status_cache);
+                   ExecutorFactory const &factory, TransactionStatusCache::ShrdPtr tx_status_cache,
+                   PrefetchCachePtr prefetch_cache = {});
 
   /// @name Execution Manager Interface
   /// @{
@@ -73,6 +89,10 @@ public:
   void Start();
   void Stop();
 
+  // configuration (applied from the next block to be executed)
+  void           SetSchedulingMode(SchedulingMode mode);
+  SchedulingMode scheduling_mode() const;
+
   // statistics
   std::size_t completed_executions() const
   {
@@ -103,6 +123,23 @@ private:
   using CounterPtr        = telemetry::CounterPtr;
   using HistogramPtr      = telemetry::HistogramPtr;
   using BlockIndex        = uint64_t;
+  using AtomicMode        = std::atomic<SchedulingMode>;
+  using NodeIndex         = std::size_t;
+  using NodeIndexList     = std::vector<NodeIndex>;
+
+  /**
+   * A node in the dependency graph of the block. Each node refers to an item of the execution plan
+   * and counts the number of its predecessors which are yet to complete.
+   */
+  struct DependencyNode
+  {
+    ExecutionItem *item{nullptr};
+    std::size_t    slice{0};
+    NodeIndexList  successors{};
+    Counter        pending{0};
+  };
+
+  using DependencyGraph = std::vector<DependencyNode>;
 
   struct Summary
   {
@@ -121,8 +158,16 @@ private:
 
   StorageUnitPtr storage_;
 
-  Mutex         execution_plan_lock_;  ///< guards `execution_plan_`
-  ExecutionPlan execution_plan_;
+  AtomicMode scheduling_mode_{SchedulingMode::SLICE_BY_SLICE};
+
+  Mutex             execution_plan_lock_;  ///< guards `execution_plan_` & `planned_mode_`
+  ExecutionPlan     execution_plan_;
+  ExecutionItemList item_pool_;  ///< Items from previous plans available for reuse
+  SchedulingMode    planned_mode_{SchedulingMode::SLICE_BY_SLICE};  ///< Mode of the current plan
+  DependencyGraph   dependency_graph_;    ///< Only populated in dependency graph mode
+  std::size_t       num_graph_nodes_{0};  ///< The number of nodes in use for the current plan
+  NodeIndexList     graph_roots_;         ///< The nodes without any predecessors
+  Counter           abort_slice_{0};      ///< Nodes beyond this slice are no longer dispatched
 
   Mutex     monitor_lock_;
   Condition monitor_wake_;
@@ -139,6 +184,9 @@ private:
   ThreadPool thread_pool_;
   ThreadPtr  monitor_thread_;
 
+  PrefetchCachePtr prefetch_cache_;  ///< Optional shared cache used by the executors
+  ThreadPool       prefetch_pool_;   ///< The thread used to prefetch upcoming slices
+
   TransactionStatusCache::ShrdPtr tx_status_cache_;  ///< Ref to the tx status cache
   // Telemetry
   CounterPtr   tx_executed_count_;
@@ -150,7 +198,10 @@ private:
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block const &block);
+  void BuildDependencyGraph();
+  void SchedulePrefetch(std::size_t slice_index);
   void DispatchExecution(ExecutionItem &item);
+  void DispatchNode(NodeIndex index);
 };
 
 }  // namespace ledger
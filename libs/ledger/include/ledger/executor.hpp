@@ -85,8 +85,8 @@ private:
   SliceIndex              slice_{};
   BitVector               allowed_shards_{};
   LaneIndex               log2_num_lanes_{0};
-  TransactionPtr          current_tx_{};
-  CachedStorageAdapterPtr storage_cache_;
+  TransactionPtr          current_tx_;     ///< Reused for each of the executed transactions
+  CachedStorageAdapterPtr storage_cache_;  ///< Reused and cleared for each transaction
   TransactionValidator    tx_validator_;
   /// @}
 
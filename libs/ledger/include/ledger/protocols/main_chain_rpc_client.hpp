@@ -40,6 +40,8 @@ public:
   BlocksPromise     GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
                                       uint64_t limit) override;
   TraveloguePromise TimeTravel(MuddleAddress peer, Digest start) override;
+  DigestsPromise    TimeTravelDigests(MuddleAddress peer, Digest start, uint64_t limit) override;
+  TraveloguePromise TimeTravelRange(MuddleAddress peer, Digest start, uint64_t limit) override;
   /// @}
 
   // Operators
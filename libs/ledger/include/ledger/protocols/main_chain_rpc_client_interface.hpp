@@ -21,6 +21,9 @@
 #include "muddle/address.hpp"
 #include "network/generics/promise_of.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
@@ -31,6 +34,7 @@ public:
   using MuddleAddress     = muddle::Address;
   using BlocksPromise     = network::PromiseOf<Blocks>;
   using TraveloguePromise = network::PromiseOf<Travelogue>;
+  using DigestsPromise    = network::PromiseOf<std::vector<Digest>>;
 
   MainChainRpcClientInterface()          = default;
   virtual ~MainChainRpcClientInterface() = default;
@@ -41,6 +45,10 @@ public:
   virtual BlocksPromise     GetCommonSubChain(MuddleAddress peer, Digest start, Digest last_seen,
                                               uint64_t limit)                       = 0;
   virtual TraveloguePromise TimeTravel(MuddleAddress peer, Digest start)            = 0;
+  virtual DigestsPromise    TimeTravelDigests(MuddleAddress peer, Digest start,
+                                              uint64_t limit)                       = 0;
+  virtual TraveloguePromise TimeTravelRange(MuddleAddress peer, Digest start,
+                                            uint64_t limit)                         = 0;
   /// @}
 };
 
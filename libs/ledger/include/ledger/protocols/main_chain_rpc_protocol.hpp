@@ -30,13 +30,16 @@ class MainChainProtocol : public service::Protocol
 {
 public:
   using Travelogue                          = TimeTravelogue;
+  using BlockHashes                         = MainChain::BlockHashes;
   static constexpr char const *LOGGING_NAME = "MainChainProtocol";
 
   enum
   {
-    HEAVIEST_CHAIN   = 1,
-    TIME_TRAVEL      = 2,
-    COMMON_SUB_CHAIN = 3
+    HEAVIEST_CHAIN      = 1,
+    TIME_TRAVEL         = 2,
+    COMMON_SUB_CHAIN    = 3,
+    TIME_TRAVEL_DIGESTS = 4,
+    TIME_TRAVEL_RANGE   = 5
   };
 
   explicit MainChainProtocol(MainChain &chain)
@@ -45,6 +48,8 @@ public:
     Expose(HEAVIEST_CHAIN, this, &MainChainProtocol::GetHeaviestChain);
     Expose(COMMON_SUB_CHAIN, this, &MainChainProtocol::GetCommonSubChain);
     Expose(TIME_TRAVEL, this, &MainChainProtocol::TimeTravel);
+    Expose(TIME_TRAVEL_DIGESTS, this, &MainChainProtocol::TimeTravelDigests);
+    Expose(TIME_TRAVEL_RANGE, this, &MainChainProtocol::TimeTravelRange);
   }
 
   Blocks GetHeaviestChain(uint64_t maxsize)
@@ -70,6 +75,16 @@ public:
     return chain_.TimeTravel(std::move(start));
   }
 
+  BlockHashes TimeTravelDigests(Digest start, uint64_t limit)
+  {
+    return chain_.TimeTravelDigests(std::move(start), limit);
+  }
+
+  Travelogue TimeTravelRange(Digest start, uint64_t limit)
+  {
+    return chain_.TimeTravel(std::move(start), limit);
+  }
+
 private:
   MainChain &chain_;
 };
@@ -34,8 +34,13 @@
 #include "network/p2pservice/p2ptrust_interface.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <deque>
 #include <limits>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -89,6 +94,22 @@ class MainChainSyncWorker;
  *                            │                    │
  *                            │                    │
  *                            └────────────────────┘
+ *
+ * In the multi-peer sync mode the service first requests the digests of the blocks that follow
+ * its heaviest block from a single peer (the "headers"). The corresponding blocks are then
+ * requested as fixed size ranges from all of the directly connected peers in parallel. Completed
+ * ranges are checked against the digests, buffered and added to the chain strictly in order. If
+ * the headers can not be retrieved (forks, failures or a single peer) the service falls back to
+ * the single peer sync loop above.
+ *
+ *   Synchronising ──▶ Request Headers ──▶ Wait for Headers ──▶ Request Block Ranges ◀──┐
+ *                            ▲                    │                       │            │
+ *                            │                    ▼                       ▼            │
+ *                            │          Start Sync with Peer   Wait for Block Ranges ──┘
+ *                            │                                            │
+ *                            └────────────────────────────────────────────┤
+ *                                                                         ▼
+ *                                                              Complete Sync with Peer
  */
 class MainChainRpcService : public muddle::rpc::Server,
                             public std::enable_shared_from_this<MainChainRpcService>
@@ -101,7 +122,17 @@ public:
     START_SYNC_WITH_PEER,
     REQUEST_NEXT_BLOCKS,
     WAIT_FOR_NEXT_BLOCKS,
-    COMPLETE_SYNC_WITH_PEER
+    COMPLETE_SYNC_WITH_PEER,
+    REQUEST_HEADERS,
+    WAIT_FOR_HEADERS,
+    REQUEST_BLOCK_RANGES,
+    WAIT_FOR_BLOCK_RANGES
+  };
+
+  enum class SyncMode
+  {
+    SINGLE_PEER,  ///< Sequentially sync the chain from a single peer
+    MULTI_PEER,   ///< Sync ranges of the chain from several peers in parallel
   };
 
   using MuddleEndpoint  = muddle::MuddleEndpoint;
@@ -111,6 +142,7 @@ public:
   using Address         = muddle::Packet::Address;
   using Block           = ledger::Block;
   using BlockHash       = Digest;
+  using BlockHashes     = MainChain::BlockHashes;
   using Promise         = service::Promise;
   using RpcClient       = MainChainRpcClientInterface;
   using TrustSystem     = p2p::P2PTrustInterface<Address>;
@@ -119,6 +151,11 @@ public:
 
   static constexpr char const *LOGGING_NAME            = "MainChainRpc";
   static constexpr uint64_t    PERIODIC_RESYNC_SECONDS = 20;
+  static constexpr std::size_t BLOCK_RANGE_SIZE        = 250;
+  static constexpr std::size_t MAX_RANGES_PER_PEER     = 2;
+  static constexpr std::size_t MAX_SYNC_PEERS          = 8;
+  static constexpr std::size_t MAX_BUFFERED_BLOCKS     = 32 * BLOCK_RANGE_SIZE;
+  static constexpr std::size_t MAX_PEER_FAILURES       = 3;
 
   enum class Mode
   {
@@ -158,6 +195,12 @@ public:
 
   bool IsHealthy() const;
 
+  /// @name Sync Mode
+  /// @{
+  void     SetSyncMode(SyncMode mode);
+  SyncMode sync_mode() const;
+  /// @}
+
   /// @name Subscription Handlers
   /// @{
   void OnNewBlock(Address const &from, Block &block, Address const &transmitter);
@@ -171,6 +214,24 @@ private:
   using StateMachine    = core::StateMachine<State>;
   using StateMachinePtr = std::shared_ptr<StateMachine>;
   using DeadlineTimer   = fetch::moment::DeadlineTimer;
+  using AtomicSyncMode  = std::atomic<SyncMode>;
+  using Addresses       = std::vector<Address>;
+  using PeerFailures    = std::map<Address, std::size_t>;
+
+  /**
+   * A contiguous range of the blocks identified by the sync digests
+   */
+  struct BlockRange
+  {
+    std::size_t offset{0};  ///< The index of the first block in the sync digests
+    std::size_t length{0};  ///< The number of blocks in the range
+    Address     peer{};     ///< The peer the range has been requested from
+    Promise     request{};  ///< The pending request for the range
+    Blocks      blocks{};   ///< The verified blocks of the completed range
+  };
+
+  using BlockRangeList = std::deque<BlockRange>;
+  using BlockRangeMap  = std::map<std::size_t, BlockRange>;
 
   /// @name Utilities
   /// @{
@@ -179,6 +240,11 @@ private:
   void HandleChainResponse(Address const &address, Blocks blocks);
   template <class Begin, class End>
   void HandleChainResponse(Address const &address, Begin begin, End end);
+
+  BlockPtr GetSyncStartBlock() const;
+  bool     HandleRangeResponse(BlockRange &range);
+  void     ApplyCompletedRanges();
+  void     ResetBlockRanges();
   /// @}
 
   /// @name State Machine Handlers
@@ -189,6 +255,10 @@ private:
   State OnRequestNextSetOfBlocks();
   State OnWaitForBlocks();
   State OnCompleteSyncWithPeer();
+  State OnRequestHeaders();
+  State OnWaitForHeaders();
+  State OnRequestBlockRanges();
+  State OnWaitForBlockRanges();
 
   bool  ValidBlock(Block const &block) const;
   State WalkBack();
@@ -230,6 +300,19 @@ private:
   std::size_t back_stride_{1};
   /// @}
 
+  /// @name Multi-Peer Sync Data
+  /// @{
+  AtomicSyncMode sync_mode_{SyncMode::SINGLE_PEER};
+  BlockHash      sync_base_hash_;        ///< The parent of the first block in the sync digests
+  BlockHashes    sync_digests_;          ///< The expected digests of the blocks being synced
+  Addresses      sync_peers_;            ///< The peers the block ranges are requested from
+  PeerFailures   sync_peer_failures_;    ///< The number of failed requests per peer
+  BlockRangeMap  pending_ranges_;        ///< Ranges waiting to be requested
+  BlockRangeList requested_ranges_;      ///< Ranges requested from the peers
+  BlockRangeMap  completed_ranges_;      ///< Ranges waiting for their predecessors
+  std::size_t    next_range_offset_{0};  ///< The offset of the next range to be added
+  /// @}
+
   /// @name Telemetry
   /// @{
   telemetry::CounterPtr         recv_block_count_;
@@ -244,6 +327,12 @@ private:
   telemetry::CounterPtr         state_request_next_blocks_;
   telemetry::CounterPtr         state_wait_for_next_blocks_;
   telemetry::CounterPtr         state_complete_sync_with_peer_;
+  telemetry::CounterPtr         state_request_headers_;
+  telemetry::CounterPtr         state_wait_for_headers_;
+  telemetry::CounterPtr         state_request_block_ranges_;
+  telemetry::CounterPtr         state_wait_for_block_ranges_;
+  telemetry::CounterPtr         sync_range_failures_;
+  telemetry::CounterPtr         sync_range_blocks_;
   telemetry::GaugePtr<uint32_t> state_current_;
   telemetry::HistogramPtr       new_block_duration_;
   /// @}
@@ -265,6 +354,14 @@ constexpr char const *ToString(MainChainRpcService::State state) noexcept
     return "Waiting for Blocks";
   case MainChainRpcService::State::COMPLETE_SYNC_WITH_PEER:
     return "Completed Sync with Peer";
+  case MainChainRpcService::State::REQUEST_HEADERS:
+    return "Requesting Headers";
+  case MainChainRpcService::State::WAIT_FOR_HEADERS:
+    return "Waiting for Headers";
+  case MainChainRpcService::State::REQUEST_BLOCK_RANGES:
+    return "Requesting Block Ranges";
+  case MainChainRpcService::State::WAIT_FOR_BLOCK_RANGES:
+    return "Waiting for Block Ranges";
   }
 
   return "unknown";
@@ -45,6 +45,10 @@ public:
   Status Read(std::string const &key, void *data, uint64_t &size) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
+  void   ReadMany(Keys const &keys, Values &values) override;
+  Status WriteMany(KeyValuePairs const &values) override;
+  Status CheckWrite(std::string const &key, uint64_t size) override;
+  Status CommitMany(KeyValuePairs const &values) override;
   /// @}
 
   /// @name Counter Access
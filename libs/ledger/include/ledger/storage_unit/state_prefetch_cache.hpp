@@ -0,0 +1,131 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/digest.hpp"
+#include "core/mutex.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * A shared read-through cache which sits in front of the storage unit during the execution of a
+ * block.
+ *
+ * The execution manager uses this to speculatively pull in the transactions and the state records
+ * declared by the transactions of upcoming slices while the current slice is being executed. The
+ * executors then read through the cache and only fall back to the lanes on a miss. All writes are
+ * passed through to the underlying storage unit and update the cache, so that it stays coherent
+ * for the duration of the block.
+ *
+ * The contents of the cache are only valid for the block being executed and must be cleared
+ * before the next block is planned.
+ */
+class StatePrefetchCache final : public StorageUnitInterface
+{
+public:
+  using StorageUnitPtr = std::shared_ptr<StorageUnitInterface>;
+  using Digests        = std::vector<Digest>;
+
+  // Construction / Destruction
+  explicit StatePrefetchCache(StorageUnitPtr storage);
+  StatePrefetchCache(StatePrefetchCache const &) = delete;
+  StatePrefetchCache(StatePrefetchCache &&)      = delete;
+  ~StatePrefetchCache() override                 = default;
+
+  /// @name Prefetch Control
+  /// @{
+  void Prefetch(Digests const &digests);
+  void Clear();
+  /// @}
+
+  /// @name State Interface
+  /// @{
+  Document  Get(ResourceAddress const &key) const override;
+  Document  GetOrCreate(ResourceAddress const &key) override;
+  void      Set(ResourceAddress const &key, StateValue const &value) override;
+  Documents GetMany(Addresses const &keys) const override;
+  void      SetMany(KeyValuePairs const &values) override;
+  bool      Lock(ShardIndex shard) override;
+  bool      Unlock(ShardIndex shard) override;
+  void      Reset() override;
+  /// @}
+
+  /// @name Transaction Interface
+  /// @{
+  void      AddTransaction(chain::Transaction const &tx) override;
+  bool      GetTransaction(Digest const &digest, chain::Transaction &tx) override;
+  bool      HasTransaction(Digest const &digest) override;
+  void      IssueCallForMissingTxs(DigestSet const &tx_set) override;
+  TxLayouts PollRecentTx(uint32_t max_to_poll) override;
+  /// @}
+
+  /// @name Revertible Document Store Interface
+  /// @{
+  Hash CurrentHash() override;
+  Hash LastCommitHash() override;
+  bool RevertToHash(Hash const &hash, uint64_t index) override;
+  Hash Commit(uint64_t index) override;
+  bool HashExists(Hash const &hash, uint64_t index) override;
+  /// @}
+
+  // Operators
+  StatePrefetchCache &operator=(StatePrefetchCache const &) = delete;
+  StatePrefetchCache &operator=(StatePrefetchCache &&) = delete;
+
+private:
+  using DocumentCache    = std::unordered_map<ResourceAddress, Document>;
+  using TransactionCache = DigestMap<chain::Transaction>;
+  using Generation       = uint64_t;
+
+  Generation CurrentGeneration() const;
+  bool       LookupDocument(ResourceAddress const &key, Document &doc) const;
+  void       InsertDocument(ResourceAddress const &key, Document const &doc,
+                            Generation generation) const;
+  void       UpdateDocument(ResourceAddress const &key, StateValue const &value);
+
+  StorageUnitPtr storage_;  ///< The underlying storage unit
+
+  /// @name Cache Data
+  /// @{
+  mutable Mutex         lock_;            ///< Guards all the cache data
+  mutable DocumentCache documents_{};     ///< The cached state documents
+  TransactionCache      transactions_{};  ///< The cached transactions
+  Generation            generation_{0};   ///< Incremented every time the cache is cleared
+  /// @}
+
+  /// @name Telemetry
+  /// @{
+  telemetry::CounterPtr   state_hit_count_;
+  telemetry::CounterPtr   state_miss_count_;
+  telemetry::CounterPtr   tx_hit_count_;
+  telemetry::CounterPtr   tx_miss_count_;
+  telemetry::HistogramPtr prefetch_duration_;
+  /// @}
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -32,9 +32,11 @@
 #include "network/generics/has_worker_thread.hpp"
 #include "storage/document_store_protocol.hpp"
 #include "storage/object_stack.hpp"
+#include "telemetry/telemetry.hpp"
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <exception>
@@ -74,6 +76,9 @@ public:
   Document Get(ResourceAddress const &key) const override;
   void     Set(ResourceAddress const &key, StateValue const &value) override;
 
+  Documents GetMany(Addresses const &keys) const override;
+  void      SetMany(KeyValuePairs const &values) override;
+
   void Reset() override;
 
   // state hash functions
@@ -96,12 +101,20 @@ private:
   using AddressList          = std::vector<muddle::Address>;
   using MerkleTree           = crypto::MerkleTree;
   using PermanentMerkleStack = fetch::storage::ObjectStack<crypto::MerkleTree>;
+  using Promises             = std::vector<service::Promise>;
+  using Histograms           = std::vector<telemetry::HistogramPtr>;
+  using Duration             = std::chrono::milliseconds;
 
   Address const &LookupAddress(ShardIndex shard) const;
   Address const &LookupAddress(storage::ResourceID const &resource) const;
 
   bool HashInStack(Hash const &hash, uint64_t index);
 
+  bool WaitForLanes(Promises const &promises, Histograms const &latencies,
+                    Duration const &timeout, char const *operation) const;
+
+  Histograms CreateLaneHistograms(char const *name, char const *description) const;
+
   /// @name Client Information
   /// @{
   AddressList const addresses_;
@@ -115,6 +128,13 @@ private:
   MerkleTree           current_merkle_;
   PermanentMerkleStack permanent_state_merkle_stack_{};
   /// @}
+
+  /// @name Telemetry
+  /// @{
+  Histograms            commit_latency_;
+  Histograms            revert_latency_;
+  telemetry::CounterPtr lane_failures_total_;
+  /// @}
 };
 
 }  // namespace ledger
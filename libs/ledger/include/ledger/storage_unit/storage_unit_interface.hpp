@@ -23,6 +23,7 @@
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -43,6 +44,9 @@ public:
   using StateValue      = byte_array::ConstByteArray;
   using ShardIndex      = uint32_t;
   using Keys            = std::vector<storage::ResourceID>;
+  using Addresses       = std::vector<ResourceAddress>;
+  using Documents       = std::vector<Document>;
+  using KeyValuePairs   = std::vector<std::pair<ResourceAddress, StateValue>>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -57,6 +61,12 @@ public:
   virtual bool     Unlock(ShardIndex shard)                                 = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual Documents GetMany(Addresses const &keys) const;
+  virtual void      SetMany(KeyValuePairs const &values);
+  /// @}
 };
 
 class StorageUnitInterface : public StorageInterface
@@ -90,5 +100,39 @@ public:
   /// @}
 };
 
+/**
+ * Lookup a set of resources from the storage engine. Implementations that are able to service
+ * these requests in bulk should override this method.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the requested keys
+ */
+inline StorageInterface::Documents StorageInterface::GetMany(Addresses const &keys) const
+{
+  Documents documents{};
+  documents.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    documents.emplace_back(Get(key));
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values in the storage engine. Implementations that are able to service these
+ * requests in bulk should override this method.
+ *
+ * @param values The key value pairs to be set
+ */
+inline void StorageInterface::SetMany(KeyValuePairs const &values)
+{
+  for (auto const &value : values)
+  {
+    Set(value.first, value.second);
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
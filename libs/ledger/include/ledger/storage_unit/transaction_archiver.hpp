@@ -22,6 +22,14 @@
 #include "core/state_machine.hpp"
 #include "telemetry/telemetry.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
@@ -44,6 +52,13 @@ class TransactionStoreInterface;
  *                              └──────▶│  Archiver   │───────┘
  *                                      └─────────────┘
  *
+ * Confirmed transactions are archived in groups. The size of each group adapts to the number of
+ * confirmations waiting in the queue, and the archive is flushed once per group. Transactions are
+ * only removed from the pool after the flush, so that a transaction is always present in at least
+ * one of the two.
+ *
+ * The archiver can either be driven by its state machine (attached to a reactor) or run on its own
+ * dedicated I/O thread. Only one of the two mechanisms should be used for a given instance.
  */
 class TransactionArchiver
 {
@@ -59,39 +74,70 @@ public:
 
   TransactionArchiver(uint32_t lane, TransactionPoolInterface &pool,
                       TransactionStoreInterface &archive);
-  ~TransactionArchiver() = default;
+  TransactionArchiver(TransactionArchiver const &) = delete;
+  TransactionArchiver(TransactionArchiver &&)      = delete;
+  ~TransactionArchiver();
 
   void Confirm(Digest const &digest);
 
   StateMachinePtr const &GetStateMachine() const;
 
+  /// @name Dedicated I/O Thread
+  /// @{
+  void StartThread();
+  void StopThread();
+  /// @}
+
+  // Operators
+  TransactionArchiver &operator=(TransactionArchiver const &) = delete;
+  TransactionArchiver &operator=(TransactionArchiver &&) = delete;
+
 private:
-  static const std::size_t BATCH_SIZE = 100;
+  static const std::size_t MIN_BATCH_SIZE = 100;
+  static const std::size_t MAX_BATCH_SIZE = 1u << 12u;
 
   using ConfirmationQueue = core::MPMCQueue<Digest, 1u << 15u>;
   using Digests           = std::vector<Digest>;
+  using Counter           = std::atomic<std::size_t>;
+  using Flag              = std::atomic<bool>;
+  using ThreadPtr         = std::unique_ptr<std::thread>;
+  using Duration          = std::chrono::milliseconds;
 
   State OnCollecting();
   State OnFlushing();
 
+  bool CollectBatch(Duration const &max_wait);
+  void FlushBatch();
+  void ThreadEntrypoint();
+
   // telemetry helpers
-  telemetry::CounterPtr CreateCounter(char const *name, char const *description) const;
+  telemetry::CounterPtr   CreateCounter(char const *name, char const *description) const;
+  telemetry::HistogramPtr CreateHistogram(std::initializer_list<double> const &buckets,
+                                          char const *name, char const *description) const;
 
   uint32_t const             lane_;
   TransactionPoolInterface & pool_;
   TransactionStoreInterface &archive_;
   ConfirmationQueue          confirmation_queue_;
+  Counter                    queue_depth_{0};  ///< Approximate number of queued confirmations
 
   // State Machine state
   StateMachinePtr state_machine_;
-  Digests         digests_;
+  Digests         digests_;   ///< The current batch of confirmed transactions
+  Digests         archived_;  ///< The transactions of the batch added to the archive
+
+  // Dedicated thread
+  Flag      running_{false};
+  ThreadPtr thread_;
 
   // telemetry
-  telemetry::CounterPtr confirmed_total_;
-  telemetry::CounterPtr duplicate_total_;
-  telemetry::CounterPtr additions_total_;
-  telemetry::CounterPtr lost_total_;
-  telemetry::CounterPtr processed_total_;
+  telemetry::CounterPtr   confirmed_total_;
+  telemetry::CounterPtr   duplicate_total_;
+  telemetry::CounterPtr   additions_total_;
+  telemetry::CounterPtr   lost_total_;
+  telemetry::CounterPtr   processed_total_;
+  telemetry::HistogramPtr batch_size_;
+  telemetry::HistogramPtr batch_duration_;
 };
 
 char const *ToString(TransactionArchiver::State state);
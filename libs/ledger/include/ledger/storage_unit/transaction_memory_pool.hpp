@@ -21,15 +21,43 @@
 #include "core/digest.hpp"
 #include "core/mutex.hpp"
 #include "ledger/storage_unit/transaction_pool_interface.hpp"
+#include "telemetry/telemetry.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <tuple>
 #include <unordered_map>
 
 namespace fetch {
 namespace ledger {
 
+/**
+ * In memory pool of transactions (for a single lane) which have not yet been archived.
+ *
+ * The pool is split into a number of stripes selected by the last byte of the transaction digest
+ * (the leading bytes select the lane), each guarded by its own lock, so that concurrent
+ * submissions, lookups and removals only contend when they target the same stripe.
+ *
+ * The approximate memory footprint of the pool is bounded by a byte budget which is divided
+ * evenly between the stripes. When a stripe exceeds its share of the budget, transactions are
+ * evicted in order of lowest charge rate first and then earliest expiry (valid until). A newly
+ * added transaction which is the least valuable one in its stripe is therefore rejected
+ * immediately.
+ */
 class TransactionMemoryPool : public TransactionPoolInterface
 {
 public:
+  static constexpr uint64_t DEFAULT_MAX_BYTES = 256ull << 20u;
+
+  // Construction / Destruction
+  explicit TransactionMemoryPool(uint32_t lane = 0, uint64_t max_bytes = DEFAULT_MAX_BYTES);
+  TransactionMemoryPool(TransactionMemoryPool const &) = delete;
+  TransactionMemoryPool(TransactionMemoryPool &&)      = delete;
+  ~TransactionMemoryPool() override                    = default;
+
   /// @name Transaction Storage Interface
   /// @{
   void     Add(chain::Transaction const &tx) override;
@@ -39,11 +67,60 @@ public:
   void     Remove(Digest const &tx_digest) override;
   /// @}
 
+  uint64_t GetSizeInBytes() const;
+  uint64_t GetEvictedCount() const;
+
+  static uint64_t EstimateSize(chain::Transaction const &tx);
+
+  // Operators
+  TransactionMemoryPool &operator=(TransactionMemoryPool const &) = delete;
+  TransactionMemoryPool &operator=(TransactionMemoryPool &&) = delete;
+
 private:
-  using TxStore = DigestMap<chain::Transaction>;
+  static const std::size_t LOG2_NUM_STRIPES = 4;
+  static const std::size_t NUM_STRIPES      = 1u << LOG2_NUM_STRIPES;
+
+  using EvictionKey = std::tuple<uint64_t, uint64_t, Digest>;  ///< charge rate, valid until, digest
+
+  struct Entry
+  {
+    chain::Transaction tx;
+    uint64_t           size{0};
+  };
+
+  using TxStore       = DigestMap<Entry>;
+  using EvictionOrder = std::set<EvictionKey>;
+
+  struct Stripe
+  {
+    mutable Mutex lock;
+    TxStore       transactions;
+    EvictionOrder eviction_order;
+    uint64_t      size_in_bytes{0};
+  };
+
+  using Stripes = std::array<Stripe, NUM_STRIPES>;
+  using Counter = std::atomic<uint64_t>;
+
+  static std::size_t StripeIndex(Digest const &tx_digest);
+  static EvictionKey MakeEvictionKey(chain::Transaction const &tx);
+
+  Stripe &      LookupStripe(Digest const &tx_digest);
+  Stripe const &LookupStripe(Digest const &tx_digest) const;
+  void          RemoveEntry(Stripe &stripe, TxStore::iterator const &it);
+  void          UpdateTelemetry();
+
+  uint64_t const stripe_max_bytes_;
+  Stripes        stripes_;
+  Counter        count_{0};
+  Counter        size_in_bytes_{0};
+  Counter        evicted_{0};
+  Counter        updates_{0};
 
-  mutable Mutex lock_;
-  TxStore       transaction_store_;
+  // telemetry
+  telemetry::GaugePtr<uint64_t> count_gauge_;
+  telemetry::GaugePtr<uint64_t> size_gauge_;
+  telemetry::CounterPtr         evicted_total_;
 };
 
 }  // namespace ledger
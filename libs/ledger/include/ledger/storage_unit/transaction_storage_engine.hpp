@@ -72,7 +72,7 @@ private:
   static const std::size_t MAX_NUM_RECENT_TX = 1u << 15u;
 
   uint32_t const             lane_;
-  TransactionMemoryPool      mem_pool_;
+  TransactionMemoryPool      mem_pool_{lane_};
   TransactionStore           archive_;
   TransactionStoreAggregator store_{mem_pool_, archive_};
   TransactionArchiver        archiver_{lane_, mem_pool_, archive_};
@@ -48,6 +48,7 @@ public:
   bool     Has(Digest const &tx_digest) const override;
   bool     Get(Digest const &tx_digest, chain::Transaction &tx) const override;
   uint64_t GetCount() const override;
+  void     Flush() override;
   /// @}
 
   /// @mame Low Level Subtree Access
@@ -68,6 +68,13 @@ public:
    * @return The number of transactions stored
    */
   virtual uint64_t GetCount() const = 0;
+
+  /**
+   * Flush any pending writes to persistent storage. Stores which are not persistent have nothing to
+   * flush
+   */
+  virtual void Flush()
+  {}
   /// @}
 };
 
@@ -22,7 +22,9 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace chain {
@@ -30,6 +32,11 @@ namespace chain {
 class Transaction;
 
 }  // namespace chain
+namespace crypto {
+
+class VerificationEngine;
+
+}  // namespace crypto
 namespace ledger {
 
 class TransactionSink;
@@ -41,7 +48,10 @@ public:
 
   // Construction / Destruction
   TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                      std::string const &name);
+                      std::string const &name, std::size_t batch_size = 1);
+  TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
+                      std::string const &name, std::size_t batch_size,
+                      crypto::VerificationEngine &engine);
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
   ~TransactionVerifier();
@@ -66,6 +76,7 @@ private:
   static constexpr std::size_t QUEUE_SIZE = 1u << 16u;  // 65K
 
   using Flag            = std::atomic<bool>;
+  using Transactions    = std::vector<TransactionPtr>;
   using VerifiedQueue   = core::MPSCQueue<TransactionPtr, QUEUE_SIZE>;
   using UnverifiedQueue = core::MPMCQueue<TransactionPtr, QUEUE_SIZE>;
   using ThreadPtr       = std::unique_ptr<std::thread>;
@@ -77,13 +88,15 @@ private:
   void Verifier();
   void Dispatcher();
 
-  std::size_t const verifying_threads_;
-  std::string const name_;
-  Sink &            sink_;
-  Flag              active_{true};
-  Threads           threads_;
-  VerifiedQueue     verified_queue_;
-  UnverifiedQueue   unverified_queue_;
+  std::size_t const           verifying_threads_;
+  std::size_t const           batch_size_;
+  std::string const           name_;
+  Sink &                      sink_;
+  crypto::VerificationEngine &engine_;
+  Flag                        active_{true};
+  Threads                     threads_;
+  VerifiedQueue               verified_queue_;
+  UnverifiedQueue             unverified_queue_;
 
   // telemetry
   GaugePtr   unverified_queue_length_;
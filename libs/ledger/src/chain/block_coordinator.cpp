@@ -39,12 +39,15 @@
 #include "telemetry/counter.hpp"
 #include "telemetry/gauge.hpp"
 #include "telemetry/histogram.hpp"
+#include "telemetry/histogram_map.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -168,9 +171,19 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
                                                                  "Blocks minted")}
   , consensus_update_failure_total_{telemetry::Registry::Instance().CreateCounter(
         "consensus_update_failure_total", "Failures to update consensus")}
+  , pipeline_prefetch_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_pipeline_prefetch_total",
+        "The total number of times missing transactions were requested for upcoming blocks")}
+  , pipeline_hit_count_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_pipeline_hit_total",
+        "The total number of blocks which had been prepared in the look-ahead window")}
   , tx_sync_times_{telemetry::Registry::Instance().CreateHistogram(
         {0.001, 0.01, 0.1, 1, 10, 100}, "ledger_block_coordinator_tx_sync_times",
         "The histogram of the time it takes to sync transactions")}
+  , stage_times_{telemetry::Registry::Instance().CreateHistogramMap(
+        {0.0001, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 100},
+        "ledger_block_coordinator_stage_duration_seconds", "stage",
+        "The histogram of the time spent in each stage of block processing")}
   , current_block_num_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
         "ledger_latest_block_num",
         "The lastest block number that has been executed by the block coordinator")}
@@ -229,6 +242,26 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
   // startup. RecoverFromStartup();
 }
 
+/**
+ * Set the size of the look-ahead window used while catching up with the chain
+ *
+ * When enabled the coordinator prepares the blocks that follow the current block while it is still
+ * being processed. The stateless checks of these blocks are performed early and any of their
+ * missing transactions are requested from peers, so that they can be synchronised in parallel with
+ * the execution of the current block.
+ *
+ * @param depth The maximum number of upcoming blocks to prepare (0 disables the pipeline)
+ */
+void BlockCoordinator::SetPipelineDepth(std::size_t depth)
+{
+  pipeline_depth_ = depth;
+}
+
+std::size_t BlockCoordinator::pipeline_depth() const
+{
+  return pipeline_depth_;
+}
+
 // Reload state ONCE on first start up of the block coordinator. Attempt to set
 // it up as if the shutdown didn't happen
 BlockCoordinator::State BlockCoordinator::OnReloadState()
@@ -444,6 +477,9 @@ BlockCoordinator::State BlockCoordinator::OnSynchronising()
 
     blocks_to_common_ancestor_.pop_back();
 
+    // update the look-ahead window before the path is (potentially) discarded
+    FillPipeline();
+
     if (blocks_to_common_ancestor_.size() < THRESHOLD_FOR_FAST_SYNCING)
     {
       blocks_to_common_ancestor_.clear();
@@ -539,6 +575,8 @@ BlockCoordinator::State BlockCoordinator::OnPreExecBlockValidation()
   current_block_coord_state_->set(static_cast<uint64_t>(state_machine_->state()));
   pre_valid_state_count_->increment();
 
+  start_block_processing_ = Clock::now();
+
   bool const is_genesis = current_block_->IsGenesis();
 
   if (!is_genesis)
@@ -572,25 +610,9 @@ BlockCoordinator::State BlockCoordinator::OnPreExecBlockValidation()
       consensus_update_failure_total_->increment();
     }
 
-    // Check: Ensure the number of lanes is correct
-    if (num_lanes_ != (1u << current_block_->log2_num_lanes))
-    {
-      FETCH_LOG_WARN(LOGGING_NAME,
-                     "Block validation failed: Lane count mismatch. Expected: ", num_lanes_,
-                     " Actual: ", (1u << current_block_->log2_num_lanes), " (0x",
-                     current_block_->hash.ToHex(), ')');
-
-      RemoveBlock(current_block_);
-      return State::RESET;
-    }
-
-    // Check: Ensure the number of slices is correct
-    if (num_slices_ != current_block_->slices.size())
+    // Check: Ensure the number of lanes and slices is correct
+    if (!ValidateBlockLayout(*current_block_))
     {
-      FETCH_LOG_WARN(
-          LOGGING_NAME, "Block validation failed: Slice count mismatch. Expected: ", num_slices_,
-          " Actual: ", current_block_->slices.size(), " (0x", current_block_->hash.ToHex(), ')');
-
       RemoveBlock(current_block_);
       return State::RESET;
     }
@@ -616,6 +638,8 @@ BlockCoordinator::State BlockCoordinator::OnPreExecBlockValidation()
   // reset the tx wait period
   tx_wait_periodic_.Reset();
 
+  RecordStage("pre_exec_validation", start_block_processing_);
+
   // All the checks pass
   return State::WAIT_FOR_TRANSACTIONS;
 }
@@ -626,6 +650,8 @@ BlockCoordinator::State BlockCoordinator::OnSynergeticExecution()
   current_block_coord_state_->set(static_cast<uint64_t>(state_machine_->state()));
   syn_exec_state_count_->count();
 
+  auto const start = Clock::now();
+
   bool const is_genesis = current_block_->IsGenesis();
 
   // Executing synergetic work
@@ -657,6 +683,8 @@ BlockCoordinator::State BlockCoordinator::OnSynergeticExecution()
     }
   }
 
+  RecordStage("synergetic_execution", start);
+
   return State::SCHEDULE_BLOCK_EXECUTION;
 }
 
@@ -708,6 +736,10 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     wait_before_asking_for_missing_tx_.Restart(WAIT_BEFORE_ASKING_FOR_MISSING_TX_INTERVAL);
     have_asked_for_missing_txs_ = false;
     start_waiting_for_tx_       = Clock::now();  // cache the start time
+
+    // the missing transactions of a block in the look-ahead window have already been collected,
+    // the ones which have still not arrived are requested again after the usual delay
+    TakePipelinedTransactions();
   }
 
   // TODO(HUT): this might need to check that storage has whatever this dag epoch needs wrt
@@ -757,6 +789,7 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
   {
     // record the time this successful syncing took place
     tx_sync_times_->Add(ToSeconds(Clock::now() - start_waiting_for_tx_));
+    RecordStage("wait_for_transactions", start_waiting_for_tx_);
 
     FETCH_LOG_DEBUG(LOGGING_NAME, "All transactions have been synchronised!");
 
@@ -777,6 +810,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     FETCH_LOG_INFO(LOGGING_NAME, "Waiting for DAG to sync");
   }
 
+  // make use of the wait to prepare the upcoming blocks
+  AdvancePipeline();
+
   // signal the next execution of the state machine should be much later in the future
   state_machine_->Delay(std::chrono::milliseconds{200});
 
@@ -801,6 +837,7 @@ void BlockCoordinator::RemoveBlock(BlockPtrType &block)
   }
 
   blocks_to_common_ancestor_.clear();
+  pipeline_.clear();
 }
 
 bool BlockCoordinator::RevertToBlock(Block const &block)
@@ -860,11 +897,163 @@ void BlockCoordinator::Panic()
   last_executed_block_.ApplyVoid([&](auto &digest) { digest = genesis_digest; });
   execution_manager_.SetLastProcessedBlock(genesis_digest);
 
+  pipeline_.clear();
+
   // delay the state machine in these error cases, to allow the network to catch up if the issue
   // is network related and if nothing else restrict logs being spammed
   state_machine_->Delay(std::chrono::seconds{5});
 }
 
+/**
+ * Perform the block checks which do not depend on the state of the previous block
+ *
+ * @param block The block to be checked
+ * @return true if the block is well formed, otherwise false
+ */
+bool BlockCoordinator::ValidateBlockLayout(Block const &block) const
+{
+  // Check: Ensure the number of lanes is correct
+  if (num_lanes_ != (1u << block.log2_num_lanes))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Block validation failed: Lane count mismatch. Expected: ",
+                   num_lanes_, " Actual: ", (1u << block.log2_num_lanes), " (0x",
+                   block.hash.ToHex(), ')');
+
+    return false;
+  }
+
+  // Check: Ensure the number of slices is correct
+  if (num_slices_ != block.slices.size())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME,
+                   "Block validation failed: Slice count mismatch. Expected: ", num_slices_,
+                   " Actual: ", block.slices.size(), " (0x", block.hash.ToHex(), ')');
+
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Update the look-ahead window from the path to the heaviest block. The window starts with the
+ * current block and any block which has already been prepared retains its state.
+ */
+void BlockCoordinator::FillPipeline()
+{
+  std::size_t const depth = pipeline_depth_;
+
+  Pipeline pipeline{};
+  if (depth > 0)
+  {
+    // the path is ordered from the heaviest block back to the current block
+    auto it = blocks_to_common_ancestor_.crbegin();
+    for (; (it != blocks_to_common_ancestor_.crend()) && (pipeline.size() <= depth); ++it)
+    {
+      auto const &block = *it;
+
+      // entries which have already been moved across no longer reference a block
+      auto existing = std::find_if(
+          pipeline_.begin(), pipeline_.end(), [&block](PipelinedBlock const &entry) {
+            return entry.block && (entry.block->hash == block->hash);
+          });
+
+      if (existing != pipeline_.end())
+      {
+        pipeline.emplace_back(std::move(*existing));
+      }
+      else
+      {
+        pipeline.emplace_back();
+        pipeline.back().block = block;
+      }
+    }
+  }
+
+  pipeline_ = std::move(pipeline);
+}
+
+/**
+ * Prepare the upcoming blocks in the look-ahead window. The missing transactions of all the newly
+ * prepared blocks are requested from peers in a single batch.
+ */
+void BlockCoordinator::AdvancePipeline()
+{
+  DigestSet missing_txs{};
+
+  auto it = pipeline_.begin();
+  while (it != pipeline_.end())
+  {
+    auto &entry = *it++;
+
+    // the current block is processed by the main stages
+    bool const is_current = current_block_ && (entry.block->hash == current_block_->hash);
+
+    if (!(entry.prepared || is_current))
+    {
+      entry.prepared    = true;
+      entry.valid       = ValidateBlockLayout(*entry.block);
+      entry.missing_txs = std::make_unique<DigestSet>();
+
+      if (entry.valid)
+      {
+        for (auto const &slice : entry.block->slices)
+        {
+          for (auto const &tx : slice)
+          {
+            if (!storage_unit_.HasTransaction(tx.digest()))
+            {
+              entry.missing_txs->insert(tx.digest());
+              missing_txs.insert(tx.digest());
+            }
+          }
+        }
+      }
+    }
+
+    // there is no point in preparing the descendants of an invalid block
+    if (!entry.valid)
+    {
+      break;
+    }
+  }
+
+  pipeline_.erase(it, pipeline_.end());
+
+  if (!missing_txs.empty())
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Pipeline: Requesting ", missing_txs.size(),
+                    " missing TXs for upcoming blocks");
+
+    pipeline_prefetch_count_->increment();
+    storage_unit_.IssueCallForMissingTxs(missing_txs);
+  }
+}
+
+/**
+ * Take over the missing transactions of the current block if it has been prepared as part of the
+ * look-ahead window
+ */
+void BlockCoordinator::TakePipelinedTransactions()
+{
+  auto it = std::find_if(pipeline_.begin(), pipeline_.end(), [this](PipelinedBlock const &entry) {
+    return entry.block->hash == current_block_->hash;
+  });
+
+  if ((it == pipeline_.end()) || !it->missing_txs)
+  {
+    return;
+  }
+
+  pending_txs_ = std::move(it->missing_txs);
+  pipeline_hit_count_->increment();
+}
+
+void BlockCoordinator::RecordStage(char const *stage, Timepoint const &start)
+{
+  stage_times_->Add(stage, ToSeconds(Clock::now() - start));
+}
+
 BlockCoordinator::State BlockCoordinator::OnScheduleBlockExecution()
 {
   MilliTimer const timer{"OnScheduleBlockExecution ", 1000};
@@ -872,11 +1061,19 @@ BlockCoordinator::State BlockCoordinator::OnScheduleBlockExecution()
 
   State next_state{State::RESET};
 
+  auto const start = Clock::now();
+
   // schedule the current block for execution
   if (ScheduleCurrentBlock())
   {
     exec_wait_periodic_.Reset();
 
+    start_block_execution_ = Clock::now();
+    RecordStage("schedule_execution", start);
+
+    // prepare the upcoming blocks while the current one is being executed
+    AdvancePipeline();
+
     next_state = State::WAIT_FOR_EXECUTION;
   }
 
@@ -896,6 +1093,8 @@ BlockCoordinator::State BlockCoordinator::OnWaitForExecution()
   switch (status)
   {
   case ExecutionStatus::IDLE:
+    RecordStage("execution", start_block_execution_);
+
     next_state = State::POST_EXEC_BLOCK_VALIDATION;
     break;
 
@@ -907,6 +1106,8 @@ BlockCoordinator::State BlockCoordinator::OnWaitForExecution()
                      current_block_->hash.ToHex());
     }
 
+    AdvancePipeline();
+
     // signal that the next execution should not happen immediately
     state_machine_->Delay(std::chrono::milliseconds{20});
     break;
@@ -926,6 +1127,8 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
   current_block_coord_state_->set(static_cast<uint64_t>(state_machine_->state()));
   post_valid_state_count_->increment();
 
+  auto const start = Clock::now();
+
   // Check: Ensure the merkle hash is correct for this block
   auto const state_hash = storage_unit_.CurrentHash();
 
@@ -979,6 +1182,9 @@ BlockCoordinator::State BlockCoordinator::OnPostExecBlockValidation()
       FETCH_LOG_WARN(LOGGING_NAME, "Failed to update consensus with valid block");
       consensus_update_failure_total_->increment();
     }
+
+    RecordStage("post_exec_validation", start);
+    RecordStage("total", start_block_processing_);
   }
 
   return State::RESET;
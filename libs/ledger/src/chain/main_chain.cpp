@@ -36,6 +36,7 @@
 #include <cstdint>
 #include <deque>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -47,8 +48,23 @@ namespace fetch {
 namespace ledger {
 
 namespace {
-constexpr char const *BLOOM_FILTER_STORE = "chain.bloom.db";
-constexpr uint64_t    OVERLAP            = 400000;
+constexpr char const *TX_INDEX_STORE = "chain.txindex.db";
+
+/**
+ * Determine the lowest block number for which duplicate transaction detection is still required.
+ * Blocks can be added to forks which are behind the heaviest tip, however not beyond the
+ * finality period.
+ *
+ * @param heaviest_block_number The current heaviest block number
+ * @return The lowest block number of interest
+ */
+uint64_t LowestTrackedBlockNumber(uint64_t heaviest_block_number)
+{
+  return (heaviest_block_number > chain::FINALITY_PERIOD)
+             ? heaviest_block_number - chain::FINALITY_PERIOD
+             : 0;
+}
+
 }  // namespace
 
 const uint64_t DIRTY_TIMEOUT{600};
@@ -61,19 +77,18 @@ const uint64_t DIRTY_TIMEOUT{600};
 MainChain::MainChain(Mode mode, bool dirty_block_functionality)
   : mode_{mode}
   , dirty_block_functionality_{dirty_block_functionality}
-  , bloom_filter_{OVERLAP}
-  , bloom_filter_queried_bit_count_(telemetry::Registry::Instance().CreateGauge<std::size_t>(
-        "ledger_main_chain_bloom_filter_queried_bit_number",
-        "Total number of bits checked during each query to the Ledger Main Chain Bloom filter"))
-  , bloom_filter_query_count_(telemetry::Registry::Instance().CreateCounter(
-        "ledger_main_chain_bloom_filter_query_total",
-        "Total number of queries to the Ledger Main Chain Bloom filter"))
-  , bloom_filter_positive_count_(telemetry::Registry::Instance().CreateCounter(
-        "ledger_main_chain_bloom_filter_positive_total",
-        "Total number of positive queries (false and true) to the Ledger Main Chain Bloom filter"))
-  , bloom_filter_false_positive_count_(telemetry::Registry::Instance().CreateCounter(
-        "ledger_main_chain_bloom_filter_false_positive_total",
-        "Total number of false positive queries to the Ledger Main Chain Bloom filter"))
+  , tx_index_size_(telemetry::Registry::Instance().CreateGauge<std::size_t>(
+        "ledger_main_chain_tx_index_size",
+        "The number of transactions tracked by the Ledger Main Chain transaction index"))
+  , tx_index_query_count_(telemetry::Registry::Instance().CreateCounter(
+        "ledger_main_chain_tx_index_query_total",
+        "Total number of queries to the Ledger Main Chain transaction index"))
+  , tx_index_match_count_(telemetry::Registry::Instance().CreateCounter(
+        "ledger_main_chain_tx_index_match_total",
+        "Total number of queries matching a transaction on any branch of the Ledger Main Chain"))
+  , tx_index_duplicate_count_(telemetry::Registry::Instance().CreateCounter(
+        "ledger_main_chain_tx_index_duplicate_total",
+        "Total number of duplicate transactions detected by the Ledger Main Chain"))
   , dirty_blocks_attempt_add_(telemetry::Registry::Instance().CreateCounter(
         "ledger_main_chain_dirty_blocks_attempt_add_total", "Total attempts to add a dirty block"))
 {
@@ -103,9 +118,14 @@ MainChain::~MainChain()
 
 void MainChain::Reset()
 {
-  FETCH_LOG_INFO(LOGGING_NAME, "Resetting the main chain.");
-
+  FETCH_LOCK(writer_gate_);
   FETCH_LOCK(lock_);
+  LocklessReset();
+}
+
+void MainChain::LocklessReset()
+{
+  FETCH_LOG_INFO(LOGGING_NAME, "Resetting the main chain.");
 
   tips_.clear();
   heaviest_ = HeaviestTip{};
@@ -119,10 +139,11 @@ void MainChain::Reset()
     head_store_.close();
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+    std::ofstream out(TX_INDEX_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
   }
 
-  std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
-  bloom_filter_.Reset();
+  tx_index_.Reset();
 
   auto genesis = CreateGenesisBlock();
 
@@ -135,6 +156,7 @@ void MainChain::Reset()
 
 void MainChain::Flush()
 {
+  FETCH_LOCK(writer_gate_);
   FETCH_LOCK(lock_);
   FlushToDisk(true);
 }
@@ -168,6 +190,9 @@ BlockStatus MainChain::AddBlock(BlockPtr const &block)
   // At this point we assume that the weight has been correctly set by the miner
   block->total_weight = 1;
 
+  FETCH_LOCK(writer_gate_);
+  FETCH_LOCK(lock_);
+
   auto const status = InsertBlock(block);
   FETCH_LOG_DEBUG(LOGGING_NAME, "New Block: 0x", block->hash.ToHex(), " -> ", ToString(status),
                   " (weight: ", block->weight, " total: ", block->total_weight, ")");
@@ -185,6 +210,8 @@ BlockStatus MainChain::AddBlock(BlockPtr const &block)
  */
 void MainChain::CacheReference(BlockHash const &hash, BlockHash const &next_hash, bool unique) const
 {
+  FETCH_LOCK(cache_lock_);
+
   // get all known forward references range for this parent
   auto siblings = forward_references_.equal_range(hash);
   // references from storage are unique
@@ -216,6 +243,8 @@ void MainChain::CacheReference(BlockHash const &hash, BlockHash const &next_hash
  */
 void MainChain::ForgetReference(BlockHash const &hash, BlockHash const &next_hash) const
 {
+  FETCH_LOCK(cache_lock_);
+
   // get all known forward references range for this parent
   auto siblings = forward_references_.equal_range(hash);
   if (next_hash.empty())
@@ -244,6 +273,8 @@ void MainChain::ForgetReference(BlockHash const &hash, BlockHash const &next_has
  */
 bool MainChain::LookupReference(BlockHash const &hash, BlockHash &next_hash) const
 {
+  FETCH_LOCK(cache_lock_);
+
   switch (forward_references_.count(hash))
   {
   case 0:
@@ -255,7 +286,7 @@ bool MainChain::LookupReference(BlockHash const &hash, BlockHash &next_hash) con
     next_hash = forward_references_.find(hash)->second;
     return true;
   default:
-    auto parent_block = GetBlock(hash);
+    auto parent_block = LookupBlock(hash);
     assert(parent_block);
     assert(heaviest_.ChainLabel() != 0);
     // check if this block is cached and known to lie on the current heaviest chain
@@ -267,7 +298,7 @@ bool MainChain::LookupReference(BlockHash const &hash, BlockHash &next_hash) con
            ++reference_it)
       {
         auto const &child_hash  = reference_it->second;
-        auto        child_block = GetBlock(child_hash);
+        auto        child_block = LookupBlock(child_hash);
         if (child_block && child_block->chain_label == heaviest_.ChainLabel())
         {
           next_hash = child_hash;
@@ -394,7 +425,7 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   if (block_store_->Get(storage::ResourceID(hash), record))
   {
     block = record.block;
-    AddBlockToBloomFilter(block);
+    AddBlockToTransactionIndex(block);
     if (next_hash != nullptr)
     {
       *next_hash = record.next_hash;
@@ -415,15 +446,20 @@ bool MainChain::LoadBlock(BlockHash const &hash, Block &block, BlockHash *next_h
   return false;
 }
 
-void MainChain::AddBlockToBloomFilter(Block const &block) const
+/**
+ * Internal: Record the transactions of a block in the transaction index, discarding transactions
+ * which can no longer be included in any block of interest
+ *
+ * @param block The block to be indexed
+ */
+void MainChain::AddBlockToTransactionIndex(Block const &block) const
 {
-  for (auto const &slice : block.slices)
-  {
-    for (auto const &tx_layout : slice)
-    {
-      bloom_filter_.Add(tx_layout.digest(), tx_layout.valid_until(), heaviest_.BlockNumber());
-    }
-  }
+  FETCH_LOCK(cache_lock_);
+
+  tx_index_.Add(block);
+  tx_index_.Prune(LowestTrackedBlockNumber(heaviest_.BlockNumber()));
+
+  tx_index_size_->set(tx_index_.size());
 }
 
 /**
@@ -433,8 +469,7 @@ void MainChain::AddBlockToBloomFilter(Block const &block) const
  */
 BlockPtr MainChain::GetHeaviestBlock() const
 {
-  FETCH_LOCK(lock_);
-  auto block_ptr = GetBlock(heaviest_.Hash());
+  auto block_ptr = std::atomic_load(&heaviest_block_);
   assert(block_ptr);
   return block_ptr;
 }
@@ -503,6 +538,7 @@ bool MainChain::RemoveTree(BlockHash const &removed_hash, BlockHashSet &invalida
  */
 bool MainChain::RemoveBlock(BlockHash const &hash)
 {
+  FETCH_LOCK(writer_gate_);
   FETCH_LOCK(lock_);
 
   if (dirty_block_functionality_)
@@ -514,7 +550,7 @@ bool MainChain::RemoveBlock(BlockHash const &hash)
   }
 
   // Step 0. Manually set heaviest to a block we still know is valid
-  auto block_to_remove = GetBlock(hash);
+  auto block_to_remove = LookupBlock(hash);
 
   if (!block_to_remove)
   {
@@ -535,6 +571,7 @@ bool MainChain::RemoveBlock(BlockHash const &hash)
     if (block_before_one_to_del)
     {
       heaviest_.Set(*block_before_one_to_del);
+      PublishHeaviestBlock(block_before_one_to_del);
     }
   }
 
@@ -570,7 +607,7 @@ bool MainChain::RemoveBlock(BlockHash const &hash)
 
   // Step 3. Since we might have removed a whole series of blocks the tips data structure
   // is likely to have been invalidated. We need to evaluate the changes here
-  return ReindexTips();
+  return LocklessReindexTips();
 }
 
 /**
@@ -585,9 +622,9 @@ Blocks MainChain::GetHeaviestChain(uint64_t limit) const
   // constexpr
   MilliTimer myTimer("MainChain::HeaviestChain", 2000);
 
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
-  return GetChainPreceding(GetHeaviestBlockHash(), limit);
+  return LocklessGetChainPreceding(heaviest_.Hash(), limit);
 }
 
 BlockPtr MainChain::GetLabeledSubchainStart() const
@@ -605,7 +642,7 @@ BlockPtr MainChain::GetLabeledSubchainStart() const
 BlockPtr MainChain::HeaviestChainBlockAbove(uint64_t limit) const
 {
   MilliTimer myTimer("MainChain::HeaviestChainBlockAbove");
-  FETCH_LOCK(lock_);
+  FETCH_LOCK(cache_lock_);
   assert(heaviest_.ChainLabel() != 0);
 
   auto block = GetLabeledSubchainStart();
@@ -645,11 +682,24 @@ Blocks MainChain::GetChainPreceding(BlockHash start, uint64_t limit) const
 {
   MilliTimer myTimer("MainChain::ChainPreceding", 2000);
 
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
+  return LocklessGetChainPreceding(std::move(start), limit);
+}
+
+/**
+ * Internal: Walk the block history collecting blocks until either genesis or the block limit is
+ * reached
+ *
+ * @param start The hash of the first block
+ * @param limit The maximum amount of blocks returned
+ * @return The array of blocks
+ */
+Blocks MainChain::LocklessGetChainPreceding(BlockHash start, uint64_t limit) const
+{
   // asserting genesis block has a number of 0, and everything else is above
-  assert(GetBlock(chain::GetGenesisDigest()));
-  assert(GetBlock(chain::GetGenesisDigest())->block_number == 0);
+  assert(LookupBlock(chain::GetGenesisDigest()));
+  assert(LookupBlock(chain::GetGenesisDigest())->block_number == 0);
 
   Blocks result;
   bool   not_at_genesis = true;
@@ -695,7 +745,7 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash, std::size_t
   BlockHash next_hash;
   Blocks    result;
 
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   // cache the heaviest block
   auto const heaviest = GetHeaviestBlock();
@@ -719,7 +769,11 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash, std::size_t
   }
 
   // We have the block we want to sync forward from. Check if it is on the heaviest chain.
-  bool const on_heaviest_branch = (block && (block->chain_label == heaviest_.ChainLabel()));
+  bool on_heaviest_branch{false};
+  {
+    FETCH_LOCK(cache_lock_);
+    on_heaviest_branch = (block && (block->chain_label == heaviest_.ChainLabel()));
+  }
 
   std::size_t const output_limit = std::min(limit, std::size_t{UPPER_BOUND});
 
@@ -758,6 +812,66 @@ MainChain::Travelogue MainChain::TimeTravel(BlockHash current_hash, std::size_t
   return {heaviest->hash, heaviest->block_number, status, std::move(result)};
 }
 
+/**
+ * Walk the chain forward in the same way as TimeTravel(), but only collect the digests of the
+ * blocks. This allows a syncing node to learn the shape of a peer's chain cheaply before fetching
+ * the blocks themselves.
+ *
+ * @param current_hash The hash of the first block's parent
+ * @param limit The maximum number of digests to return
+ * @return The array of block digests, in chain order
+ */
+MainChain::BlockHashes MainChain::TimeTravelDigests(BlockHash current_hash, std::size_t limit) const
+{
+  MilliTimer myTimer("MainChain::TimeTravelDigests", 750);
+
+  BlockHash   next_hash;
+  BlockHashes result;
+
+  auto read_lock = LockForReading();
+
+  BlockPtr block;
+  if (current_hash.empty())
+  {
+    // start of the sync, from genesis
+    next_hash = chain::GetGenesisDigest();
+  }
+  else if (!LookupBlock(current_hash, block, &next_hash))
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Block lookup failure for block: 0x", ToHex(current_hash),
+                    " during digest time travel");
+
+    return {};
+  }
+
+  std::size_t const output_limit = std::min(limit, std::size_t{DIGEST_UPPER_BOUND});
+
+  bool not_done = true;
+  for (current_hash = std::move(next_hash);
+       not_done && !current_hash.empty() && result.size() < output_limit;
+       current_hash = std::move(next_hash))
+  {
+    block.reset();
+    if (!LookupBlock(current_hash, block, &next_hash))
+    {
+      if (!block)
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Block lookup failure during TT, for block: 0x",
+                        ToHex(current_hash));
+
+        return {};
+      }
+
+      // the forward reference is ambiguous, so stop here
+      not_done = false;
+    }
+
+    result.push_back(current_hash);
+  }
+
+  return result;
+}
+
 /**
  * Get a common sub tree from the chain.
  *
@@ -780,7 +894,7 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip_hash, Bloc
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
   MilliTimer myTimer("MainChain::GetPathToCommonAncestor", 500);
 
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   bool success{true};
 
@@ -893,7 +1007,7 @@ BlockPtr MainChain::GetBlock(BlockHash const &hash) const
     return {};
   }
 
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   BlockPtr output_block{};
 
@@ -918,7 +1032,7 @@ BlockPtr MainChain::GetBlock(BlockHash const &hash) const
  */
 MainChain::BlockHashSet MainChain::GetMissingTips() const
 {
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   BlockHashSet tips{};
   for (auto const &element : loose_blocks_)
@@ -944,7 +1058,7 @@ MainChain::BlockHashSet MainChain::GetMissingTips() const
 MainChain::BlockHashes MainChain::GetMissingBlockHashes(uint64_t limit) const
 {
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   BlockHashes results;
 
@@ -967,7 +1081,7 @@ MainChain::BlockHashes MainChain::GetMissingBlockHashes(uint64_t limit) const
  */
 bool MainChain::HasMissingBlocks() const
 {
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
   return !loose_blocks_.empty();
 }
 
@@ -978,7 +1092,7 @@ bool MainChain::HasMissingBlocks() const
  */
 MainChain::BlockHashSet MainChain::GetTips() const
 {
-  FETCH_LOCK(lock_);
+  auto read_lock = LockForReading();
 
   BlockHashSet hash_set;
   for (auto const &element : tips_)
@@ -1000,7 +1114,7 @@ void MainChain::RecoverFromFile(Mode mode)
 
   assert(static_cast<bool>(block_store_));
 
-  FETCH_LOCK(lock_);
+  // Note: only called during construction, therefore no locking is required
 
   // load the database files
   if (Mode::CREATE_PERSISTENT_DB == mode)
@@ -1009,8 +1123,8 @@ void MainChain::RecoverFromFile(Mode mode)
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
 
-    std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
-    bloom_filter_.Reset();
+    std::ofstream out(TX_INDEX_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
+    tx_index_.Reset();
 
     return;
   }
@@ -1022,23 +1136,23 @@ void MainChain::RecoverFromFile(Mode mode)
     block_store_->Load("chain.db", "chain.index.db");
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
 
-    std::ifstream in(BLOOM_FILTER_STORE, std::ios::binary | std::ios::in);
+    std::ifstream in(TX_INDEX_STORE, std::ios::binary | std::ios::in);
 
     if (in.is_open())
     {
       try
       {
-        byte_array::ByteArray bloom_filter_data{in};
+        byte_array::ByteArray tx_index_data{in};
 
-        LargeObjectSerializeHelper buffer{bloom_filter_data};
+        LargeObjectSerializeHelper buffer{tx_index_data};
 
-        buffer >> bloom_filter_;
+        buffer >> tx_index_;
       }
       catch (std::exception const &e)
       {
         FETCH_LOG_ERROR(LOGGING_NAME,
-                        "Failed to load Bloom filter from storage! Reason: ", e.what());
-        Reset();
+                        "Failed to load transaction index from storage! Reason: ", e.what());
+        LocklessReset();
       }
     }
   }
@@ -1122,8 +1236,8 @@ void MainChain::RecoverFromFile(Mode mode)
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
 
-    std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
-    bloom_filter_.Reset();
+    std::ofstream out(TX_INDEX_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
+    tx_index_.Reset();
   }
 }
 
@@ -1230,8 +1344,6 @@ void MainChain::TrimCache()
 
   MilliTimer myTimer("MainChain::TrimCache");
 
-  FETCH_LOCK(lock_);
-
   uint64_t const heaviest_block_num = heaviest_.BlockNumber();
 
   if (CACHE_TRIM_THRESHOLD < heaviest_block_num)
@@ -1329,8 +1441,6 @@ void MainChain::FlushBlock(BlockPtr const &block)
 // walk through it adding the blocks, so long as we do breadth first search (!!)
 void MainChain::CompleteLooseBlocks(BlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // Determine if this block is actually a loose block, if it isn't exit immediately
   auto it = loose_blocks_.find(block->hash);
   if (it == loose_blocks_.end())
@@ -1383,8 +1493,6 @@ void MainChain::CompleteLooseBlocks(BlockPtr const &block)
  */
 void MainChain::RecordLooseBlock(BlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // Get vector of waiting blocks and push ours on
   auto &waiting_blocks = loose_blocks_[block->previous_hash];
   waiting_blocks.push_back(block->hash);
@@ -1427,6 +1535,8 @@ bool MainChain::UpdateHeaviestTip(BlockPtr const &block)
   auto ret_val = heaviest_.Update(*block);
   if (ret_val)
   {
+    PublishHeaviestBlock(block);
+
     if (!labeled_subchain_start_ || labeled_subchain_start_->chain_label != heaviest_.ChainLabel())
     {
       // we have a new distinct heaviest chain
@@ -1436,6 +1546,30 @@ bool MainChain::UpdateHeaviestTip(BlockPtr const &block)
   return ret_val;
 }
 
+/**
+ * Internal: Publish the snapshot of the heaviest block, allowing it to be queried without locking
+ *
+ * @param block The new heaviest block
+ */
+void MainChain::PublishHeaviestBlock(BlockPtr const &block)
+{
+  std::atomic_store(&heaviest_block_, block);
+}
+
+/**
+ * Internal: Acquire the shared lock for a query of the chain
+ *
+ * The writer gate is held only while the shared lock is being acquired. Since writers hold the gate
+ * while waiting for exclusive access, new queries queue up behind a pending writer.
+ *
+ * @return The acquired shared lock
+ */
+MainChain::ReadLock MainChain::LockForReading() const
+{
+  FETCH_LOCK(writer_gate_);
+  return ReadLock{lock_};
+}
+
 /**
  * Internal: Insert the block into the cache
  *
@@ -1451,8 +1585,6 @@ BlockStatus MainChain::InsertBlock(BlockPtr const &block, bool evaluate_loose_bl
 
   MilliTimer myTimer("MainChain::InsertBlock", 750);
 
-  FETCH_LOCK(lock_);
-
   if (dirty_block_functionality_ && dirty_map_.find(block->hash) != dirty_map_.end())
   {
     if (time_now < dirty_map_[block->hash])
@@ -1484,7 +1616,7 @@ BlockStatus MainChain::InsertBlock(BlockPtr const &block, bool evaluate_loose_bl
     }
   }
 
-  auto const duplicates = DetectDuplicateTransactions(block->previous_hash, txs);
+  auto const duplicates = LocklessDetectDuplicateTransactions(block->previous_hash, txs);
   if (!duplicates.empty())
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Block discard due to duplicate tx(s)");
@@ -1584,7 +1716,7 @@ BlockStatus MainChain::InsertBlock(BlockPtr const &block, bool evaluate_loose_bl
     CompleteLooseBlocks(block);
   }
 
-  AddBlockToBloomFilter(*block);
+  AddBlockToTransactionIndex(*block);
 
   return BlockStatus::ADDED;
 }
@@ -1637,8 +1769,6 @@ bool MainChain::LookupBlock(BlockHash const &hash, BlockPtr &block, BlockHash *n
  */
 bool MainChain::LookupBlockFromCache(BlockHash const &hash, BlockPtr &block) const
 {
-  FETCH_LOCK(lock_);
-
   // perform the lookup
   auto const it = block_chain_.find(hash);
   if ((block_chain_.end() != it))
@@ -1717,8 +1847,6 @@ void MainChain::AddBlockToCache(BlockPtr const &block) const
  */
 bool MainChain::AddTip(BlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // record the tip weight
   tips_[block->hash] = Tip(*block);
 
@@ -1732,8 +1860,6 @@ bool MainChain::AddTip(BlockPtr const &block)
  */
 bool MainChain::DetermineHeaviestTip()
 {
-  FETCH_LOCK(lock_);
-
   if (!tips_.empty())
   {
     // find the heaviest item in our tip selection
@@ -1758,6 +1884,7 @@ bool MainChain::DetermineHeaviestTip()
     auto heaviest_block = LookupBlock(it->first);
     assert(heaviest_block);
     heaviest_.Set(*heaviest_block);
+    PublishHeaviestBlock(heaviest_block);
     return true;
   }
 
@@ -1774,8 +1901,13 @@ bool MainChain::DetermineHeaviestTip()
  */
 bool MainChain::ReindexTips()
 {
+  FETCH_LOCK(writer_gate_);
   FETCH_LOCK(lock_);
+  return LocklessReindexTips();
+}
 
+bool MainChain::LocklessReindexTips()
+{
   // Tips are hashes of cached non-loose blocks that don't have any forward references
   TipsMap   new_tips;
   Tip       best_tip{};
@@ -1820,6 +1952,7 @@ bool MainChain::ReindexTips()
   auto heaviest_block = LookupBlock(best_tip.hash);
   assert(heaviest_block);
   heaviest_.Set(*heaviest_block);
+  PublishHeaviestBlock(heaviest_block);
 
   return true;
 }
@@ -1846,8 +1979,7 @@ BlockPtr MainChain::CreateGenesisBlock()
  */
 BlockHash MainChain::GetHeaviestBlockHash() const
 {
-  FETCH_LOCK(lock_);
-  return heaviest_.Hash();
+  return GetHeaviestBlock()->hash;
 }
 
 Tip::Tip(Block const &block)
@@ -1983,6 +2115,11 @@ void MainChain::SetHeadHash(BlockHash const &hash)
 /**
  * Strip transactions in container that already exist in the blockchain
  *
+ * The transaction index identifies the (recent) blocks on any branch which contain each of the
+ * transactions. Only when a transaction is found in the index is it necessary to check that one of
+ * its blocks is an ancestor of the starting block. This walk is bounded by the lowest block number
+ * of these matching blocks and is therefore never required in the common (unique transaction) case.
+ *
  * @param: starting_hash Block to start looking downwards from
  * @tparam: transaction The set of transaction to be filtered
  *
@@ -1991,12 +2128,28 @@ void MainChain::SetHeadHash(BlockHash const &hash)
 DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           starting_hash,
                                                  TransactionLayoutSet const &transactions) const
 {
+  auto read_lock = LockForReading();
+
+  return LocklessDetectDuplicateTransactions(starting_hash, transactions);
+}
+
+/**
+ * Internal: Determine which of the specified transactions already exist in the blockchain
+ *
+ * @param: starting_hash Block to start looking downwards from
+ * @tparam: transaction The set of transaction to be filtered
+ *
+ * @return: The set of duplicate transaction digests
+ */
+DigestSet MainChain::LocklessDetectDuplicateTransactions(
+    BlockHash const &starting_hash, TransactionLayoutSet const &transactions) const
+{
+  using CandidateMap = std::unordered_map<BlockHash, DigestSet>;
+
   MilliTimer const timer{"DuplicateTransactionsCheck", 100};
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Starting TX uniqueness verify");
 
-  FETCH_LOCK(lock_);
-
   BlockPtr block;
   if (!LookupBlock(starting_hash, block) || block->is_loose)
   {
@@ -2004,54 +2157,63 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash const &           sta
     return {};
   }
 
-  DigestSet potential_duplicates{};
-  for (auto const &tx_layout : transactions)
-  {
-    std::pair<bool, std::size_t> const result =
-        bloom_filter_.Match(tx_layout.digest(), tx_layout.valid_until());
-    bloom_filter_queried_bit_count_->set(result.second);
-    if (result.first)
-    {
-      bloom_filter_positive_count_->increment();
-      potential_duplicates.insert(tx_layout.digest());
-    }
-    bloom_filter_query_count_->increment();
-  }
+  // build up the set of blocks which could contain a duplicate transaction
+  CandidateMap candidates{};
+  uint64_t     lowest_block_number{block->block_number};
 
-  DigestSet duplicates{};
-  if (!potential_duplicates.empty())
   {
-    for (;;)
+    FETCH_LOCK(cache_lock_);
+
+    for (auto const &tx_layout : transactions)
     {
-      for (auto const &slice : block->slices)
+      tx_index_query_count_->increment();
+
+      auto const *locations = tx_index_.Lookup(tx_layout.digest());
+      if (locations == nullptr)
       {
-        for (auto const &tx : slice)
-        {
-          if (potential_duplicates.count(tx.digest()) > 0)
-          {
-            duplicates.insert(tx.digest());
-          }
-        }
+        continue;
       }
 
-      // Exit the loop once all known transactions are duplicates.
-      if (potential_duplicates.size() == duplicates.size()
-          // or we can no longer find the block
-          || !LookupBlock(block->previous_hash, block))
+      tx_index_match_count_->increment();
+
+      for (auto const &location : *locations)
       {
-        break;
+        // blocks above the starting block can not be one of its ancestors
+        if (location.block_number <= block->block_number)
+        {
+          candidates[location.block_hash].insert(tx_layout.digest());
+          lowest_block_number = std::min(lowest_block_number, location.block_number);
+        }
       }
     }
   }
 
-  auto const false_positives = potential_duplicates.size() - duplicates.size();
+  // determine which of the candidate blocks are ancestors of the starting block
+  DigestSet duplicates{};
+  while (!candidates.empty())
+  {
+    auto const it = candidates.find(block->hash);
+    if (it != candidates.end())
+    {
+      duplicates.insert(it->second.begin(), it->second.end());
+      candidates.erase(it);
+    }
+
+    // exit the loop once we have passed the lowest candidate block
+    if ((block->block_number <= lowest_block_number)
+        // or we can no longer find the block
+        || !LookupBlock(block->previous_hash, block))
+    {
+      break;
+    }
+  }
 
-  bloom_filter_false_positive_count_->add(false_positives);
+  tx_index_duplicate_count_->add(duplicates.size());
 
   return duplicates;
 }
 
-void MainChain::FlushToDisk(bool flush_bloom)
+void MainChain::FlushToDisk(bool flush_index)
 {
   using namespace fetch::serializers;
 
@@ -2060,19 +2222,19 @@ void MainChain::FlushToDisk(bool flush_bloom)
     block_store_->Flush(false);
   }
 
-  if (flush_bloom && (mode_ != Mode::IN_MEMORY_DB))
+  if (flush_index && (mode_ != Mode::IN_MEMORY_DB))
   {
     try
     {
-      std::ofstream out(BLOOM_FILTER_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
+      std::ofstream out(TX_INDEX_STORE, std::ios::binary | std::ios::out | std::ios::trunc);
       LargeObjectSerializeHelper buffer{};
-      buffer << bloom_filter_;
+      buffer << tx_index_;
 
       out << buffer.data();
     }
     catch (std::exception const &e)
     {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Failed to save Bloom filter to file, reason: ", e.what());
+      FETCH_LOG_ERROR(LOGGING_NAME, "Failed to save transaction index to file, reason: ", e.what());
     }
   }
 }
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/transaction_index.hpp"
+
+#include <algorithm>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Record the locations of all the transactions contained in the specified block
+ *
+ * @param block The block to be indexed
+ */
+void TransactionIndex::Add(Block const &block)
+{
+  for (auto const &slice : block.slices)
+  {
+    for (auto const &tx_layout : slice)
+    {
+      auto &entry = index_[tx_layout.digest()];
+
+      if (entry.locations.empty())
+      {
+        entry.valid_until = tx_layout.valid_until();
+        expiry_[entry.valid_until].insert(tx_layout.digest());
+      }
+
+      // the same block can be indexed multiple times (for example when reloaded from storage)
+      auto const it = std::find_if(
+          entry.locations.begin(), entry.locations.end(),
+          [&block](Location const &location) { return location.block_hash == block.hash; });
+
+      if (it == entry.locations.end())
+      {
+        entry.locations.push_back(Location{block.hash, block.block_number});
+      }
+    }
+  }
+}
+
+/**
+ * Lookup the locations of a specified transaction
+ *
+ * @param digest The digest of the transaction
+ * @return The locations of the transaction if found, otherwise nullptr
+ */
+TransactionIndex::Locations const *TransactionIndex::Lookup(Digest const &digest) const
+{
+  auto const it = index_.find(digest);
+  if (it == index_.end())
+  {
+    return nullptr;
+  }
+
+  return &(it->second.locations);
+}
+
+/**
+ * Remove all the transactions which can no longer be included in a block at or above the specified
+ * block number
+ *
+ * @param block_number The lowest block number which is still of interest
+ */
+void TransactionIndex::Prune(uint64_t block_number)
+{
+  // a transaction is only valid in blocks strictly below its valid until
+  auto const end = expiry_.upper_bound(block_number);
+
+  for (auto it = expiry_.begin(); it != end; ++it)
+  {
+    for (auto const &digest : it->second)
+    {
+      index_.erase(digest);
+    }
+  }
+
+  expiry_.erase(expiry_.begin(), end);
+}
+
+void TransactionIndex::Reset()
+{
+  index_.clear();
+  expiry_.clear();
+}
+
+std::size_t TransactionIndex::size() const
+{
+  return index_.size();
+}
+
+void TransactionIndex::RebuildExpiry()
+{
+  expiry_.clear();
+
+  for (auto const &element : index_)
+  {
+    expiry_[element.second.valid_until].insert(element.first);
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
+#include "logging/logging.hpp"
+#include "storage/resource_mapper.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/generator.hpp"
+#include "vm/opcodes.hpp"
+
+#include <cassert>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "ExecutableCache";
+
+// The approximate bookkeeping overhead of an entry in the cache (hash map and LRU list nodes)
+constexpr uint64_t ENTRY_OVERHEAD = 128;
+
+uint64_t EstimateFunctionSize(vm::Executable::Function const &function)
+{
+  uint64_t size = sizeof(function) + function.name.size();
+
+  size += function.parameters.size() * sizeof(vm::Executable::Parameter);
+  size += function.variables.size() * sizeof(vm::Executable::Variable);
+  size += function.instructions.size() * sizeof(vm::Executable::Instruction);
+  size += function.annotations.size() * sizeof(vm::Annotation);
+
+  // approximation of a red-black tree node
+  size += function.pc_to_line_map.size() * 48u;
+
+  return size;
+}
+
+/**
+ * Build the key of an executable in the persistent store. Executables refer to the functions of the
+ * module by opcode, which are numbered after the reserved opcodes of the VM. Therefore the number
+ * of reserved opcodes is part of the key, so that a change to the instruction set invalidates the
+ * previously persisted executables.
+ *
+ * @param digest The digest of the contract source
+ * @return The resource id of the executable
+ */
+storage::ResourceID StorageKey(Digest const &digest)
+{
+  crypto::SHA256 hasher{};
+  hasher.Reset();
+  hasher.Update(digest);
+  hasher.Update(std::to_string(vm::Opcodes::NumReserved));
+
+  return storage::ResourceID{hasher.Final()};
+}
+
+}  // namespace
+
+constexpr uint64_t ExecutableCache::DEFAULT_MAX_BYTES;
+
+/**
+ * Get the process wide instance of the executable cache
+ *
+ * @return The executable cache
+ */
+ExecutableCache &ExecutableCache::Instance()
+{
+  static ExecutableCache instance{};
+  return instance;
+}
+
+/**
+ * Construct an executable cache
+ *
+ * @param max_bytes The approximate upper bound on the memory used by the cached executables
+ */
+ExecutableCache::ExecutableCache(uint64_t max_bytes)
+  : max_bytes_{max_bytes}
+  , hits_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_hits_total",
+        "The total number of executables found in the memory cache")}
+  , disk_hits_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_disk_hits_total",
+        "The total number of executables loaded from the persistent cache")}
+  , misses_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_misses_total",
+        "The total number of executables which needed to be compiled")}
+  , evictions_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_executable_cache_evictions_total",
+        "The total number of executables evicted from the memory cache")}
+{}
+
+ExecutableCache::~ExecutableCache() = default;
+
+/**
+ * Enable the persistence of the compiled executables
+ *
+ * @param doc_file The path to the document file
+ * @param index_file The path to the index file
+ */
+void ExecutableCache::EnablePersistence(std::string const &doc_file, std::string const &index_file)
+{
+  auto archive = std::make_unique<Archive>();
+  archive->Load(doc_file, index_file, true);
+
+  FETCH_LOCK(lock_);
+  archive_ = std::move(archive);
+}
+
+bool ExecutableCache::IsPersistent() const
+{
+  FETCH_LOCK(lock_);
+  return static_cast<bool>(archive_);
+}
+
+/**
+ * Lookup a compiled executable
+ *
+ * @param digest The digest of the contract source
+ * @param num_system_types The number of system types of the module the executable will be used with
+ * @return The executable if found, otherwise nullptr
+ */
+ExecutableCache::ExecutablePtr ExecutableCache::Lookup(Digest const &digest,
+                                                       uint16_t      num_system_types)
+{
+  FETCH_LOCK(lock_);
+
+  auto it = entries_.find(digest);
+  if (it != entries_.end())
+  {
+    // mark as most recently used
+    lru_.splice(lru_.begin(), lru_, it->second.position);
+
+    hits_total_->increment();
+    return it->second.executable;
+  }
+
+  if (archive_)
+  {
+    auto executable = std::make_shared<Executable>();
+
+    bool success{false};
+    try
+    {
+      success = archive_->Get(StorageKey(digest), *executable);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to load persisted executable: ", ex.what());
+    }
+
+    // only reuse executables generated against a compatible module
+    if (success && (executable->num_system_types == num_system_types))
+    {
+      LocklessInsert(digest, executable);
+
+      disk_hits_total_->increment();
+      return executable;
+    }
+  }
+
+  misses_total_->increment();
+  return {};
+}
+
+/**
+ * Add a compiled executable to the cache (and the persistent store if enabled)
+ *
+ * @param digest The digest of the contract source
+ * @param executable The compiled executable (which must not be modified afterwards)
+ */
+void ExecutableCache::Add(Digest const &digest, ExecutablePtr const &executable)
+{
+  FETCH_LOCK(lock_);
+
+  if (entries_.find(digest) == entries_.end())
+  {
+    LocklessInsert(digest, executable);
+  }
+
+  if (archive_)
+  {
+    storage::ResourceID const rid{StorageKey(digest)};
+
+    try
+    {
+      if (!archive_->Has(rid))
+      {
+        archive_->Set(rid, *executable);
+        archive_->Flush(false);
+      }
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to persist executable: ", ex.what());
+    }
+  }
+}
+
+/**
+ * Remove all the executables from the memory cache
+ */
+void ExecutableCache::Reset()
+{
+  FETCH_LOCK(lock_);
+  entries_.clear();
+  lru_.clear();
+  size_in_bytes_ = 0;
+}
+
+std::size_t ExecutableCache::size() const
+{
+  FETCH_LOCK(lock_);
+  return entries_.size();
+}
+
+uint64_t ExecutableCache::size_in_bytes() const
+{
+  FETCH_LOCK(lock_);
+  return size_in_bytes_;
+}
+
+/**
+ * Estimate the memory footprint of an executable
+ *
+ * @param executable The executable to be evaluated
+ * @return The approximate size in bytes
+ */
+uint64_t ExecutableCache::EstimateSize(Executable const &executable)
+{
+  uint64_t size = sizeof(Executable) + ENTRY_OVERHEAD + executable.name.size();
+
+  for (auto const &str : executable.strings)
+  {
+    size += sizeof(str) + str.size();
+  }
+
+  size += executable.constants.size() * sizeof(vm::Variant);
+  size += executable.large_constants.size() * sizeof(Executable::LargeConstant);
+  size += executable.types.size() * sizeof(vm::TypeInfo);
+
+  for (auto const &function : executable.functions)
+  {
+    size += EstimateFunctionSize(function);
+  }
+
+  for (auto const &contract : executable.contracts)
+  {
+    size += sizeof(contract);
+    for (auto const &function : contract.functions)
+    {
+      size += EstimateFunctionSize(function);
+    }
+  }
+
+  for (auto const &type : executable.user_defined_types)
+  {
+    size += sizeof(type) + type.variables.size() * sizeof(Executable::Variable);
+    for (auto const &function : type.functions)
+    {
+      size += EstimateFunctionSize(function);
+    }
+  }
+
+  return size;
+}
+
+/**
+ * Insert an executable into the memory cache, evicting the least recently used entries as
+ * required (lock must be held)
+ *
+ * @param digest The digest of the contract source
+ * @param executable The compiled executable
+ */
+void ExecutableCache::LocklessInsert(Digest const &digest, ExecutablePtr const &executable)
+{
+  uint64_t const size = EstimateSize(*executable);
+
+  // executables which would exceed the whole budget are never cached in memory
+  if (size > max_bytes_)
+  {
+    return;
+  }
+
+  while (!lru_.empty() && ((size_in_bytes_ + size) > max_bytes_))
+  {
+    auto it = entries_.find(lru_.back());
+    assert(it != entries_.end());
+
+    size_in_bytes_ -= it->second.size;
+    entries_.erase(it);
+    lru_.pop_back();
+
+    evictions_total_->increment();
+  }
+
+  lru_.push_front(digest);
+  entries_[digest] = Entry{executable, size, lru_.begin()};
+  size_in_bytes_ += size;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -24,6 +24,7 @@
 #include "crypto/sha256.hpp"
 #include "ledger/chaincode/contract.hpp"
 #include "ledger/chaincode/contract_context.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
 #include "ledger/chaincode/smart_contract.hpp"
 #include "ledger/chaincode/smart_contract_exception.hpp"
 #include "ledger/chaincode/smart_contract_factory.hpp"
@@ -35,6 +36,8 @@
 #include "variant/variant.hpp"
 #include "variant/variant_utils.hpp"
 #include "vm/address.hpp"
+#include "vm/cached_io_observer.hpp"
+#include "vm/compiler.hpp"
 #include "vm/function_decorators.hpp"
 #include "vm/module.hpp"
 #include "vm/string.hpp"
@@ -105,7 +108,6 @@ constexpr char const *LOGGING_NAME = "SmartContract";
 SmartContract::SmartContract(std::string const &source)
   : source_{source}
   , digest_{fetch::crypto::Hash<fetch::crypto::SHA256>(ConstByteArray(source))}
-  , executable_{std::make_shared<Executable>()}
   , module_{VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS)}
 {
   if (source_.empty())
@@ -122,14 +124,33 @@ SmartContract::SmartContract(std::string const &source)
   module_->CreateFreeFunction(
       "getContext", [this](vm::VM *) -> vm_modules::ledger::ContextPtr { return context_; });
 
-  // create and compile the executable
-  fetch::vm::SourceFiles files  = {{"default.etch", source}};
-  auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable_);
+  // the module only builds its type and function tables when it is attached to a compiler. These
+  // are needed by the VM irrespective of whether the executable is compiled or taken from the cache
+  vm::Compiler const compiler{module_.get()};
 
-  // if there are any compilation errors
-  if (!errors.empty())
+  // the compiled executable only depends on the contract source, therefore it can be shared
+  // between all the instances of the same contract
+  auto &     cache            = ExecutableCache::Instance();
+  auto const num_system_types = static_cast<uint16_t>(module_->GetTypeInfoArray().size());
+
+  executable_ = cache.Lookup(digest_, num_system_types);
+
+  if (!executable_)
   {
-    throw SmartContractException(SmartContractException::Category::COMPILATION, std::move(errors));
+    // create and compile the executable
+    executable_ = std::make_shared<Executable>();
+
+    fetch::vm::SourceFiles files  = {{"default.etch", source}};
+    auto                   errors = vm_modules::VMFactory::Compile(module_, files, *executable_);
+
+    // if there are any compilation errors
+    if (!errors.empty())
+    {
+      throw SmartContractException(SmartContractException::Category::COMPILATION,
+                                   std::move(errors));
+    }
+
+    cache.Add(digest_, executable_);
   }
 
   // since we now have a fully compiled executable we can evaluate the functions and assign the
@@ -489,6 +510,9 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     container.convert(input_params);
   }
 
+  // state accesses of the action are cached and written back once it has been executed
+  vm::CachedIoObserver state_cache{state()};
+
   // Get clean VM instance
   auto vm = std::make_unique<vm::VM>(module_.get());
 
@@ -500,7 +524,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
 
   std::stringstream console;
   vm->AttachOutputDevice(vm::VM::STDOUT, console);
-  vm->SetIOObserver(state());
+  vm->SetIOObserver(state_cache);
 
   std::unordered_set<chain::Address> call_history{tx.contract_address()};
   vm::ContractInvocationHandler      contract_invocation_handler;
@@ -566,6 +590,9 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
                                 return loaded_contract->context_;
                               });
 
+    // the called contract has its own state scope and therefore its own cache
+    vm::CachedIoObserver called_state_cache{*c.state_adapter};
+
     vm::VM vm2{&module};
     loaded_contract->context_ =
         vm_modules::ledger::Context::Factory(&vm2, tx, context().block_index);
@@ -574,7 +601,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
 
     std::vector<std::string> errors{};
 
-    vm2.SetIOObserver(vm->GetIOObserver());
+    vm2.SetIOObserver(called_state_cache);
     vm2.SetContractInvocationHandler(contract_invocation_handler);
     vm2.AttachOutputDevice(fetch::vm::VM::STDOUT, vm->GetOutputDevice(fetch::vm::VM::STDOUT));
 
@@ -590,7 +617,7 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     ContractContextAttacher raii{*loaded_contract, ctx};
     c.state_adapter->PushContext(identity);
 
-    bool const success =
+    bool success =
         vm2.Execute(*loaded_contract->executable(), function.name, error, output, param_pack);
     if (!success)
     {
@@ -600,6 +627,16 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
       error = ss.str();
     }
 
+    // write back the state of the called contract while its scope is still active
+    if (called_state_cache.Flush() != vm::IoObserverInterface::Status::OK)
+    {
+      if (success)
+      {
+        error = "Failure of writing state of contract " + identity + " to the storage";
+      }
+      success = false;
+    }
+
     c.state_adapter->PopContext();
     vm->IncreaseChargeTotal(vm2.GetChargeTotal() - reference_charge);
 
@@ -655,6 +692,12 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
     status = Status::FAILED;
   }
 
+  if (state_cache.Flush() != vm::IoObserverInterface::Status::OK)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failure of writing state to the storage");
+    status = Status::FAILED;
+  }
+
   using ResponseType = int64_t;
   Result result{status};
   if (output.type_id == vm::TypeIds::Int64)
@@ -673,6 +716,9 @@ Contract::Result SmartContract::InvokeAction(std::string const &name, chain::Tra
 Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
                                            chain::Transaction const &tx)
 {
+  // state accesses of the init function are cached and written back once it has been executed
+  vm::CachedIoObserver state_cache{state()};
+
   // Get clean VM instance
   auto vm = std::make_unique<vm::VM>(module_.get());
 
@@ -684,7 +730,7 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
   // vm->SetChargeLimit(123);
   // vm->UpdateCharges({});
 
-  vm->SetIOObserver(state());
+  vm->SetIOObserver(state_cache);
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Running SC init function: ", init_fn_name_);
 
@@ -720,6 +766,12 @@ Contract::Result SmartContract::InvokeInit(chain::Address const &    owner,
     status = Status::FAILED;
   }
 
+  if (state_cache.Flush() != vm::IoObserverInterface::Status::OK)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failure of writing state to the storage");
+    status = Status::FAILED;
+  }
+
   using ResponseType = int64_t;
   int64_t return_value{-1};
   if (output.type_id == vm::TypeIds::Int64)
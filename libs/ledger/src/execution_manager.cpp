@@ -35,7 +35,9 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -43,6 +45,7 @@
 static constexpr char const *LOGGING_NAME              = "ExecutionManager";
 static constexpr std::size_t MAX_STARTUP_ITERATIONS    = 20;
 static constexpr std::size_t STARTUP_ITERATION_TIME_MS = 100;
+static constexpr std::size_t PREFETCH_SLICE_LOOKAHEAD  = 2;
 
 namespace fetch {
 namespace ledger {
@@ -53,13 +56,17 @@ using telemetry::Registry;
  * Constructs a execution manager instance
  *
  * @param num_executors The specified number of executors (and threads)
+ * @param prefetch_cache The optional cache (shared with the executors) used to prefetch state
  */
 ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes,
                                    StorageUnitPtr storage, ExecutorFactory const &factory,
-                                   TransactionStatusCache::ShrdPtr tx_status_cache)
+                                   TransactionStatusCache::ShrdPtr tx_status_cache,
+                                   PrefetchCachePtr                prefetch_cache)
   : log2_num_lanes_{log2_num_lanes}
   , storage_{std::move(storage)}
   , thread_pool_{network::MakeThreadPool(num_executors, "Executor")}
+  , prefetch_cache_{std::move(prefetch_cache)}
+  , prefetch_pool_{network::MakeThreadPool(1, "Prefetch")}
   , tx_status_cache_{std::move(tx_status_cache)}
   , tx_executed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_tx_executed_total", "The total number of executed transactions"))
@@ -203,8 +210,17 @@ bool ExecutionManager::PlanExecution(Block const &block)
 {
   FETCH_LOCK(execution_plan_lock_);
 
-  // clear and resize the execution plan
-  execution_plan_.clear();
+  // return the items of the previous plan to the pool, retaining the capacity of the slice plans
+  for (auto &slice_plan : execution_plan_)
+  {
+    for (auto &item : slice_plan)
+    {
+      item_pool_.push_back(std::move(item));
+    }
+
+    slice_plan.clear();
+  }
+
   execution_plan_.resize(block.slices.size());
 
   uint64_t slice_index = 0;
@@ -220,16 +236,152 @@ bool ExecutionManager::PlanExecution(Block const &block)
       assert((1u << log2_num_lanes_) == tx.mask().size());
 
       // insert the item into the execution plan
-      slice_plan.emplace_back(
-          std::make_unique<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask()));
+      if (item_pool_.empty())
+      {
+        slice_plan.emplace_back(std::make_unique<ExecutionItem>(tx.digest(), block.block_number,
+                                                                slice_index, tx.mask()));
+      }
+      else
+      {
+        slice_plan.emplace_back(std::move(item_pool_.back()));
+        item_pool_.pop_back();
+
+        slice_plan.back()->Reset(tx.digest(), block.block_number, slice_index, tx.mask());
+      }
     }
 
     ++slice_index;
   }
 
+  // build the dependency graph if the block is going to be scheduled with it
+  planned_mode_ = scheduling_mode_;
+
+  num_graph_nodes_ = 0;
+  graph_roots_.clear();
+
+  if (SchedulingMode::DEPENDENCY_GRAPH == planned_mode_)
+  {
+    BuildDependencyGraph();
+  }
+
+  // the cached state from the previous block is no longer valid, start warming up the cache with
+  // the first slices of this block
+  if (prefetch_cache_)
+  {
+    prefetch_cache_->Clear();
+
+    for (std::size_t i = 0; i < PREFETCH_SLICE_LOOKAHEAD; ++i)
+    {
+      SchedulePrefetch(i);
+    }
+  }
+
   return true;
 }
 
+/**
+ * Build the dependency graph for the current execution plan
+ *
+ * Each transaction depends on the latest preceding transaction (in slice order) on each of the
+ * lanes in its mask. Executing the transactions in any order consistent with these dependencies
+ * therefore presents each lane with the same sequence of transactions as slice by slice execution.
+ *
+ * Must be called with the `execution_plan_lock_` held
+ */
+void ExecutionManager::BuildDependencyGraph()
+{
+  static constexpr NodeIndex NO_NODE = std::numeric_limits<NodeIndex>::max();
+
+  std::size_t num_items{0};
+  for (auto const &slice_plan : execution_plan_)
+  {
+    num_items += slice_plan.size();
+  }
+
+  // the nodes are reused between blocks, the graph only being reallocated when it needs to grow
+  if (dependency_graph_.size() < num_items)
+  {
+    DependencyGraph graph(num_items);
+    dependency_graph_.swap(graph);
+  }
+
+  num_graph_nodes_ = num_items;
+
+  NodeIndexList last_node_on_lane(1u << log2_num_lanes_, NO_NODE);
+
+  NodeIndex index{0};
+  for (std::size_t slice = 0; slice < execution_plan_.size(); ++slice)
+  {
+    for (auto const &item : execution_plan_[slice])
+    {
+      auto &node = dependency_graph_[index];
+      node.item  = item.get();
+      node.slice = slice;
+      node.successors.clear();
+      node.pending = 0;
+
+      auto const &shards    = item->shards();
+      auto const  num_lanes = std::min(shards.size(), last_node_on_lane.size());
+
+      for (std::size_t lane = 0; lane < num_lanes; ++lane)
+      {
+        if (shards.bit(lane) == 0u)
+        {
+          continue;
+        }
+
+        auto &last_node = last_node_on_lane[lane];
+        if (NO_NODE != last_node)
+        {
+          auto &successors = dependency_graph_[last_node].successors;
+
+          // the predecessor might share more than one lane with this transaction
+          if (successors.empty() || (successors.back() != index))
+          {
+            successors.push_back(index);
+            ++node.pending;
+          }
+        }
+
+        last_node = index;
+      }
+
+      if (node.pending == 0)
+      {
+        graph_roots_.push_back(index);
+      }
+
+      ++index;
+    }
+  }
+}
+
+/**
+ * Schedule the prefetching of the resources for the specified slice of the execution plan
+ *
+ * Must be called with the `execution_plan_lock_` held
+ *
+ * @param slice_index The index of the slice to prefetch
+ */
+void ExecutionManager::SchedulePrefetch(std::size_t slice_index)
+{
+  if (!prefetch_cache_ || (slice_index >= execution_plan_.size()))
+  {
+    return;
+  }
+
+  StatePrefetchCache::Digests digests{};
+  digests.reserve(execution_plan_[slice_index].size());
+
+  for (auto const &item : execution_plan_[slice_index])
+  {
+    digests.push_back(item->digest());
+  }
+
+  auto cache = prefetch_cache_;
+  prefetch_pool_->Post([cache, digests]() { cache->Prefetch(digests); });
+}
+
 /**
  * Dispatches an execution item to the next available executor
  *
@@ -271,10 +423,7 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
                      " status: ", ledger::ToString(result.status));
     }
 
-    counters_.ApplyVoid([](auto &counters) {
-      --counters.active;
-      --counters.remaining;
-    });
+    counters_.ApplyVoid([](auto &counters) { --counters.active; });
 
     ++completed_executions_;
     tx_executed_count_->increment();
@@ -290,6 +439,58 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
   }
 }
 
+/**
+ * Dispatches the execution of a node of the dependency graph and then dispatches each of its
+ * successors which no longer has any outstanding predecessors
+ *
+ * This function should be called from a context of a thread pool
+ *
+ * @param index The index of the node to dispatch
+ */
+void ExecutionManager::DispatchNode(NodeIndex index)
+{
+  auto &node = dependency_graph_[index];
+
+  // once a slice has failed the block can not be completed, so there is no point executing any of
+  // the later slices. The earlier slices are still required to determine the final status
+  if (node.slice <= abort_slice_)
+  {
+    DispatchExecution(*node.item);
+
+    switch (Categorise(node.item->result().status))
+    {
+    case ExecutionStatusCategory::INTERNAL_ERROR:
+    case ExecutionStatusCategory::BLOCK_INVALIDATING_ERROR:
+    {
+      std::size_t current = abort_slice_;
+      while ((node.slice < current) && !abort_slice_.compare_exchange_weak(current, node.slice))
+      {
+      }
+      break;
+    }
+
+    case ExecutionStatusCategory::SUCCESS:
+    case ExecutionStatusCategory::NORMAL_ERROR:
+      break;
+    }
+  }
+
+  for (auto const successor : node.successors)
+  {
+    if (--dependency_graph_[successor].pending == 0)
+    {
+      auto self = shared_from_this();
+      thread_pool_->Post([self, successor]() {
+        telemetry::FunctionTimer const timer{*(self->execution_duration_)};
+        self->DispatchNode(successor);
+      });
+    }
+  }
+
+  // must be signalled last, since the graph can be replaced as soon as the block completes
+  counters_.ApplyVoid([](auto &counters) { --counters.remaining; });
+}
+
 /**
  * Starts the execution manager running
  */
@@ -318,6 +519,22 @@ void ExecutionManager::Start()
 
   // fire up the main worker thread pool
   thread_pool_->Start();
+  prefetch_pool_->Start();
+}
+
+/**
+ * Set the mode used to schedule the transactions of subsequent blocks
+ *
+ * @param mode The scheduling mode to be used
+ */
+void ExecutionManager::SetSchedulingMode(SchedulingMode mode)
+{
+  scheduling_mode_ = mode;
+}
+
+ExecutionManager::SchedulingMode ExecutionManager::scheduling_mode() const
+{
+  return scheduling_mode_;
 }
 
 /**
@@ -344,6 +561,7 @@ void ExecutionManager::Stop()
 
   // tear down the thread pool
   thread_pool_->Stop();
+  prefetch_pool_->Stop();
 }
 
 void ExecutionManager::SetLastProcessedBlock(Digest hash)
@@ -455,14 +673,42 @@ void ExecutionManager::MonitorThreadEntrypoint()
     {
       FETCH_LOCK(execution_plan_lock_);
 
-      slices_executed_count_->increment();
-
       if (execution_plan_.empty())
       {
+        slices_executed_count_->increment();
         monitor_state = MonitorState::SETTLE_FEES;
       }
+      else if (SchedulingMode::DEPENDENCY_GRAPH == planned_mode_)
+      {
+        *slices_executed_count_ += execution_plan_.size();
+
+        // the whole block is dispatched at once, each node dispatching its own successors
+        counters_.ApplyVoid([this](auto &counters) {
+          counters = Counters{0, num_graph_nodes_};
+        });
+        abort_slice_ = std::numeric_limits<std::size_t>::max();
+
+        auto self = shared_from_this();
+        for (auto const index : graph_roots_)
+        {
+          thread_pool_->Post([self, index]() {
+            telemetry::FunctionTimer const timer{*(self->execution_duration_)};
+            self->DispatchNode(index);
+          });
+        }
+
+        // any of the remaining slices might now be executing, so warm up all of them
+        for (std::size_t i = PREFETCH_SLICE_LOOKAHEAD; i < execution_plan_.size(); ++i)
+        {
+          SchedulePrefetch(i);
+        }
+
+        monitor_state = MonitorState::RUNNING;
+      }
       else
       {
+        slices_executed_count_->increment();
+
         auto const &slice_plan = execution_plan_[current_slice];
 
         // determine the target number of executions being expected (must be
@@ -478,9 +724,13 @@ void ExecutionManager::MonitorThreadEntrypoint()
           thread_pool_->Post([self, &item]() {
             telemetry::FunctionTimer const timer{*(self->execution_duration_)};
             self->DispatchExecution(*item);
+            self->counters_.ApplyVoid([](auto &counters) { --counters.remaining; });
           });
         }
 
+        // warm up the state for the upcoming slices while this one is executing
+        SchedulePrefetch(current_slice + PREFETCH_SLICE_LOOKAHEAD);
+
         monitor_state = MonitorState::RUNNING;
       }
 
@@ -502,83 +752,97 @@ void ExecutionManager::MonitorThreadEntrypoint()
       }
       else
       {
-        // evaluate the status of the executions
-        std::size_t num_complete{0};
-        std::size_t num_stalls{0};
-        std::size_t num_errors{0};
-        std::size_t num_fatal_errors{0};
-
-        // look through all execution items and determine if it was successful
-        for (auto const &item : execution_plan_[current_slice])
+        // in dependency graph mode the whole block has been executed, however the slices are still
+        // evaluated in order so that the outcome matches slice by slice execution
+        std::size_t const last_slice = (SchedulingMode::DEPENDENCY_GRAPH == planned_mode_)
+                                           ? execution_plan_.size()
+                                           : current_slice + 1;
+
+        bool evaluate{true};
+        while (evaluate)
         {
-          assert(item);
-
-          switch (Categorise(item->result().status))
+          // evaluate the status of the executions
+          std::size_t num_complete{0};
+          std::size_t num_stalls{0};
+          std::size_t num_errors{0};
+          std::size_t num_fatal_errors{0};
+
+          // look through all execution items and determine if it was successful
+          for (auto const &item : execution_plan_[current_slice])
           {
-          case ExecutionStatusCategory::SUCCESS:
-            ++num_complete;
-            break;
-
-          case ExecutionStatusCategory::NORMAL_ERROR:
-            ++num_errors;
-            break;
-
-          case ExecutionStatusCategory::INTERNAL_ERROR:
-            ++num_stalls;
-            break;
+            assert(item);
+
+            switch (Categorise(item->result().status))
+            {
+            case ExecutionStatusCategory::SUCCESS:
+              ++num_complete;
+              break;
+
+            case ExecutionStatusCategory::NORMAL_ERROR:
+              ++num_errors;
+              break;
+
+            case ExecutionStatusCategory::INTERNAL_ERROR:
+              ++num_stalls;
+              break;
+
+            case ExecutionStatusCategory::BLOCK_INVALIDATING_ERROR:
+            default:
+              ++num_fatal_errors;
+              break;
+            }
+
+            // update aggregate fees
+            aggregate_block_fees += item->fee();
+            item->AggregateStakeUpdates(aggregated_stake_events);
+
+            if (tx_status_cache_)
+            {
+              tx_status_cache_->Update(item->digest(), item->result());
+            }
+          }
 
-          case ExecutionStatusCategory::BLOCK_INVALIDATING_ERROR:
-          default:
-            ++num_fatal_errors;
-            break;
+          // only provide debug if required
+          if ((num_complete + num_stalls + num_errors + num_fatal_errors) != 0u)
+          {
+            if ((num_stalls + num_errors + num_fatal_errors) != 0u)
+            {
+              FETCH_LOG_WARN(LOGGING_NAME, "Slice ", current_slice,
+                             " Execution Status - Complete: ", num_complete,
+                             " Stalls: ", num_stalls, " Errors: ", num_errors,
+                             " Fatal Errors: ", num_fatal_errors);
+            }
+            else
+            {
+              FETCH_LOG_DEBUG(LOGGING_NAME, "Slice ", current_slice,
+                              " Execution Status - Complete: ", num_complete,
+                              " Stalls: ", num_stalls, " Errors: ", num_errors);
+            }
           }
 
-          // update aggregate fees
-          aggregate_block_fees += item->fee();
-          item->AggregateStakeUpdates(aggregated_stake_events);
+          // increment the slice counter
+          ++current_slice;
 
-          if (tx_status_cache_)
+          // decide the next monitor state based on the status of the slice execution
+          if (num_fatal_errors != 0u)
           {
-            tx_status_cache_->Update(item->digest(), item->result());
+            monitor_state = MonitorState::FAILED;
           }
-        }
-
-        // only provide debug if required
-        if ((num_complete + num_stalls + num_errors + num_fatal_errors) != 0u)
-        {
-          if ((num_stalls + num_errors + num_fatal_errors) != 0u)
+          else if (num_stalls != 0u)
+          {
+            monitor_state = MonitorState::STALLED;
+          }
+          else if (num_slices_ > current_slice)
           {
-            FETCH_LOG_WARN(LOGGING_NAME, "Slice ", current_slice,
-                           " Execution Status - Complete: ", num_complete, " Stalls: ", num_stalls,
-                           " Errors: ", num_errors, " Fatal Errors: ", num_fatal_errors);
+            monitor_state = MonitorState::SCHEDULE_NEXT_SLICE;
           }
           else
           {
-            FETCH_LOG_DEBUG(LOGGING_NAME, "Slice ", current_slice,
-                            " Execution Status - Complete: ", num_complete, " Stalls: ", num_stalls,
-                            " Errors: ", num_errors);
+            monitor_state = MonitorState::SETTLE_FEES;
           }
-        }
-
-        // increment the slice counter
-        ++current_slice;
 
-        // decide the next monitor state based on the status of the slice execution
-        if (num_fatal_errors != 0u)
-        {
-          monitor_state = MonitorState::FAILED;
-        }
-        else if (num_stalls != 0u)
-        {
-          monitor_state = MonitorState::STALLED;
-        }
-        else if (num_slices_ > current_slice)
-        {
-          monitor_state = MonitorState::SCHEDULE_NEXT_SLICE;
-        }
-        else
-        {
-          monitor_state = MonitorState::SETTLE_FEES;
+          evaluate = (MonitorState::SCHEDULE_NEXT_SLICE == monitor_state) &&
+                     (current_slice < last_slice);
         }
       }
       break;
@@ -54,6 +54,8 @@ namespace ledger {
  */
 Executor::Executor(StorageUnitPtr storage)
   : storage_{std::move(storage)}
+  , current_tx_{std::make_shared<chain::Transaction>()}
+  , storage_cache_{std::make_shared<CachedStorageAdapter>(*storage_)}
   , tx_validator_{*storage_, token_contract_}
   , fee_manager_{token_contract_, "ledger_executor_deduct_fees_duration"}
   , overall_duration_{Registry::Instance().LookupMeasurement<Histogram>(
@@ -106,8 +108,9 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
     result.charge_rate  = current_tx_->charge_rate();
     result.charge_limit = current_tx_->charge_limit();
 
-    // create the storage cache
-    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
+    // the storage cache is reused between transactions, however it must not serve any values
+    // cached during a previous execution since they might have been updated since
+    storage_cache_->Clear();
 
     // follow the three step process for executing a transaction
     //
@@ -187,10 +190,7 @@ bool Executor::RetrieveTransaction(Digest const &digest)
 
   try
   {
-    // create a new transaction
-    current_tx_ = std::make_unique<chain::Transaction>();
-
-    // load the transaction from the store
+    // load the transaction from the store (reusing the previous transaction object)
     success = storage_->GetTransaction(digest, *current_tx_);
   }
   catch (std::exception const &ex)
@@ -27,6 +27,7 @@ namespace {
 
 using BlocksPromise     = MainChainRpcClient::BlocksPromise;
 using TraveloguePromise = MainChainRpcClient::TraveloguePromise;
+using DigestsPromise    = MainChainRpcClient::DigestsPromise;
 
 }  // namespace
 
@@ -59,5 +60,23 @@ TraveloguePromise MainChainRpcClient::TimeTravel(MuddleAddress peer, Digest star
   return TraveloguePromise{promise};
 }
 
+DigestsPromise MainChainRpcClient::TimeTravelDigests(MuddleAddress peer, Digest start,
+                                                     uint64_t limit)
+{
+  auto promise = rpc_client_.CallSpecificAddress(
+      peer, RPC_MAIN_CHAIN, MainChainProtocol::TIME_TRAVEL_DIGESTS, start, limit);
+
+  return DigestsPromise{promise};
+}
+
+TraveloguePromise MainChainRpcClient::TimeTravelRange(MuddleAddress peer, Digest start,
+                                                      uint64_t limit)
+{
+  auto promise = rpc_client_.CallSpecificAddress(
+      peer, RPC_MAIN_CHAIN, MainChainProtocol::TIME_TRAVEL_RANGE, start, limit);
+
+  return TraveloguePromise{promise};
+}
+
 }  // namespace ledger
 }  // namespace fetch
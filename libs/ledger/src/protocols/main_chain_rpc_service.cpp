@@ -38,9 +38,12 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -56,6 +59,7 @@ using State                  = MainChainRpcService::State;
 using Mode                   = MainChainRpcService::Mode;
 
 constexpr uint64_t MAX_SENSIBLE_STEP_BACK = 10000;
+constexpr uint64_t RANGE_POLL_INTERVAL_MS = 10;
 
 }  // namespace
 
@@ -108,6 +112,24 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   , state_complete_sync_with_peer_{telemetry::Registry::Instance().CreateCounter(
         "ledger_mainchain_service_state_complete_sync_with_peer_total",
         "The number of times in the complete sync with peer state")}
+  , state_request_headers_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_request_headers_total",
+        "The number of times in the request headers state")}
+  , state_wait_for_headers_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_wait_for_headers_total",
+        "The number of times in the wait for headers state")}
+  , state_request_block_ranges_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_request_block_ranges_total",
+        "The number of times in the request block ranges state")}
+  , state_wait_for_block_ranges_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_state_wait_for_block_ranges_total",
+        "The number of times in the wait for block ranges state")}
+  , sync_range_failures_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_sync_range_failures_total",
+        "The number of block range requests which failed or returned unexpected blocks")}
+  , sync_range_blocks_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mainchain_service_sync_range_blocks_total",
+        "The number of blocks retrieved through block range requests")}
   , state_current_{telemetry::Registry::Instance().CreateGauge<uint32_t>(
         "ledger_mainchain_service_state",
         "The number of times in the complete sync with peer state")}
@@ -128,6 +150,10 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
   state_machine_->RegisterHandler(State::REQUEST_NEXT_BLOCKS,     this, &MainChainRpcService::OnRequestNextSetOfBlocks);
   state_machine_->RegisterHandler(State::WAIT_FOR_NEXT_BLOCKS,    this, &MainChainRpcService::OnWaitForBlocks);
   state_machine_->RegisterHandler(State::COMPLETE_SYNC_WITH_PEER, this, &MainChainRpcService::OnCompleteSyncWithPeer);
+  state_machine_->RegisterHandler(State::REQUEST_HEADERS,         this, &MainChainRpcService::OnRequestHeaders);
+  state_machine_->RegisterHandler(State::WAIT_FOR_HEADERS,        this, &MainChainRpcService::OnWaitForHeaders);
+  state_machine_->RegisterHandler(State::REQUEST_BLOCK_RANGES,    this, &MainChainRpcService::OnRequestBlockRanges);
+  state_machine_->RegisterHandler(State::WAIT_FOR_BLOCK_RANGES,   this, &MainChainRpcService::OnWaitForBlockRanges);
   // clang-format on
 
   state_machine_->OnStateChange([](State current, State previous) {
@@ -319,6 +345,13 @@ State MainChainRpcService::OnSynchronising()
   if (!current_peer_address_.empty())
   {
     next_state = State::START_SYNC_WITH_PEER;
+
+    // the parallel sync is only worthwhile when there are several peers to share the work
+    if ((SyncMode::MULTI_PEER == sync_mode_) &&
+        (endpoint_.GetDirectlyConnectedPeers().size() > 1))
+    {
+      next_state = State::REQUEST_HEADERS;
+    }
   }
 
   return next_state;
@@ -365,13 +398,7 @@ State MainChainRpcService::OnStartSyncWithPeer()
   state_start_sync_with_peer_->increment();
   state_current_->set(static_cast<uint32_t>(State::START_SYNC_WITH_PEER));
 
-  // we always start a sync from the block 1 behind our heaviest block (except in the case of
-  // genesis)
-  block_resolving_ = chain_.GetHeaviestBlock();
-  if (!block_resolving_->IsGenesis())
-  {
-    block_resolving_ = chain_.GetBlock(block_resolving_->previous_hash);
-  }
+  block_resolving_ = GetSyncStartBlock();
 
   if (block_resolving_ && !current_peer_address_.empty())
   {
@@ -509,9 +536,223 @@ State MainChainRpcService::OnCompleteSyncWithPeer()
   block_resolving_      = {};
   consecutive_failures_ = 0;
 
+  ResetBlockRanges();
+
   return State::SYNCHRONISED;
 }
 
+State MainChainRpcService::OnRequestHeaders()
+{
+  state_request_headers_->increment();
+  state_current_->set(static_cast<uint32_t>(State::REQUEST_HEADERS));
+
+  ResetBlockRanges();
+
+  block_resolving_ = GetSyncStartBlock();
+  if (!(block_resolving_ && !current_peer_address_.empty()))
+  {
+    return State::COMPLETE_SYNC_WITH_PEER;
+  }
+
+  // the chain has no separate header type, so the block digests serve as the headers
+  sync_base_hash_  = block_resolving_->hash;
+  current_request_ = rpc_client_
+                         .TimeTravelDigests(current_peer_address_, sync_base_hash_,
+                                            MainChain::DIGEST_UPPER_BOUND)
+                         .GetInnerPromise();
+
+  return State::WAIT_FOR_HEADERS;
+}
+
+State MainChainRpcService::OnWaitForHeaders()
+{
+  state_wait_for_headers_->increment();
+  state_current_->set(static_cast<uint32_t>(State::WAIT_FOR_HEADERS));
+
+  if (!current_request_)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "State machine error. Restarting sync");
+
+    state_machine_->Delay(std::chrono::milliseconds{500});
+    return State::COMPLETE_SYNC_WITH_PEER;
+  }
+
+  switch (current_request_->state())
+  {
+  case PromiseState::WAITING:
+    state_machine_->Delay(std::chrono::milliseconds{RANGE_POLL_INTERVAL_MS});
+    return State::WAIT_FOR_HEADERS;
+
+  case PromiseState::FAILED:
+  case PromiseState::TIMEDOUT:
+    // the single peer sync has its own retry policy
+    current_request_ = {};
+    return State::START_SYNC_WITH_PEER;
+
+  case PromiseState::SUCCESS:;
+  }
+
+  healthy_ = true;
+
+  BlockHashes digests{};
+  bool const  success = current_request_->GetResult(digests);
+  current_request_    = {};
+
+  // An empty response means either that we are already at the tip of the peer or that the peer is
+  // on a different fork. In both cases the single peer sync is the appropriate way to proceed.
+  if (!success || digests.empty())
+  {
+    return State::START_SYNC_WITH_PEER;
+  }
+
+  sync_digests_ = std::move(digests);
+
+  // select the peers which will serve the ranges, starting with the peer that sent the headers
+  sync_peers_.push_back(current_peer_address_);
+  for (auto const &peer : endpoint_.GetDirectlyConnectedPeers())
+  {
+    if (sync_peers_.size() >= MAX_SYNC_PEERS)
+    {
+      break;
+    }
+
+    if (peer != current_peer_address_)
+    {
+      sync_peers_.push_back(peer);
+    }
+  }
+
+  // split the digests into ranges
+  for (std::size_t offset = 0; offset < sync_digests_.size(); offset += BLOCK_RANGE_SIZE)
+  {
+    BlockRange range{};
+    range.offset = offset;
+    range.length = std::min(BLOCK_RANGE_SIZE, sync_digests_.size() - offset);
+
+    pending_ranges_.emplace(offset, std::move(range));
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Syncing ", sync_digests_.size(), " blocks from ",
+                 sync_peers_.size(), " peers in ", pending_ranges_.size(), " ranges");
+
+  return State::REQUEST_BLOCK_RANGES;
+}
+
+State MainChainRpcService::OnRequestBlockRanges()
+{
+  state_request_block_ranges_->increment();
+  state_current_->set(static_cast<uint32_t>(State::REQUEST_BLOCK_RANGES));
+
+  // count the number of outstanding requests for each of the peers
+  std::map<Address, std::size_t> requests_per_peer{};
+  for (auto const &range : requested_ranges_)
+  {
+    ++requests_per_peer[range.peer];
+  }
+
+  // share the pending ranges between the peers one at a time, limiting the number of blocks which
+  // can be buffered ahead of the next range to be added to the chain
+  bool dispatched{true};
+  while (dispatched && !pending_ranges_.empty())
+  {
+    dispatched = false;
+
+    for (auto const &peer : sync_peers_)
+    {
+      if (pending_ranges_.empty() ||
+          (pending_ranges_.begin()->first >= next_range_offset_ + MAX_BUFFERED_BLOCKS))
+      {
+        break;
+      }
+
+      if ((sync_peer_failures_[peer] >= MAX_PEER_FAILURES) ||
+          (requests_per_peer[peer] >= MAX_RANGES_PER_PEER))
+      {
+        continue;
+      }
+
+      BlockRange range = std::move(pending_ranges_.begin()->second);
+      pending_ranges_.erase(pending_ranges_.begin());
+
+      BlockHash const &start =
+          (range.offset == 0) ? sync_base_hash_ : sync_digests_[range.offset - 1];
+
+      range.peer    = peer;
+      range.request = rpc_client_.TimeTravelRange(peer, start, range.length).GetInnerPromise();
+
+      requested_ranges_.emplace_back(std::move(range));
+      ++requests_per_peer[peer];
+      dispatched = true;
+    }
+  }
+
+  // if none of the peers are able to serve the remaining ranges then give up on this sync, the
+  // periodic resync will resume from the blocks that have been added so far
+  if (requested_ranges_.empty())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to request the remaining block ranges. Aborting sync");
+    return State::COMPLETE_SYNC_WITH_PEER;
+  }
+
+  return State::WAIT_FOR_BLOCK_RANGES;
+}
+
+State MainChainRpcService::OnWaitForBlockRanges()
+{
+  state_wait_for_block_ranges_->increment();
+  state_current_->set(static_cast<uint32_t>(State::WAIT_FOR_BLOCK_RANGES));
+
+  bool updated{false};
+
+  for (auto it = requested_ranges_.begin(); it != requested_ranges_.end();)
+  {
+    auto const status = it->request->state();
+    if (PromiseState::WAITING == status)
+    {
+      ++it;
+      continue;
+    }
+
+    BlockRange range = std::move(*it);
+    it               = requested_ranges_.erase(it);
+    updated          = true;
+
+    if ((PromiseState::SUCCESS != status) || !HandleRangeResponse(range))
+    {
+      sync_range_failures_->increment();
+      ++sync_peer_failures_[range.peer];
+
+      // reschedule the range, it will be requested ahead of any later ranges
+      range.peer    = {};
+      range.request = {};
+      pending_ranges_.emplace(range.offset, std::move(range));
+    }
+  }
+
+  if (!updated)
+  {
+    state_machine_->Delay(std::chrono::milliseconds{RANGE_POLL_INTERVAL_MS});
+    return State::WAIT_FOR_BLOCK_RANGES;
+  }
+
+  healthy_ = true;
+
+  ApplyCompletedRanges();
+
+  if (next_range_offset_ < sync_digests_.size())
+  {
+    return State::REQUEST_BLOCK_RANGES;
+  }
+
+  // when the headers were truncated there are further blocks to be synced from the new tip
+  if (sync_digests_.size() >= MainChain::DIGEST_UPPER_BOUND)
+  {
+    return State::REQUEST_HEADERS;
+  }
+
+  return State::COMPLETE_SYNC_WITH_PEER;
+}
+
 bool MainChainRpcService::ValidBlock(Block const &block) const
 {
   return !consensus_ || consensus_->ValidBlock(block) == ConsensusInterface::Status::YES;
@@ -577,6 +818,128 @@ State MainChainRpcService::WalkBack()
   return State::REQUEST_NEXT_BLOCKS;
 }
 
+/**
+ * Determine the block from which a sync is started. This is always one block behind our heaviest
+ * block (except in the case of genesis)
+ *
+ * @return The block to sync from
+ */
+BlockPtr MainChainRpcService::GetSyncStartBlock() const
+{
+  auto block = chain_.GetHeaviestBlock();
+  if (!block->IsGenesis())
+  {
+    block = chain_.GetBlock(block->previous_hash);
+  }
+
+  return block;
+}
+
+/**
+ * Validate the response to a block range request against the sync digests. When the peer only
+ * returns the beginning of the range, the remainder is rescheduled as a new range.
+ *
+ * @param range The completed block range request
+ * @return true if at least one of the expected blocks was returned, otherwise false
+ */
+bool MainChainRpcService::HandleRangeResponse(BlockRange &range)
+{
+  MainChainProtocol::Travelogue log{};
+  if (!range.request->GetResult(log))
+  {
+    return false;
+  }
+
+  // determine how many of the returned blocks match the expected digests
+  std::size_t const num_blocks = std::min(range.length, log.blocks.size());
+
+  std::size_t matched{0};
+  for (; matched < num_blocks; ++matched)
+  {
+    auto &block = log.blocks[matched];
+    block->UpdateDigest();
+
+    if (block->hash != sync_digests_[range.offset + matched])
+    {
+      break;
+    }
+  }
+
+  if (matched == 0)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Unexpected block range #", range.offset, " from muddle://",
+                    ToBase64(range.peer));
+    return false;
+  }
+
+  sync_range_blocks_->add(matched);
+
+  if (matched < range.length)
+  {
+    BlockRange remainder{};
+    remainder.offset = range.offset + matched;
+    remainder.length = range.length - matched;
+
+    pending_ranges_.emplace(remainder.offset, std::move(remainder));
+  }
+
+  log.blocks.resize(matched);
+
+  range.length  = matched;
+  range.blocks  = std::move(log.blocks);
+  range.request = {};
+
+  completed_ranges_.emplace(range.offset, std::move(range));
+
+  return true;
+}
+
+/**
+ * Add the completed ranges to the chain, in order, for as long as there are no gaps
+ */
+void MainChainRpcService::ApplyCompletedRanges()
+{
+  for (auto it = completed_ranges_.begin();
+       (it != completed_ranges_.end()) && (it->first == next_range_offset_);
+       it = completed_ranges_.erase(it))
+  {
+    auto &range = it->second;
+
+    HandleChainResponse(range.peer, range.blocks.begin(), range.blocks.end());
+    next_range_offset_ += range.length;
+  }
+}
+
+/**
+ * Clear all the state associated with the multi-peer sync
+ */
+void MainChainRpcService::ResetBlockRanges()
+{
+  sync_base_hash_ = {};
+  sync_digests_.clear();
+  sync_peers_.clear();
+  sync_peer_failures_.clear();
+  pending_ranges_.clear();
+  requested_ranges_.clear();
+  completed_ranges_.clear();
+  next_range_offset_ = 0;
+}
+
+/**
+ * Set the mode used to synchronise the chain with peers
+ *
+ * @param mode The sync mode to be used
+ */
+void MainChainRpcService::SetSyncMode(SyncMode mode)
+{
+  sync_mode_ = mode;
+}
+
+MainChainRpcService::SyncMode MainChainRpcService::sync_mode() const
+{
+  return sync_mode_;
+}
+
 /**
  * Return whether the service is healthy or not. Currently it is considered
  * healthy when it has made at least one successful RPC call to a peer
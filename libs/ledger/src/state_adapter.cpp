@@ -137,6 +137,90 @@ StateAdapter::Status StateAdapter::Exists(std::string const &key)
   return Status::OK;
 }
 
+/**
+ * Read a series of values from the state store with a single batched storage request
+ *
+ * @param keys The keys to be accessed
+ * @param values The status and, if successful, the value of each key in the order of the keys
+ */
+void StateAdapter::ReadMany(Keys const &keys, Values &values)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "ReadMany: ", keys.size(), " keys");
+
+  auto const scope = CurrentScope();
+
+  StorageInterface::Addresses addresses{};
+  addresses.reserve(keys.size());
+  for (auto const &key : keys)
+  {
+    addresses.emplace_back(CreateAddress(scope, key));
+  }
+
+  auto const documents = storage_.GetMany(addresses);
+
+  values.clear();
+  values.reserve(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if ((i < documents.size()) && !documents[i].failed)
+    {
+      values.emplace_back(Status::OK, documents[i].document);
+    }
+    else
+    {
+      values.emplace_back(Status::ERROR, ConstByteArray{});
+    }
+  }
+}
+
+/**
+ * Write a series of values to the state store with a single batched storage request
+ *
+ * @param values The key value pairs to be written
+ * @return OK if the writes were successful, PERMISSION_DENIED if the adapter is read only
+ */
+StateAdapter::Status StateAdapter::WriteMany(KeyValuePairs const &values)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "WriteMany: ", values.size(), " values");
+
+  // early exit if we do not have permission to write to the storage interface
+  if (Mode::READ_WRITE != mode_)
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  auto const scope = CurrentScope();
+
+  StorageInterface::KeyValuePairs storage_values{};
+  storage_values.reserve(values.size());
+  for (auto const &value : values)
+  {
+    storage_values.emplace_back(CreateAddress(scope, value.first), value.second);
+  }
+
+  storage_.SetMany(storage_values);
+
+  return Status::OK;
+}
+
+/**
+ * Check a write which is buffered by a write-back cache
+ *
+ * @param key The key to be accessed
+ * @param size The size in bytes of the value to be written
+ * @return OK if the write is permitted, PERMISSION_DENIED if the adapter is read only
+ */
+StateAdapter::Status StateAdapter::CheckWrite(std::string const & /*key*/, uint64_t /*size*/)
+{
+  // early exit if we do not have permission to write to the storage interface
+  if (Mode::READ_WRITE != mode_)
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  return Status::OK;
+}
+
 /**
  * Creates a scoped address from a string based key
  *
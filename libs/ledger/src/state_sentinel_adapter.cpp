@@ -20,7 +20,9 @@
 #include "logging/logging.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <cstddef>
 #include <string>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -145,6 +147,137 @@ StateSentinelAdapter::Status StateSentinelAdapter::Exists(std::string const &key
   return StateAdapter::Exists(key);
 }
 
+/**
+ * Read a series of values from the state store. Keys on shards which are not permitted are
+ * reported as such and the remaining keys are fetched in a single batch.
+ *
+ * @param keys The keys to be accessed
+ * @param values The status and, if successful, the value of each key in the order of the keys
+ */
+void StateSentinelAdapter::ReadMany(Keys const &keys, Values &values)
+{
+  Keys allowed_keys{};
+  allowed_keys.reserve(keys.size());
+  for (auto const &key : keys)
+  {
+    if (IsAllowedResource(key))
+    {
+      allowed_keys.push_back(key);
+    }
+  }
+
+  // proxy the call the the state adapter
+  Values allowed_values{};
+  StateAdapter::ReadMany(allowed_keys, allowed_values);
+
+  values.clear();
+  values.reserve(keys.size());
+
+  std::size_t allowed_index{0};
+  for (auto const &key : keys)
+  {
+    if ((allowed_index < allowed_keys.size()) && (allowed_keys[allowed_index] == key))
+    {
+      auto &value = allowed_values[allowed_index++];
+
+      // update the counters
+      if (Status::OK == value.first)
+      {
+        bytes_read_ += value.second.size();
+      }
+
+      ++lookups_;
+
+      values.emplace_back(std::move(value));
+    }
+    else
+    {
+      values.emplace_back(Status::PERMISSION_DENIED, ConstByteArray{});
+    }
+  }
+}
+
+/**
+ * Write a series of values to the state store. No values are written if any of the keys is on a
+ * shard which is not permitted.
+ *
+ * @param values The key value pairs to be written
+ * @return OK if the writes were successful, PERMISSION_DENIED if a key is not permitted
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::WriteMany(KeyValuePairs const &values)
+{
+  for (auto const &value : values)
+  {
+    if (!IsAllowedResource(value.first))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to write to resource: ",
+                     CreateAddress(CurrentScope(), value.first).address());
+      return Status::PERMISSION_DENIED;
+    }
+  }
+
+  // proxy call to the state adapter
+  auto const status = StateAdapter::WriteMany(values);
+
+  // update the counters
+  if (Status::OK == status)
+  {
+    for (auto const &value : values)
+    {
+      bytes_written_ += value.second.size();
+    }
+  }
+
+  lookups_ += values.size();
+
+  return status;
+}
+
+/**
+ * Check a write which is buffered by a write-back cache. The write is accounted for as if it had
+ * been written, so that the counters do not depend on whether the writes are cached.
+ *
+ * @param key The key to be accessed
+ * @param size The size in bytes of the value to be written
+ * @return OK if the write is permitted, PERMISSION_DENIED if the key is incorrect
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::CheckWrite(std::string const &key,
+                                                              uint64_t           size)
+{
+  if (!IsAllowedResource(key))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME,
+                   "Unable to write to resource: ", CreateAddress(CurrentScope(), key).address());
+    return Status::PERMISSION_DENIED;
+  }
+
+  // proxy call to the state adapter
+  auto const status = StateAdapter::CheckWrite(key, size);
+
+  // update the counters
+  if (Status::OK == status)
+  {
+    bytes_written_ += size;
+  }
+
+  ++lookups_;
+
+  return status;
+}
+
+/**
+ * Write back a series of values which have all been accepted by CheckWrite. The values are
+ * neither checked nor counted again.
+ *
+ * @param values The key value pairs to be written
+ * @return OK if the writes were successful, otherwise the status reported by the state adapter
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::CommitMany(KeyValuePairs const &values)
+{
+  // proxy call to the state adapter
+  return StateAdapter::WriteMany(values);
+}
+
 /**
  * Check whether the resource being requested is allowed
  *
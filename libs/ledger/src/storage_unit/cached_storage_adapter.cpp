@@ -43,17 +43,24 @@ CachedStorageAdapter::~CachedStorageAdapter() = default;
 void CachedStorageAdapter::Flush()
 {
   cache_.ApplyVoid([this](auto &cache) {
+    KeyValuePairs values{};
+
     for (auto &entry : cache)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        values.emplace_back(entry.first, entry.second.value);
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
+
+    // set all the dirty values on the storage engine in a single batch
+    if (!values.empty())
+    {
+      storage_.SetMany(values);
+    }
   });
 }
 
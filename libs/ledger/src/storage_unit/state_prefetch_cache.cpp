@@ -0,0 +1,435 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/address.hpp"
+#include "ledger/storage_unit/state_prefetch_cache.hpp"
+#include "logging/logging.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
+#include "telemetry/utils/timer.hpp"
+
+#include <exception>
+#include <unordered_set>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using telemetry::Registry;
+
+constexpr char const *LOGGING_NAME = "StatePrefetchCache";
+
+/**
+ * Create the address of the token wallet record for the specified address
+ *
+ * @param address The address of the wallet
+ * @return The resource address of the wallet record
+ */
+storage::ResourceAddress CreateWalletAddress(chain::Address const &address)
+{
+  return storage::ResourceAddress{"fetch.token.state." + address.display()};
+}
+
+}  // namespace
+
+/**
+ * Construct the prefetch cache
+ *
+ * @param storage The underlying storage unit
+ */
+StatePrefetchCache::StatePrefetchCache(StorageUnitPtr storage)
+  : storage_{std::move(storage)}
+  , state_hit_count_{Registry::Instance().CreateCounter(
+        "ledger_executor_prefetch_state_hit_total",
+        "The total number of state lookups served from the prefetch cache")}
+  , state_miss_count_{Registry::Instance().CreateCounter(
+        "ledger_executor_prefetch_state_miss_total",
+        "The total number of state lookups not present in the prefetch cache")}
+  , tx_hit_count_{Registry::Instance().CreateCounter(
+        "ledger_executor_prefetch_tx_hit_total",
+        "The total number of transaction lookups served from the prefetch cache")}
+  , tx_miss_count_{Registry::Instance().CreateCounter(
+        "ledger_executor_prefetch_tx_miss_total",
+        "The total number of transaction lookups not present in the prefetch cache")}
+  , prefetch_duration_{Registry::Instance().CreateHistogram(
+        {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
+         0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
+         0.0001,   0.0002,   0.0003,   0.0004,   0.0005,   0.0006,   0.0007,   0.0008,   0.0009,
+         0.001,    0.01,     0.1,      1,        10.,      100.},
+        "ledger_executor_prefetch_duration",
+        "The duration in seconds for prefetching the resources of a set of transactions")}
+{}
+
+/**
+ * Pull the specified transactions and the state records that they declare into the cache
+ *
+ * This is intended to be called from a background thread while other transactions are being
+ * executed. Any values which are already present in the cache (because they have been read or
+ * written in the meantime) are never overwritten.
+ *
+ * @param digests The set of transaction digests to be prefetched
+ */
+void StatePrefetchCache::Prefetch(Digests const &digests)
+{
+  telemetry::FunctionTimer const timer{*prefetch_duration_};
+
+  auto const generation = CurrentGeneration();
+
+  std::unordered_set<ResourceAddress> unique_addresses{};
+
+  for (auto const &digest : digests)
+  {
+    chain::Transaction tx{};
+
+    bool present{false};
+    {
+      FETCH_LOCK(lock_);
+
+      auto it = transactions_.find(digest);
+      if (it != transactions_.end())
+      {
+        tx      = it->second;
+        present = true;
+      }
+    }
+
+    if (!present)
+    {
+      try
+      {
+        if (!storage_->GetTransaction(digest, tx))
+        {
+          continue;
+        }
+      }
+      catch (std::exception const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Unable to prefetch transaction: ", ex.what());
+        continue;
+      }
+
+      FETCH_LOCK(lock_);
+
+      // the cache has been cleared in the meantime, the prefetch is now stale
+      if (generation != generation_)
+      {
+        return;
+      }
+
+      transactions_.emplace(digest, tx);
+    }
+
+    // collect the resources that are declared by the transaction
+    unique_addresses.emplace(CreateWalletAddress(tx.from()));
+    for (auto const &transfer : tx.transfers())
+    {
+      unique_addresses.emplace(CreateWalletAddress(transfer.to));
+    }
+  }
+
+  // filter out the resources which are already present in the cache
+  Addresses addresses{};
+  {
+    FETCH_LOCK(lock_);
+
+    for (auto const &address : unique_addresses)
+    {
+      if (documents_.find(address) == documents_.end())
+      {
+        addresses.push_back(address);
+      }
+    }
+  }
+
+  if (addresses.empty())
+  {
+    return;
+  }
+
+  // make a single batched request for all the missing resources
+  auto const documents = storage_->GetMany(addresses);
+
+  for (std::size_t i = 0; i < addresses.size(); ++i)
+  {
+    InsertDocument(addresses[i], documents[i], generation);
+  }
+}
+
+/**
+ * Clear the contents of the cache
+ */
+void StatePrefetchCache::Clear()
+{
+  FETCH_LOCK(lock_);
+  documents_.clear();
+  transactions_.clear();
+  ++generation_;
+}
+
+StatePrefetchCache::Document StatePrefetchCache::Get(ResourceAddress const &key) const
+{
+  Document doc{};
+  if (LookupDocument(key, doc))
+  {
+    return doc;
+  }
+
+  auto const generation = CurrentGeneration();
+
+  doc = storage_->Get(key);
+  InsertDocument(key, doc, generation);
+
+  return doc;
+}
+
+StatePrefetchCache::Document StatePrefetchCache::GetOrCreate(ResourceAddress const &key)
+{
+  Document doc{};
+  if (LookupDocument(key, doc))
+  {
+    return doc;
+  }
+
+  doc = storage_->GetOrCreate(key);
+
+  // the document might have been created on the lane, always update the cache
+  if (!doc.failed)
+  {
+    UpdateDocument(key, doc.document);
+  }
+
+  return doc;
+}
+
+void StatePrefetchCache::Set(ResourceAddress const &key, StateValue const &value)
+{
+  storage_->Set(key, value);
+  UpdateDocument(key, value);
+}
+
+StatePrefetchCache::Documents StatePrefetchCache::GetMany(Addresses const &keys) const
+{
+  Documents documents(keys.size());
+
+  // serve as many of the requests as possible from the cache
+  Addresses                missing{};
+  std::vector<std::size_t> positions{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    if (!LookupDocument(keys[i], documents[i]))
+    {
+      missing.push_back(keys[i]);
+      positions.push_back(i);
+    }
+  }
+
+  if (!missing.empty())
+  {
+    auto const generation = CurrentGeneration();
+
+    auto fetched = storage_->GetMany(missing);
+    for (std::size_t i = 0; i < missing.size(); ++i)
+    {
+      InsertDocument(missing[i], fetched[i], generation);
+      documents[positions[i]] = std::move(fetched[i]);
+    }
+  }
+
+  return documents;
+}
+
+void StatePrefetchCache::SetMany(KeyValuePairs const &values)
+{
+  storage_->SetMany(values);
+
+  for (auto const &value : values)
+  {
+    UpdateDocument(value.first, value.second);
+  }
+}
+
+bool StatePrefetchCache::Lock(ShardIndex shard)
+{
+  return storage_->Lock(shard);
+}
+
+bool StatePrefetchCache::Unlock(ShardIndex shard)
+{
+  return storage_->Unlock(shard);
+}
+
+void StatePrefetchCache::Reset()
+{
+  storage_->Reset();
+  Clear();
+}
+
+void StatePrefetchCache::AddTransaction(chain::Transaction const &tx)
+{
+  storage_->AddTransaction(tx);
+}
+
+bool StatePrefetchCache::GetTransaction(Digest const &digest, chain::Transaction &tx)
+{
+  {
+    FETCH_LOCK(lock_);
+
+    auto it = transactions_.find(digest);
+    if (it != transactions_.end())
+    {
+      tx = it->second;
+      tx_hit_count_->increment();
+
+      return true;
+    }
+  }
+
+  tx_miss_count_->increment();
+
+  return storage_->GetTransaction(digest, tx);
+}
+
+bool StatePrefetchCache::HasTransaction(Digest const &digest)
+{
+  return storage_->HasTransaction(digest);
+}
+
+void StatePrefetchCache::IssueCallForMissingTxs(DigestSet const &tx_set)
+{
+  storage_->IssueCallForMissingTxs(tx_set);
+}
+
+StatePrefetchCache::TxLayouts StatePrefetchCache::PollRecentTx(uint32_t max_to_poll)
+{
+  return storage_->PollRecentTx(max_to_poll);
+}
+
+StatePrefetchCache::Hash StatePrefetchCache::CurrentHash()
+{
+  return storage_->CurrentHash();
+}
+
+StatePrefetchCache::Hash StatePrefetchCache::LastCommitHash()
+{
+  return storage_->LastCommitHash();
+}
+
+bool StatePrefetchCache::RevertToHash(Hash const &hash, uint64_t index)
+{
+  // the state underneath the cache is changing
+  Clear();
+
+  return storage_->RevertToHash(hash, index);
+}
+
+StatePrefetchCache::Hash StatePrefetchCache::Commit(uint64_t index)
+{
+  return storage_->Commit(index);
+}
+
+bool StatePrefetchCache::HashExists(Hash const &hash, uint64_t index)
+{
+  return storage_->HashExists(hash, index);
+}
+
+StatePrefetchCache::Generation StatePrefetchCache::CurrentGeneration() const
+{
+  FETCH_LOCK(lock_);
+  return generation_;
+}
+
+/**
+ * Lookup a document from the cache, updating the hit / miss statistics
+ *
+ * @param key The key being requested
+ * @param doc The output document
+ * @return true if the document was present in the cache, otherwise false
+ */
+bool StatePrefetchCache::LookupDocument(ResourceAddress const &key, Document &doc) const
+{
+  bool present{false};
+
+  {
+    FETCH_LOCK(lock_);
+
+    auto it = documents_.find(key);
+    if (it != documents_.end())
+    {
+      doc     = it->second;
+      present = true;
+    }
+  }
+
+  if (present)
+  {
+    state_hit_count_->increment();
+  }
+  else
+  {
+    state_miss_count_->increment();
+  }
+
+  return present;
+}
+
+/**
+ * Add a document which has been read from the storage unit to the cache. Existing entries are
+ * never replaced since they might reflect a more recent write. Failed reads (for example an RPC
+ * error or timeout on the lane) are not cached, so that later lookups fall back to the storage
+ * unit instead of failing for the rest of the block.
+ *
+ * @param key The key of the document
+ * @param doc The document that was read
+ * @param generation The generation of the cache when the read was started
+ */
+void StatePrefetchCache::InsertDocument(ResourceAddress const &key, Document const &doc,
+                                        Generation generation) const
+{
+  if (doc.failed)
+  {
+    return;
+  }
+
+  FETCH_LOCK(lock_);
+
+  // discard reads that were started before the cache was cleared
+  if (generation == generation_)
+  {
+    documents_.emplace(key, doc);
+  }
+}
+
+/**
+ * Update the cache following a write to the storage unit
+ *
+ * @param key The key of the document
+ * @param value The value that was written
+ */
+void StatePrefetchCache::UpdateDocument(ResourceAddress const &key, StateValue const &value)
+{
+  Document doc{};
+  doc.document = value;
+
+  FETCH_LOCK(lock_);
+  documents_[key] = std::move(doc);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -23,12 +23,18 @@
 #include "ledger/storage_unit/storage_unit_client.hpp"
 #include "ledger/storage_unit/transaction_finder_protocol.hpp"
 #include "ledger/storage_unit/transaction_storage_protocol.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
 
+#include <condition_variable>
 #include <cstddef>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <unordered_set>
 #include <utility>
 
@@ -58,6 +64,25 @@ AddressList GenerateAddressList(ShardConfigs const &shards)
 constexpr char const *MERKLE_FILENAME_DOC   = "merkle_stack.db";
 constexpr char const *MERKLE_FILENAME_INDEX = "merkle_stack_index.db";
 
+using Clock = std::chrono::steady_clock;
+
+// The maximum time to wait for all of the lanes to respond (the slowest lane determines the
+// overall latency, therefore these bound the time that a single lane can stall the node)
+constexpr std::chrono::seconds LANE_COMMIT_TIMEOUT{30};
+constexpr std::chrono::seconds LANE_REVERT_TIMEOUT{180};
+
+/**
+ * The shared state used to track the responses of the lanes to a fanned out request. It is
+ * referenced by the promise callbacks, which can outlive the waiting call in the case of timeout.
+ */
+struct LaneResponses
+{
+  std::mutex              lock;
+  std::condition_variable condition;
+  std::size_t             pending{0};
+  bool                    failed{false};
+};
+
 }  // namespace
 
 StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const &shards,
@@ -66,6 +91,13 @@ StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const
   , log2_num_lanes_(log2_num_lanes)
   , rpc_client_{std::make_shared<Client>("STUC", muddle, SERVICE_LANE_CTRL, CHANNEL_RPC)}
   , current_merkle_{num_lanes()}
+  , commit_latency_{CreateLaneHistograms("ledger_storage_unit_lane_commit_latency_seconds",
+                                         "The time taken for each lane to commit its state")}
+  , revert_latency_{CreateLaneHistograms("ledger_storage_unit_lane_revert_latency_seconds",
+                                         "The time taken for each lane to revert its state")}
+  , lane_failures_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_storage_unit_lane_failures_total",
+        "The total number of fanned out lane requests which failed or timed out")}
 {
   if (num_lanes() != shards.size())
   {
@@ -91,6 +123,11 @@ byte_array::ConstByteArray StorageUnitClient::CurrentHash()
     promises.push_back(promise);
   }
 
+  if (!WaitForLanes(promises, {}, LANE_COMMIT_TIMEOUT, "current hash"))
+  {
+    return {};
+  }
+
   std::size_t index = 0;
   for (auto &p : promises)
   {
@@ -197,18 +234,25 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
     promises.emplace_back(std::move(promise));
   }
 
+  // wait for all the lanes, failing as soon as one of them fails or the timeout expires
+  bool all_success = WaitForLanes(promises, revert_latency_, LANE_REVERT_TIMEOUT, "revert");
+
   lane_index = 0;
-  bool all_success{true};
   for (auto &p : promises)
   {
     bool item_success{false};
-    if (!(p->GetResult(item_success, 180) && item_success))
+    // the promise expires after its default timeout unless extended, even when it has succeeded
+    if (all_success &&
+        !(p->GetResult(item_success, static_cast<uint64_t>(LANE_REVERT_TIMEOUT.count())) &&
+          item_success))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Failed to revert shard ", lane_index, " to 0x",
                      tree[lane_index].ToHex());
 
-      all_success &= false;
+      all_success = false;
     }
+
+    ++lane_index;
   }
 
   if (all_success)
@@ -253,6 +297,13 @@ byte_array::ConstByteArray StorageUnitClient::Commit(uint64_t const commit_index
     promises.push_back(promise);
   }
 
+  // wait for all the lanes, failing as soon as one of them fails or the timeout expires
+  if (!WaitForLanes(promises, commit_latency_, LANE_COMMIT_TIMEOUT, "commit"))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to commit lanes at index: ", commit_index);
+    return {};
+  }
+
   std::size_t index = 0;
   for (auto &p : promises)
   {
@@ -511,6 +562,115 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
   }
 }
 
+/**
+ * Lookup a set of documents from the lanes. The keys are grouped by lane and a single request is
+ * made to each of the lanes involved. All the requests are in flight at the same time.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the requested keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetMany(Addresses const &keys) const
+{
+  using ResourceIDs = RevertibleDocumentStoreProtocol::ResourceIDs;
+
+  struct LaneRequest
+  {
+    ResourceIDs              resources{};
+    std::vector<std::size_t> positions{};
+  };
+
+  // group the keys by lane remembering where each one came from
+  std::map<LaneIndex, LaneRequest> requests{};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    auto &request = requests[keys[i].lane(log2_num_lanes_)];
+    request.resources.push_back(keys[i].as_resource_id());
+    request.positions.push_back(i);
+  }
+
+  // dispatch all the lane requests
+  std::vector<std::pair<LaneIndex, service::Promise>> promises{};
+  promises.reserve(requests.size());
+  for (auto const &request : requests)
+  {
+    promises.emplace_back(
+        request.first,
+        rpc_client_->CallSpecificAddress(LookupAddress(request.first), RPC_STATE,
+                                         RevertibleDocumentStoreProtocol::GET_MANY,
+                                         request.second.resources));
+  }
+
+  // collect the responses back into request order
+  Documents documents(keys.size());
+  for (auto &promise : promises)
+  {
+    auto const &positions = requests[promise.first].positions;
+
+    Documents lane_documents{};
+    if (promise.second->GetResult(lane_documents) && (lane_documents.size() == positions.size()))
+    {
+      for (std::size_t i = 0; i < positions.size(); ++i)
+      {
+        documents[positions[i]] = std::move(lane_documents[i]);
+      }
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get documents from lane: ", promise.first);
+
+      // signal the failure for every document on this lane
+      for (auto const position : positions)
+      {
+        documents[position].failed = true;
+      }
+    }
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values on the lanes. The values are grouped by lane and a single request is made
+ * to each of the lanes involved. All the requests are in flight at the same time.
+ *
+ * @param values The key value pairs to be set
+ */
+void StorageUnitClient::SetMany(KeyValuePairs const &values)
+{
+  using LaneValues = RevertibleDocumentStoreProtocol::KeyValuePairs;
+
+  // group the values by lane
+  std::map<LaneIndex, LaneValues> requests{};
+  for (auto const &value : values)
+  {
+    requests[value.first.lane(log2_num_lanes_)].emplace_back(value.first.as_resource_id(),
+                                                              value.second);
+  }
+
+  try
+  {
+    // dispatch all the lane requests
+    std::vector<service::Promise> promises{};
+    promises.reserve(requests.size());
+    for (auto const &request : requests)
+    {
+      promises.emplace_back(rpc_client_->CallSpecificAddress(
+          LookupAddress(request.first), RPC_STATE, RevertibleDocumentStoreProtocol::SET_MANY,
+          request.second));
+    }
+
+    // wait for all the responses
+    for (auto &promise : promises)
+    {
+      promise->Wait();
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_MANY (store documents), because: ", e.what());
+  }
+}
+
 bool StorageUnitClient::Lock(ShardIndex index)
 {
   bool success{false};
@@ -582,5 +742,95 @@ uint32_t StorageUnitClient::num_lanes() const
   return 1u << log2_num_lanes_;
 }
 
+/**
+ * Wait for the responses to a request which has been fanned out to all of the lanes
+ *
+ * The lanes are processed in parallel, so the overall latency is determined by the slowest lane.
+ * Rather than waiting on each lane in turn, the wait completes as soon as any of the lanes fails
+ * or when the (overall) timeout expires.
+ *
+ * @param promises The promises for each of the lanes (indexed by lane)
+ * @param latencies The per lane latency histograms (can be empty)
+ * @param timeout The maximum time to wait for all of the lanes
+ * @param operation The name of the operation being performed (for logging)
+ * @return true if all of the lanes responded successfully, otherwise false
+ */
+bool StorageUnitClient::WaitForLanes(Promises const &promises, Histograms const &latencies,
+                                     Duration const &timeout, char const *operation) const
+{
+  auto const start     = Clock::now();
+  auto const responses = std::make_shared<LaneResponses>();
+  responses->pending   = promises.size();
+
+  for (std::size_t lane = 0; lane < promises.size(); ++lane)
+  {
+    telemetry::HistogramPtr latency = (lane < latencies.size()) ? latencies[lane] : nullptr;
+
+    auto const on_response = [responses, latency, start](bool success) {
+      if (latency)
+      {
+        latency->Add(std::chrono::duration<double>(Clock::now() - start).count());
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(responses->lock);
+        --responses->pending;
+        responses->failed |= !success;
+      }
+
+      responses->condition.notify_all();
+    };
+
+    promises[lane]
+        ->WithHandlers()
+        .Then([on_response]() { on_response(true); })
+        .Catch([on_response]() { on_response(false); });
+  }
+
+  bool success{false};
+  {
+    std::unique_lock<std::mutex> lock(responses->lock);
+    responses->condition.wait_until(lock, start + timeout, [&responses]() {
+      return responses->failed || (responses->pending == 0);
+    });
+
+    success = !responses->failed && (responses->pending == 0);
+  }
+
+  if (!success)
+  {
+    lane_failures_total_->increment();
+
+    for (std::size_t lane = 0; lane < promises.size(); ++lane)
+    {
+      auto const state = promises[lane]->state();
+
+      if (service::PromiseState::SUCCESS != state)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Lane ", lane, " did not complete ", operation,
+                       " (state: ", service::ToString(state), ")");
+      }
+    }
+  }
+
+  return success;
+}
+
+StorageUnitClient::Histograms StorageUnitClient::CreateLaneHistograms(
+    char const *name, char const *description) const
+{
+  Histograms histograms{};
+  histograms.reserve(num_lanes());
+
+  for (uint32_t lane = 0; lane < num_lanes(); ++lane)
+  {
+    histograms.emplace_back(telemetry::Registry::Instance().CreateHistogram(
+        {0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 30.0}, name,
+        description, {{"lane", std::to_string(lane)}}));
+  }
+
+  return histograms;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -17,12 +17,17 @@
 //------------------------------------------------------------------------------
 
 #include "chain/transaction.hpp"
+#include "core/set_thread_name.hpp"
 #include "ledger/storage_unit/transaction_archiver.hpp"
 #include "ledger/storage_unit/transaction_pool_interface.hpp"
 #include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
+#include "telemetry/utils/timer.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <string>
 
 using namespace std::chrono;
 using namespace std::chrono_literals;
@@ -33,8 +38,14 @@ namespace {
 
 constexpr char const *LOGGING_NAME = "TxArchiver";
 
+// the maximum time the dedicated thread waits for a confirmation before checking for shutdown
+constexpr milliseconds THREAD_WAIT_TIME{100};
+
 }  // namespace
 
+const std::size_t TransactionArchiver::MIN_BATCH_SIZE;
+const std::size_t TransactionArchiver::MAX_BATCH_SIZE;
+
 TransactionArchiver::TransactionArchiver(uint32_t lane, TransactionPoolInterface &pool,
                                          TransactionStoreInterface &archive)
   : lane_{lane}
@@ -47,18 +58,27 @@ TransactionArchiver::TransactionArchiver(uint32_t lane, TransactionPoolInterface
   , additions_total_{CreateCounter("ledger_txarchiver_additions_total", "The total number of transactions archived by the archiver")}
   , lost_total_{CreateCounter("ledger_txarchiver_lost_total", "The total number of transactions lost by the archiver")}
   , processed_total_{CreateCounter("ledger_txarchiver_processed_total", "The total number of transactions processed by the archiver")}
+  , batch_size_{CreateHistogram({1, 10, 50, 100, 250, 500, 1000, 2000, 4096}, "ledger_txarchiver_batch_size", "The number of transactions archived in each batch")}
+  , batch_duration_{CreateHistogram({0.0001, 0.0002, 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0}, "ledger_txarchiver_batch_duration", "The time in seconds taken to archive and flush a batch")}
 // clang-format on
 {
   // make the reservation
-  digests_.reserve(BATCH_SIZE);
+  digests_.reserve(MAX_BATCH_SIZE);
+  archived_.reserve(MAX_BATCH_SIZE);
 
   // configure the state machine
   state_machine_->RegisterHandler(State::COLLECTING, this, &TransactionArchiver::OnCollecting);
   state_machine_->RegisterHandler(State::FLUSHING, this, &TransactionArchiver::OnFlushing);
 }
 
+TransactionArchiver::~TransactionArchiver()
+{
+  StopThread();
+}
+
 void TransactionArchiver::Confirm(Digest const &digest)
 {
+  ++queue_depth_;
   confirmation_queue_.Push(digest);
   confirmed_total_->increment();
 }
@@ -68,81 +88,159 @@ TransactionArchiver::StateMachinePtr const &TransactionArchiver::GetStateMachine
   return state_machine_;
 }
 
-TransactionArchiver::State TransactionArchiver::OnCollecting()
+/**
+ * Start archiving on a dedicated thread, instead of using the state machine
+ */
+void TransactionArchiver::StartThread()
 {
-  for (;;)
+  if (!thread_)
   {
-    // attempt to extract an element in the confirmation queue
-    digests_.emplace_back(Digest{});
-    bool const extracted = confirmation_queue_.Pop(digests_.back(), milliseconds::zero());
-
-    // update the index if needed
-    if (!extracted)
-    {
-      digests_.pop_back();
-    }
+    running_ = true;
+    thread_  = std::make_unique<std::thread>(&TransactionArchiver::ThreadEntrypoint, this);
+  }
+}
 
-    bool const is_buffer_full    = (digests_.size() == BATCH_SIZE);
-    bool const is_batch_complete = (!extracted) && (!digests_.empty());
+/**
+ * Stop the dedicated thread, after all the outstanding confirmations have been archived
+ */
+void TransactionArchiver::StopThread()
+{
+  if (thread_)
+  {
+    running_ = false;
 
-    if (is_buffer_full || is_batch_complete)
-    {
-      return State::FLUSHING;
-    }
+    thread_->join();
+    thread_.reset();
+  }
+}
 
-    // Queue is empty and nothing to write - trigger delay and do not change FSM state
-    if (!extracted)
-    {
-      state_machine_->Delay(1s);
-      break;
-    }
+TransactionArchiver::State TransactionArchiver::OnCollecting()
+{
+  if (CollectBatch(milliseconds::zero()))
+  {
+    return State::FLUSHING;
   }
 
+  // Queue is empty and nothing to write - trigger delay and do not change FSM state
+  state_machine_->Delay(1s);
+
   return State::COLLECTING;
 }
 
 TransactionArchiver::State TransactionArchiver::OnFlushing()
 {
-  // check if we need to transition from this state
-  if (digests_.empty())
+  FlushBatch();
+
+  return State::COLLECTING;
+}
+
+/**
+ * Collect the next batch of confirmed transactions from the queue
+ *
+ * The size of the batch grows with the number of confirmations waiting in the queue, so that a
+ * backlog is cleared with fewer (larger) flushes.
+ *
+ * @param max_wait The maximum time to wait for the first confirmation
+ * @return true if the batch contains any transactions, otherwise false
+ */
+bool TransactionArchiver::CollectBatch(Duration const &max_wait)
+{
+  std::size_t const target =
+      std::min(MAX_BATCH_SIZE, std::max(MIN_BATCH_SIZE, queue_depth_.load()));
+
+  Duration wait{max_wait};
+  Digest   digest{};
+  while ((digests_.size() < target) && confirmation_queue_.Pop(digest, wait))
   {
-    return State::COLLECTING;
+    --queue_depth_;
+    digests_.emplace_back(std::move(digest));
+
+    // only wait for the first element of the batch
+    wait = milliseconds::zero();
   }
 
-  // flush a transaction to the archive
+  return !digests_.empty();
+}
+
+/**
+ * Move the current batch of transactions from the pool to the archive
+ *
+ * All the transactions are added to the archive before it is flushed, once. Only then are they
+ * removed from the pool.
+ */
+void TransactionArchiver::FlushBatch()
+{
+  if (digests_.empty())
   {
-    auto const &current = digests_.back();
+    return;
+  }
 
-    chain::Transaction tx{};
+  telemetry::FunctionTimer const timer{*batch_duration_};
+
+  std::size_t num_duplicates{0};
+  std::size_t num_lost{0};
+
+  chain::Transaction tx{};
+  for (auto const &current : digests_)
+  {
     if (archive_.Has(current))
     {
       // no op
-      duplicate_total_->increment();
+      ++num_duplicates;
     }
     else if (pool_.Get(current, tx))
     {
       // add the transaction to the store
       archive_.Add(tx);
-
-      // remove the transaction from the pool
-      pool_.Remove(current);
-
-      additions_total_->increment();
+      archived_.push_back(current);
     }
     else
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Unable to lookup tx: 0x", current.ToHex(), " from cache");
 
-      lost_total_->increment();
+      ++num_lost;
     }
   }
 
-  // remove the current element
-  digests_.pop_back();
+  if (!archived_.empty())
+  {
+    // a single flush for the whole batch
+    archive_.Flush();
+
+    // the transactions are now persistent, remove them from the pool
+    for (auto const &current : archived_)
+    {
+      pool_.Remove(current);
+    }
+  }
 
-  processed_total_->increment();
+  batch_size_->Add(static_cast<double>(digests_.size()));
+  *additions_total_ += archived_.size();
+  *duplicate_total_ += num_duplicates;
+  *lost_total_ += num_lost;
+  *processed_total_ += digests_.size();
 
-  return State::FLUSHING;
+  archived_.clear();
+  digests_.clear();
+}
+
+void TransactionArchiver::ThreadEntrypoint()
+{
+  SetThreadName("TxArchiver");
+
+  while (running_)
+  {
+    if (CollectBatch(THREAD_WAIT_TIME))
+    {
+      FlushBatch();
+    }
+  }
+
+  // archive any remaining confirmations
+  while (CollectBatch(milliseconds::zero()))
+  {
+    FlushBatch();
+  }
 }
 
 telemetry::CounterPtr TransactionArchiver::CreateCounter(char const *name,
@@ -152,6 +250,14 @@ telemetry::CounterPtr TransactionArchiver::CreateCounter(char const *name,
   return telemetry::Registry::Instance().CreateCounter(name, description, std::move(labels));
 }
 
+telemetry::HistogramPtr TransactionArchiver::CreateHistogram(
+    std::initializer_list<double> const &buckets, char const *name, char const *description) const
+{
+  telemetry::Measurement::Labels labels{{"lane", std::to_string(lane_)}};
+  return telemetry::Registry::Instance().CreateHistogram(buckets, name, description,
+                                                         std::move(labels));
+}
+
 char const *ToString(TransactionArchiver::State state)
 {
   char const *text = "Unknown";
@@ -18,19 +18,95 @@
 
 #include "chain/transaction.hpp"
 #include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <algorithm>
+#include <string>
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+// The approximate bookkeeping overhead of a single entry in the pool (hash map node, eviction
+// order node and the heap allocations of the digest)
+constexpr uint64_t ENTRY_OVERHEAD = 192;
+
+// The gauges are only refreshed periodically to avoid serialising the stripes on their locks
+constexpr uint64_t TELEMETRY_UPDATE_MASK = 0xFF;
+
+}  // namespace
+
+constexpr uint64_t TransactionMemoryPool::DEFAULT_MAX_BYTES;
+
+/**
+ * Construct a transaction memory pool
+ *
+ * @param lane The lane that this pool belongs to (used for telemetry)
+ * @param max_bytes The approximate upper bound on the memory used by the transactions in the pool
+ */
+TransactionMemoryPool::TransactionMemoryPool(uint32_t lane, uint64_t max_bytes)
+  : stripe_max_bytes_{std::max<uint64_t>(max_bytes / NUM_STRIPES, 1)}
+  , count_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_mempool_transactions", "The current number of transactions in the memory pool",
+        {{"lane", std::to_string(lane)}})}
+  , size_gauge_{telemetry::Registry::Instance().CreateGauge<uint64_t>(
+        "ledger_mempool_size_bytes",
+        "The approximate memory used by the transactions in the memory pool",
+        {{"lane", std::to_string(lane)}})}
+  , evicted_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_mempool_evicted_total",
+        "The total number of transactions evicted from the memory pool",
+        {{"lane", std::to_string(lane)}})}
+{}
 
 /**
  * Add a transaction to the store
  *
+ * If the stripe of the transaction exceeds its share of the byte budget, the least valuable
+ * transactions of the stripe (possibly including this one) are evicted.
+ *
  * @param tx The transaction to set added to storage
  */
 void TransactionMemoryPool::Add(chain::Transaction const &tx)
 {
-  FETCH_LOCK(lock_);
-  transaction_store_[tx.digest()] = tx;
+  uint64_t const size = EstimateSize(tx);
+  uint64_t       num_evicted{0};
+
+  {
+    auto &stripe = LookupStripe(tx.digest());
+    FETCH_LOCK(stripe.lock);
+
+    // replace any previous version of the transaction
+    auto it = stripe.transactions.find(tx.digest());
+    if (it != stripe.transactions.end())
+    {
+      RemoveEntry(stripe, it);
+    }
+
+    stripe.transactions.emplace(tx.digest(), Entry{tx, size});
+    stripe.eviction_order.emplace(MakeEvictionKey(tx));
+    stripe.size_in_bytes += size;
+    size_in_bytes_ += size;
+    ++count_;
+
+    // evict the least valuable transactions until the stripe is back within its budget
+    while ((stripe.size_in_bytes > stripe_max_bytes_) && !stripe.eviction_order.empty())
+    {
+      auto const victim = stripe.transactions.find(std::get<2>(*stripe.eviction_order.begin()));
+      RemoveEntry(stripe, victim);
+      ++num_evicted;
+    }
+  }
+
+  if (num_evicted != 0u)
+  {
+    evicted_ += num_evicted;
+    *evicted_total_ += num_evicted;
+  }
+
+  UpdateTelemetry();
 }
 
 /**
@@ -41,8 +117,10 @@ void TransactionMemoryPool::Add(chain::Transaction const &tx)
  */
 bool TransactionMemoryPool::Has(Digest const &tx_digest) const
 {
-  FETCH_LOCK(lock_);
-  return transaction_store_.find(tx_digest) != transaction_store_.end();
+  auto const &stripe = LookupStripe(tx_digest);
+  FETCH_LOCK(stripe.lock);
+
+  return stripe.transactions.find(tx_digest) != stripe.transactions.end();
 }
 
 /**
@@ -56,12 +134,13 @@ bool TransactionMemoryPool::Get(Digest const &tx_digest, chain::Transaction &tx)
 {
   bool success{false};
 
-  FETCH_LOCK(lock_);
+  auto const &stripe = LookupStripe(tx_digest);
+  FETCH_LOCK(stripe.lock);
 
-  auto it = transaction_store_.find(tx_digest);
-  if (it != transaction_store_.end())
+  auto it = stripe.transactions.find(tx_digest);
+  if (it != stripe.transactions.end())
   {
-    tx      = it->second;
+    tx      = it->second.tx;
     success = true;
   }
 
@@ -75,8 +154,7 @@ bool TransactionMemoryPool::Get(Digest const &tx_digest, chain::Transaction &tx)
  */
 uint64_t TransactionMemoryPool::GetCount() const
 {
-  FETCH_LOCK(lock_);
-  return static_cast<uint64_t>(transaction_store_.size());
+  return count_;
 }
 
 /**
@@ -86,8 +164,122 @@ uint64_t TransactionMemoryPool::GetCount() const
  */
 void TransactionMemoryPool::Remove(Digest const &tx_digest)
 {
-  FETCH_LOCK(lock_);
-  transaction_store_.erase(tx_digest);
+  {
+    auto &stripe = LookupStripe(tx_digest);
+    FETCH_LOCK(stripe.lock);
+
+    auto it = stripe.transactions.find(tx_digest);
+    if (it == stripe.transactions.end())
+    {
+      return;
+    }
+
+    RemoveEntry(stripe, it);
+  }
+
+  UpdateTelemetry();
+}
+
+/**
+ * Get the approximate memory used by the transactions in the pool
+ *
+ * @return The size in bytes
+ */
+uint64_t TransactionMemoryPool::GetSizeInBytes() const
+{
+  return size_in_bytes_;
+}
+
+/**
+ * Get the total number of transactions which have been evicted from the pool
+ *
+ * @return The number of evicted transactions
+ */
+uint64_t TransactionMemoryPool::GetEvictedCount() const
+{
+  return evicted_;
+}
+
+/**
+ * Estimate the memory footprint of a transaction once it is stored in the pool
+ *
+ * @param tx The transaction to be evaluated
+ * @return The approximate size in bytes
+ */
+uint64_t TransactionMemoryPool::EstimateSize(chain::Transaction const &tx)
+{
+  uint64_t size = sizeof(Entry) + ENTRY_OVERHEAD;
+
+  size += tx.chain_code().size();
+  size += tx.action().size();
+  size += tx.data().size();
+  size += (tx.shard_mask().size() + 7u) / 8u;
+  size += tx.transfers().size() * sizeof(chain::Transaction::Transfer);
+
+  for (auto const &signatory : tx.signatories())
+  {
+    size += sizeof(signatory);
+    size += signatory.identity.identifier().size();
+    size += signatory.signature.size();
+  }
+
+  return size;
+}
+
+std::size_t TransactionMemoryPool::StripeIndex(Digest const &tx_digest)
+{
+  if (tx_digest.empty())
+  {
+    return 0;
+  }
+
+  // the lane of a transaction is selected by the leading bytes of its digest (see
+  // ResourceID::lane), so every transaction in the pool of a lane shares them. The stripe is
+  // therefore taken from the trailing byte of the digest instead
+  return static_cast<std::size_t>(tx_digest[tx_digest.size() - 1u]) & (NUM_STRIPES - 1u);
+}
+
+TransactionMemoryPool::EvictionKey TransactionMemoryPool::MakeEvictionKey(
+    chain::Transaction const &tx)
+{
+  return EvictionKey{tx.charge_rate(), tx.valid_until(), tx.digest()};
+}
+
+TransactionMemoryPool::Stripe &TransactionMemoryPool::LookupStripe(Digest const &tx_digest)
+{
+  return stripes_[StripeIndex(tx_digest)];
+}
+
+TransactionMemoryPool::Stripe const &TransactionMemoryPool::LookupStripe(
+    Digest const &tx_digest) const
+{
+  return stripes_[StripeIndex(tx_digest)];
+}
+
+/**
+ * Remove an entry from a stripe and update the accounting (stripe lock must be held)
+ *
+ * @param stripe The stripe containing the entry
+ * @param it The iterator to the entry being removed
+ */
+void TransactionMemoryPool::RemoveEntry(Stripe &stripe, TxStore::iterator const &it)
+{
+  auto const size = it->second.size;
+
+  stripe.eviction_order.erase(MakeEvictionKey(it->second.tx));
+  stripe.transactions.erase(it);
+  stripe.size_in_bytes -= size;
+  size_in_bytes_ -= size;
+  --count_;
+}
+
+void TransactionMemoryPool::UpdateTelemetry()
+{
+  if ((updates_++ & TELEMETRY_UPDATE_MASK) == 0)
+  {
+    count_gauge_->set(count_);
+    size_gauge_->set(size_in_bytes_);
+  }
 }
 
 }  // namespace ledger
@@ -116,6 +116,14 @@ uint64_t TransactionStore::GetCount() const
   return static_cast<uint64_t>(archive_.size());
 }
 
+/**
+ * Flush all the added transactions to disk
+ */
+void TransactionStore::Flush()
+{
+  archive_.Flush(false);
+}
+
 /**
  * Pull a sub tree from the storage engine with the given starting prefix for the digest
  *
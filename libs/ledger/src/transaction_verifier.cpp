@@ -19,6 +19,7 @@
 #include "chain/transaction.hpp"
 #include "core/set_thread_name.hpp"
 #include "core/string/to_lower.hpp"
+#include "crypto/verification_engine.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "logging/logging.hpp"
@@ -40,6 +41,7 @@ using telemetry::Registry;
 
 constexpr char const *          LOGGING_NAME = "TxVerifier";
 const std::chrono::milliseconds POP_TIMEOUT{300};
+const std::chrono::milliseconds BATCH_POP_TIMEOUT{0};
 
 std::string CreateMetricName(std::string const &prefix, std::string const &name)
 {
@@ -81,12 +83,31 @@ telemetry::CounterPtr CreateCounter(std::string const &prefix, std::string const
  * @param sink The destination for verified transactions
  * @param verifying_threads The number of verifying threads to be used
  * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions verified together by a verifying thread
  */
 TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                                         std::string const &name)
+                                         std::string const &name, std::size_t batch_size)
+  : TransactionVerifier(sink, verifying_threads, name, batch_size,
+                        crypto::VerificationEngine::Default())
+{}
+
+/**
+ * Construct a transaction verifier queue
+ *
+ * @param sink The destination for verified transactions
+ * @param verifying_threads The number of verifying threads to be used
+ * @param name The name of the verifier
+ * @param batch_size The maximum number of transactions verified together by a verifying thread
+ * @param engine The verification engine used to check the transaction signatures
+ */
+TransactionVerifier::TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
+                                         std::string const &name, std::size_t batch_size,
+                                         crypto::VerificationEngine &engine)
   : verifying_threads_(verifying_threads)
+  , batch_size_(std::max<std::size_t>(batch_size, 1))
   , name_(name)
   , sink_(sink)
+  , engine_(engine)
   , unverified_queue_length_(
         CreateGauge(name, "unverified_queue_size", "The current size of the unverified queue"))
   , unverified_queue_max_length_(
@@ -180,11 +201,14 @@ void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
 }
 
 /**
- * Internal: Thread process for the verification of
+ * Internal: Thread process for the verification of transactions. When configured with a batch size
+ * larger than one, all the transactions which are already waiting (up to the batch size) are
+ * verified together, sharing the work across the threads of the verification engine.
  */
 void TransactionVerifier::Verifier()
 {
   TransactionPtr tx;
+  Transactions   batch{};
 
   while (active_)
   {
@@ -193,25 +217,42 @@ void TransactionVerifier::Verifier()
       // wait for a mutable transaction to be available
       if (unverified_queue_.Pop(tx, POP_TIMEOUT))
       {
-        unverified_queue_length_->decrement();
-
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+        batch.clear();
+        batch.emplace_back(std::move(tx));
 
-        // check the status
-        if (tx->Verify())
+        // collect the transactions that are already waiting to be verified
+        while ((batch.size() < batch_size_) && unverified_queue_.Pop(tx, BATCH_POP_TIMEOUT))
         {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
-
-          verified_queue_.Push(std::move(tx));
-          verified_queue_length_->increment();
-          verified_tx_total_->increment();
+          batch.emplace_back(std::move(tx));
         }
-        else
+
+        unverified_queue_length_->decrement(batch.size());
+
+        if (batch.size() > 1)
         {
-          FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
+          chain::Transaction::VerifyBatch(batch, engine_);
+        }
 
-          discarded_tx_total_->increment();
+        for (auto &candidate : batch)
+        {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", candidate->digest().ToHex());
+
+          // check the status
+          if (candidate->Verify(engine_))
+          {
+            FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", candidate->digest().ToHex());
+
+            verified_queue_.Push(std::move(candidate));
+            verified_queue_length_->increment();
+            verified_tx_total_->increment();
+          }
+          else
+          {
+            FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
+                           candidate->digest().ToHex());
+
+            discarded_tx_total_->increment();
+          }
         }
       }
     }
@@ -53,6 +53,7 @@ using fetch::ledger::testing::BlockGenerator;
 
 using ::testing::_;
 using ::testing::AnyNumber;
+using ::testing::Contains;
 using ::testing::InSequence;
 using ::testing::NiceMock;
 using ::testing::StrictMock;
@@ -1042,4 +1043,57 @@ TEST_F(NiceMockBlockCoordinatorTests, UnknownTransactionDoesNotBlockForever)
   Tock(State::WAIT_FOR_TRANSACTIONS, State::SYNCHRONISED);
 }
 
+TEST_F(NiceMockBlockCoordinatorTests, PipelinedBlocksRequestMissingTransactionsEarly)
+{
+  auto const        unknown_tx = *fetch::testing::GenerateUniqueHashes(1u).begin();
+  TransactionLayout layout{unknown_tx, fetch::BitVector{}, 0, 0, 1000};
+
+  auto genesis = block_generator_();
+  auto b1      = block_generator_(genesis);
+  auto b2      = block_generator_(b1);
+  auto b3      = block_generator_(b2);
+
+  // Fabricate unknown transaction in a block which follows the next block to be executed
+  b2->slices.begin()->push_back(layout);
+
+  EXPECT_CALL(*storage_unit_, LastCommitHash()).Times(AnyNumber());
+  EXPECT_CALL(*storage_unit_, CurrentHash()).Times(AnyNumber());
+  EXPECT_CALL(*execution_manager_, LastProcessedBlock()).Times(AnyNumber());
+  EXPECT_CALL(*storage_unit_, HashExists(_, _)).Times(AnyNumber());
+  EXPECT_CALL(*storage_unit_, RevertToHash(_, _)).Times(AnyNumber());
+  EXPECT_CALL(*execution_manager_, SetLastProcessedBlock(_)).Times(AnyNumber());
+
+  // the missing transaction is requested ahead of the block being processed
+  EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(Contains(unknown_tx))).Times(1);
+
+  block_coordinator_->SetPipelineDepth(4);
+  EXPECT_EQ(4u, block_coordinator_->pipeline_depth());
+
+  Tock(State::RELOAD_STATE, State::SYNCHRONISED);
+
+  ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*b1));
+  ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*b2));
+  ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*b3));
+
+  // the request is issued while the first block is being executed
+  Tock(State::SYNCHRONISED, State::WAIT_FOR_EXECUTION);
+  ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(storage_unit_.get()));
+
+  Tock(State::WAIT_FOR_EXECUTION, State::WAIT_FOR_TRANSACTIONS);
+  EXPECT_EQ(b1->hash, block_coordinator_->GetLastExecutedBlock());
+
+  // the transaction which has still not arrived is requested again for the current block
+  EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(Contains(unknown_tx))).Times(1);
+  ASSERT_TRUE(RemainsOn(State::WAIT_FOR_TRANSACTIONS));
+
+  clock_->Advance(std::chrono::seconds(6u));
+  ASSERT_TRUE(RemainsOn(State::WAIT_FOR_TRANSACTIONS));
+
+  // Time out wait for Tx - block should be invalidated at this point
+  clock_->Advance(std::chrono::seconds(601u));
+
+  Tock(State::WAIT_FOR_TRANSACTIONS, State::SYNCHRONISED);
+  EXPECT_EQ(b1->hash, block_coordinator_->GetLastExecutedBlock());
+}
+
 }  // namespace
@@ -31,11 +31,17 @@
 
 #include "gtest/gtest.h"
 
+#include <dirent.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <climits>
 #include <cstddef>
 #include <memory>
 #include <random>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace {
@@ -106,6 +112,60 @@ std::string Hashes(std::vector<BlockPtr> const &v)
   return ret_val.str();
 }
 
+/**
+ * Switches to a new temporary directory for its lifetime, so that the database files of persistent
+ * chains are not left in the working directory of the tests
+ */
+class TemporaryWorkingDirectory
+{
+public:
+  TemporaryWorkingDirectory()
+  {
+    char previous[PATH_MAX];
+    if (getcwd(previous, sizeof(previous)) == nullptr)
+    {
+      throw std::runtime_error("Unable to determine the working directory");
+    }
+    previous_ = previous;
+
+    std::string path = ::testing::TempDir() + "main_chain_tests.XXXXXX";
+    if ((mkdtemp(&path[0]) == nullptr) || (chdir(path.c_str()) != 0))
+    {
+      throw std::runtime_error("Unable to create a temporary working directory");
+    }
+    path_ = path;
+  }
+
+  TemporaryWorkingDirectory(TemporaryWorkingDirectory const &) = delete;
+  TemporaryWorkingDirectory &operator=(TemporaryWorkingDirectory const &) = delete;
+
+  ~TemporaryWorkingDirectory()
+  {
+    if (chdir(previous_.c_str()) != 0)
+    {
+      return;
+    }
+
+    if (DIR *dir = opendir(path_.c_str()))
+    {
+      while (dirent *entry = readdir(dir))
+      {
+        std::string const name = entry->d_name;
+        if ((name != ".") && (name != ".."))
+        {
+          unlink((path_ + "/" + name).c_str());
+        }
+      }
+      closedir(dir);
+    }
+    rmdir(path_.c_str());
+  }
+
+private:
+  std::string previous_;
+  std::string path_;
+};
+
 class MainChainTests : public ::testing::TestWithParam<MainChain::Mode>
 {
 public:
@@ -123,12 +183,15 @@ protected:
 
     auto const main_chain_mode = GetParam();
 
-    chain_     = std::make_unique<MainChain>(main_chain_mode);
-    generator_ = std::make_unique<BlockGenerator>(NUM_LANES, NUM_SLICES);
+    working_directory_ = std::make_unique<TemporaryWorkingDirectory>();
+    chain_             = std::make_unique<MainChain>(main_chain_mode);
+    generator_         = std::make_unique<BlockGenerator>(NUM_LANES, NUM_SLICES);
   }
 
-  MainChainPtr      chain_;
-  BlockGeneratorPtr generator_;
+  // declared first, so that the chain has closed its files before the directory is removed
+  std::unique_ptr<TemporaryWorkingDirectory> working_directory_;
+  MainChainPtr                               chain_;
+  BlockGeneratorPtr                          generator_;
 };
 
 TEST_P(MainChainTests, EnsureGenesisIsConsistent)
@@ -933,6 +996,40 @@ TEST_P(MainChainTests, CheckHeaviestChain)
   }
 }
 
+TEST_P(MainChainTests, CheckTimeTravelDigestsMatchesTimeTravel)
+{
+  auto genesis     = generator_->Generate();
+  auto main_branch = Generate(generator_, genesis, 20);
+
+  for (auto const &block : main_branch)
+  {
+    ASSERT_EQ(ToString(chain_->AddBlock(*block)), ToString(BlockStatus::ADDED));
+  }
+
+  // the digests follow on from the starting block
+  auto digests = chain_->TimeTravelDigests(genesis->hash);
+  ASSERT_EQ(digests.size(), main_branch.size());
+  for (std::size_t i = 0; i < main_branch.size(); ++i)
+  {
+    EXPECT_EQ(digests[i], main_branch[i]->hash);
+  }
+
+  // the limited walks agree with each other
+  digests    = chain_->TimeTravelDigests(main_branch[4]->hash, 5);
+  auto logue = chain_->TimeTravel(main_branch[4]->hash, 5);
+  ASSERT_EQ(digests.size(), 5u);
+  ASSERT_EQ(logue.blocks.size(), 5u);
+  for (std::size_t i = 0; i < digests.size(); ++i)
+  {
+    EXPECT_EQ(digests[i], main_branch[i + 5]->hash);
+    EXPECT_EQ(logue.blocks[i]->hash, main_branch[i + 5]->hash);
+  }
+
+  // unknown blocks have no digests
+  auto const unknown = generator_->Generate(main_branch.back());
+  EXPECT_TRUE(chain_->TimeTravelDigests(unknown->hash).empty());
+}
+
 TEST_P(MainChainTests, AddingBlockWithDuplicateTxFails)
 {
   crypto::ECDSASigner signer;
@@ -995,6 +1092,52 @@ TEST_P(MainChainTests, AddingBlockWithDuplicateTxInSameBlockFails)
   ASSERT_EQ(chain_->GetHeaviestBlockHash(), genesis->hash);
 }
 
+TEST_P(MainChainTests, AddingBlockWithTxFromOtherBranchSucceeds)
+{
+  crypto::ECDSASigner signer;
+  chain::Address      signer_address{signer.identity()};
+
+  auto tx = chain::TransactionBuilder{}
+                .From(signer_address)
+                .TargetChainCode("some.kind.of.chain.code", BitVector{})
+                .Action("do.work")
+                .ValidUntil(100)
+                .ChargeRate(1)
+                .ChargeLimit(1)
+                .Signer(signer.identity())
+                .Seal()
+                .Sign(signer)
+                .Build();
+
+  auto genesis = generator_->Generate();
+  auto common  = generator_->Generate(genesis);
+
+  // include the transaction on a side branch
+  auto side1 = generator_->Generate(common);
+  side1->slices.push_back({chain::TransactionLayout(*tx, 1)});
+  side1->UpdateDigest();
+
+  // and then again on the main branch, which does not contain the side branch block
+  auto main1 = generator_->Generate(common, 2u);
+  auto main2 = generator_->Generate(main1);
+  main2->slices.push_back({chain::TransactionLayout(*tx, 1)});
+  main2->UpdateDigest();
+
+  auto main3 = generator_->Generate(main2);
+  main3->slices.push_back({chain::TransactionLayout(*tx, 1)});
+  main3->UpdateDigest();
+
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*common));
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*side1));
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*main1));
+  ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*main2));
+  ASSERT_EQ(chain_->GetHeaviestBlockHash(), main2->hash);
+
+  // the transaction is now present on the main branch
+  ASSERT_EQ(BlockStatus::INVALID, chain_->AddBlock(*main3));
+  ASSERT_EQ(chain_->GetHeaviestBlockHash(), main2->hash);
+}
+
 INSTANTIATE_TEST_SUITE_P(ParamBased, MainChainTests,
                          ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
                                            MainChain::Mode::IN_MEMORY_DB));
@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/executable_cache.hpp"
+#include "vm/compiler.hpp"
+#include "vm/generator.hpp"
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+
+using fetch::Digest;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::ExecutableCache;
+using fetch::vm::Executable;
+using fetch::vm_modules::VMFactory;
+
+using ExecutablePtr = ExecutableCache::ExecutablePtr;
+
+char const *TEXT = R"(
+  @action
+  function increment() : Int64
+    var count = 0i64;
+    for (i in 0:10)
+      count += 1i64;
+    endfor
+    return count;
+  endfunction
+)";
+
+Digest SourceDigest(std::string const &source)
+{
+  return Hash<SHA256>(source);
+}
+
+ExecutablePtr Compile(std::string const &source)
+{
+  auto module     = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+  auto executable = std::make_shared<Executable>();
+
+  auto const errors = VMFactory::Compile(module, {{"default.etch", source}}, *executable);
+  EXPECT_TRUE(errors.empty());
+
+  return executable;
+}
+
+uint16_t NumSystemTypes()
+{
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+  // the type tables of the module are only populated once it has been attached to a compiler
+  fetch::vm::Compiler const compiler{module.get()};
+
+  return static_cast<uint16_t>(module->GetTypeInfoArray().size());
+}
+
+TEST(ExecutableCacheTests, CheckMissOnEmptyCache)
+{
+  ExecutableCache cache{};
+
+  EXPECT_FALSE(cache.Lookup(SourceDigest(TEXT), NumSystemTypes()));
+  EXPECT_EQ(0, cache.size());
+  EXPECT_EQ(0, cache.size_in_bytes());
+}
+
+TEST(ExecutableCacheTests, CheckHitAfterAdd)
+{
+  ExecutableCache cache{};
+
+  auto const digest     = SourceDigest(TEXT);
+  auto const executable = Compile(TEXT);
+  cache.Add(digest, executable);
+
+  // the same instance should be shared between all the users of the cache
+  EXPECT_EQ(executable, cache.Lookup(digest, NumSystemTypes()));
+  EXPECT_EQ(1, cache.size());
+  EXPECT_EQ(ExecutableCache::EstimateSize(*executable), cache.size_in_bytes());
+
+  cache.Reset();
+  EXPECT_FALSE(cache.Lookup(digest, NumSystemTypes()));
+  EXPECT_EQ(0, cache.size_in_bytes());
+}
+
+TEST(ExecutableCacheTests, CheckLeastRecentlyUsedEviction)
+{
+  std::string const source_a = std::string{TEXT} + "\n// a\n";
+  std::string const source_b = std::string{TEXT} + "\n// b\n";
+  std::string const source_c = std::string{TEXT} + "\n// c\n";
+
+  auto const executable_a = Compile(source_a);
+  auto const executable_b = Compile(source_b);
+  auto const executable_c = Compile(source_c);
+
+  // size the cache so that only two executables fit at any one time
+  auto const entry_size = ExecutableCache::EstimateSize(*executable_a);
+  ExecutableCache cache{(entry_size * 5u) / 2u};
+
+  cache.Add(SourceDigest(source_a), executable_a);
+  cache.Add(SourceDigest(source_b), executable_b);
+
+  // touch "a" so that "b" becomes the least recently used entry
+  ASSERT_TRUE(cache.Lookup(SourceDigest(source_a), NumSystemTypes()));
+
+  cache.Add(SourceDigest(source_c), executable_c);
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_LE(cache.size_in_bytes(), (entry_size * 5u) / 2u);
+  EXPECT_TRUE(cache.Lookup(SourceDigest(source_a), NumSystemTypes()));
+  EXPECT_FALSE(cache.Lookup(SourceDigest(source_b), NumSystemTypes()));
+  EXPECT_TRUE(cache.Lookup(SourceDigest(source_c), NumSystemTypes()));
+}
+
+TEST(ExecutableCacheTests, CheckPersistedExecutablesAreReloaded)
+{
+  auto const digest = SourceDigest(TEXT);
+
+  {
+    ExecutableCache cache{};
+    cache.EnablePersistence("executable_cache_tests.db", "executable_cache_tests.index.db");
+    ASSERT_TRUE(cache.IsPersistent());
+
+    cache.Add(digest, Compile(TEXT));
+  }
+
+  // simulate a restart of the node
+  ExecutableCache cache{};
+  cache.EnablePersistence("executable_cache_tests.db", "executable_cache_tests.index.db");
+
+  // executables generated against a different module must not be reused
+  EXPECT_FALSE(cache.Lookup(digest, static_cast<uint16_t>(NumSystemTypes() + 1u)));
+
+  auto const executable = cache.Lookup(digest, NumSystemTypes());
+  ASSERT_TRUE(executable);
+  EXPECT_EQ(NumSystemTypes(), executable->num_system_types);
+  EXPECT_EQ(1, cache.size());
+
+  // the reloaded executable should be runnable against a freshly created module
+  auto                      module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+  fetch::vm::Compiler const compiler{module.get()};
+  fetch::vm::VM             vm{module.get()};
+
+  std::string        error{};
+  fetch::vm::Variant output{};
+  ASSERT_TRUE(vm.Execute(*executable, "increment", error, output)) << error;
+  EXPECT_EQ(10, output.Get<int64_t>());
+}
+
+}  // namespace
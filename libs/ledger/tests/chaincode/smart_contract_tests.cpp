@@ -376,13 +376,12 @@ TEST_F(SmartContractTests, CheckBasicTokenContract)
     // from query
     EXPECT_CALL(*storage_, Get(owner_resource)).Times(2);  // from io.Exists() & io.Read()
 
-    // from the action
+    // from the action, reads are cached and writes are flushed once the action has finished
     EXPECT_CALL(*storage_, Lock(_));
     EXPECT_CALL(*storage_, Get(owner_resource));                    // from io.Exists()
-    EXPECT_CALL(*storage_, Get(owner_resource));                    // from io.Read()
-    EXPECT_CALL(*storage_, Set(owner_resource, remaining_amount));  // from io.Write()
     EXPECT_CALL(*storage_, Get(target_resource));                   // from io.Exists()
-    EXPECT_CALL(*storage_, Set(target_resource, transfer_amount));  // from io.Write()
+    EXPECT_CALL(*storage_, Set(owner_resource, remaining_amount));  // from the flush
+    EXPECT_CALL(*storage_, Set(target_resource, transfer_amount));  // from the flush
     EXPECT_CALL(*storage_, Unlock(_));
 
     // from query
@@ -186,6 +186,55 @@ TEST_P(ExecutionManagerTests, DISABLED_CheckIncrementalExecution)
   manager_->Stop();
 }
 
+TEST_P(ExecutionManagerTests, CheckDependencyGraphExecution)
+{
+  using HistoryElement      = FakeExecutor::HistoryElement;
+  using HistoryElementCache = FakeExecutor::HistoryElementCache;
+
+  BlockConfig const &config = GetParam();
+
+  manager_->SetSchedulingMode(ExecutionManager::SchedulingMode::DEPENDENCY_GRAPH);
+
+  // generate a block with the desired lane and slice configuration
+  auto block = TestBlock::Generate(config.log2_lanes, config.slices, __LINE__);
+  EXPECT_GT(block.num_transactions, 0);
+
+  manager_->Start();
+
+  ASSERT_EQ(manager_->Execute(block.block), ExecutionManager::ScheduleStatus::SCHEDULED);
+  ASSERT_TRUE(WaitUntilExecutionComplete(static_cast<std::size_t>(block.num_transactions)));
+  ASSERT_EQ(GetNumExecutedTransaction(), block.num_transactions);
+
+  manager_->Stop();
+
+  HistoryElementCache history;
+  for (auto &exec : executors_)
+  {
+    exec->CollectHistory(history);
+  }
+
+  std::sort(history.begin(), history.end(), [](HistoryElement const &a, HistoryElement const &b) {
+    return a.timestamp < b.timestamp;
+  });
+
+  // transactions may run ahead of their slice, but never ahead of an earlier slice on the same lane
+  for (std::size_t lane = 0; lane < config.lanes(); ++lane)
+  {
+    std::size_t current_slice{0};
+
+    for (auto const &element : history)
+    {
+      if (element.shards.bit(lane) == 0u)
+      {
+        continue;
+      }
+
+      EXPECT_LE(current_slice, element.slice) << "lane: " << lane;
+      current_slice = std::max<std::size_t>(current_slice, element.slice);
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Param, ExecutionManagerTests,
                          ::testing::ValuesIn(BlockConfig::REDUCED_SET));
 
@@ -57,6 +57,8 @@ using AddressList        = fetch::muddle::MuddleEndpoint::AddressList;
 using State              = MainChainRpcService::State;
 using MuddleAddress      = fetch::muddle::Address;
 using TraveloguePromise  = fetch::network::PromiseOf<MainChainProtocol::Travelogue>;
+using BlockHashes        = MainChainRpcService::BlockHashes;
+using SyncMode           = MainChainRpcService::SyncMode;
 using AdjustableClockPtr = fetch::moment::AdjustableClockPtr;
 
 namespace {
@@ -80,6 +82,15 @@ fetch::network::PromiseOf<T> CreatePromise(T const &item)
   return fetch::network::PromiseOf<T>{prom};
 }
 
+template <typename T>
+fetch::network::PromiseOf<T> CreateFailedPromise()
+{
+  auto prom = fetch::service::MakePromise();
+  prom->Fail();
+
+  return fetch::network::PromiseOf<T>{prom};
+}
+
 constexpr std::size_t NUM_LANES  = 1;
 constexpr std::size_t NUM_SLICES = 16;
 
@@ -112,7 +123,7 @@ protected:
   ECDSASigner                      other1_signer_;
   MuddleAddress                    other1_{other1_signer_.identity().identifier()};
   ECDSASigner                      other2_signer_;
-  MuddleAddress                    other2_{other1_signer_.identity().identifier()};
+  MuddleAddress                    other2_{other2_signer_.identity().identifier()};
   NiceMock<MockMainChainRpcClient> rpc_client_;
   NiceMock<MockMuddleEndpoint>     endpoint_{self_.identity().identifier(), NetworkId{"TEST"}};
   NiceMock<MockConsensus>          consensus_;
@@ -283,4 +294,77 @@ TEST_F(MainChainSyncTest, CheckExponentialBackStep)
   }
 }
 
+TEST_F(MainChainSyncTest, CheckParallelSyncFromMultiplePeers)
+{
+  using BlockPtrs = BlockGenerator::BlockPtrs;
+
+  static constexpr std::size_t range_size = MainChainRpcService::BLOCK_RANGE_SIZE;
+
+  auto gen    = block_generator_();
+  auto blocks = block_generator_(2 * range_size + range_size / 2, gen);
+
+  BlockHashes digests{};
+  for (auto const &block : blocks)
+  {
+    digests.push_back(block->hash);
+  }
+
+  auto range = [&blocks](std::size_t offset, std::size_t length) {
+    return CreatePromise(TimeTravel(blocks.back(), BlockPtrs(blocks.cbegin() + offset,
+                                                             blocks.cbegin() + offset + length)));
+  };
+
+  rpc_service_.SetSyncMode(SyncMode::MULTI_PEER);
+
+  EXPECT_CALL(endpoint_, GetDirectlyConnectedPeers())
+      .WillRepeatedly(Return(AddressList{other1_, other2_}));
+  EXPECT_CALL(consensus_, ValidBlock(_)).WillRepeatedly(Return(ConsensusInterface::Status::YES));
+
+  // the legacy single peer sync is not used
+  EXPECT_CALL(rpc_client_, TimeTravel(_, _)).Times(0);
+
+  EXPECT_CALL(rpc_client_, TimeTravelDigests(_, ExpectedHash(GetGenesisDigest()), _))
+      .WillOnce(Return(CreatePromise(digests)));
+
+  // all of the ranges are requested in parallel, the second range fails once and is requested again
+  EXPECT_CALL(rpc_client_, TimeTravelRange(_, ExpectedHash(GetGenesisDigest()), range_size))
+      .WillOnce(Return(range(0, range_size)));
+  EXPECT_CALL(rpc_client_, TimeTravelRange(_, ExpectedHash(digests[range_size - 1]), range_size))
+      .WillOnce(Return(CreateFailedPromise<MainChainProtocol::Travelogue>()))
+      .WillOnce(Return(range(range_size, range_size)));
+  EXPECT_CALL(rpc_client_,
+              TimeTravelRange(_, ExpectedHash(digests[2 * range_size - 1]), range_size / 2))
+      .WillOnce(Return(range(2 * range_size, range_size / 2)));
+
+  FollowPath(State::SYNCHRONISING, State::REQUEST_HEADERS, State::WAIT_FOR_HEADERS,
+             State::REQUEST_BLOCK_RANGES, State::WAIT_FOR_BLOCK_RANGES,
+             State::REQUEST_BLOCK_RANGES);
+
+  // only the first range can be added to the chain until the second has been retrieved
+  EXPECT_EQ(chain_.GetHeaviestBlockHash(), digests[range_size - 1]);
+
+  FollowPath(State::REQUEST_BLOCK_RANGES, State::WAIT_FOR_BLOCK_RANGES,
+             State::COMPLETE_SYNC_WITH_PEER, State::SYNCHRONISED);
+
+  EXPECT_EQ(chain_.GetHeaviestBlockHash(), blocks.back()->hash);
+}
+
+TEST_F(MainChainSyncTest, CheckParallelSyncFallsBackToSinglePeerSync)
+{
+  rpc_service_.SetSyncMode(SyncMode::MULTI_PEER);
+
+  EXPECT_CALL(endpoint_, GetDirectlyConnectedPeers())
+      .WillRepeatedly(Return(AddressList{other1_, other2_}));
+
+  // the peer does not know of our block
+  EXPECT_CALL(rpc_client_, TimeTravelDigests(_, ExpectedHash(GetGenesisDigest()), _))
+      .WillOnce(Return(CreatePromise(BlockHashes{})));
+  EXPECT_CALL(rpc_client_, TimeTravel(_, ExpectedHash(GetGenesisDigest())))
+      .WillOnce(Return(CreatePromise(MainChainProtocol::Travelogue{})));
+
+  FollowPath(State::SYNCHRONISING, State::REQUEST_HEADERS, State::WAIT_FOR_HEADERS,
+             State::START_SYNC_WITH_PEER, State::REQUEST_NEXT_BLOCKS, State::WAIT_FOR_NEXT_BLOCKS,
+             State::COMPLETE_SYNC_WITH_PEER);
+}
+
 }  // namespace
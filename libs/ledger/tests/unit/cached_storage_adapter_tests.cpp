@@ -30,6 +30,7 @@ using fetch::storage::ResourceAddress;
 using fetch::storage::Document;
 
 using testing::Return;
+using testing::SizeIs;
 
 class MockStorage : public StorageInterface
 {
@@ -40,6 +41,7 @@ public:
   MOCK_METHOD1(Lock, bool(ShardIndex));
   MOCK_METHOD1(Unlock, bool(ShardIndex));
   MOCK_METHOD0(Reset, void());
+  MOCK_METHOD1(SetMany, void(KeyValuePairs const &));
 };
 
 class CachedStorageAdapterTests : public testing::Test
@@ -99,4 +101,20 @@ TEST_F(CachedStorageAdapterTests, Get_does_not_cache_result_if_retrieval_from_st
   cached_storage_adapter.Get(key);
 }
 
+TEST_F(CachedStorageAdapterTests, Flush_writes_all_dirty_entries_in_a_single_batch)
+{
+  ResourceAddress other_key{"other-key"};
+
+  EXPECT_CALL(mock_storage, Set(testing::_, testing::_)).Times(0);
+  EXPECT_CALL(mock_storage, SetMany(SizeIs(2))).Times(1);
+
+  cached_storage_adapter.Set(key, "value");
+  cached_storage_adapter.Set(other_key, "other-value");
+
+  cached_storage_adapter.Flush();
+
+  // no further writes since all the entries have been flushed
+  cached_storage_adapter.Flush();
+}
+
 }  // namespace
@@ -30,4 +30,6 @@ public:
   MOCK_METHOD2(GetHeaviestChain, BlocksPromise(MuddleAddress, uint64_t));
   MOCK_METHOD4(GetCommonSubChain, BlocksPromise(MuddleAddress, Digest, Digest, uint64_t));
   MOCK_METHOD2(TimeTravel, TraveloguePromise(MuddleAddress, Digest));
+  MOCK_METHOD3(TimeTravelDigests, DigestsPromise(MuddleAddress, Digest, uint64_t));
+  MOCK_METHOD3(TimeTravelRange, TraveloguePromise(MuddleAddress, Digest, uint64_t));
 };
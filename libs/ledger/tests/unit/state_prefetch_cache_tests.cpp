@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+
+#include "chain/address.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "ledger/storage_unit/state_prefetch_cache.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+using fetch::chain::Address;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::StatePrefetchCache;
+using fetch::storage::ResourceAddress;
+
+class StatePrefetchCacheTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    tx_ = TransactionBuilder{}
+              .From(from_)
+              .Transfer(to_, 100)
+              .ValidUntil(100)
+              .Signer(signer_.identity())
+              .Seal()
+              .Sign(signer_)
+              .Build();
+
+    storage_->AddTransaction(*tx_);
+    storage_->Set(from_wallet_, "from-wallet");
+    storage_->Set(to_wallet_, "to-wallet");
+  }
+
+  ECDSASigner                         signer_{};
+  ECDSASigner                         target_{};
+  Address                             from_{signer_.identity()};
+  Address                             to_{target_.identity()};
+  ResourceAddress                     from_wallet_{"fetch.token.state." + from_.display()};
+  ResourceAddress                     to_wallet_{"fetch.token.state." + to_.display()};
+  TransactionBuilder::TransactionPtr  tx_{};
+  std::shared_ptr<FakeStorageUnit>    storage_{std::make_shared<FakeStorageUnit>()};
+  std::unique_ptr<StatePrefetchCache> cache_{std::make_unique<StatePrefetchCache>(storage_)};
+};
+
+TEST_F(StatePrefetchCacheTests, PrefetchedTransactionIsServedFromCache)
+{
+  cache_->Prefetch({tx_->digest()});
+
+  fetch::chain::Transaction tx{};
+  ASSERT_TRUE(cache_->GetTransaction(tx_->digest(), tx));
+  EXPECT_EQ(tx.digest(), tx_->digest());
+}
+
+TEST_F(StatePrefetchCacheTests, DeclaredResourcesArePrefetched)
+{
+  cache_->Prefetch({tx_->digest()});
+
+  // update the underlying storage directly, the cache should still serve the prefetched values
+  storage_->Set(from_wallet_, "updated");
+  storage_->Set(to_wallet_, "updated");
+
+  EXPECT_EQ(cache_->Get(from_wallet_).document, "from-wallet");
+  EXPECT_EQ(cache_->Get(to_wallet_).document, "to-wallet");
+}
+
+TEST_F(StatePrefetchCacheTests, WritesArePassedThroughAndCached)
+{
+  cache_->Prefetch({tx_->digest()});
+  cache_->Set(from_wallet_, "written");
+
+  EXPECT_EQ(storage_->Get(from_wallet_).document, "written");
+  EXPECT_EQ(cache_->Get(from_wallet_).document, "written");
+}
+
+TEST_F(StatePrefetchCacheTests, FailedPrefetchFallsBackToStorage)
+{
+  ResourceAddress const missing_wallet{"fetch.token.state.missing"};
+
+  // the lookup of a resource which can not be read fails...
+  EXPECT_TRUE(cache_->Get(missing_wallet).failed);
+  EXPECT_TRUE(cache_->GetMany({missing_wallet}).at(0).failed);
+
+  // ...however subsequent lookups are served from the storage unit once it can be read
+  storage_->Set(missing_wallet, "recovered");
+
+  auto const doc = cache_->Get(missing_wallet);
+  EXPECT_FALSE(doc.failed);
+  EXPECT_EQ(doc.document, "recovered");
+}
+
+TEST_F(StatePrefetchCacheTests, ClearDropsCachedState)
+{
+  cache_->Prefetch({tx_->digest()});
+  storage_->Set(from_wallet_, "updated");
+
+  cache_->Clear();
+
+  EXPECT_EQ(cache_->Get(from_wallet_).document, "updated");
+}
+
+}  // namespace
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+#include "vm/cached_io_observer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::ledger::FakeStorageUnit;
+using fetch::ledger::StateAdapter;
+using fetch::ledger::StateSentinelAdapter;
+using fetch::vm::CachedIoObserver;
+
+using Status = StateSentinelAdapter::Status;
+
+constexpr char const *SCOPE = "fetch.sentinel";
+
+class StateSentinelAdapterTests : public ::testing::Test
+{
+public:
+  StateSentinelAdapterTests()
+  {
+    // only the first of the two shards is permitted
+    shards_.set(0, 1);
+  }
+
+  static std::string KeyOnShard(uint32_t shard)
+  {
+    for (uint32_t i = 0;; ++i)
+    {
+      auto key = "key" + std::to_string(i);
+      if (StateAdapter::CreateAddress(SCOPE, key).lane(1) == shard)
+      {
+        return key;
+      }
+    }
+  }
+
+  FakeStorageUnit storage_;
+  BitVector       shards_{2};
+};
+
+TEST_F(StateSentinelAdapterTests, cached_writes_are_accounted_like_direct_writes)
+{
+  auto const     key = KeyOnShard(0);
+  uint64_t const first{1};
+  uint16_t const second{2};
+
+  FakeStorageUnit      direct_storage{};
+  StateSentinelAdapter direct{direct_storage, SCOPE, shards_};
+  EXPECT_EQ(direct.Write(key, &first, sizeof(first)), Status::OK);
+  EXPECT_EQ(direct.Write(key, &second, sizeof(second)), Status::OK);
+
+  StateSentinelAdapter sentinel{storage_, SCOPE, shards_};
+  {
+    CachedIoObserver cache{sentinel};
+    EXPECT_EQ(cache.Write(key, &first, sizeof(first)), Status::OK);
+    EXPECT_EQ(cache.Write(key, &second, sizeof(second)), Status::OK);
+
+    // overwritten values are accounted for even though only the last one is written back
+    EXPECT_EQ(sentinel.num_bytes_written(), direct.num_bytes_written());
+    EXPECT_EQ(sentinel.num_lookups(), direct.num_lookups());
+
+    ASSERT_EQ(cache.Flush(), Status::OK);
+  }
+
+  // writing back the values is not accounted for a second time
+  EXPECT_EQ(sentinel.num_bytes_written(), sizeof(first) + sizeof(second));
+  EXPECT_EQ(sentinel.num_lookups(), direct.num_lookups());
+
+  uint16_t stored{0};
+  uint64_t size{sizeof(stored)};
+  EXPECT_EQ(sentinel.Read(key, &stored, size), Status::OK);
+  EXPECT_EQ(stored, second);
+}
+
+TEST_F(StateSentinelAdapterTests, cached_writes_to_other_shards_are_rejected_immediately)
+{
+  auto const     allowed_key = KeyOnShard(0);
+  auto const     denied_key  = KeyOnShard(1);
+  uint64_t const value{1};
+
+  StateSentinelAdapter sentinel{storage_, SCOPE, shards_};
+  CachedIoObserver     cache{sentinel};
+
+  EXPECT_EQ(cache.Write(allowed_key, &value, sizeof(value)), Status::OK);
+  EXPECT_EQ(cache.Write(denied_key, &value, sizeof(value)), Status::PERMISSION_DENIED);
+  EXPECT_EQ(sentinel.num_bytes_written(), sizeof(value));
+
+  // the permitted write is not affected by the rejected one
+  EXPECT_EQ(cache.Flush(), Status::OK);
+  EXPECT_EQ(sentinel.Exists(allowed_key), Status::OK);
+}
+
+}  // namespace
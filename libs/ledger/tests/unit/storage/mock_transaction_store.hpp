@@ -46,6 +46,7 @@ public:
   MOCK_CONST_METHOD1(Has, bool(Digest const &));
   MOCK_CONST_METHOD2(Get, bool(Digest const &, Transaction &));
   MOCK_CONST_METHOD0(GetCount, uint64_t());
+  MOCK_METHOD0(Flush, void());
 
   fetch::ledger::TransactionMemoryPool pool;
 };
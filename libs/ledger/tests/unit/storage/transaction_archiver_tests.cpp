@@ -23,6 +23,10 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
 namespace {
 
 using testing::_;
@@ -138,4 +142,62 @@ TEST_F(TransactionArchiverTests, CheckRecoveryFromLookupFailure)
   EXPECT_FALSE(pool_.pool.Has(current));
 }
 
+TEST_F(TransactionArchiverTests, CheckBatchIsFlushedBeforeRemovalFromPool)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(3);
+
+  for (auto const &tx : txs)
+  {
+    pool_.pool.Add(*tx);
+    archiver_.Confirm(tx->digest());
+  }
+
+  {
+    // all the transactions are archived with a single flush, before any are removed from the pool
+    InSequence seq;
+    for (auto const &tx : txs)
+    {
+      EXPECT_CALL(store_, Add(IsTransaction(tx->digest()))).Times(1);
+    }
+    EXPECT_CALL(store_, Flush()).Times(1);
+    for (auto const &tx : txs)
+    {
+      EXPECT_CALL(pool_, Remove(tx->digest())).Times(1);
+    }
+
+    CycleStateMachine();
+  }
+
+  for (auto const &tx : txs)
+  {
+    EXPECT_TRUE(store_.pool.Has(tx->digest()));
+    EXPECT_FALSE(pool_.pool.Has(tx->digest()));
+  }
+}
+
+TEST_F(TransactionArchiverTests, CheckDedicatedThread)
+{
+  static constexpr std::size_t NUM_TXS = 250;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(NUM_TXS);
+
+  for (auto const &tx : txs)
+  {
+    pool_.pool.Add(*tx);
+  }
+
+  archiver_.StartThread();
+
+  for (auto const &tx : txs)
+  {
+    archiver_.Confirm(tx->digest());
+  }
+
+  // stopping the thread archives all the outstanding confirmations
+  archiver_.StopThread();
+
+  EXPECT_EQ(NUM_TXS, store_.pool.GetCount());
+  EXPECT_EQ(0, pool_.pool.GetCount());
+}
+
 }  // namespace
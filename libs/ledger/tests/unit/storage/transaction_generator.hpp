@@ -48,6 +48,21 @@ public:
         .Build();
   }
 
+  TransactionPtr operator()(uint64_t charge_rate, uint64_t valid_until)
+  {
+    return TransactionBuilder{}
+        .From(address_)
+        .ValidUntil(valid_until)
+        .ChargeRate(charge_rate)
+        .TargetChainCode("foo.bar.baz", BitVector{})
+        .Action("test")
+        .Data(GenerateRandomData())
+        .Signer(public_key_)
+        .Seal()
+        .Sign(private_key_)
+        .Build();
+  }
+
   Txs GenerateRandomTxs(std::size_t count)
   {
     TransactionGenerator &self = *this;
@@ -19,8 +19,12 @@
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
 #include "ledger/storage_unit/transaction_memory_pool.hpp"
+#include "storage/resource_mapper.hpp"
 #include "transaction_generator.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -75,4 +79,163 @@ TEST_F(TransactionMemPoolTests, SimpleCheck)
   }
 }
 
+TEST_F(TransactionMemPoolTests, CheckSizeAccounting)
+{
+  auto const txs = tx_gen_.GenerateRandomTxs(10);
+
+  uint64_t expected_size{0};
+  for (auto const &tx : txs)
+  {
+    memory_pool_.Add(*tx);
+    expected_size += TransactionMemoryPool::EstimateSize(*tx);
+  }
+
+  EXPECT_EQ(expected_size, memory_pool_.GetSizeInBytes());
+
+  // adding the same transaction again should not change the accounting
+  memory_pool_.Add(*txs.front());
+  EXPECT_EQ(10, memory_pool_.GetCount());
+  EXPECT_EQ(expected_size, memory_pool_.GetSizeInBytes());
+
+  for (auto const &tx : txs)
+  {
+    memory_pool_.Remove(tx->digest());
+  }
+
+  EXPECT_EQ(0, memory_pool_.GetCount());
+  EXPECT_EQ(0, memory_pool_.GetSizeInBytes());
+  EXPECT_EQ(0, memory_pool_.GetEvictedCount());
+}
+
+TEST_F(TransactionMemPoolTests, CheckEvictionOfLowestChargeRate)
+{
+  static constexpr std::size_t NUM_STRIPES       = 16;
+  static constexpr std::size_t TXS_PER_STRIPE    = 4;
+  static constexpr std::size_t NUM_LOW_VALUE_TXS = 200;
+
+  auto const     reference = tx_gen_(1, 1000);
+  uint64_t const tx_size   = TransactionMemoryPool::EstimateSize(*reference);
+
+  // budget for (at most) a few transactions in each of the stripes of the pool
+  uint64_t const        max_bytes = NUM_STRIPES * TXS_PER_STRIPE * tx_size;
+  TransactionMemoryPool pool{0, max_bytes};
+
+  for (std::size_t i = 0; i < NUM_LOW_VALUE_TXS; ++i)
+  {
+    pool.Add(*tx_gen_(1, 1000 + i));
+  }
+
+  EXPECT_LE(pool.GetSizeInBytes(), max_bytes);
+  EXPECT_GT(pool.GetEvictedCount(), 0);
+  EXPECT_EQ(NUM_LOW_VALUE_TXS, pool.GetCount() + pool.GetEvictedCount());
+
+  // high value transactions always displace the low value ones
+  auto const high_value_txs = std::vector<TransactionGenerator::TransactionPtr>{
+      tx_gen_(100, 1000), tx_gen_(100, 1000), tx_gen_(100, 1000)};
+
+  for (auto const &tx : high_value_txs)
+  {
+    pool.Add(*tx);
+  }
+
+  for (auto const &tx : high_value_txs)
+  {
+    EXPECT_TRUE(pool.Has(tx->digest()));
+  }
+
+  EXPECT_LE(pool.GetSizeInBytes(), max_bytes);
+
+  // a low value transaction is rejected when its stripe is already full of high value ones
+  TransactionMemoryPool small_pool{0, NUM_STRIPES * tx_size};
+  auto const            high_value = tx_gen_(100, 1000);
+  small_pool.Add(*high_value);
+
+  // find a low value transaction which maps to the same stripe
+  auto const stripe_of = [](TransactionGenerator::TransactionPtr const &tx) {
+    auto const &digest = tx->digest();
+    return digest[digest.size() - 1u] & (NUM_STRIPES - 1u);
+  };
+
+  auto low_value = tx_gen_(1, 1000);
+  while (stripe_of(low_value) != stripe_of(high_value))
+  {
+    low_value = tx_gen_(1, 1000);
+  }
+
+  small_pool.Add(*low_value);
+  EXPECT_TRUE(small_pool.Has(high_value->digest()));
+  EXPECT_FALSE(small_pool.Has(low_value->digest()));
+  EXPECT_EQ(1, small_pool.GetEvictedCount());
+}
+
+TEST_F(TransactionMemPoolTests, CheckSingleLaneUsesAllStripes)
+{
+  static constexpr std::size_t NUM_STRIPES    = 16;
+  static constexpr std::size_t LOG2_NUM_LANES = 4;
+  static constexpr uint32_t    LANE           = 5;
+  static constexpr std::size_t NUM_TXS        = 2 * NUM_STRIPES;
+
+  auto const     reference = tx_gen_(1, 1000);
+  uint64_t const tx_size   = TransactionMemoryPool::EstimateSize(*reference);
+
+  // each stripe has room for half of the transactions, so the pool comfortably fits all of them
+  // unless they are confined to a single stripe
+  uint64_t const        max_bytes = NUM_STRIPES * (NUM_TXS / 2) * tx_size;
+  TransactionMemoryPool pool{LANE, max_bytes};
+
+  // only the transactions of a single lane are ever added to its pool
+  std::size_t num_added{0};
+  while (num_added < NUM_TXS)
+  {
+    auto const tx = tx_gen_(1, 1000);
+    if (fetch::storage::ResourceID{tx->digest()}.lane(LOG2_NUM_LANES) != LANE)
+    {
+      continue;
+    }
+
+    pool.Add(*tx);
+    ++num_added;
+  }
+
+  EXPECT_GT(pool.GetSizeInBytes(), max_bytes / NUM_STRIPES);
+  EXPECT_EQ(NUM_TXS, pool.GetCount());
+  EXPECT_EQ(0, pool.GetEvictedCount());
+}
+
+TEST_F(TransactionMemPoolTests, CheckConcurrentAccess)
+{
+  static constexpr std::size_t NUM_THREADS    = 4;
+  static constexpr std::size_t TXS_PER_THREAD = 50;
+
+  std::vector<TransactionGenerator::Txs> batches{};
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    batches.emplace_back(tx_gen_.GenerateRandomTxs(TXS_PER_THREAD));
+  }
+
+  std::vector<std::thread> threads{};
+  for (auto const &batch : batches)
+  {
+    threads.emplace_back([this, &batch]() {
+      for (auto const &tx : batch)
+      {
+        memory_pool_.Add(*tx);
+        EXPECT_TRUE(memory_pool_.Has(tx->digest()));
+      }
+
+      for (std::size_t i = 0; i < batch.size(); i += 2)
+      {
+        memory_pool_.Remove(batch[i]->digest());
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(NUM_THREADS * TXS_PER_THREAD / 2, memory_pool_.GetCount());
+}
+
 }  // namespace
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_layout.hpp"
+#include "chain/transaction_layout_rpc_serializers.hpp"
+#include "core/bitvector.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_index.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::Digest;
+using fetch::chain::TransactionLayout;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Block;
+using fetch::ledger::TransactionIndex;
+using fetch::serializers::LargeObjectSerializeHelper;
+
+Digest MakeDigest(std::string const &name)
+{
+  return Hash<SHA256>(name);
+}
+
+TransactionLayout MakeLayout(std::string const &name, uint64_t valid_until)
+{
+  return TransactionLayout{MakeDigest(name), BitVector{1}, 1, 0, valid_until};
+}
+
+Block MakeBlock(std::string const &name, uint64_t block_number,
+                std::vector<TransactionLayout> const &layouts)
+{
+  Block block{};
+  block.hash         = MakeDigest(name);
+  block.block_number = block_number;
+  block.slices.emplace_back(layouts.begin(), layouts.end());
+
+  return block;
+}
+
+TEST(TransactionIndexTests, CheckLookupOfIndexedTransactions)
+{
+  TransactionIndex index{};
+  index.Add(MakeBlock("block-1", 1, {MakeLayout("tx-1", 10), MakeLayout("tx-2", 10)}));
+
+  EXPECT_EQ(2, index.size());
+  EXPECT_EQ(nullptr, index.Lookup(MakeDigest("tx-3")));
+
+  auto const *locations = index.Lookup(MakeDigest("tx-1"));
+  ASSERT_NE(nullptr, locations);
+  ASSERT_EQ(1, locations->size());
+  EXPECT_EQ(MakeDigest("block-1"), locations->front().block_hash);
+  EXPECT_EQ(1, locations->front().block_number);
+}
+
+TEST(TransactionIndexTests, CheckTransactionOnMultipleBranches)
+{
+  TransactionIndex index{};
+
+  auto const block_a = MakeBlock("block-a", 2, {MakeLayout("tx-1", 10)});
+  auto const block_b = MakeBlock("block-b", 3, {MakeLayout("tx-1", 10)});
+
+  index.Add(block_a);
+  index.Add(block_b);
+
+  // indexing the same block again should not generate additional locations
+  index.Add(block_a);
+
+  auto const *locations = index.Lookup(MakeDigest("tx-1"));
+  ASSERT_NE(nullptr, locations);
+  ASSERT_EQ(2, locations->size());
+  EXPECT_EQ(block_a.hash, (*locations)[0].block_hash);
+  EXPECT_EQ(block_b.hash, (*locations)[1].block_hash);
+}
+
+TEST(TransactionIndexTests, CheckPruningOfExpiredTransactions)
+{
+  TransactionIndex index{};
+  index.Add(MakeBlock("block-1", 1, {MakeLayout("tx-1", 5), MakeLayout("tx-2", 10)}));
+
+  index.Prune(4);
+  EXPECT_EQ(2, index.size());
+
+  // tx-1 can not be included in a block at or above block 5
+  index.Prune(5);
+  EXPECT_EQ(1, index.size());
+  EXPECT_EQ(nullptr, index.Lookup(MakeDigest("tx-1")));
+  EXPECT_NE(nullptr, index.Lookup(MakeDigest("tx-2")));
+
+  index.Prune(100);
+  EXPECT_EQ(0, index.size());
+}
+
+TEST(TransactionIndexTests, CheckSerialisation)
+{
+  TransactionIndex original{};
+  original.Add(MakeBlock("block-1", 1, {MakeLayout("tx-1", 5), MakeLayout("tx-2", 10)}));
+
+  LargeObjectSerializeHelper buffer{};
+  buffer << original;
+
+  TransactionIndex restored{};
+  LargeObjectSerializeHelper input{buffer.data()};
+  input >> restored;
+
+  EXPECT_EQ(2, restored.size());
+
+  auto const *locations = restored.Lookup(MakeDigest("tx-2"));
+  ASSERT_NE(nullptr, locations);
+  ASSERT_EQ(1, locations->size());
+  EXPECT_EQ(MakeDigest("block-1"), locations->front().block_hash);
+
+  // the expiry information should also be restored
+  restored.Prune(5);
+  EXPECT_EQ(1, restored.size());
+  EXPECT_EQ(nullptr, restored.Lookup(MakeDigest("tx-1")));
+}
+
+}  // namespace
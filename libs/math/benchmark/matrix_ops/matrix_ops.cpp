@@ -21,6 +21,7 @@
 
 #include "benchmark/benchmark.h"
 
+#include <cstdint>
 #include <vector>
 
 template <class T, int C, int H, int W>
@@ -770,6 +771,68 @@ BENCHMARK_TEMPLATE(BM_TransposeDot, fetch::fixed_point::FixedPoint<16, 16>, 512,
 BENCHMARK_TEMPLATE(BM_TransposeDot, fetch::fixed_point::FixedPoint<32, 32>, 512, 512)
     ->Unit(benchmark::kMillisecond);
 
+/**
+ * Throughput of C = A * B for square matrices of increasing size, comparing the packed threaded
+ * GEMM used by Dot for large products against the vectorised implementation
+ */
+template <class T, uint64_t V>
+void BM_GemmThroughput(benchmark::State &state)
+{
+  using namespace fetch::math::linalg;
+  using SizeType = fetch::math::SizeType;
+
+  auto const n = static_cast<SizeType>(state.range(0));
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{n, n});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{n, n});
+  fetch::math::Tensor<T> c(std::vector<SizeType>{n, n});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Blas<T, Signature(_C <= _alpha, _A, _B, _beta, _C), Computes(_C <= _alpha * _A * _B + _beta * _C),
+       V>
+      gemm_nn;
+
+  for (auto _ : state)
+  {
+    gemm_nn(T{1}, a.View(), b.View(), T{0}, c.View());
+    benchmark::DoNotOptimize(c.data().pointer());
+  }
+
+  // one multiply and one add per element of A * B, reported in units of 10^9 per second
+  state.counters["GFLOP"] = benchmark::Counter(2.0 * static_cast<double>(n * n * n) * 1e-9,
+                                                 benchmark::Counter::kIsIterationInvariantRate);
+}
+
+constexpr uint64_t GEMM_VECTORISED = fetch::platform::Parallelisation::VECTORISE;
+constexpr uint64_t GEMM_THREADED =
+    fetch::platform::Parallelisation::VECTORISE | fetch::platform::Parallelisation::THREADING;
+
+BENCHMARK_TEMPLATE(BM_GemmThroughput, float, GEMM_VECTORISED)
+    ->RangeMultiplier(2)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmThroughput, float, GEMM_THREADED)
+    ->RangeMultiplier(2)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmThroughput, double, GEMM_VECTORISED)
+    ->RangeMultiplier(2)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmThroughput, double, GEMM_THREADED)
+    ->RangeMultiplier(2)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmThroughput, fetch::fixed_point::FixedPoint<32, 32>, GEMM_VECTORISED)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_GemmThroughput, fetch::fixed_point::FixedPoint<32, 32>, GEMM_THREADED)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+
 template <class T, int C, int H, int W>
 void BM_DynamicStitch(benchmark::State &state)
 {
@@ -0,0 +1,70 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Cache blocked GEMM shared by the threaded Blas implementations. The
+ * operands are copied block by block into packed panels which are then
+ * consumed by a register tiled micro kernel, following the usual
+ * GotoBLAS / BLIS loop structure:
+ *
+ *   for jc in N step NC          (columns of C, split across threads)
+ *     for pc in K step KC        (pack a KC x NC panel of B)
+ *       for ic in M step MC      (pack an MC x KC block of A)
+ *         for jr in NC step NR
+ *           for ir in MC step MR (MR x NR micro kernel)
+ */
+
+#include "math/base_types.hpp"
+#include "math/tensor/tensor_view.hpp"
+
+#include <cstddef>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+/**
+ * Types for which the packed GEMM is instantiated
+ */
+template <typename T>
+constexpr bool HasPackedGemm = meta::IsFloat<T> || meta::IsFixedPoint<T>;
+
+namespace details {
+
+/// Minimum number of multiply-adds (M * N * K) for which the packed GEMM is used
+constexpr SizeType PACKED_GEMM_THRESHOLD = 64 * 64 * 64;
+
+inline bool UsePackedGemm(SizeType m, SizeType n, SizeType k)
+{
+  return (m * n * k) >= PACKED_GEMM_THRESHOLD;
+}
+
+/**
+ * Computes C <= alpha * op(A) * op(B) + beta * C where op(X) is either X or T(X)
+ *
+ * @param transpose_a true if op(A) = T(A)
+ * @param transpose_b true if op(B) = T(B)
+ */
+template <typename T>
+void GemmPacked(bool transpose_a, bool transpose_b, T alpha, TensorView<T> const &a,
+                TensorView<T> const &b, T beta, TensorView<T> &c);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -22,10 +22,14 @@
 #include "math/fundamental_operators.hpp"
 #include "math/linalg/blas/base.hpp"
 #include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
 #include "math/linalg/blas/gemm_nn_vector.hpp"
 #include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_threaded.hpp"
 #include "math/linalg/blas/gemm_nt_vector.hpp"
+#include "math/linalg/blas/gemm_packed.hpp"
 #include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_threaded.hpp"
 #include "math/linalg/blas/gemm_tn_vector.hpp"
 #include "math/linalg/prototype.hpp"
 #include "math/meta/math_type_traits.hpp"
@@ -1087,9 +1091,23 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayT
   {
     OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
                              ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+                             : platform::Parallelisation::NOT_PARALLEL,
+    PACKED_FLAGS = HasPackedGemm<Type> ? platform::Parallelisation::VECTORISE |
+                                             platform::Parallelisation::THREADING
+                                       : OPTIMISATION_FLAGS
   };
 
+  // large products are computed with the cache blocked, multi-threaded kernel
+  if (linalg::details::UsePackedGemm(aview.height(), bview.width(), aview.width()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * _B + _beta * _C), PACKED_FLAGS>
+        gemm_nn_packed;
+
+    gemm_nn_packed(static_cast<Type>(1), aview, bview, static_cast<Type>(0), ret.View());
+    return;
+  }
+
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
        Computes(_C <= _alpha * _A * _B + _beta * _C), OPTIMISATION_FLAGS>
       gemm_nn;
@@ -1137,9 +1155,23 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
   {
     OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
                              ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+                             : platform::Parallelisation::NOT_PARALLEL,
+    PACKED_FLAGS = HasPackedGemm<Type> ? platform::Parallelisation::VECTORISE |
+                                             platform::Parallelisation::THREADING
+                                       : OPTIMISATION_FLAGS
   };
 
+  // large products are computed with the cache blocked, multi-threaded kernel
+  if (linalg::details::UsePackedGemm(aview.height(), bview.height(), aview.width()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * _A * T(_B) + _beta * _C), PACKED_FLAGS>
+        gemm_nt_packed;
+
+    gemm_nt_packed(static_cast<Type>(1), aview, bview, static_cast<Type>(0), ret.View());
+    return;
+  }
+
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
        Computes(_C <= _alpha * _A * T(_B) + _beta * _C), OPTIMISATION_FLAGS>
       gemm_nt;
@@ -1188,9 +1220,23 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
   {
     OPTIMISATION_FLAGS = meta::HasVectorSupport<Type>::value
                              ? platform::Parallelisation::VECTORISE
-                             : platform::Parallelisation::NOT_PARALLEL
+                             : platform::Parallelisation::NOT_PARALLEL,
+    PACKED_FLAGS = HasPackedGemm<Type> ? platform::Parallelisation::VECTORISE |
+                                             platform::Parallelisation::THREADING
+                                       : OPTIMISATION_FLAGS
   };
 
+  // large products are computed with the cache blocked, multi-threaded kernel
+  if (linalg::details::UsePackedGemm(aview.width(), bview.width(), aview.height()))
+  {
+    Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
+         Computes(_C <= _alpha * T(_A) * _B + _beta * _C), PACKED_FLAGS>
+        gemm_tn_packed;
+
+    gemm_tn_packed(static_cast<Type>(1), aview, bview, static_cast<Type>(0), ret.View());
+    return;
+  }
+
   Blas<Type, Signature(_C <= _alpha, _A, _B, _beta, _C),
        Computes(_C <= _alpha * T(_A) * _B + _beta * _C), OPTIMISATION_FLAGS>
       gemm_tn;
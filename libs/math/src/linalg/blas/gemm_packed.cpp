@@ -0,0 +1,312 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/gemm_packed.hpp"
+#include "math/tensor/tensor_view.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace details {
+namespace {
+
+constexpr SizeType MR = 8;     ///< The number of rows of the micro tile
+constexpr SizeType NR = 4;     ///< The number of columns of the micro tile
+constexpr SizeType MC = 128;   ///< The number of rows of A packed at a time
+constexpr SizeType KC = 256;   ///< The depth of the packed panels
+constexpr SizeType NC = 2048;  ///< The number of columns of B packed at a time
+
+/// The minimum number of rows or columns of C computed by each thread
+constexpr SizeType MIN_ROWS_PER_TASK = 64;
+
+constexpr SizeType RoundUp(SizeType value, SizeType multiple)
+{
+  return ((value + multiple - 1) / multiple) * multiple;
+}
+
+/**
+ * Read only access to a column major operand which is optionally transposed
+ */
+template <typename T>
+class Operand
+{
+public:
+  Operand(TensorView<T> const &view, bool transposed)
+    : data_{view.data().pointer()}
+    , stride_{view.padded_height()}
+    , transposed_{transposed}
+  {}
+
+  T operator()(SizeType i, SizeType j) const
+  {
+    return transposed_ ? data_[j + (i * stride_)] : data_[i + (j * stride_)];
+  }
+
+private:
+  T const *data_;
+  SizeType stride_;
+  bool     transposed_;
+};
+
+/**
+ * Copy an mc x kc block of op(A) into consecutive panels of MR rows. The panels are stored depth
+ * first and the last panel is padded with zeros.
+ */
+template <typename T>
+void PackA(Operand<T> const &a, SizeType row, SizeType depth, SizeType mc, SizeType kc, T *packed)
+{
+  for (SizeType ir = 0; ir < mc; ir += MR)
+  {
+    SizeType const rows = std::min(MR, mc - ir);
+
+    for (SizeType p = 0; p < kc; ++p)
+    {
+      for (SizeType i = 0; i < MR; ++i)
+      {
+        *packed++ = (i < rows) ? a(row + ir + i, depth + p) : T{0};
+      }
+    }
+  }
+}
+
+/**
+ * Copy a kc x nc panel of op(B) into consecutive panels of NR columns. The panels are stored depth
+ * first and the last panel is padded with zeros.
+ */
+template <typename T>
+void PackB(Operand<T> const &b, SizeType depth, SizeType col, SizeType kc, SizeType nc, T *packed)
+{
+  for (SizeType jr = 0; jr < nc; jr += NR)
+  {
+    SizeType const cols = std::min(NR, nc - jr);
+
+    for (SizeType p = 0; p < kc; ++p)
+    {
+      for (SizeType j = 0; j < NR; ++j)
+      {
+        *packed++ = (j < cols) ? b(depth + p, col + jr + j) : T{0};
+      }
+    }
+  }
+}
+
+/**
+ * Accumulate the product of an MR row panel of A and an NR column panel of B in registers and add
+ * the (rows x cols) valid part of the result to C
+ */
+template <typename T>
+void MicroKernel(SizeType kc, T const *a, T const *b, T alpha, T *c, SizeType ldc, SizeType rows,
+                 SizeType cols)
+{
+  T acc[NR][MR]{};
+
+  for (SizeType p = 0; p < kc; ++p)
+  {
+    for (SizeType j = 0; j < NR; ++j)
+    {
+      T const b_pj = b[j];
+
+      for (SizeType i = 0; i < MR; ++i)
+      {
+        acc[j][i] = static_cast<T>(acc[j][i] + a[i] * b_pj);
+      }
+    }
+
+    a += MR;
+    b += NR;
+  }
+
+  for (SizeType j = 0; j < cols; ++j)
+  {
+    for (SizeType i = 0; i < rows; ++i)
+    {
+      c[i + (j * ldc)] = static_cast<T>(c[i + (j * ldc)] + alpha * acc[j][i]);
+    }
+  }
+}
+
+/**
+ * Compute the rows [row_begin, row_end) and columns [col_begin, col_end) of C
+ */
+template <typename T>
+void GemmBlock(Operand<T> const &a, Operand<T> const &b, SizeType k, T alpha, T beta, T *c,
+               SizeType ldc, SizeType row_begin, SizeType row_end, SizeType col_begin,
+               SizeType col_end)
+{
+  if (beta != T{1})
+  {
+    for (SizeType j = col_begin; j < col_end; ++j)
+    {
+      for (SizeType i = row_begin; i < row_end; ++i)
+      {
+        T &value = c[i + (j * ldc)];
+        value    = (beta == T{0}) ? T{0} : static_cast<T>(beta * value);
+      }
+    }
+  }
+
+  if ((alpha == T{0}) || (k == 0))
+  {
+    return;
+  }
+
+  std::vector<T> packed_a(MC * KC);
+  std::vector<T> packed_b(KC * RoundUp(std::min(NC, col_end - col_begin), NR));
+
+  for (SizeType jc = col_begin; jc < col_end; jc += NC)
+  {
+    SizeType const nc = std::min(NC, col_end - jc);
+
+    for (SizeType pc = 0; pc < k; pc += KC)
+    {
+      SizeType const kc = std::min(KC, k - pc);
+
+      PackB(b, pc, jc, kc, nc, packed_b.data());
+
+      for (SizeType ic = row_begin; ic < row_end; ic += MC)
+      {
+        SizeType const mc = std::min(MC, row_end - ic);
+
+        PackA(a, ic, pc, mc, kc, packed_a.data());
+
+        for (SizeType jr = 0; jr < nc; jr += NR)
+        {
+          for (SizeType ir = 0; ir < mc; ir += MR)
+          {
+            MicroKernel(kc, packed_a.data() + (ir * kc), packed_b.data() + (jr * kc), alpha,
+                        c + (ic + ir) + ((jc + jr) * ldc), ldc, std::min(MR, mc - ir),
+                        std::min(NR, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+threading::Pool &GemmPool()
+{
+  static threading::Pool pool{std::max(std::thread::hardware_concurrency(), 1u), "GEMM"};
+  return pool;
+}
+
+template <typename T>
+SizeType NumberOfTasks(SizeType m, SizeType n)
+{
+  // fixed point arithmetic records overflows in a state shared by all threads, so it must not be
+  // computed concurrently
+  if (meta::IsFixedPoint<T>)
+  {
+    return 1;
+  }
+
+  auto const threads = static_cast<SizeType>(std::thread::hardware_concurrency());
+
+  return std::max<SizeType>(1, std::min(threads, std::max(m, n) / MIN_ROWS_PER_TASK));
+}
+
+}  // namespace
+
+template <typename T>
+void GemmPacked(bool transpose_a, bool transpose_b, T alpha, TensorView<T> const &a,
+                TensorView<T> const &b, T beta, TensorView<T> &c)
+{
+  SizeType const m = c.height();
+  SizeType const n = c.width();
+  SizeType const k = transpose_a ? a.height() : a.width();
+
+  if ((m == 0) || (n == 0) || (((alpha == T{0}) || (k == 0)) && (beta == T{1})))
+  {
+    return;
+  }
+
+  Operand<T> const op_a{a, transpose_a};
+  Operand<T> const op_b{b, transpose_b};
+  T *const         c_data = c.data().pointer();
+  SizeType const   ldc    = c.padded_height();
+
+  SizeType const tasks = NumberOfTasks<T>(m, n);
+  if (tasks == 1)
+  {
+    GemmBlock(op_a, op_b, k, alpha, beta, c_data, ldc, 0, m, 0, n);
+    return;
+  }
+
+  // split the larger dimension of C into blocks which are aligned to the micro tile
+  bool const     split_columns = n >= m;
+  SizeType const extent        = split_columns ? n : m;
+  SizeType const chunk = RoundUp((extent + tasks - 1) / tasks, split_columns ? NR : MR);
+
+  auto const compute = [&](SizeType begin, SizeType end) {
+    if (split_columns)
+    {
+      GemmBlock(op_a, op_b, k, alpha, beta, c_data, ldc, 0, m, begin, end);
+    }
+    else
+    {
+      GemmBlock(op_a, op_b, k, alpha, beta, c_data, ldc, begin, end, 0, n);
+    }
+  };
+
+  // the first block is computed by the calling thread
+  std::vector<std::future<void>> results{};
+  for (SizeType begin = chunk; begin < extent; begin += chunk)
+  {
+    SizeType const end = std::min(extent, begin + chunk);
+    results.emplace_back(GemmPool().Dispatch([&compute, begin, end]() { compute(begin, end); }));
+  }
+
+  compute(0, std::min(extent, chunk));
+
+  for (auto &result : results)
+  {
+    result.get();
+  }
+}
+
+template void GemmPacked<float>(bool, bool, float, TensorView<float> const &,
+                                TensorView<float> const &, float, TensorView<float> &);
+template void GemmPacked<double>(bool, bool, double, TensorView<double> const &,
+                                 TensorView<double> const &, double, TensorView<double> &);
+template void GemmPacked<fixed_point::fp32_t>(bool, bool, fixed_point::fp32_t,
+                                              TensorView<fixed_point::fp32_t> const &,
+                                              TensorView<fixed_point::fp32_t> const &,
+                                              fixed_point::fp32_t,
+                                              TensorView<fixed_point::fp32_t> &);
+template void GemmPacked<fixed_point::fp64_t>(bool, bool, fixed_point::fp64_t,
+                                              TensorView<fixed_point::fp64_t> const &,
+                                              TensorView<fixed_point::fp64_t> const &,
+                                              fixed_point::fp64_t,
+                                              TensorView<fixed_point::fp64_t> &);
+template void GemmPacked<fixed_point::fp128_t>(bool, bool, fixed_point::fp128_t,
+                                               TensorView<fixed_point::fp128_t> const &,
+                                               TensorView<fixed_point::fp128_t> const &,
+                                               fixed_point::fp128_t,
+                                               TensorView<fixed_point::fp128_t> &);
+
+}  // namespace details
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
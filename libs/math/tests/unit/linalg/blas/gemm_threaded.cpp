@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_threaded.hpp"
+#include "math/linalg/blas/gemm_nt_novector.hpp"
+#include "math/linalg/blas/gemm_nt_threaded.hpp"
+#include "math/linalg/blas/gemm_tn_novector.hpp"
+#include "math/linalg/blas/gemm_tn_threaded.hpp"
+#include "math/linalg/blas/gemm_tt_novector.hpp"
+#include "math/linalg/blas/gemm_tt_threaded.hpp"
+#include "math/linalg/prototype.hpp"
+#include "math/matrix_operations.hpp"
+#include "math/tensor/tensor.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace math {
+namespace test {
+
+using namespace fetch::math::linalg;
+
+enum : uint64_t
+{
+  THREADED = platform::Parallelisation::VECTORISE | platform::Parallelisation::THREADING
+};
+
+template <typename T>
+class BlasGemmThreadedTest : public ::testing::Test
+{
+protected:
+  using TensorType = Tensor<T>;
+
+  /// fixed point products are rounded in a different order to the reference implementation
+  static T Tolerance()
+  {
+    return fetch::math::Type<T>("0.001");
+  }
+
+  static TensorType Random(SizeType height, SizeType width)
+  {
+    TensorType tensor({height, width});
+    tensor.FillUniformRandom();
+    return tensor;
+  }
+
+  /**
+   * Compare the threaded implementation against the reference one for a range of shapes which do
+   * not line up with the micro tile or the cache blocks
+   */
+  template <typename Threaded, typename Reference>
+  static void CheckAgainstReference(bool transpose_a, bool transpose_b)
+  {
+    std::vector<std::vector<SizeType>> const shapes{
+        {1, 1, 1}, {7, 3, 5}, {8, 4, 16}, {67, 131, 259}, {130, 9, 300}, {257, 70, 33}};
+
+    // powers of two keep the fixed point results exact
+    std::vector<std::vector<std::string>> const scalars{
+        {"1", "0"}, {"0.5", "2"}, {"0", "0.5"}, {"2", "1"}};
+
+    for (auto const &shape : shapes)
+    {
+      SizeType const m = shape[0];
+      SizeType const n = shape[1];
+      SizeType const k = shape[2];
+
+      TensorType const a = transpose_a ? Random(k, m) : Random(m, k);
+      TensorType const b = transpose_b ? Random(n, k) : Random(k, n);
+      TensorType const c = Random(m, n);
+
+      for (auto const &scalar : scalars)
+      {
+        TensorType expected = c.Copy();
+        TensorType actual   = c.Copy();
+
+        T const alpha = fetch::math::Type<T>(scalar[0]);
+        T const beta  = fetch::math::Type<T>(scalar[1]);
+
+        Reference{}(alpha, a.View(), b.View(), beta, expected.View());
+        Threaded{}(alpha, a.View(), b.View(), beta, actual.View());
+
+        EXPECT_TRUE(actual.AllClose(expected, Tolerance(), Tolerance()))
+            << "m: " << m << " n: " << n << " k: " << k;
+      }
+    }
+  }
+};
+
+TYPED_TEST_SUITE(BlasGemmThreadedTest, FloatingTypes, );
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_nn_threaded)
+{
+  using Threaded = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * _A * _B + _beta * _C), THREADED>;
+  using Reference =
+      Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+           Computes(_C <= _alpha * _A * _B + _beta * _C), platform::Parallelisation::NOT_PARALLEL>;
+
+  this->template CheckAgainstReference<Threaded, Reference>(false, false);
+}
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_nt_threaded)
+{
+  using Threaded = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * _A * T(_B) + _beta * _C), THREADED>;
+  using Reference = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * _A * T(_B) + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  this->template CheckAgainstReference<Threaded, Reference>(false, true);
+}
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_tn_threaded)
+{
+  using Threaded = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * T(_A) * _B + _beta * _C), THREADED>;
+  using Reference = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * T(_A) * _B + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  this->template CheckAgainstReference<Threaded, Reference>(true, false);
+}
+
+TYPED_TEST(BlasGemmThreadedTest, gemm_tt_threaded)
+{
+  using Threaded = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                        Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C), THREADED>;
+  using Reference = Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+                         Computes(_C <= _alpha * T(_A) * T(_B) + _beta * _C),
+                         platform::Parallelisation::NOT_PARALLEL>;
+
+  this->template CheckAgainstReference<Threaded, Reference>(true, true);
+}
+
+TYPED_TEST(BlasGemmThreadedTest, dot_selects_threaded_gemm_for_large_products)
+{
+  using TensorType = Tensor<TypeParam>;
+
+  auto const a = this->Random(96, 80);
+  auto const b = this->Random(80, 72);
+
+  TensorType expected({96, 72});
+  Blas<TypeParam, Signature(_C <= _alpha, _A, _B, _beta, _C),
+       Computes(_C <= _alpha * _A * _B + _beta * _C), platform::Parallelisation::NOT_PARALLEL>
+      gemm_nn;
+  gemm_nn(TypeParam{1}, a.View(), b.View(), TypeParam{0}, expected.View());
+
+  ASSERT_TRUE(details::UsePackedGemm(96, 72, 80));
+
+  auto const tolerance = this->Tolerance();
+  EXPECT_TRUE(fetch::math::Dot(a, b).AllClose(expected, tolerance, tolerance));
+  EXPECT_TRUE(fetch::math::DotTranspose(a, b.Transpose()).AllClose(expected, tolerance, tolerance));
+  EXPECT_TRUE(fetch::math::TransposeDot(a.Transpose(), b).AllClose(expected, tolerance, tolerance));
+}
+
+}  // namespace test
+}  // namespace math
+}  // namespace fetch
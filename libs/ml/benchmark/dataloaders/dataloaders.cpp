@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "logging/logging.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/word2vec_loaders/sgns_w2v_dataloader.hpp"
+#include "ml/layers/skip_gram.hpp"
+#include "ml/ops/loss_functions/cross_entropy_loss.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/optimisation/lazy_adam_optimiser.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+// the word2vec example's dataloader parameters
+SizeType const WINDOW_SIZE          = 2;
+SizeType const NEGATIVE_SAMPLE_SIZE = 5;
+SizeType const MIN_COUNT            = 5;
+
+// a synthetic corpus with a Zipf like word distribution
+SizeType const CORPUS_SIZE = 20000;
+SizeType const VOCAB_SIZE  = 2000;
+
+std::string Corpus()
+{
+  std::mt19937                           rng(1337);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  std::string corpus;
+  for (SizeType i = 0; i < CORPUS_SIZE; ++i)
+  {
+    auto index =
+        static_cast<SizeType>(std::pow(static_cast<double>(VOCAB_SIZE), uniform(rng))) - 1;
+
+    // words only consist of letters, as the dataloader removes everything else
+    std::string word = "w";
+    do
+    {
+      word += static_cast<char>('a' + index % 26);
+      index /= 26;
+    } while (index > 0);
+
+    corpus += word + " ";
+  }
+
+  return corpus;
+}
+
+/**
+ * Building the vocab and unigram table of the word2vec loader is slow, so every benchmark trains
+ * from the same loader
+ */
+template <typename TensorType>
+std::shared_ptr<fetch::ml::dataloaders::GraphW2VLoader<TensorType>> W2VLoader()
+{
+  static auto loader = [] {
+    auto ret = std::make_shared<fetch::ml::dataloaders::GraphW2VLoader<TensorType>>(
+        WINDOW_SIZE, NEGATIVE_SAMPLE_SIZE, fetch::math::Type<fetch::fixed_point::fp64_t>("0.001"),
+        fetch::math::numeric_max<SizeType>());
+    ret->BuildVocabAndData({Corpus()}, MIN_COUNT);
+    return ret;
+  }();
+
+  loader->Reset();
+  return loader;
+}
+
+/**
+ * Trains the model of the word2vec example for one epoch per iteration. With a queue size of 0
+ * the batches are prepared synchronously by the word2vec loader, otherwise they are prefetched
+ * by a PrefetchingDataLoader with the given queue size.
+ */
+template <typename T>
+void BM_Word2Vec_Epoch(::benchmark::State &state)
+{
+  using DataType   = T;
+  using TensorType = fetch::math::Tensor<DataType>;
+
+  fetch::SetGlobalLogLevel(fetch::LogLevel::CRITICAL);
+
+  auto batch_size     = static_cast<SizeType>(state.range(0));
+  auto embedding_size = static_cast<SizeType>(state.range(1));
+  auto queue_size     = static_cast<SizeType>(state.range(2));
+
+  auto w2v_loader = W2VLoader<TensorType>();
+
+  std::shared_ptr<fetch::ml::dataloaders::DataLoader<TensorType>> loader = w2v_loader;
+  if (queue_size > 0)
+  {
+    loader = std::make_shared<fetch::ml::dataloaders::PrefetchingDataLoader<TensorType>>(
+        w2v_loader, queue_size);
+  }
+
+  auto g = std::make_shared<fetch::ml::Graph<TensorType>>();
+  g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Input", {});
+  g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Context", {});
+  g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("Label", {});
+  std::string skipgram = g->template AddNode<fetch::ml::layers::SkipGram<TensorType>>(
+      "SkipGram", {"Input", "Context"}, SizeType(1), SizeType(1), embedding_size,
+      w2v_loader->vocab_size());
+  std::string error = g->template AddNode<fetch::ml::ops::CrossEntropyLoss<TensorType>>(
+      "Error", {skipgram, "Label"});
+
+  fetch::ml::optimisers::LazyAdamOptimiser<TensorType> optimiser(
+      g, {"Input", "Context"}, "Label", error, fetch::math::Type<DataType>("0.001"));
+
+  for (auto _ : state)
+  {
+    ::benchmark::DoNotOptimize(optimiser.Run(*loader, batch_size));
+  }
+
+  state.counters["Words"] = static_cast<double>(w2v_loader->Size());
+}
+
+/**
+ * Prepares the batches of one epoch per iteration without training on them, i.e. the time which
+ * prefetching can at most hide behind training
+ */
+template <typename T>
+void BM_Word2Vec_Prepare_Epoch(::benchmark::State &state)
+{
+  using TensorType = fetch::math::Tensor<T>;
+
+  auto batch_size = static_cast<SizeType>(state.range(0));
+  auto loader     = W2VLoader<TensorType>();
+
+  for (auto _ : state)
+  {
+    loader->Reset();
+
+    bool is_done_set = false;
+    while (!is_done_set && !loader->IsDone())
+    {
+      ::benchmark::DoNotOptimize(loader->PrepareBatch(batch_size, is_done_set));
+    }
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Word2Vec_Prepare_Epoch, float)
+    ->Arg(128)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Word2Vec_Epoch, float)
+    ->Args({128, 100, 0})
+    ->Args({128, 100, 4})
+    ->Args({1000, 100, 0})
+    ->Args({1000, 100, 4})
+    ->Args({1000, 500, 0})
+    ->Args({1000, 500, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Word2Vec_Epoch, double)
+    ->Args({1000, 100, 0})
+    ->Args({1000, 100, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// fixed point batches are assembled on the training thread
+BENCHMARK_TEMPLATE(BM_Word2Vec_Epoch, fetch::fixed_point::fp64_t)
+    ->Args({1000, 100, 0})
+    ->Args({1000, 100, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
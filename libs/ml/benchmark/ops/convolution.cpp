@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/ops/convolution_1d.hpp"
+#include "ml/ops/convolution_2d.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+/**
+ * Convolution2D over batches of images of common sizes. The arguments are the batch size, input
+ * channels, image height and width, output channels, kernel size and stride.
+ */
+template <class T, bool BACKWARD>
+void BM_Conv2DImages(benchmark::State &state)
+{
+  using TensorType    = fetch::math::Tensor<T>;
+  using VecTensorType = typename fetch::ml::ops::Ops<TensorType>::VecTensorType;
+
+  auto const batch_size      = static_cast<SizeType>(state.range(0));
+  auto const input_channels  = static_cast<SizeType>(state.range(1));
+  auto const image_height    = static_cast<SizeType>(state.range(2));
+  auto const image_width     = static_cast<SizeType>(state.range(3));
+  auto const output_channels = static_cast<SizeType>(state.range(4));
+  auto const kernel_size     = static_cast<SizeType>(state.range(5));
+  auto const stride          = static_cast<SizeType>(state.range(6));
+
+  TensorType input({input_channels, image_height, image_width, batch_size});
+  TensorType kernels({output_channels, input_channels, kernel_size, kernel_size, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  VecTensorType const inputs{std::make_shared<TensorType>(input),
+                             std::make_shared<TensorType>(kernels)};
+
+  fetch::ml::ops::Convolution2D<TensorType> conv_2d(stride);
+  TensorType                                output(conv_2d.ComputeOutputShape(inputs));
+  output.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    if (BACKWARD)
+    {
+      benchmark::DoNotOptimize(conv_2d.Backward(inputs, output));
+    }
+    else
+    {
+      conv_2d.Forward(inputs, output);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
+/**
+ * Convolution1D over batches of sequences. The arguments are the batch size, input channels,
+ * sequence length, output channels, kernel size and stride.
+ */
+template <class T, bool BACKWARD>
+void BM_Conv1DSequences(benchmark::State &state)
+{
+  using TensorType    = fetch::math::Tensor<T>;
+  using VecTensorType = typename fetch::ml::ops::Ops<TensorType>::VecTensorType;
+
+  auto const batch_size      = static_cast<SizeType>(state.range(0));
+  auto const input_channels  = static_cast<SizeType>(state.range(1));
+  auto const length          = static_cast<SizeType>(state.range(2));
+  auto const output_channels = static_cast<SizeType>(state.range(3));
+  auto const kernel_size     = static_cast<SizeType>(state.range(4));
+  auto const stride          = static_cast<SizeType>(state.range(5));
+
+  TensorType input({input_channels, length, batch_size});
+  TensorType kernels({output_channels, input_channels, kernel_size, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  VecTensorType const inputs{std::make_shared<TensorType>(input),
+                             std::make_shared<TensorType>(kernels)};
+
+  fetch::ml::ops::Convolution1D<TensorType> conv_1d(stride);
+  TensorType                                output(conv_1d.ComputeOutputShape(inputs));
+  output.FillUniformRandom();
+
+  for (auto _ : state)
+  {
+    if (BACKWARD)
+    {
+      benchmark::DoNotOptimize(conv_1d.Backward(inputs, output));
+    }
+    else
+    {
+      conv_1d.Forward(inputs, output);
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
+// batch, input channels, height, width, output channels, kernel size, stride
+void ImageSizes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->Args({32, 1, 28, 28, 16, 5, 1});   // MNIST first layer
+  benchmark->Args({32, 16, 12, 12, 32, 3, 1});  // MNIST second layer
+  benchmark->Args({32, 3, 32, 32, 32, 3, 1});   // CIFAR first layer
+  benchmark->Args({32, 32, 16, 16, 64, 3, 2});  // strided downsampling
+  benchmark->Args({8, 64, 32, 32, 64, 1, 1});   // pointwise
+  benchmark->Args({8, 3, 64, 64, 16, 3, 1});    // larger images
+}
+
+// batch, input channels, length, output channels, kernel size, stride
+void SequenceSizes(benchmark::internal::Benchmark *benchmark)
+{
+  benchmark->Args({32, 16, 128, 32, 3, 1});
+  benchmark->Args({32, 64, 256, 64, 5, 2});
+  benchmark->Args({8, 128, 512, 128, 1, 1});
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Conv2DImages, float, false)->Apply(ImageSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DImages, float, true)->Apply(ImageSizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DImages, double, false)
+    ->Apply(ImageSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DImages, double, true)
+    ->Apply(ImageSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DImages, fetch::fixed_point::fp64_t, false)
+    ->Apply(ImageSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv2DImages, fetch::fixed_point::fp64_t, true)
+    ->Apply(ImageSizes)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Conv1DSequences, float, false)
+    ->Apply(SequenceSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv1DSequences, float, true)
+    ->Apply(SequenceSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv1DSequences, fetch::fixed_point::fp64_t, false)
+    ->Apply(SequenceSizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Conv1DSequences, fetch::fixed_point::fp64_t, true)
+    ->Apply(SequenceSizes)
+    ->Unit(benchmark::kMillisecond);
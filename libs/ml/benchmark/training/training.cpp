@@ -23,11 +23,55 @@
 #include "ml/ops/loss_functions/mean_square_error_loss.hpp"
 #include "ml/ops/placeholder.hpp"
 #include "ml/optimisation/sgd_optimiser.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
 
 #include "benchmark/benchmark.h"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <new>
 #include <string>
+#include <vector>
+
+namespace {
+
+// The total number of heap allocations made by the benchmark binary (see operator new below)
+std::atomic<std::size_t> allocation_count{0};
+
+/**
+ * Two fully connected layers with relu activations and a mean square error loss
+ */
+template <typename TensorType>
+std::shared_ptr<fetch::ml::Graph<TensorType>> MakeGraph(fetch::math::SizeType input_size,
+                                                        fetch::math::SizeType hidden_size,
+                                                        fetch::math::SizeType output_size,
+                                                        std::string &input_name,
+                                                        std::string &label_name,
+                                                        std::string &error_name)
+{
+  auto g = std::make_shared<fetch::ml::Graph<TensorType>>();
+
+  input_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("", {});
+  label_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("", {});
+
+  std::string h_1 = g->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+      "FC1", {input_name}, input_size, hidden_size);
+  std::string a_1 = g->template AddNode<fetch::ml::ops::Relu<TensorType>>("", {h_1});
+
+  std::string h_2 = g->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
+      "FC2", {a_1}, hidden_size, output_size);
+  std::string output_name = g->template AddNode<fetch::ml::ops::Relu<TensorType>>("", {h_2});
+
+  error_name = g->template AddNode<fetch::ml::ops::MeanSquareErrorLoss<TensorType>>(
+      "", {output_name, label_name});
+
+  return g;
+}
+
+}  // namespace
 
 template <typename T, fetch::math::SizeType B, fetch::math::SizeType I, fetch::math::SizeType H,
           fetch::math::SizeType O, fetch::math::SizeType E>
@@ -54,22 +98,11 @@ void BM_Setup_And_Train(benchmark::State &state)
   for (auto _ : state)
   {
     // make a graph
-    auto g = std::make_shared<fetch::ml::Graph<TensorType>>();
-
-    // set up the neural net architecture
-    std::string input_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("", {});
-    std::string label_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TensorType>>("", {});
-
-    std::string h_1 = g->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
-        "FC1", {input_name}, input_size, hidden_size);
-    std::string a_1 = g->template AddNode<fetch::ml::ops::Relu<TensorType>>("", {h_1});
-
-    std::string h_2 = g->template AddNode<fetch::ml::layers::FullyConnected<TensorType>>(
-        "FC2", {a_1}, hidden_size, output_size);
-    std::string output_name = g->template AddNode<fetch::ml::ops::Relu<TensorType>>("", {h_2});
-
-    std::string error_name = g->template AddNode<fetch::ml::ops::MeanSquareErrorLoss<TensorType>>(
-        "", {output_name, label_name});
+    std::string input_name;
+    std::string label_name;
+    std::string error_name;
+    auto        g = MakeGraph<TensorType>(input_size, hidden_size, output_size, input_name,
+                                   label_name, error_name);
 
     // Initialise Optimiser
     fetch::ml::optimisers::SGDOptimiser<TensorType> optimiser(g, {input_name}, label_name,
@@ -83,6 +116,93 @@ void BM_Setup_And_Train(benchmark::State &state)
   }
 }
 
+/**
+ * A single steady state training step (forward, backward and gradient update) of a graph which has
+ * already been compiled and trained on a batch of the same size
+ */
+template <typename T, fetch::math::SizeType B, fetch::math::SizeType I, fetch::math::SizeType H,
+          fetch::math::SizeType O>
+void BM_Train_Step(benchmark::State &state)
+{
+  using SizeType   = fetch::math::SizeType;
+  using DataType   = T;
+  using TensorType = fetch::math::Tensor<DataType>;
+
+  SizeType batch_size = B;
+
+  TensorType data({I, batch_size});
+  TensorType gt({O, batch_size});
+  data.FillUniformRandom();
+  gt.FillUniformRandom();
+
+  std::string input_name;
+  std::string label_name;
+  std::string error_name;
+  auto g = MakeGraph<TensorType>(I, H, O, input_name, label_name, error_name);
+
+  fetch::ml::optimisers::SGDOptimiser<TensorType> optimiser(g, {input_name}, label_name,
+                                                            error_name,
+                                                            fetch::math::Type<DataType>("0.1"));
+  std::vector<TensorType> const inputs{data};
+
+  // the first step compiles the graph and sizes all of the buffers
+  optimiser.Run(inputs, gt, batch_size);
+
+  std::size_t const initial_allocations = allocation_count;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(optimiser.Run(inputs, gt, batch_size));
+  }
+
+  auto const allocations = static_cast<double>(allocation_count - initial_allocations);
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+  state.counters["allocs/step"] =
+      benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * A steady state training step with each batch split across state.range(0) threads. The wall clock
+ * time is reported, since the CPU time of the worker threads is not attributed to the benchmark.
+ */
+template <typename T, fetch::math::SizeType B, fetch::math::SizeType I, fetch::math::SizeType H,
+          fetch::math::SizeType O>
+void BM_Data_Parallel_Train_Step(benchmark::State &state)
+{
+  using SizeType   = fetch::math::SizeType;
+  using DataType   = T;
+  using TensorType = fetch::math::Tensor<DataType>;
+
+  SizeType batch_size = B;
+
+  TensorType data({I, batch_size});
+  TensorType gt({O, batch_size});
+  data.FillUniformRandom();
+  gt.FillUniformRandom();
+
+  std::string input_name;
+  std::string label_name;
+  std::string error_name;
+  auto g = MakeGraph<TensorType>(I, H, O, input_name, label_name, error_name);
+
+  fetch::ml::optimisers::SGDOptimiser<TensorType> optimiser(g, {input_name}, label_name,
+                                                            error_name,
+                                                            fetch::math::Type<DataType>("0.1"));
+  optimiser.SetThreadCount(static_cast<SizeType>(state.range(0)));
+  std::vector<TensorType> const inputs{data};
+
+  // the first step builds the graph replicas and sizes all of the buffers
+  optimiser.Run(inputs, gt, batch_size);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(optimiser.Run(inputs, gt, batch_size));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch_size));
+}
+
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 1, 1, 1, 1, 100)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 10, 10, 10, 10, 100)->Unit(benchmark::kMillisecond);
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 100, 100, 100, 100, 100)
@@ -90,4 +210,52 @@ BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 100, 100, 100, 100, 100)
 BENCHMARK_TEMPLATE(BM_Setup_And_Train, float, 100, 1000, 1000, 1000, 100)
     ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_TEMPLATE(BM_Train_Step, float, 1, 1, 1, 1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Train_Step, float, 32, 10, 10, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Train_Step, float, 32, 100, 100, 100)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Train_Step, float, 128, 1000, 1000, 1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Train_Step, fetch::fixed_point::fp64_t, 32, 100, 100, 100)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_Data_Parallel_Train_Step, float, 256, 100, 100, 100)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Data_Parallel_Train_Step, float, 256, 1000, 1000, 1000)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Data_Parallel_Train_Step, double, 256, 1000, 1000, 1000)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Replace the global allocation functions in order to count the allocations made during a training
+// step. This applies to the whole benchmark binary, but only adds an atomic increment.
+void *operator new(std::size_t size)
+{
+  ++allocation_count;
+
+  void *ptr = std::malloc((size == 0) ? 1 : size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
 BENCHMARK_MAIN();
@@ -23,6 +23,10 @@
 #include "ml/ops/constant.hpp"
 #include "ml/ops/trainable.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // TODO(#1554) - we should only reset the cache for trained nodes, not all nodes
 // TODO(1467) - implement validity checks on graph compilation - e.g. loss function should not
 // appear in middle of graph
@@ -164,9 +168,32 @@ protected:
   void       InsertSharedCopy(std::shared_ptr<Graph<TensorType>> output_ptr);
   TensorType ForwardPropagate(std::string const &node_name, bool is_training = true);
 
+  ArrayPtrType ScheduledForward(std::string const &node_name, bool is_training);
+  void         ScheduledBackward(std::string const &node_name, TensorType const &error_signal);
+  TensorType   ScheduledErrorSignal(std::string const &node_name) const;
+
 private:
+  /**
+   * A node of the compiled execution schedule, together with the storage for the error signals
+   * it receives during backpropagation. The storage is kept between passes so that training steps
+   * on batches of the same size do not need to reallocate it.
+   */
+  struct ScheduledNode
+  {
+    NodePtrType           node;
+    std::vector<SizeType> inputs;  ///< schedule positions of the input nodes
+    TensorType            error_signal;
+    TensorType            accumulated_error_signal;
+    SizeType              error_signal_count{0};
+  };
+
   GraphState graph_state_ = GraphState::NOT_COMPILED;
 
+  // nodes in topological order, and the positions of the nodes each node depends upon
+  std::vector<ScheduledNode>                             schedule_;
+  std::unordered_map<std::string, SizeType>              schedule_positions_;
+  std::unordered_map<std::string, std::vector<SizeType>> execution_plans_;
+
   friend class optimisers::Optimiser<TensorType>;
   friend class model::ModelInterface<TensorType>;
 
@@ -188,6 +215,11 @@ private:
 
   void ResetGraphCache(bool input_size_changed, std::shared_ptr<Node<T>> n = {});
 
+  void                         CompileSchedule();
+  void                         ResetSchedule();
+  std::vector<SizeType> const &ExecutionPlan(std::string const &node_name);
+  void AccumulateErrorSignal(ScheduledNode &scheduled_node, TensorType const &error_signal);
+
   //////////////////////////////////////////
   /// recursive implementation functions ///
   //////////////////////////////////////////
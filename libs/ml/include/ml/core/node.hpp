@@ -94,7 +94,7 @@ public:
     , operation_type_(old_node.OperationType())
     , op_ptr_(std::move(op_ptr))
   {
-    cached_output_ = old_node.cached_output_.Copy();
+    cached_output_ = std::make_shared<TensorType>(old_node.cached_output_->Copy());
   }
 
   virtual ~Node() = default;
@@ -112,16 +112,17 @@ public:
   /// FORWARD/BACKWARD OPERATIONS ///
   ///////////////////////////////////
 
-  VecTensorType               GatherInputs() const;
+  VecTensorType const &       GatherInputs();
   std::shared_ptr<TensorType> Evaluate(bool is_training);
 
-  NodeErrorMapType BackPropagate(TensorType const &error_signal);
+  std::vector<TensorType> Backward(TensorType const &error_signal);
+  NodeErrorMapType        BackPropagate(TensorType const &error_signal);
 
   void                                AddInput(NodeWeakPtrType const &i);
   std::vector<std::string>            GetInputNames();
   void                                AddOutput(NodeWeakPtrType const &o);
   std::vector<NodeWeakPtrType> const &GetOutputs() const;
-  void                                ResetCache(bool input_size_changed);
+  bool                                ResetCache(bool input_size_changed);
   void                                ResetInputsAndOutputs();
 
   inline std::string const &GetNodeName() const
@@ -156,10 +157,13 @@ private:
   std::vector<NodeWeakPtrType> input_nodes_;
   std::vector<NodeWeakPtrType> outputs_;
 
-  std::string       name_;
-  TensorType        cached_output_;
-  CachedOutputState cached_output_status_;
-  OpType            operation_type_;
+  std::string                 name_;
+  std::shared_ptr<TensorType> cached_output_ = std::make_shared<TensorType>();
+  CachedOutputState           cached_output_status_;
+  OpType                      operation_type_;
+
+  // the outputs of the input nodes, kept between passes to avoid reallocating them
+  VecTensorType inputs_;
 
   std::shared_ptr<ops::Ops<TensorType>> op_ptr_;
 };
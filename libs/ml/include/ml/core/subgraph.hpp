@@ -34,12 +34,11 @@ template <class T>
 class SubGraph : public Graph<T>, public ops::Ops<T>
 {
 public:
-  using TensorType       = T;
-  using VecTensorType    = std::vector<std::shared_ptr<TensorType const>>;
-  using SPType           = SubGraphSaveableParams<TensorType>;
-  using OpPtrType        = std::shared_ptr<fetch::ml::ops::Ops<TensorType>>;
-  using NodePtrType      = std::shared_ptr<Node<TensorType>>;
-  using NodeErrorMapType = std::unordered_map<Node<TensorType> *, std::vector<TensorType>>;
+  using TensorType    = T;
+  using VecTensorType = std::vector<std::shared_ptr<TensorType const>>;
+  using SPType        = SubGraphSaveableParams<TensorType>;
+  using OpPtrType     = std::shared_ptr<fetch::ml::ops::Ops<TensorType>>;
+  using NodePtrType   = std::shared_ptr<Node<TensorType>>;
 
   static constexpr char const *DESCRIPTOR = "SubGraph";
 
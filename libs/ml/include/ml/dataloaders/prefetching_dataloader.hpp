@@ -0,0 +1,145 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/dataloader.hpp"
+#include "ml/meta/ml_type_traits.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Wraps another dataloader and assembles its batches on a background thread, so that the next
+ * batches are prepared while the current one is trained on. Up to queue_size batches are kept
+ * ready, and an optional shuffle buffer draws every sample at random from the next
+ * shuffle_buffer_size samples of the wrapped loader's epoch.
+ *
+ * Batches, epochs and IsDone / Reset behave as they do for the wrapped loader. The wrapped loader
+ * is owned by the background thread while batches are prefetched, so it must not be used directly
+ * once wrapped. Random mode is set on the wrapped loader, while SetSeed seeds the shuffle buffer.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+class PrefetchingDataLoader : public DataLoader<TensorType>
+{
+public:
+  using SizeType       = fetch::math::SizeType;
+  using SizeVector     = fetch::math::SizeVector;
+  using ReturnType     = std::pair<TensorType, std::vector<TensorType>>;
+  using DataLoaderType = DataLoader<TensorType>;
+
+  explicit PrefetchingDataLoader(std::shared_ptr<DataLoaderType> loader, SizeType queue_size = 4,
+                                 SizeType shuffle_buffer_size = 0);
+
+  ~PrefetchingDataLoader() override;
+
+  PrefetchingDataLoader(PrefetchingDataLoader const &) = delete;
+  PrefetchingDataLoader &operator=(PrefetchingDataLoader const &) = delete;
+
+  ReturnType GetNext() override;
+  ReturnType PrepareBatch(fetch::math::SizeType batch_size, bool &is_done_set) override;
+
+  bool AddData(std::vector<TensorType> const &data, TensorType const &label) override;
+
+  SizeType Size() const override;
+  bool     IsDone() const override;
+  void     Reset() override;
+  void     SetTestRatio(fixed_point::fp32_t new_test_ratio) override;
+  void     SetValidationRatio(fixed_point::fp32_t new_validation_ratio) override;
+  bool     IsModeAvailable(DataLoaderMode mode) override;
+
+  std::shared_ptr<DataLoaderType> GetLoader() const;
+
+  LoaderType LoaderCode() override
+  {
+    return LoaderType::PREFETCH;
+  }
+
+protected:
+  void UpdateCursor() override;
+
+private:
+  // a sample taken from the wrapped loader ahead of time
+  struct Sample
+  {
+    ReturnType data;
+    bool       starts_epoch = false;
+  };
+
+  // the samples taken ahead of time for one mode of the wrapped loader
+  struct Stream
+  {
+    std::deque<Sample>      pending;
+    std::vector<ReturnType> shuffle_buffer;
+  };
+
+  struct Batch
+  {
+    ReturnType            data;
+    std::vector<SizeType> epoch_starts;
+    bool                  done_after = false;
+    std::exception_ptr    error;
+  };
+
+  std::shared_ptr<DataLoaderType> loader_;
+  SizeType                        queue_size_;
+  SizeType                        shuffle_buffer_size_;
+  bool                            prefetch_;
+
+  // the state below is only used by the worker while it runs
+  std::map<DataLoaderMode, Stream> streams_;
+  DataLoaderMode                   active_mode_ = DataLoaderMode::TRAIN;
+  SizeVector                       label_shape_;
+  std::vector<SizeVector>          data_shapes_;
+
+  std::unique_ptr<std::thread> worker_;
+  SizeType                     worker_batch_size_ = 0;
+  std::mutex                   mutex_;
+  std::condition_variable      batch_available_;
+  std::condition_variable      space_available_;
+  std::deque<Batch>            queue_;
+  bool                         paused_ = false;
+  bool                         stop_   = false;
+
+  bool done_ = false;
+
+  void StartWorker(SizeType batch_size);
+  void StopWorker();
+  void JoinWorker();
+  void WorkerLoop(SizeType batch_size);
+
+  Batch      AssembleBatch(SizeType batch_size);
+  ReturnType NextSample(bool &starts_epoch);
+  ReturnType CopySample(ReturnType const &sample) const;
+  bool       SourceIsDone();
+  Stream &   ActiveStream();
+};
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
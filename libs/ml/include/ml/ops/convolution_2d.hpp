@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ml/ops/im2col.hpp"
 #include "ml/ops/ops.hpp"
 
 #include <cassert>
@@ -82,28 +83,8 @@ public:
   OperationsCount ChargeForward() const override;
 
 private:
-  void FillVerticalStride(TensorType &input, TensorType &vertical_stride, SizeType output_channels,
-                          SizeType input_channels, SizeType kernel_height, SizeType kernel_width);
-
-  void ReverseFillVerticalStride(TensorType &input, TensorType &vertical_stride,
-                                 SizeType output_channels, SizeType input_channels,
-                                 SizeType kernel_height, SizeType kernel_width);
-
-  void FillHorizontalStride(TensorType &input, TensorType &horizontal_stride,
-                            SizeType output_height, SizeType output_width, SizeType input_channels,
-                            SizeType kernel_height, SizeType kernel_width, SizeType batch_size);
-
-  void ReverseFillHorizontalStride(TensorType &input, TensorType &horizontal_stride,
-                                   SizeType output_height, SizeType output_width,
-                                   SizeType input_channels, SizeType kernel_height,
-                                   SizeType kernel_width, SizeType batch_size);
-
-  void FillOutput(TensorType const &gemm_output, TensorType &output, SizeType output_channels,
-                  SizeType output_height, SizeType output_width, SizeType batch_size);
-
-  void ReverseFillOutput(TensorType &gemm_output, TensorType const &output,
-                         SizeType output_channels, SizeType output_height, SizeType output_width,
-                         SizeType batch_size);
+  ConvolutionGeometry ComputeGeometry(std::vector<SizeType> const &input_shape,
+                                      std::vector<SizeType> const &kernel_shape) const;
 
   SizeType ComputeOutputDim(SizeType input_dim, SizeType kernel_dim) const;
 
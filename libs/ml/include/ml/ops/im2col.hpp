@@ -0,0 +1,121 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Convolution engine shared by Convolution1D and Convolution2D.
+ *
+ * The receptive field of every output position is unrolled (im2col) into
+ * one column of a [(kW * kH * iC) x (N * oW * oH)] matrix so that the
+ * convolution becomes a single matrix multiplication with the kernels. The
+ * rows are ordered (kernel width, kernel height, input channel) and the
+ * columns (batch, output width, output height) from slowest to fastest,
+ * which matches the memory layout of the kernel [oC x iC x kH x kW x 1] and
+ * output [oC x oH x oW x N] tensors. Neither of them therefore needs to be
+ * reshaped around the multiplication, and every unrolled element is part of
+ * a contiguous run of input channels.
+ */
+
+#include "math/base_types.hpp"
+
+namespace fetch {
+namespace ml {
+namespace ops {
+
+/**
+ * Dimensions of a convolution. One dimensional convolutions are described with an input, kernel
+ * and output width of 1.
+ */
+struct ConvolutionGeometry
+{
+  using SizeType = fetch::math::SizeType;
+
+  SizeType input_channels{0};
+  SizeType input_height{0};
+  SizeType input_width{1};
+  SizeType kernel_height{0};
+  SizeType kernel_width{1};
+  SizeType output_height{0};
+  SizeType output_width{1};
+  SizeType batch_size{0};
+  SizeType stride{1};
+
+  /// The number of rows of the unrolled input
+  SizeType ColumnHeight() const
+  {
+    return kernel_width * kernel_height * input_channels;
+  }
+
+  /// The number of columns of the unrolled input
+  SizeType ColumnWidth() const
+  {
+    return batch_size * output_width * output_height;
+  }
+
+  /// 1x1 kernels with unit stride, for which the input already has the unrolled layout
+  bool IsPointwise() const
+  {
+    return (kernel_height == 1) && (kernel_width == 1) && (stride == 1);
+  }
+};
+
+/**
+ * Unrolls the input [iC x iH x iW x N] into a [(kW * kH * iC) x (N * oW * oH)] matrix. The batch
+ * is split across threads for large inputs.
+ *
+ * @param input the input tensor
+ * @param geometry the dimensions of the convolution
+ * @param buffer storage for the unrolled input
+ * @return the unrolled input, which is the input itself for pointwise convolutions
+ */
+template <typename TensorType>
+TensorType const &Im2Col(TensorType const &input, ConvolutionGeometry const &geometry,
+                         TensorType &buffer);
+
+/**
+ * Reverses Im2Col by adding every element of the unrolled matrix to the input position it was
+ * read from, so that overlapping receptive fields accumulate their gradients
+ *
+ * @param columns the [(kW * kH * iC) x (N * oW * oH)] unrolled gradient
+ * @param geometry the dimensions of the convolution
+ * @param input the zero initialised [iC x iH x iW x N] gradient to accumulate into
+ */
+template <typename TensorType>
+void Col2Im(TensorType const &columns, ConvolutionGeometry const &geometry, TensorType &input);
+
+/**
+ * Returns the first set of kernels [oC x iC x kH x kW x 1] of the kernels tensor, which has the
+ * memory layout of a [oC x (iC * kH * kW)] matrix
+ *
+ * @param kernels the kernels tensor
+ * @param buffer storage for the first set of kernels
+ * @return the kernels themselves when they only hold a single set, otherwise a copy of the first
+ */
+template <typename TensorType>
+TensorType const &SingleKernelSet(TensorType const &kernels, TensorType &buffer);
+
+/**
+ * Copies between tensors of different shapes which share the same memory layout, such as a
+ * [oC x (oH * oW * N)] matrix and the [oC x oH x oW x N] tensor it represents. When the
+ * destination is larger only its leading part is written.
+ */
+template <typename TensorType>
+void CopyLayout(TensorType const &from, TensorType &to);
+
+}  // namespace ops
+}  // namespace ml
+}  // namespace fetch
@@ -22,13 +22,25 @@
 #include "ml/optimisation/learning_rate_params.hpp"
 
 #include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace fetch {
+namespace threading {
+class Pool;
+}  // namespace threading
+
 namespace ml {
 
 template <class T>
 class Graph;
 
+namespace ops {
+template <class T>
+class Variable;
+}  // namespace ops
+
 namespace optimisers {
 
 static constexpr fetch::math::SizeType SIZE_NOT_SET = fetch::math::numeric_max<math::SizeType>();
@@ -60,8 +72,13 @@ public:
   inline void SetGraph(std::shared_ptr<Graph<T>> graph)
   {
     graph_ = graph;
+    replicas_.clear();
   }
 
+  /// DATA PARALLEL TRAINING ///
+  void     SetThreadCount(SizeType thread_count);
+  SizeType GetThreadCount() const;
+
   /// DATA RUN INTERFACES ///
   DataType Run(std::vector<TensorType> const &data, TensorType const &labels,
                SizeType batch_size = SIZE_NOT_SET);
@@ -112,8 +129,26 @@ private:
   TensorType                                     batch_labels_;
   LearningRateParam<DataType>                    learning_rate_param_;
 
+  // data parallel training: every thread trains a replica of graph_ on a slice of each batch. The
+  // replicas share the weights of graph_, which is itself the first replica.
+  using VariablePtrType = std::shared_ptr<fetch::ml::ops::Variable<TensorType>>;
+
+  SizeType                                  thread_count_ = 1;
+  std::shared_ptr<threading::Pool>          thread_pool_;
+  std::vector<std::shared_ptr<Graph<T>>>    replicas_;
+  std::vector<std::vector<VariablePtrType>> replica_trainables_;
+  std::vector<std::vector<TensorType>>      replica_data_;
+  std::vector<TensorType>                   replica_labels_;
+  std::vector<DataType>                     replica_losses_;
+
   void ResetGradients();
 
+  DataType ComputeGradients(std::vector<TensorType> const &data, TensorType const &labels);
+  DataType ComputeGradientsDataParallel(std::vector<TensorType> const &data,
+                                        TensorType const &             labels);
+  void     BuildReplicas();
+  void     ReduceGradients(SizeType replica_count);
+
   void PrintStats(SizeType batch_size, SizeType subset_size);
 
   void Init();
@@ -94,6 +94,7 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCH:
     {
       throw ml::exceptions::NotImplemented(
           "Serialization for current dataloader type not implemented yet.");
@@ -161,6 +162,7 @@ struct MapSerializer<ml::model::Model<TensorType>, D>
     case ml::LoaderType::W2V:
     case ml::LoaderType::COMMODITY:
     case ml::LoaderType::C2V:
+    case ml::LoaderType::PREFETCH:
     {
       throw ml::exceptions::NotImplemented(
           "serialization for current dataloader type not implemented yet.");
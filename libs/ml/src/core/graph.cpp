@@ -18,6 +18,7 @@
 
 #include "ml/core/graph.hpp"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "math/tensor/tensor.hpp"
@@ -38,6 +39,7 @@ template <typename TensorType>
 void Graph<TensorType>::ResetCompile()
 {
   graph_state_ = GraphState::NOT_COMPILED;
+  ResetSchedule();
 
   for (auto &connection : connections_)
   {
@@ -86,6 +88,7 @@ void Graph<TensorType>::Compile()
     // appear in middle of graph
     if (valid)
     {
+      CompileSchedule();
       ComputeAllNodeShapes();
       graph_state_ = GraphState::COMPILED;
     }
@@ -188,7 +191,7 @@ TensorType Graph<TensorType>::ForwardImplementation(std::string const &node_name
     case GraphState::UPDATED:
     {
       graph_state_ = GraphState::EVALUATED;
-      auto ret     = (*(nodes_[node_name]->Evaluate(is_training)));
+      auto ret     = *ScheduledForward(node_name, is_training);
       if (evaluate_mode)
       {
         return ret.Copy();
@@ -270,7 +273,7 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
     case GraphState::BACKWARD:
     case GraphState::UPDATED:
     {
-      nodes_[node_name]->BackPropagate(error_signal);
+      ScheduledBackward(node_name, error_signal);
       graph_state_ = GraphState::BACKWARD;
       break;
     }
@@ -291,10 +294,249 @@ void Graph<TensorType>::BackPropagate(std::string const &node_name, TensorType c
 /// PROTECTED METHODS ///
 /////////////////////////
 
+/**
+ * Evaluates the nodes a node depends upon in execution order, so that every node finds the
+ * outputs of its inputs already computed
+ * @param node_name name of node to evaluate
+ * @param is_training
+ * @return the output of the node
+ */
+template <typename TensorType>
+typename Graph<TensorType>::ArrayPtrType Graph<TensorType>::ScheduledForward(
+    std::string const &node_name, bool is_training)
+{
+  ArrayPtrType output;
+  for (SizeType position : ExecutionPlan(node_name))
+  {
+    output = schedule_[position].node->Evaluate(is_training);
+  }
+  return output;
+}
+
+/**
+ * Backpropagates an error signal through the nodes a node depends upon in reverse execution
+ * order. Every node is only backpropagated once, with the sum of the error signals from all of its
+ * outputs.
+ * @param node_name name of node from which to begin backprop
+ * @param error_signal the error signal of that node
+ */
+template <typename TensorType>
+void Graph<TensorType>::ScheduledBackward(std::string const &node_name,
+                                          TensorType const & error_signal)
+{
+  std::vector<SizeType> const &plan = ExecutionPlan(node_name);
+
+  for (SizeType position : plan)
+  {
+    schedule_[position].error_signal_count = 0;
+  }
+
+  AccumulateErrorSignal(schedule_[plan.back()], error_signal);
+
+  for (auto position_it = plan.rbegin(); position_it != plan.rend(); ++position_it)
+  {
+    ScheduledNode &scheduled_node = schedule_[*position_it];
+    if (scheduled_node.error_signal_count == 0)
+    {
+      continue;
+    }
+
+    std::vector<TensorType> const error_signals =
+        scheduled_node.node->Backward(scheduled_node.error_signal);
+
+    // nodes without inputs, such as weights, have used their error signal in Backward
+    for (SizeType i{0}; i < std::min(scheduled_node.inputs.size(), error_signals.size()); ++i)
+    {
+      AccumulateErrorSignal(schedule_[scheduled_node.inputs[i]], error_signals[i]);
+    }
+  }
+}
+
+/**
+ * Returns the error signal which the last backward pass propagated to a node
+ * @param node_name name of the node
+ * @return the error signal, or an empty tensor if the node was not reached
+ */
+template <typename TensorType>
+TensorType Graph<TensorType>::ScheduledErrorSignal(std::string const &node_name) const
+{
+  auto const position_it = schedule_positions_.find(node_name);
+  if ((position_it == schedule_positions_.end()) ||
+      (schedule_[position_it->second].error_signal_count == 0))
+  {
+    return {};
+  }
+
+  return schedule_[position_it->second].error_signal;
+}
+
 ///////////////////////
 /// PRIVATE METHODS ///
 ///////////////////////
 
+/**
+ * Sorts the linked nodes topologically into a flat schedule and records the schedule positions of
+ * the inputs of every node
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Graph<TensorType>::CompileSchedule()
+{
+  ResetSchedule();
+
+  std::unordered_map<std::string, std::vector<std::string>> input_names;
+  std::unordered_map<std::string, SizeType>                 unscheduled_inputs;
+  std::unordered_map<std::string, std::vector<std::string>> output_names;
+  std::vector<std::string>                                  ready;
+
+  for (auto const &node : nodes_)
+  {
+    auto &inputs                    = input_names[node.first];
+    inputs                          = node.second->GetInputNames();
+    unscheduled_inputs[node.first] = inputs.size();
+
+    for (auto const &input : inputs)
+    {
+      output_names[input].emplace_back(node.first);
+    }
+
+    if (inputs.empty())
+    {
+      ready.emplace_back(node.first);
+    }
+  }
+
+  // a node is scheduled once all of its inputs have been
+  for (SizeType i{0}; i < ready.size(); ++i)
+  {
+    std::string const node_name = ready[i];
+
+    schedule_positions_[node_name] = schedule_.size();
+    schedule_.emplace_back();
+    schedule_.back().node = nodes_.at(node_name);
+
+    for (auto const &output : output_names[node_name])
+    {
+      if (--unscheduled_inputs[output] == 0)
+      {
+        ready.emplace_back(output);
+      }
+    }
+  }
+
+  if (schedule_.size() != nodes_.size())
+  {
+    ResetSchedule();
+    throw ml::exceptions::InvalidMode("Cannot schedule graph: nodes are connected in a cycle");
+  }
+
+  for (auto &scheduled_node : schedule_)
+  {
+    for (auto const &input : input_names[scheduled_node.node->GetNodeName()])
+    {
+      scheduled_node.inputs.emplace_back(schedule_positions_.at(input));
+    }
+  }
+}
+
+/**
+ * Discards the schedule and execution plans, which need to be recompiled whenever nodes are
+ * inserted or linked
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Graph<TensorType>::ResetSchedule()
+{
+  schedule_.clear();
+  schedule_positions_.clear();
+  execution_plans_.clear();
+}
+
+/**
+ * Returns the schedule positions of a node and all nodes it depends upon in execution order. The
+ * plan is computed when a node is first evaluated and reused afterwards.
+ * @param node_name name of the node
+ * @return the execution plan ending with the node itself
+ */
+template <typename TensorType>
+std::vector<typename Graph<TensorType>::SizeType> const &Graph<TensorType>::ExecutionPlan(
+    std::string const &node_name)
+{
+  auto const plan_it = execution_plans_.find(node_name);
+  if (plan_it != execution_plans_.end())
+  {
+    return plan_it->second;
+  }
+
+  if (schedule_.empty())
+  {
+    CompileSchedule();
+  }
+
+  // inputs are always scheduled before the nodes using them, so a single reverse sweep finds all
+  // of the nodes this one depends upon
+  SizeType const    target = schedule_positions_.at(node_name);
+  std::vector<bool> required(target + 1, false);
+  required[target] = true;
+
+  for (SizeType position = target + 1; position-- > 0;)
+  {
+    if (required[position])
+    {
+      for (SizeType input : schedule_[position].inputs)
+      {
+        required[input] = true;
+      }
+    }
+  }
+
+  std::vector<SizeType> plan;
+  for (SizeType position{0}; position <= target; ++position)
+  {
+    if (required[position])
+    {
+      plan.emplace_back(position);
+    }
+  }
+
+  return execution_plans_.emplace(node_name, std::move(plan)).first->second;
+}
+
+/**
+ * Adds an error signal to those a node has received during the current backward pass. A single
+ * error signal is passed on as is; several are summed into storage which is kept between passes.
+ * @param scheduled_node the receiving node
+ * @param error_signal the error signal from one of its outputs
+ */
+template <typename TensorType>
+void Graph<TensorType>::AccumulateErrorSignal(ScheduledNode &   scheduled_node,
+                                              TensorType const &error_signal)
+{
+  TensorType &accumulated = scheduled_node.accumulated_error_signal;
+
+  if (scheduled_node.error_signal_count == 0)
+  {
+    scheduled_node.error_signal = error_signal;
+  }
+  else if (scheduled_node.error_signal_count == 1)
+  {
+    // the first error signal may be shared with the op which produced it, so it is not modified
+    if (accumulated.shape() != error_signal.shape())
+    {
+      accumulated.Resize(error_signal.shape());
+    }
+
+    fetch::math::Add(scheduled_node.error_signal, error_signal, accumulated);
+    scheduled_node.error_signal = accumulated;
+  }
+  else
+  {
+    fetch::math::Add(accumulated, error_signal, accumulated);
+  }
+
+  ++scheduled_node.error_signal_count;
+}
+
 /**
  * Set regularisation type and rate for all trainables in graph
  * @tparam TensorType
@@ -401,7 +643,7 @@ void Graph<TensorType>::ApplyGradients(std::vector<TensorType> &grad)
     // reset cache on all nodes
     for (auto const &t : nodes_)
     {
-      ResetGraphCache(false, t.second);
+      t.second->ResetCache(false);
     }
 
     return;
@@ -450,7 +692,7 @@ void Graph<TensorType>::ApplySparseGradients(std::vector<TensorType> &grad,
     // reset cache on all nodes
     for (auto const &t : nodes_)
     {
-      ResetGraphCache(false, t.second);
+      t.second->ResetCache(false);
     }
 
     return;
@@ -478,6 +720,7 @@ bool Graph<T>::InsertNode(std::string const &node_name, NodePtrType node_ptr)
 {
   // put node in look up table
   nodes_[node_name] = node_ptr;
+  ResetSchedule();
   return nodes_.find(node_name) != nodes_.end();
 }
 
@@ -605,7 +848,12 @@ void Graph<TensorType>::ResetGraphCache(bool input_size_changed, NodePtrType n)
   }
   else
   {
-    n->ResetCache(input_size_changed);
+    // if the cache was already invalid then so are the caches of all nodes depending on this one
+    if (!n->ResetCache(input_size_changed))
+    {
+      return;
+    }
+
     for (auto &node : n->GetOutputs())
     {
       if (auto ptr = node.lock())
@@ -726,6 +974,8 @@ void Graph<TensorType>::LinkNodesInGraph(std::string const &             node_na
     nodes_.at(node_name)->AddInput(nodes_.at(i));
     nodes_[i]->AddOutput(nodes_[node_name]);
   }
+
+  ResetSchedule();
 }
 
 /**
@@ -279,33 +279,37 @@ std::shared_ptr<typename Node<TensorType>::SPType> Node<TensorType>::GetNodeSave
 }
 
 /**
- * returns a vector of all nodes which provide input to this node
+ * returns the outputs of all nodes which provide input to this node. The returned vector is
+ * reused by subsequent calls
  * @tparam TensorType tensor
- * @return vector of reference_wrapped tensors
+ * @return vector of pointers to the input tensors
  */
 template <class TensorType>
-typename Node<TensorType>::VecTensorType Node<TensorType>::GatherInputs() const
+typename Node<TensorType>::VecTensorType const &Node<TensorType>::GatherInputs()
 {
-  VecTensorType inputs;
+  inputs_.resize(input_nodes_.size());
+
+  auto input_it = inputs_.begin();
   for (auto const &i : input_nodes_)
   {
     if (auto ptr = i.lock())
     {
-      inputs.push_back(ptr->Evaluate(op_ptr_->IsTraining()));
+      *input_it = ptr->Evaluate(op_ptr_->IsTraining());
+      ++input_it;
     }
     else
     {
       throw std::runtime_error("Unable to lock weak pointer.");
     }
   }
-  return inputs;
+  return inputs_;
 }
 
 /**
  * Returns the result of a forward evaluation of this node. If that's already been
  * computed this is cheap; if not then Forward is called as necessary if the output
  * size has not been updated since last used. This also must be changed and
- * recalculated as necessary
+ * recalculated as necessary. The same output tensor is reused between evaluations
  * @tparam T tensor type
  * @tparam O operation class
  * @return the tensor with the forward result
@@ -317,20 +321,20 @@ std::shared_ptr<TensorType> Node<TensorType>::Evaluate(bool is_training)
 
   if (cached_output_status_ != CachedOutputState::VALID_CACHE)
   {
-    VecTensorType inputs = GatherInputs();
+    VecTensorType const &inputs = GatherInputs();
 
     if (cached_output_status_ == CachedOutputState::CHANGED_SIZE)
     {
       auto output_shape = op_ptr_->ComputeOutputShape(inputs);
 
       // make shape compatible right before we do the forwarding
-      if (cached_output_.shape() != output_shape)
+      if (cached_output_->shape() != output_shape)
       {
-        cached_output_.Reshape(output_shape);
+        cached_output_->Reshape(output_shape);
       }
     }
 
-    op_ptr_->Forward(inputs, cached_output_);
+    op_ptr_->Forward(inputs, *cached_output_);
     cached_output_status_ = CachedOutputState::VALID_CACHE;
 
     if (math::state_division_by_zero<DataType>())
@@ -349,11 +353,44 @@ std::shared_ptr<TensorType> Node<TensorType>::Evaluate(bool is_training)
     assert(!math::state_overflow<DataType>());
   }
 
-  return std::make_shared<TensorType>(cached_output_);
+  return cached_output_;
 }
 
 /**
- * Recursively backpropagates error_signal through this node to all input nodes
+ * Backpropagates error_signal through this node only. Propagating the returned error signals to
+ * the input nodes is left to the graph, which visits every node once in reverse execution order
+ * @tparam T the tensor type
+ * @tparam O the operation class
+ * @param error_signal the sum of the error signals from all outputs of this node
+ * @return the error signals for each of the input nodes
+ */
+template <typename TensorType>
+std::vector<TensorType> Node<TensorType>::Backward(TensorType const &error_signal)
+{
+  VecTensorType const &   inputs        = GatherInputs();
+  std::vector<TensorType> error_signals = op_ptr_->Backward(inputs, error_signal);
+  assert(error_signals.size() == inputs.size() || inputs.empty());
+
+  if (math::state_division_by_zero<DataType>())
+  {
+    throw std::runtime_error("Division by zero encountered in Node::Backward");
+  }
+  if (math::state_infinity<DataType>())
+  {
+    throw std::runtime_error("Infinity encountered in Node::Backward");
+  }
+  if (math::state_nan<DataType>())
+  {
+    throw std::runtime_error("NaN encountered in Node::Backward");
+  }
+
+  assert(!math::state_overflow<DataType>());
+  return error_signals;
+}
+
+/**
+ * Recursively backpropagates error_signal through this node to all input nodes. Nodes with several
+ * outputs are backpropagated once per output; Graph avoids this by using Backward on its schedule
  * @tparam T the tensor type
  * @tparam O the operation class
  * @param error_signal the error signal to backpropagate
@@ -365,9 +402,7 @@ typename Node<TensorType>::NodeErrorMapType Node<TensorType>::BackPropagate(
 {
   NodeErrorMapType ret;
 
-  // gather inputs and backprop for this node
-  std::vector<TensorType> error_signals = op_ptr_->Backward(GatherInputs(), error_signal);
-  assert(error_signals.size() == GatherInputs().size() || GatherInputs().empty());
+  std::vector<TensorType> error_signals = Backward(error_signal);
 
   if (input_nodes_.empty())
   {
@@ -394,22 +429,9 @@ typename Node<TensorType>::NodeErrorMapType Node<TensorType>::BackPropagate(
     }
   }
 
-  if (math::state_division_by_zero<DataType>())
-  {
-    throw std::runtime_error("Division by zero encountered in Node::BackPropagate");
-  }
-  if (math::state_infinity<DataType>())
-  {
-    throw std::runtime_error("Infinity encountered in Node::BackPropagate");
-  }
-  if (math::state_nan<DataType>())
-  {
-    throw std::runtime_error("NaN encountered in Node::BackPropagate");
-  }
-
-  assert(!math::state_overflow<DataType>());
   return ret;
 }
+
 /**
  * Resets input and output node ptr containers. Useful for graph decompiling.
  * @tparam T
@@ -486,15 +508,22 @@ std::vector<typename Node<TensorType>::NodeWeakPtrType> const &Node<TensorType>:
  * @tparam T tensor type
  * @tparam O operation class
  * @param input_size_changed boolean indicating whether the input size changed
+ * @return false if the cache had already been invalidated at least as much
  */
 template <typename TensorType>
-void Node<TensorType>::ResetCache(bool input_size_changed)
+bool Node<TensorType>::ResetCache(bool input_size_changed)
 {
-  if (cached_output_status_ != CachedOutputState::CHANGED_SIZE)
+  CachedOutputState const new_status =
+      input_size_changed ? CachedOutputState::CHANGED_SIZE : CachedOutputState::CHANGED_CONTENT;
+
+  if ((cached_output_status_ == CachedOutputState::CHANGED_SIZE) ||
+      (cached_output_status_ == new_status))
   {
-    cached_output_status_ =
-        input_size_changed ? CachedOutputState::CHANGED_SIZE : CachedOutputState::CHANGED_CONTENT;
+    return false;
   }
+
+  cached_output_status_ = new_status;
+  return true;
 }
 
 /**
@@ -41,7 +41,7 @@ void SubGraph<TensorType>::Forward(VecTensorType const &inputs, TensorType &outp
   {
     this->SetInput(input_node_names_[i], *(inputs.at(i)));
   }
-  output = *(this->nodes_[output_node_name_]->Evaluate(this->is_training_));
+  output = *(this->ScheduledForward(output_node_name_, this->is_training_));
 }
 
 /**
@@ -61,13 +61,10 @@ std::vector<TensorType> SubGraph<TensorType>::Backward(VecTensorType const &inpu
   FETCH_UNUSED(inputs);
   std::vector<TensorType> ret;
 
-  NodeErrorMapType map_node_error_signals =
-      this->nodes_[output_node_name_]->BackPropagate(error_signal);
-  for (std::size_t i = 0; i < input_node_names_.size(); i++)
+  this->ScheduledBackward(output_node_name_, error_signal);
+  for (auto const &input_node_name : input_node_names_)
   {
-    NodePtrType node          = this->nodes_[input_node_names_[i]];
-    auto        error_signals = map_node_error_signals[node.get()];
-    ret.insert(ret.end(), error_signals.begin(), error_signals.end());
+    ret.emplace_back(this->ScheduledErrorSignal(input_node_name));
   }
 
   return ret;
@@ -0,0 +1,521 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+
+#include "core/mutex.hpp"
+#include "core/set_thread_name.hpp"
+#include "math/tensor/tensor.hpp"
+#include "ml/exceptions/exceptions.hpp"
+#include "vectorise/fixed_point/type_traits.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace fetch {
+namespace ml {
+namespace dataloaders {
+
+/**
+ * Batches are only prefetched when queue_size is non zero. Fixed point batches are assembled on
+ * the calling thread, since fixed point arithmetic records its errors in a state shared by all
+ * threads.
+ * @tparam TensorType
+ * @param loader the dataloader to take samples from
+ * @param queue_size maximum number of batches prepared ahead of time
+ * @param shuffle_buffer_size number of samples to draw each sample from, 0 disables shuffling
+ */
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::PrefetchingDataLoader(std::shared_ptr<DataLoaderType> loader,
+                                                         SizeType queue_size,
+                                                         SizeType shuffle_buffer_size)
+  : loader_(std::move(loader))
+  , queue_size_(queue_size)
+  , shuffle_buffer_size_(shuffle_buffer_size)
+  , prefetch_((queue_size > 0) && !math::meta::IsFixedPoint<typename TensorType::Type>)
+{
+  if (!loader_)
+  {
+    throw exceptions::InvalidInput("PrefetchingDataLoader requires a dataloader to wrap");
+  }
+
+  this->mode_  = DataLoaderMode::TRAIN;
+  active_mode_ = DataLoaderMode::TRAIN;
+  loader_->SetMode(active_mode_);
+  done_ = loader_->IsDone();
+}
+
+template <typename TensorType>
+PrefetchingDataLoader<TensorType>::~PrefetchingDataLoader()
+{
+  if (worker_)
+  {
+    JoinWorker();
+  }
+}
+
+/**
+ * Returns a copy of the next sample. Any prefetched batches are kept and returned later.
+ * @tparam TensorType
+ * @return the next sample of the wrapped loader
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType PrefetchingDataLoader<TensorType>::GetNext()
+{
+  StopWorker();
+
+  bool       starts_epoch = false;
+  ReturnType ret          = CopySample(NextSample(starts_epoch));
+  done_                   = SourceIsDone();
+
+  return ret;
+}
+
+/**
+ * Returns the next prefetched batch, starting the background thread on the first call. As for
+ * the wrapped loader, a batch which runs past the end of the data set continues with the next
+ * epoch and sets is_done_set.
+ * @tparam TensorType
+ * @param batch_size i.e. batch size of returned Tensors
+ * @param is_done_set set to true if the batch started a new epoch
+ * @return pair of label tensor and vector of data tensors with specified batch size
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType
+PrefetchingDataLoader<TensorType>::PrepareBatch(fetch::math::SizeType batch_size,
+                                                bool &                is_done_set)
+{
+  Batch batch;
+
+  if (!prefetch_)
+  {
+    batch = AssembleBatch(batch_size);
+  }
+  else
+  {
+    if (worker_ && (worker_batch_size_ != batch_size))
+    {
+      StopWorker();
+    }
+
+    if (!worker_)
+    {
+      StartWorker(batch_size);
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      // the worker waits at the end of each epoch until the next batch is actually asked for
+      if (queue_.empty() && paused_)
+      {
+        paused_ = false;
+        space_available_.notify_one();
+      }
+
+      batch_available_.wait(lock, [this] { return !queue_.empty(); });
+
+      batch = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    space_available_.notify_one();
+
+    if (batch.error)
+    {
+      std::rethrow_exception(batch.error);
+    }
+  }
+
+  if (!batch.epoch_starts.empty())
+  {
+    is_done_set = true;
+  }
+  done_ = batch.done_after;
+
+  return batch.data;
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::AddData(std::vector<TensorType> const &data,
+                                                TensorType const &             label)
+{
+  StopWorker();
+  streams_.clear();
+
+  bool const ret = loader_->AddData(data, label);
+  done_          = loader_->IsDone();
+
+  return ret;
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::SizeType PrefetchingDataLoader<TensorType>::Size() const
+{
+  return loader_->Size();
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsDone() const
+{
+  return done_;
+}
+
+/**
+ * Discards the prefetched batches of the current mode and resets the wrapped loader
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::Reset()
+{
+  StopWorker();
+
+  Stream &stream = ActiveStream();
+  stream.pending.clear();
+  stream.shuffle_buffer.clear();
+
+  loader_->Reset();
+  done_ = loader_->IsDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetTestRatio(fixed_point::fp32_t new_test_ratio)
+{
+  StopWorker();
+  streams_.clear();
+
+  loader_->SetTestRatio(new_test_ratio);
+  done_ = loader_->IsDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::SetValidationRatio(fixed_point::fp32_t new_validation_ratio)
+{
+  StopWorker();
+  streams_.clear();
+
+  loader_->SetValidationRatio(new_validation_ratio);
+  done_ = loader_->IsDone();
+}
+
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::IsModeAvailable(DataLoaderMode mode)
+{
+  return loader_->IsModeAvailable(mode);
+}
+
+template <typename TensorType>
+std::shared_ptr<typename PrefetchingDataLoader<TensorType>::DataLoaderType>
+PrefetchingDataLoader<TensorType>::GetLoader() const
+{
+  return loader_;
+}
+
+/**
+ * Switches the wrapped loader to the new mode. The samples prefetched for the previous mode are
+ * kept, so that its epoch continues where it was left when switching back.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::UpdateCursor()
+{
+  StopWorker();
+
+  loader_->SetMode(this->mode_);
+  active_mode_ = this->mode_;
+
+  this->current_min_  = 0;
+  this->current_max_  = loader_->Size();
+  this->current_size_ = loader_->Size();
+
+  done_ = SourceIsDone();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::StartWorker(SizeType batch_size)
+{
+  {
+    FETCH_LOCK(mutex_);
+    paused_ = false;
+    stop_   = false;
+  }
+
+  worker_batch_size_ = batch_size;
+  worker_            = std::make_unique<std::thread>([this, batch_size]() {
+    SetThreadName("Prefetch");
+    WorkerLoop(batch_size);
+  });
+}
+
+/**
+ * Stops the background thread and returns the samples of the batches it prepared ahead of time to
+ * the front of their stream, so that no sample is lost or repeated.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::StopWorker()
+{
+  if (!worker_)
+  {
+    return;
+  }
+
+  JoinWorker();
+
+  std::vector<Sample> samples;
+  for (auto &batch : queue_)
+  {
+    if (batch.error)
+    {
+      break;
+    }
+
+    for (SizeType idx = 0; idx < worker_batch_size_; ++idx)
+    {
+      Sample sample;
+      sample.data.first = batch.data.first.View(idx).Copy(label_shape_);
+      for (SizeType j = 0; j < batch.data.second.size(); ++j)
+      {
+        sample.data.second.emplace_back(
+            batch.data.second.at(j).View(idx).Copy(data_shapes_.at(j)));
+      }
+      sample.starts_epoch = std::find(batch.epoch_starts.begin(), batch.epoch_starts.end(), idx) !=
+                            batch.epoch_starts.end();
+
+      samples.emplace_back(std::move(sample));
+    }
+  }
+  queue_.clear();
+
+  auto &pending = streams_[active_mode_].pending;
+  pending.insert(pending.begin(), std::make_move_iterator(samples.begin()),
+                 std::make_move_iterator(samples.end()));
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::JoinWorker()
+{
+  {
+    FETCH_LOCK(mutex_);
+    stop_ = true;
+  }
+  space_available_.notify_all();
+
+  worker_->join();
+  worker_.reset();
+}
+
+template <typename TensorType>
+void PrefetchingDataLoader<TensorType>::WorkerLoop(SizeType batch_size)
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      space_available_.wait(
+          lock, [this] { return stop_ || (!paused_ && (queue_.size() < queue_size_)); });
+
+      if (stop_)
+      {
+        return;
+      }
+    }
+
+    Batch batch;
+    try
+    {
+      batch = AssembleBatch(batch_size);
+    }
+    catch (...)
+    {
+      batch.error = std::current_exception();
+    }
+
+    {
+      FETCH_LOCK(mutex_);
+
+      // nothing is taken from the next epoch before the consumer has seen the end of this one
+      paused_ = batch.done_after || batch.error;
+      queue_.emplace_back(std::move(batch));
+    }
+    batch_available_.notify_one();
+  }
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::Batch PrefetchingDataLoader<TensorType>::AssembleBatch(
+    SizeType batch_size)
+{
+  Batch batch;
+
+  for (SizeType idx = 0; idx < batch_size; ++idx)
+  {
+    bool       starts_epoch = false;
+    ReturnType sample       = NextSample(starts_epoch);
+    if (starts_epoch)
+    {
+      batch.epoch_starts.emplace_back(idx);
+    }
+
+    // the batch shapes are those of a sample with a trailing batch dimension
+    if (idx == 0)
+    {
+      label_shape_ = sample.first.shape();
+      data_shapes_.clear();
+
+      SizeVector shape           = label_shape_;
+      shape.at(shape.size() - 1) = batch_size;
+      batch.data.first           = TensorType(shape);
+
+      for (auto const &tensor : sample.second)
+      {
+        data_shapes_.emplace_back(tensor.shape());
+
+        shape                      = tensor.shape();
+        shape.at(shape.size() - 1) = batch_size;
+        batch.data.second.emplace_back(TensorType(shape));
+      }
+    }
+
+    auto label_view = batch.data.first.View(idx);
+    label_view.Assign(sample.first);
+
+    for (SizeType j = 0; j < sample.second.size(); ++j)
+    {
+      auto data_view = batch.data.second.at(j).View(idx);
+      data_view.Assign(sample.second.at(j));
+    }
+  }
+
+  batch.done_after = SourceIsDone();
+
+  return batch;
+}
+
+/**
+ * Takes the next sample of the current epoch, resetting the wrapped loader once all of its
+ * samples have been taken. The returned sample may share its data with the wrapped loader, so it
+ * is only valid until the next sample is taken.
+ * @tparam TensorType
+ * @param starts_epoch set to true if the sample is the first of a new epoch
+ * @return the next sample
+ */
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType
+PrefetchingDataLoader<TensorType>::NextSample(bool &starts_epoch)
+{
+  Stream &stream = ActiveStream();
+
+  if (!stream.pending.empty())
+  {
+    Sample sample = std::move(stream.pending.front());
+    stream.pending.pop_front();
+
+    starts_epoch = sample.starts_epoch;
+    return sample.data;
+  }
+
+  if (shuffle_buffer_size_ == 0)
+  {
+    if (loader_->IsDone())
+    {
+      loader_->Reset();
+      starts_epoch = true;
+    }
+
+    return loader_->GetNext();
+  }
+
+  // the buffer is drained before the wrapped loader is reset, so every epoch is a permutation
+  auto &buffer = stream.shuffle_buffer;
+  if (buffer.empty() && loader_->IsDone())
+  {
+    loader_->Reset();
+    starts_epoch = true;
+  }
+
+  while ((buffer.size() < shuffle_buffer_size_) && !loader_->IsDone())
+  {
+    buffer.emplace_back(CopySample(loader_->GetNext()));
+  }
+
+  SizeType const pick = static_cast<SizeType>(this->rand()) % buffer.size();
+  std::swap(buffer.at(pick), buffer.back());
+
+  ReturnType ret = std::move(buffer.back());
+  buffer.pop_back();
+
+  return ret;
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::ReturnType
+PrefetchingDataLoader<TensorType>::CopySample(ReturnType const &sample) const
+{
+  ReturnType ret;
+  ret.first = sample.first.Copy();
+  for (auto const &tensor : sample.second)
+  {
+    ret.second.emplace_back(tensor.Copy());
+  }
+
+  return ret;
+}
+
+/**
+ * The current epoch is over once every sample taken ahead of time has been used and the wrapped
+ * loader is done
+ * @tparam TensorType
+ */
+template <typename TensorType>
+bool PrefetchingDataLoader<TensorType>::SourceIsDone()
+{
+  Stream &stream = ActiveStream();
+
+  if (!stream.pending.empty())
+  {
+    return stream.pending.front().starts_epoch;
+  }
+
+  return stream.shuffle_buffer.empty() && loader_->IsDone();
+}
+
+template <typename TensorType>
+typename PrefetchingDataLoader<TensorType>::Stream &
+PrefetchingDataLoader<TensorType>::ActiveStream()
+{
+  return streams_[active_mode_];
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template class PrefetchingDataLoader<math::Tensor<std::int8_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int16_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int32_t>>;
+template class PrefetchingDataLoader<math::Tensor<std::int64_t>>;
+template class PrefetchingDataLoader<math::Tensor<float>>;
+template class PrefetchingDataLoader<math::Tensor<double>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp32_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp64_t>>;
+template class PrefetchingDataLoader<math::Tensor<fixed_point::fp128_t>>;
+
+}  // namespace dataloaders
+}  // namespace ml
+}  // namespace fetch
@@ -64,39 +64,25 @@ void Convolution2D<TensorType>::Forward(VecTensorType const &inputs, TensorType
   assert(inputs.at(1)->shape().size() == 5);
   assert(output.shape() == ComputeOutputShape(inputs));
 
-  TensorType input   = (*inputs.at(0));
-  TensorType kernels = (*inputs.at(1));
+  TensorType const &input   = *inputs.at(0);
+  TensorType const &kernels = *inputs.at(1);
 
-  SizeType input_channels  = input.shape().at(0);
-  SizeType batch_size      = input.shape().at(3);
-  SizeType output_channels = kernels.shape().at(0);
-  SizeType kernel_height   = kernels.shape().at(2);
-  SizeType kernel_width    = kernels.shape().at(3);
-  SizeType output_height   = output.shape().at(1);
-  SizeType output_width    = output.shape().at(2);
+  ConvolutionGeometry const geometry = ComputeGeometry(input.shape(), kernels.shape());
 
-  SizeType horizontal_stride_width  = kernel_width * kernel_height * input_channels;
-  SizeType horizontal_stride_height = output_height * output_width * batch_size;
-  SizeType vertical_stride_width    = output_channels;
-
-  // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
-  // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  // Reshape input data to columns - im2col
+  TensorType        columns_buffer;
+  TensorType const &columns = Im2Col(input, geometry, columns_buffer);
 
-  // Reshape input data to horizontal stride - im2col
-  FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
-                       kernel_height, kernel_width, batch_size);
-
-  // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
-                     kernel_width);
+  // The kernels already have the layout of a [oC x (iC * kH * kW)] matrix
+  TensorType        kernels_buffer;
+  TensorType const &kernel_matrix = SingleKernelSet(kernels, kernels_buffer);
 
   // Do matmul
-  TensorType reshaped_output = fetch::math::Dot(vertical_stride, horizontal_stride);
+  TensorType reshaped_output;
+  fetch::math::Dot(kernel_matrix, columns, reshaped_output);
 
-  // Reshape values after matmul to output
-  FillOutput(reshaped_output, output, output_channels, output_height, output_width, batch_size);
+  // [oC x (N * oW * oH)] already has the memory layout of the output
+  CopyLayout(reshaped_output, output);
 }
 
 /**
@@ -125,52 +111,28 @@ std::vector<TensorType> Convolution2D<TensorType>::Backward(VecTensorType const
   // input data channels = kernel input channels
   assert(inputs.at(0)->shape().at(0) == inputs.at(1)->shape().at(1));
 
-  SizeType output_height = error_signal.shape().at(1);
-  SizeType output_width  = error_signal.shape().at(2);
-
-  TensorType input   = (*inputs.at(0));
-  TensorType kernels = (*inputs.at(1));
-
-  SizeType   input_channels  = input.shape().at(0);
-  SizeType   batch_size      = input.shape().at(3);
-  SizeType   output_channels = kernels.shape().at(0);
-  SizeType   kernel_height   = kernels.shape().at(2);
-  SizeType   kernel_width    = kernels.shape().at(3);
-  TensorType input_error(input.shape());
-  TensorType kernel_error(kernels.shape());
-
-  SizeType horizontal_stride_width  = kernel_width * kernel_height * input_channels;
-  SizeType horizontal_stride_height = output_height * output_width * batch_size;
-  SizeType vertical_stride_width    = output_channels;
+  TensorType const &input   = *inputs.at(0);
+  TensorType const &kernels = *inputs.at(1);
 
-  // Horizontal stride contains input data
-  TensorType horizontal_stride{{horizontal_stride_width, horizontal_stride_height}};
-  // Vertical stride contains kernel data
-  TensorType vertical_stride{{vertical_stride_width, horizontal_stride_width}};
+  ConvolutionGeometry const geometry = ComputeGeometry(input.shape(), kernels.shape());
 
-  // Reshape input data to horizontal stride - im2col
-  FillHorizontalStride(input, horizontal_stride, output_height, output_width, input_channels,
-                       kernel_height, kernel_width, batch_size);
+  // Reshape input data to columns - im2col
+  TensorType        columns_buffer;
+  TensorType const &columns = Im2Col(input, geometry, columns_buffer);
 
-  // Reshape kernel data to vertical stride - im2col
-  FillVerticalStride(kernels, vertical_stride, output_channels, input_channels, kernel_height,
-                     kernel_width);
+  TensorType        kernels_buffer;
+  TensorType const &kernel_matrix = SingleKernelSet(kernels, kernels_buffer);
 
-  // Reshape error_signal to error for matmul
-  TensorType error{{vertical_stride_width, horizontal_stride_height}};
-  ReverseFillOutput(error, error_signal, output_channels, output_height, output_width, batch_size);
+  // Backwards matmul, the error signal has the layout of a [oC x (N * oW * oH)] matrix
+  TensorType kernel_gradient = fetch::math::DotTranspose(error_signal, columns);
+  TensorType column_gradient = fetch::math::TransposeDot(kernel_matrix, error_signal);
 
-  // Backwards matmul
-  TensorType error2 = fetch::math::DotTranspose(error, horizontal_stride);
-  TensorType error1 = fetch::math::TransposeDot(vertical_stride, error);
-
-  // Reshape horizontal stride to input data error_signal - reversed im2col
-  ReverseFillHorizontalStride(input_error, error1, output_height, output_width, input_channels,
-                              kernel_height, kernel_width, batch_size);
+  // Reshape columns to input data error_signal - reversed im2col
+  TensorType input_error(input.shape());
+  Col2Im(column_gradient, geometry, input_error);
 
-  // Reshape vertical stride to kernel data error_signal - reversed im2col
-  ReverseFillVerticalStride(kernel_error, error2, output_channels, input_channels, kernel_height,
-                            kernel_width);
+  TensorType kernel_error(kernels.shape());
+  CopyLayout(kernel_gradient, kernel_error);
 
   return {input_error, kernel_error};
 }
@@ -204,243 +166,22 @@ math::SizeType Convolution2D<TensorType>::ComputeOutputDim(SizeType const input_
   return output_dim;
 }
 
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes input tensor to vertical_stride tensor using im2col
- * @tparam TensorType
- * @param input
- * @param vertical_stride
- * @param output_channels
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::FillVerticalStride(TensorType &input, TensorType &vertical_stride,
-                                                   SizeType const output_channels,
-                                                   SizeType const input_channels,
-                                                   SizeType const kernel_height,
-                                                   SizeType const kernel_width)
-{
-  SizeType j_s;                                           // stride height iterator
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    j_s = 0;
-    for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
-    {
-
-      for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-      {
-        for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-        {
-          vertical_stride(i_oc, j_s) = input.At(i_oc, i_ic, i_k, j_k, 0);
-          ++j_s;
-        }
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes vertical_stride tensor to input tensor using reversed im2col
- * @tparam TensorType
- * @param input
- * @param vertical_stride
- * @param output_channels
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::ReverseFillVerticalStride(
-    TensorType &input, TensorType &vertical_stride, SizeType const output_channels,
-    SizeType const input_channels, SizeType const kernel_height, SizeType const kernel_width)
-{
-  SizeType j_s;                                           // stride height iterator
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    j_s = 0;
-    for (SizeType i_ic{0}; i_ic < input_channels; ++i_ic)  // Iterate over input channels
-    {
-
-      for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-      {
-        for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-        {
-          input(i_oc, i_ic, i_k, j_k, 0) = vertical_stride.At(i_oc, j_s);
-          ++j_s;
-        }
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes kernel(input) tensor to horizontal_stride tensor using im2col
- * @tparam TensorType
- * @param input
- * @param horizontal_stride
- * @param output_height
- * @param output_width
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
 template <class TensorType>
-void Convolution2D<TensorType>::FillHorizontalStride(
-    TensorType &input, TensorType &horizontal_stride, SizeType const output_height,
-    SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
-    SizeType const kernel_width, SizeType const batch_size)
+ConvolutionGeometry Convolution2D<TensorType>::ComputeGeometry(
+    std::vector<SizeType> const &input_shape, std::vector<SizeType> const &kernel_shape) const
 {
-  SizeType i_s;  // stride width index
-  SizeType j_s;  // stride height index
-
-  j_s = 0;
-  for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-  {
-    for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-    {
-      for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-      {
-        i_s = 0;
-        for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
-        {
-
-          for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-          {
-            for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-            {
-              horizontal_stride(i_s, j_s) =
-                  input.At(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b);
-              ++i_s;
-            }
-          }
-        }
-        ++j_s;
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshapes horizontal_stride tensor to kernel(input) tensor using reversed im2col
- * @tparam TensorType
- * @param input
- * @param horizontal_stride
- * @param output_height
- * @param output_width
- * @param input_channels
- * @param kernel_height
- * @param kernel_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::ReverseFillHorizontalStride(
-    TensorType &input, TensorType &horizontal_stride, SizeType const output_height,
-    SizeType const output_width, SizeType const input_channels, SizeType const kernel_height,
-    SizeType const kernel_width, SizeType const batch_size)
-{
-  SizeType i_s;  // stride width index
-  SizeType j_s;  // stride height index
-
-  j_s = 0;
-  for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-  {
-    for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-    {
-      for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-      {
-        i_s = 0;
-        for (SizeType i_ic(0); i_ic < input_channels; ++i_ic)  // Iterate over input channels
-        {
-
-          for (SizeType i_k(0); i_k < kernel_height; i_k++)  // Iterate over kernel height
-          {
-            for (SizeType j_k(0); j_k < kernel_width; j_k++)  // Iterate over kernel width
-            {
-              input(i_ic, i_o * stride_size_ + i_k, j_o * stride_size_ + j_k, i_b) =
-                  horizontal_stride.At(i_s, j_s);
-              ++i_s;
-            }
-          }
-        }
-        ++j_s;
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshape gemm_output tensor (result of matmul on vertical and horizontal stride) to output tensor
- * @tparam TensorType
- * @param gemm_output
- * @param output
- * @param output_channels
- * @param output_height
- * @param output_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::FillOutput(TensorType const &gemm_output, TensorType &output,
-                                           SizeType const output_channels,
-                                           SizeType const output_height,
-                                           SizeType const output_width, SizeType const batch_size)
-{
-
-  SizeType it;
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-    {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-      {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-        {
-          output(i_oc, i_o, j_o, i_b) = gemm_output.At(i_oc, it);
-          ++it;
-        }
-      }
-    }
-  }
-}
-
-// TODO(issue 943): Make im2col efficient using iterators
-/**
- * Reshape output tensor to gemm_output tensor (result of matmul on vertical and horizontal stride)
- * @tparam TensorType
- * @param gemm_output
- * @param output
- * @param output_channels
- * @param output_height
- * @param output_width
- */
-template <class TensorType>
-void Convolution2D<TensorType>::ReverseFillOutput(TensorType &gemm_output, TensorType const &output,
-                                                  SizeType const output_channels,
-                                                  SizeType const output_height,
-                                                  SizeType const output_width,
-                                                  SizeType const batch_size)
-{
-
-  SizeType it;
-  for (SizeType i_oc{0}; i_oc < output_channels; ++i_oc)  // Iterate over output channels
-  {
-    it = 0;
-    for (SizeType i_b{0}; i_b < batch_size; ++i_b)  // Iterate over batch
-    {
-      for (SizeType i_o{0}; i_o < output_height; ++i_o)  // Iterate over output height
-      {
-        for (SizeType j_o{0}; j_o < output_width; ++j_o)  // Iterate over output width
-        {
-          gemm_output(i_oc, it) = output.At(i_oc, i_o, j_o, i_b);
-          ++it;
-        }
-      }
-    }
-  }
+  ConvolutionGeometry geometry;
+  geometry.input_channels = input_shape.at(0);
+  geometry.input_height   = input_shape.at(1);
+  geometry.input_width    = input_shape.at(2);
+  geometry.batch_size     = input_shape.at(3);
+  geometry.kernel_height  = kernel_shape.at(2);
+  geometry.kernel_width   = kernel_shape.at(3);
+  geometry.output_height  = ComputeOutputDim(geometry.input_height, geometry.kernel_height);
+  geometry.output_width   = ComputeOutputDim(geometry.input_width, geometry.kernel_width);
+  geometry.stride         = stride_size_;
+
+  return geometry;
 }
 
 template <typename TensorType>
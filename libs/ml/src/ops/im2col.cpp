@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/tensor/tensor.hpp"
+#include "ml/ops/im2col.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace ops {
+namespace {
+
+using SizeType = fetch::math::SizeType;
+
+/// The minimum number of elements unrolled by each thread
+constexpr SizeType MIN_ELEMENTS_PER_TASK = SizeType{1} << 15u;
+
+threading::Pool &ConvolutionPool()
+{
+  static threading::Pool pool{std::max(std::thread::hardware_concurrency(), 1u), "Conv"};
+  return pool;
+}
+
+/**
+ * Calls handler(batch_begin, batch_end) over the whole batch, splitting it across threads when
+ * there is enough work to amortise the dispatch
+ */
+template <typename Handler>
+void ForEachBatch(ConvolutionGeometry const &geometry, bool concurrent, Handler const &handler)
+{
+  SizeType const batch_size = geometry.batch_size;
+  SizeType const elements   = geometry.ColumnHeight() * geometry.ColumnWidth();
+
+  SizeType tasks{1};
+  if (concurrent)
+  {
+    auto const threads = static_cast<SizeType>(std::thread::hardware_concurrency());
+    tasks =
+        std::max<SizeType>(1, std::min({threads, batch_size, elements / MIN_ELEMENTS_PER_TASK}));
+  }
+
+  if (tasks == 1)
+  {
+    handler(0, batch_size);
+    return;
+  }
+
+  // the first range is unrolled by the calling thread
+  SizeType const                 chunk = (batch_size + tasks - 1) / tasks;
+  std::vector<std::future<void>> results{};
+  for (SizeType begin = chunk; begin < batch_size; begin += chunk)
+  {
+    SizeType const end = std::min(batch_size, begin + chunk);
+    results.emplace_back(
+        ConvolutionPool().Dispatch([&handler, begin, end]() { handler(begin, end); }));
+  }
+
+  handler(0, std::min(batch_size, chunk));
+
+  for (auto &result : results)
+  {
+    result.get();
+  }
+}
+
+/**
+ * Visits the receptive fields of the output positions of a range of the batch. The visitor is
+ * called with the first element of every run of input channels and the matching element of the
+ * unrolled matrix.
+ */
+template <typename T, typename Visitor>
+void VisitReceptiveFields(ConvolutionGeometry const &geometry, T *input, SizeType input_stride,
+                          T *columns, SizeType columns_stride, SizeType batch_begin,
+                          SizeType batch_end, Visitor const &visitor)
+{
+  SizeType const row_stride    = input_stride;
+  SizeType const column_stride = row_stride * geometry.input_height;
+  SizeType const batch_stride  = column_stride * geometry.input_width;
+
+  for (SizeType i_b = batch_begin; i_b < batch_end; ++i_b)
+  {
+    for (SizeType j_o = 0; j_o < geometry.output_width; ++j_o)
+    {
+      for (SizeType i_o = 0; i_o < geometry.output_height; ++i_o)
+      {
+        SizeType const column =
+            (((i_b * geometry.output_width) + j_o) * geometry.output_height) + i_o;
+
+        T *const field = input + (i_b * batch_stride) +
+                         (j_o * geometry.stride * column_stride) +
+                         (i_o * geometry.stride * row_stride);
+        T *unrolled = columns + (column * columns_stride);
+
+        for (SizeType j_k = 0; j_k < geometry.kernel_width; ++j_k)
+        {
+          for (SizeType i_k = 0; i_k < geometry.kernel_height; ++i_k)
+          {
+            visitor(field + (j_k * column_stride) + (i_k * row_stride), unrolled);
+            unrolled += geometry.input_channels;
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename TensorType>
+TensorType const &Im2Col(TensorType const &input, ConvolutionGeometry const &geometry,
+                         TensorType &buffer)
+{
+  using DataType = typename TensorType::Type;
+
+  if (geometry.IsPointwise())
+  {
+    return input;
+  }
+
+  buffer.Resize({geometry.ColumnHeight(), geometry.ColumnWidth()});
+
+  // input is only read, the const_cast lets it share the traversal with Col2Im
+  auto *const    input_data = const_cast<DataType *>(input.data().pointer());
+  auto *const    columns    = buffer.data().pointer();
+  SizeType const channels   = geometry.input_channels;
+
+  auto const unroll = [&](SizeType batch_begin, SizeType batch_end) {
+    VisitReceptiveFields(geometry, input_data, input.padded_height(), columns,
+                         buffer.padded_height(), batch_begin, batch_end,
+                         [channels](DataType *field, DataType *unrolled) {
+                           std::copy(field, field + channels, unrolled);
+                         });
+  };
+
+  // unrolling only copies values, so it is safe to split for every type
+  ForEachBatch(geometry, true, unroll);
+
+  return buffer;
+}
+
+template <typename TensorType>
+void Col2Im(TensorType const &columns, ConvolutionGeometry const &geometry, TensorType &input)
+{
+  using DataType = typename TensorType::Type;
+
+  assert(columns.shape() ==
+         std::vector<SizeType>({geometry.ColumnHeight(), geometry.ColumnWidth()}));
+
+  if (geometry.IsPointwise())
+  {
+    CopyLayout(columns, input);
+    return;
+  }
+
+  auto *const    input_data   = input.data().pointer();
+  auto *const    columns_data = const_cast<DataType *>(columns.data().pointer());
+  SizeType const channels     = geometry.input_channels;
+
+  auto const fold = [&](SizeType batch_begin, SizeType batch_end) {
+    VisitReceptiveFields(geometry, input_data, input.padded_height(), columns_data,
+                         columns.padded_height(), batch_begin, batch_end,
+                         [channels](DataType *field, DataType *unrolled) {
+                           for (SizeType i_ic = 0; i_ic < channels; ++i_ic)
+                           {
+                             field[i_ic] = static_cast<DataType>(field[i_ic] + unrolled[i_ic]);
+                           }
+                         });
+  };
+
+  // each range of the batch writes to its own part of the input, but fixed point arithmetic
+  // records overflows in a state shared by all threads
+  ForEachBatch(geometry, !math::meta::IsFixedPoint<DataType>, fold);
+}
+
+template <typename TensorType>
+TensorType const &SingleKernelSet(TensorType const &kernels, TensorType &buffer)
+{
+  std::vector<SizeType> shape = kernels.shape();
+  if (shape.back() == 1)
+  {
+    return kernels;
+  }
+
+  // the set is the slowest changing dimension, so the first set is at the start of the data
+  shape.back() = 1;
+  buffer.Resize(shape);
+  CopyLayout(kernels, buffer);
+
+  return buffer;
+}
+
+template <typename TensorType>
+void CopyLayout(TensorType const &from, TensorType &to)
+{
+  assert(from.padded_height() == to.padded_height());
+
+  auto const *const source = from.data().pointer();
+  std::copy(source, source + std::min(from.padded_size(), to.padded_size()), to.data().pointer());
+}
+
+///////////////////////////////
+/// EXPLICIT INSTANTIATIONS ///
+///////////////////////////////
+
+template math::Tensor<int8_t> const &Im2Col<math::Tensor<int8_t>>(
+    math::Tensor<int8_t> const &, ConvolutionGeometry const &, math::Tensor<int8_t> &);
+template math::Tensor<int16_t> const &Im2Col<math::Tensor<int16_t>>(
+    math::Tensor<int16_t> const &, ConvolutionGeometry const &, math::Tensor<int16_t> &);
+template math::Tensor<int32_t> const &Im2Col<math::Tensor<int32_t>>(
+    math::Tensor<int32_t> const &, ConvolutionGeometry const &, math::Tensor<int32_t> &);
+template math::Tensor<int64_t> const &Im2Col<math::Tensor<int64_t>>(
+    math::Tensor<int64_t> const &, ConvolutionGeometry const &, math::Tensor<int64_t> &);
+template math::Tensor<float> const &Im2Col<math::Tensor<float>>(
+    math::Tensor<float> const &, ConvolutionGeometry const &, math::Tensor<float> &);
+template math::Tensor<double> const &Im2Col<math::Tensor<double>>(
+    math::Tensor<double> const &, ConvolutionGeometry const &, math::Tensor<double> &);
+template math::Tensor<fixed_point::fp32_t> const &Im2Col<math::Tensor<fixed_point::fp32_t>>(
+    math::Tensor<fixed_point::fp32_t> const &, ConvolutionGeometry const &,
+    math::Tensor<fixed_point::fp32_t> &);
+template math::Tensor<fixed_point::fp64_t> const &Im2Col<math::Tensor<fixed_point::fp64_t>>(
+    math::Tensor<fixed_point::fp64_t> const &, ConvolutionGeometry const &,
+    math::Tensor<fixed_point::fp64_t> &);
+template math::Tensor<fixed_point::fp128_t> const &Im2Col<math::Tensor<fixed_point::fp128_t>>(
+    math::Tensor<fixed_point::fp128_t> const &, ConvolutionGeometry const &,
+    math::Tensor<fixed_point::fp128_t> &);
+
+template void Col2Im<math::Tensor<int8_t>>(math::Tensor<int8_t> const &,
+                                           ConvolutionGeometry const &, math::Tensor<int8_t> &);
+template void Col2Im<math::Tensor<int16_t>>(math::Tensor<int16_t> const &,
+                                            ConvolutionGeometry const &, math::Tensor<int16_t> &);
+template void Col2Im<math::Tensor<int32_t>>(math::Tensor<int32_t> const &,
+                                            ConvolutionGeometry const &, math::Tensor<int32_t> &);
+template void Col2Im<math::Tensor<int64_t>>(math::Tensor<int64_t> const &,
+                                            ConvolutionGeometry const &, math::Tensor<int64_t> &);
+template void Col2Im<math::Tensor<float>>(math::Tensor<float> const &, ConvolutionGeometry const &,
+                                          math::Tensor<float> &);
+template void Col2Im<math::Tensor<double>>(math::Tensor<double> const &,
+                                           ConvolutionGeometry const &, math::Tensor<double> &);
+template void Col2Im<math::Tensor<fixed_point::fp32_t>>(math::Tensor<fixed_point::fp32_t> const &,
+                                                        ConvolutionGeometry const &,
+                                                        math::Tensor<fixed_point::fp32_t> &);
+template void Col2Im<math::Tensor<fixed_point::fp64_t>>(math::Tensor<fixed_point::fp64_t> const &,
+                                                        ConvolutionGeometry const &,
+                                                        math::Tensor<fixed_point::fp64_t> &);
+template void Col2Im<math::Tensor<fixed_point::fp128_t>>(math::Tensor<fixed_point::fp128_t> const &,
+                                                         ConvolutionGeometry const &,
+                                                         math::Tensor<fixed_point::fp128_t> &);
+
+template math::Tensor<int8_t> const &SingleKernelSet<math::Tensor<int8_t>>(
+    math::Tensor<int8_t> const &, math::Tensor<int8_t> &);
+template math::Tensor<int16_t> const &SingleKernelSet<math::Tensor<int16_t>>(
+    math::Tensor<int16_t> const &, math::Tensor<int16_t> &);
+template math::Tensor<int32_t> const &SingleKernelSet<math::Tensor<int32_t>>(
+    math::Tensor<int32_t> const &, math::Tensor<int32_t> &);
+template math::Tensor<int64_t> const &SingleKernelSet<math::Tensor<int64_t>>(
+    math::Tensor<int64_t> const &, math::Tensor<int64_t> &);
+template math::Tensor<float> const &SingleKernelSet<math::Tensor<float>>(
+    math::Tensor<float> const &, math::Tensor<float> &);
+template math::Tensor<double> const &SingleKernelSet<math::Tensor<double>>(
+    math::Tensor<double> const &, math::Tensor<double> &);
+template math::Tensor<fixed_point::fp32_t> const &
+    SingleKernelSet<math::Tensor<fixed_point::fp32_t>>(math::Tensor<fixed_point::fp32_t> const &,
+                                                       math::Tensor<fixed_point::fp32_t> &);
+template math::Tensor<fixed_point::fp64_t> const &
+    SingleKernelSet<math::Tensor<fixed_point::fp64_t>>(math::Tensor<fixed_point::fp64_t> const &,
+                                                       math::Tensor<fixed_point::fp64_t> &);
+template math::Tensor<fixed_point::fp128_t> const &
+    SingleKernelSet<math::Tensor<fixed_point::fp128_t>>(math::Tensor<fixed_point::fp128_t> const &,
+                                                        math::Tensor<fixed_point::fp128_t> &);
+
+template void CopyLayout<math::Tensor<int8_t>>(math::Tensor<int8_t> const &,
+                                               math::Tensor<int8_t> &);
+template void CopyLayout<math::Tensor<int16_t>>(math::Tensor<int16_t> const &,
+                                                math::Tensor<int16_t> &);
+template void CopyLayout<math::Tensor<int32_t>>(math::Tensor<int32_t> const &,
+                                                math::Tensor<int32_t> &);
+template void CopyLayout<math::Tensor<int64_t>>(math::Tensor<int64_t> const &,
+                                                math::Tensor<int64_t> &);
+template void CopyLayout<math::Tensor<float>>(math::Tensor<float> const &, math::Tensor<float> &);
+template void CopyLayout<math::Tensor<double>>(math::Tensor<double> const &,
+                                               math::Tensor<double> &);
+template void CopyLayout<math::Tensor<fixed_point::fp32_t>>(
+    math::Tensor<fixed_point::fp32_t> const &, math::Tensor<fixed_point::fp32_t> &);
+template void CopyLayout<math::Tensor<fixed_point::fp64_t>>(
+    math::Tensor<fixed_point::fp64_t> const &, math::Tensor<fixed_point::fp64_t> &);
+template void CopyLayout<math::Tensor<fixed_point::fp128_t>>(
+    math::Tensor<fixed_point::fp128_t> const &, math::Tensor<fixed_point::fp128_t> &);
+
+}  // namespace ops
+}  // namespace ml
+}  // namespace fetch
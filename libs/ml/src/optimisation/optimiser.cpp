@@ -20,11 +20,136 @@
 #include "ml/core/graph.hpp"
 #include "ml/meta/ml_type_traits.hpp"
 #include "ml/ops/trainable.hpp"
+#include "ml/ops/variable.hpp"
 #include "ml/optimisation/optimiser.hpp"
+#include "ml/utilities/graph_builder.hpp"
+#include "vectorise/fixed_point/type_traits.hpp"
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <string>
+#include <vector>
 
 namespace fetch {
 namespace ml {
 namespace optimisers {
+namespace {
+
+/**
+ * Calls task(i) for every i in [0, count), dispatching all but the first task to the pool. Without
+ * a pool the tasks are run in order on the calling thread.
+ */
+template <typename Task>
+void RunTasks(threading::Pool *pool, math::SizeType count, Task const &task)
+{
+  if (pool == nullptr)
+  {
+    for (math::SizeType i = 0; i < count; ++i)
+    {
+      task(i);
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> results{};
+  for (math::SizeType i = 1; i < count; ++i)
+  {
+    results.emplace_back(pool->Dispatch([&task, i]() { task(i); }));
+  }
+
+  // every task refers to the caller's state, so all of them must finish before an error is raised
+  std::exception_ptr error;
+  try
+  {
+    task(0);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  for (auto &result : results)
+  {
+    try
+    {
+      result.get();
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * The gradients of these losses are averaged over the batch they are computed on, so the
+ * gradients of each slice of a batch must be weighted by the size of the slice before they are
+ * summed. The gradients of the other losses are summed over the batch.
+ */
+bool AveragesGradientsOverBatch(OpType op_type)
+{
+  return (op_type == OpType::LOSS_CROSS_ENTROPY) || (op_type == OpType::LOSS_MEAN_SQUARE_ERROR);
+}
+
+/**
+ * Multiplies the accumulated gradients of a trainable by factor, only touching the updated rows
+ * of sparse gradients
+ */
+template <typename TensorType>
+void ScaleGradients(ops::Variable<TensorType> const &trainable,
+                    typename TensorType::Type const &factor)
+{
+  // a shallow copy which shares the gradient accumulation of the trainable
+  TensorType gradients = trainable.GetGradientsReferences();
+  auto const &rows     = trainable.GetUpdatedRowsReferences();
+
+  if (rows.empty())
+  {
+    fetch::math::Multiply(gradients, factor, gradients);
+    return;
+  }
+
+  for (auto const row : rows)
+  {
+    auto       gradient_slice        = gradients.View(row);
+    TensorType gradient_slice_tensor = gradient_slice.Copy();
+    fetch::math::Multiply(gradient_slice_tensor, factor, gradient_slice_tensor);
+    gradient_slice.Assign(gradient_slice_tensor);
+  }
+}
+
+/**
+ * Copies the samples [begin, end) of the last dimension of from into to, resizing to if needed
+ */
+template <typename TensorType>
+void CopyBatchSlice(TensorType const &from, math::SizeType begin, math::SizeType end,
+                    TensorType &to)
+{
+  std::vector<math::SizeType> shape = from.shape();
+  shape.back()                      = end - begin;
+  if (to.shape() != shape)
+  {
+    to = TensorType{shape};
+  }
+
+  for (math::SizeType i = begin; i < end; ++i)
+  {
+    auto view = to.View(i - begin);
+    view.Assign(from.View(i));
+  }
+}
+
+}  // namespace
 
 template <class TensorType>
 void Optimiser<TensorType>::Init()
@@ -145,20 +270,7 @@ typename TensorType::Type Optimiser<TensorType>::Run(std::vector<TensorType> con
       it++;
     }
 
-    // Set inputs
-    auto name_it = input_node_names_.begin();
-    for (auto &input : batch_data_)
-    {
-      graph_->SetInputReference(*name_it, input);
-      ++name_it;
-    }
-
-    // Set Label
-    graph_->SetInputReference(label_node_name_, batch_labels_);
-
-    auto loss_tensor = graph_->ForwardPropagate(output_node_name_);
-    loss_ += *(loss_tensor.begin());
-    graph_->BackPropagate(output_node_name_);
+    loss_ += ComputeGradients(batch_data_, batch_labels_);
 
     // Compute and apply gradient
     ApplyGradients(batch_size);
@@ -248,20 +360,7 @@ typename TensorType::Type Optimiser<TensorType>::RunImplementation(
 
     // Do batch back-propagation
     input = loader.PrepareBatch(batch_size, is_done_set);
-
-    auto name_it = input_node_names_.begin();
-    for (auto &cur_input : input.second)
-    {
-      graph_->SetInputReference(*name_it, cur_input);
-      ++name_it;
-    }
-
-    // Set Label
-    graph_->SetInputReference(label_node_name_, input.first);
-
-    auto loss_tensor = graph_->ForwardPropagate(output_node_name_);
-    loss_ += *(loss_tensor.begin());
-    graph_->BackPropagate(output_node_name_);
+    loss_ += ComputeGradients(input.second, input.first);
 
     // Compute and apply gradient
     ApplyGradients(batch_size);
@@ -287,6 +386,254 @@ typename TensorType::Type Optimiser<TensorType>::RunImplementation(
   return loss_sum_ / static_cast<DataType>(i);
 }
 
+/**
+ * Sets the number of threads each batch is split across. Every thread forward and back propagates
+ * a contiguous slice of the batch through its own replica of the graph, and the gradients of the
+ * replicas are then summed by a tree reduction in a fixed order, so that training results only
+ * depend on the thread count. Fixed point replicas are run one after the other, since fixed point
+ * arithmetic records its errors in a state shared by all threads.
+ * @tparam TensorType
+ * @param thread_count the number of graph replicas, 1 disables data parallel training
+ */
+template <typename TensorType>
+void Optimiser<TensorType>::SetThreadCount(SizeType thread_count)
+{
+  if (thread_count == 0)
+  {
+    throw exceptions::InvalidMode("Optimiser thread count must be at least 1");
+  }
+
+  thread_count_ = thread_count;
+  replicas_.clear();
+
+  thread_pool_.reset();
+  if ((thread_count_ > 1) && !math::meta::IsFixedPoint<DataType>)
+  {
+    // the calling thread trains the first replica
+    thread_pool_ = std::make_shared<threading::Pool>(thread_count_ - 1, "Optimiser");
+  }
+}
+
+template <typename TensorType>
+typename Optimiser<TensorType>::SizeType Optimiser<TensorType>::GetThreadCount() const
+{
+  return thread_count_;
+}
+
+/**
+ * Forward and back propagates a batch, accumulating the gradients in the trainables of graph_
+ * @tparam TensorType
+ * @param data the batch of every input node
+ * @param labels the batch of labels
+ * @return the loss of the batch
+ */
+template <typename TensorType>
+typename TensorType::Type Optimiser<TensorType>::ComputeGradients(
+    std::vector<TensorType> const &data, TensorType const &labels)
+{
+  if (thread_count_ > 1)
+  {
+    return ComputeGradientsDataParallel(data, labels);
+  }
+
+  auto name_it = input_node_names_.begin();
+  for (auto const &input : data)
+  {
+    graph_->SetInputReference(*name_it, input);
+    ++name_it;
+  }
+
+  // Set Label
+  graph_->SetInputReference(label_node_name_, labels);
+
+  auto     loss_tensor = graph_->ForwardPropagate(output_node_name_);
+  DataType loss        = *(loss_tensor.begin());
+  graph_->BackPropagate(output_node_name_);
+
+  return loss;
+}
+
+template <typename TensorType>
+typename TensorType::Type Optimiser<TensorType>::ComputeGradientsDataParallel(
+    std::vector<TensorType> const &data, TensorType const &labels)
+{
+  if (replicas_.size() != thread_count_)
+  {
+    BuildReplicas();
+  }
+
+  SizeType const batch_size    = labels.shape().back();
+  SizeType const replica_count = std::min(thread_count_, batch_size);
+  bool const     averaged_loss =
+      AveragesGradientsOverBatch(graph_->GetNode(output_node_name_)->OperationType());
+
+  // slices of equal size are weighted once after the reduction rather than by every replica
+  bool const equal_slices = (batch_size % replica_count) == 0;
+
+  auto const slice_begin = [batch_size, replica_count](SizeType replica) {
+    return (replica * batch_size) / replica_count;
+  };
+
+  auto const train_replica = [&](SizeType replica) {
+    auto const &graph        = replicas_.at(replica);
+    auto const &trainables   = replica_trainables_.at(replica);
+    auto &      replica_data = replica_data_.at(replica);
+
+    SizeType const begin = slice_begin(replica);
+    SizeType const end   = slice_begin(replica + 1);
+
+    // share weights which were replaced since the last batch, and discard the outputs computed
+    // with the weights before the last update
+    for (SizeType i = 0; i < trainables.size(); ++i)
+    {
+      TensorType const &weights = graph_trainables_.at(i)->GetWeights();
+      if (trainables.at(i)->GetWeights().data().pointer() != weights.data().pointer())
+      {
+        trainables.at(i)->SetData(weights);
+      }
+    }
+    graph->ResetGraphCache(false);
+
+    replica_data.resize(data.size());
+    auto name_it = input_node_names_.begin();
+    for (SizeType i = 0; i < data.size(); ++i)
+    {
+      CopyBatchSlice(data.at(i), begin, end, replica_data.at(i));
+      graph->SetInputReference(*name_it, replica_data.at(i));
+      ++name_it;
+    }
+
+    CopyBatchSlice(labels, begin, end, replica_labels_.at(replica));
+    graph->SetInputReference(label_node_name_, replica_labels_.at(replica));
+
+    auto loss_tensor = graph->ForwardPropagate(output_node_name_);
+    graph->BackPropagate(output_node_name_);
+
+    // the losses are averaged over the batch
+    DataType const slice_weight =
+        static_cast<DataType>(end - begin) / static_cast<DataType>(batch_size);
+    replica_losses_.at(replica) = static_cast<DataType>(*(loss_tensor.begin()) * slice_weight);
+
+    if (averaged_loss && !equal_slices)
+    {
+      for (auto const &trainable : trainables)
+      {
+        ScaleGradients(*trainable, slice_weight);
+      }
+    }
+  };
+
+  RunTasks(thread_pool_.get(), replica_count, train_replica);
+
+  ReduceGradients(replica_count);
+
+  if (averaged_loss && equal_slices && (replica_count > 1))
+  {
+    DataType const slice_weight = DataType{1} / static_cast<DataType>(replica_count);
+    for (auto const &trainable : replica_trainables_.front())
+    {
+      ScaleGradients(*trainable, slice_weight);
+    }
+  }
+
+  DataType loss{0};
+  for (SizeType replica = 0; replica < replica_count; ++replica)
+  {
+    loss = static_cast<DataType>(loss + replica_losses_.at(replica));
+  }
+
+  return loss;
+}
+
+/**
+ * Builds the graph replicas for data parallel training from the saveable params of graph_, which
+ * is used as the first replica. The weights of the replicas share the memory of the weights of
+ * graph_ so that the optimiser updates all of them at once, while every replica accumulates its
+ * own gradients.
+ * @tparam TensorType
+ */
+template <typename TensorType>
+void Optimiser<TensorType>::BuildReplicas()
+{
+  replicas_ = {graph_};
+
+  auto const graph_saveable_params = graph_->GetGraphSaveableParams();
+  for (SizeType i = 1; i < thread_count_; ++i)
+  {
+    auto replica = std::make_shared<Graph<TensorType>>();
+    utilities::BuildGraph<TensorType>(graph_saveable_params, replica);
+    replica->Compile();
+    replicas_.emplace_back(replica);
+  }
+
+  replica_trainables_.clear();
+  for (auto const &replica : replicas_)
+  {
+    std::vector<VariablePtrType> trainables;
+    for (auto const &trainable : replica->GetTrainables())
+    {
+      trainables.emplace_back(std::dynamic_pointer_cast<ops::Variable<TensorType>>(trainable));
+    }
+
+    if (trainables.size() != graph_trainables_.size())
+    {
+      throw exceptions::InvalidMode("Graph replica does not match the trained graph");
+    }
+
+    for (SizeType i = 0; i < trainables.size(); ++i)
+    {
+      if (!trainables.at(i) ||
+          (trainables.at(i)->GetWeights().shape() != graph_trainables_.at(i)->GetWeights().shape()))
+      {
+        throw exceptions::InvalidMode("Graph replica does not match the trained graph");
+      }
+
+      if (replica != graph_)
+      {
+        trainables.at(i)->SetData(graph_trainables_.at(i)->GetWeights());
+        trainables.at(i)->ResetGradients();
+      }
+    }
+
+    replica_trainables_.emplace_back(std::move(trainables));
+  }
+
+  replica_data_.resize(thread_count_);
+  replica_labels_.resize(thread_count_);
+  replica_losses_.resize(thread_count_);
+}
+
+/**
+ * Sums the gradients of the first replica_count replicas into graph_ with a tree reduction. At
+ * every level replica i accumulates the gradients of replica (i + stride), so the order of the
+ * additions only depends on the number of replicas.
+ * @tparam TensorType
+ * @param replica_count the number of replicas which computed gradients
+ */
+template <typename TensorType>
+void Optimiser<TensorType>::ReduceGradients(SizeType replica_count)
+{
+  SizeType const trainable_count = graph_trainables_.size();
+
+  for (SizeType stride = 1; stride < replica_count; stride *= 2)
+  {
+    SizeType const pairs = (replica_count - stride + (2 * stride) - 1) / (2 * stride);
+
+    auto const reduce = [&](SizeType task) {
+      SizeType const pair      = task / trainable_count;
+      SizeType const trainable = task % trainable_count;
+
+      auto const &to   = replica_trainables_.at(2 * stride * pair).at(trainable);
+      auto const &from = replica_trainables_.at((2 * stride * pair) + stride).at(trainable);
+
+      to->AddToGradient(from->GetGradientsReferences(), from->GetUpdatedRowsReferences());
+      from->ResetGradients();
+    };
+
+    RunTasks(thread_pool_.get(), pairs * trainable_count, reduce);
+  }
+}
+
 template <typename TensorType>
 void Optimiser<TensorType>::PrintStats(SizeType batch_size, SizeType subset_size)
 {
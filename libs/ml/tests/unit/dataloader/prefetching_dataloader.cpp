@@ -0,0 +1,296 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ml/dataloaders/prefetching_dataloader.hpp"
+#include "ml/dataloaders/tensor_dataloader.hpp"
+
+#include "math/base_types.hpp"
+#include "ml/core/graph.hpp"
+#include "ml/layers/fully_connected.hpp"
+#include "ml/ops/loss_functions/mean_square_error_loss.hpp"
+#include "ml/ops/placeholder.hpp"
+#include "ml/optimisation/sgd_optimiser.hpp"
+#include "test_types.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace fetch {
+namespace ml {
+namespace test {
+
+template <typename T>
+class PrefetchingDataloaderTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_SUITE(PrefetchingDataloaderTest, math::test::TensorFloatingTypes, );
+
+namespace prefetching_dataloader_details {
+
+/**
+ * Builds a tensor dataloader whose i-th sample has the label i and the data {i, 2 * i, 3 * i}
+ */
+template <typename TypeParam>
+std::shared_ptr<fetch::ml::dataloaders::TensorDataLoader<TypeParam>> PrepareTestLoader(
+    fetch::math::SizeType n_data)
+{
+  using SizeType = fetch::math::SizeType;
+  using DataType = typename TypeParam::Type;
+
+  TypeParam labels({1, n_data});
+  TypeParam data({3, n_data});
+  for (SizeType i = 0; i < n_data; ++i)
+  {
+    labels(0, i) = static_cast<DataType>(i);
+    for (SizeType j = 0; j < 3; ++j)
+    {
+      data(j, i) = static_cast<DataType>(i * (j + 1));
+    }
+  }
+
+  auto loader = std::make_shared<fetch::ml::dataloaders::TensorDataLoader<TypeParam>>();
+  loader->AddData({data}, labels);
+  return loader;
+}
+
+template <typename TypeParam>
+std::vector<fetch::math::SizeType> Labels(
+    std::pair<TypeParam, std::vector<TypeParam>> const &batch)
+{
+  std::vector<fetch::math::SizeType> labels;
+  for (auto const &label : batch.first)
+  {
+    labels.emplace_back(static_cast<fetch::math::SizeType>(label));
+  }
+  return labels;
+}
+
+}  // namespace prefetching_dataloader_details
+
+TYPED_TEST(PrefetchingDataloaderTest, batches_match_wrapped_loader)
+{
+  using SizeType = fetch::math::SizeType;
+
+  // 10 samples in batches of 4 run past the end of the epoch every third batch
+  auto expected_loader = prefetching_dataloader_details::PrepareTestLoader<TypeParam>(10);
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(10), 3);
+
+  for (SizeType i = 0; i < 10; ++i)
+  {
+    bool expected_is_done_set = false;
+    bool is_done_set          = false;
+    auto expected             = expected_loader->PrepareBatch(4, expected_is_done_set);
+    auto batch                = loader.PrepareBatch(4, is_done_set);
+
+    EXPECT_EQ(is_done_set, expected_is_done_set);
+    EXPECT_EQ(loader.IsDone(), expected_loader->IsDone());
+    EXPECT_TRUE(batch.first.AllClose(expected.first));
+    ASSERT_EQ(batch.second.size(), 1);
+    EXPECT_EQ(batch.second.at(0).shape(), expected.second.at(0).shape());
+    EXPECT_TRUE(batch.second.at(0).AllClose(expected.second.at(0)));
+  }
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, is_done_and_reset)
+{
+  using SizeType = fetch::math::SizeType;
+
+  // 12 samples in batches of 4 end the epoch with the third batch
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(12), 2);
+
+  for (SizeType epoch = 0; epoch < 3; ++epoch)
+  {
+    if (loader.IsDone())
+    {
+      loader.Reset();
+    }
+
+    for (SizeType i = 0; i < 3; ++i)
+    {
+      EXPECT_FALSE(loader.IsDone());
+
+      bool is_done_set = false;
+      auto batch       = loader.PrepareBatch(4, is_done_set);
+
+      EXPECT_FALSE(is_done_set);
+      EXPECT_EQ(prefetching_dataloader_details::Labels(batch),
+                std::vector<SizeType>({4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3}));
+    }
+    EXPECT_TRUE(loader.IsDone());
+  }
+
+  // a reset during an epoch discards the prefetched batches and starts over
+  bool is_done_set = false;
+  loader.Reset();
+  loader.PrepareBatch(4, is_done_set);
+  loader.Reset();
+  auto batch = loader.PrepareBatch(4, is_done_set);
+  EXPECT_FALSE(is_done_set);
+  EXPECT_EQ(prefetching_dataloader_details::Labels(batch), std::vector<SizeType>({0, 1, 2, 3}));
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, changing_batch_size_keeps_prefetched_samples)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(20), 4);
+
+  bool is_done_set = false;
+  auto batch       = loader.PrepareBatch(3, is_done_set);
+  EXPECT_EQ(prefetching_dataloader_details::Labels(batch), std::vector<SizeType>({0, 1, 2}));
+
+  batch = loader.PrepareBatch(5, is_done_set);
+  EXPECT_EQ(prefetching_dataloader_details::Labels(batch), std::vector<SizeType>({3, 4, 5, 6, 7}));
+
+  auto sample = loader.GetNext();
+  EXPECT_EQ(static_cast<SizeType>(sample.first(0, 0)), 8);
+
+  batch = loader.PrepareBatch(2, is_done_set);
+  EXPECT_EQ(prefetching_dataloader_details::Labels(batch), std::vector<SizeType>({9, 10}));
+  EXPECT_FALSE(is_done_set);
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, shuffle_buffer_permutes_every_epoch)
+{
+  using SizeType = fetch::math::SizeType;
+
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(20), 2, 8);
+  loader.SetSeed(42);
+
+  std::vector<SizeType> sequential(20);
+  std::iota(sequential.begin(), sequential.end(), SizeType{0});
+
+  for (SizeType epoch = 0; epoch < 2; ++epoch)
+  {
+    std::vector<SizeType> labels;
+    for (SizeType i = 0; i < 4; ++i)
+    {
+      bool is_done_set = false;
+      auto batch       = loader.PrepareBatch(5, is_done_set);
+      EXPECT_FALSE(is_done_set);
+
+      // the data of every sample is still that of its label
+      for (SizeType j = 0; j < 5; ++j)
+      {
+        auto const label = static_cast<SizeType>(batch.first(0, j));
+        EXPECT_EQ(static_cast<SizeType>(batch.second.at(0)(2, j)), 3 * label);
+        labels.emplace_back(label);
+      }
+    }
+    EXPECT_TRUE(loader.IsDone());
+    loader.Reset();
+
+    EXPECT_NE(labels, sequential);
+    std::sort(labels.begin(), labels.end());
+    EXPECT_EQ(labels, sequential);
+  }
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, modes_keep_their_own_epochs)
+{
+  using DataLoaderMode = fetch::ml::dataloaders::DataLoaderMode;
+
+  auto expected_loader = prefetching_dataloader_details::PrepareTestLoader<TypeParam>(20);
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(20), 2);
+
+  expected_loader->SetValidationRatio(math::AsType<fetch::fixed_point::fp32_t>(0.2));
+  loader.SetValidationRatio(math::AsType<fetch::fixed_point::fp32_t>(0.2));
+  ASSERT_TRUE(loader.IsModeAvailable(DataLoaderMode::VALIDATE));
+
+  // switching modes part way through the training epoch resumes it when switching back
+  for (auto mode : {DataLoaderMode::TRAIN, DataLoaderMode::VALIDATE, DataLoaderMode::TRAIN,
+                    DataLoaderMode::VALIDATE, DataLoaderMode::TRAIN})
+  {
+    expected_loader->SetMode(mode);
+    loader.SetMode(mode);
+    EXPECT_EQ(loader.Size(), expected_loader->Size());
+    EXPECT_EQ(loader.IsDone(), expected_loader->IsDone());
+
+    bool expected_is_done_set = false;
+    bool is_done_set          = false;
+    auto expected             = expected_loader->PrepareBatch(3, expected_is_done_set);
+    auto batch                = loader.PrepareBatch(3, is_done_set);
+
+    EXPECT_EQ(is_done_set, expected_is_done_set);
+    EXPECT_EQ(loader.IsDone(), expected_loader->IsDone());
+    EXPECT_EQ(prefetching_dataloader_details::Labels(batch),
+              prefetching_dataloader_details::Labels(expected));
+  }
+}
+
+TYPED_TEST(PrefetchingDataloaderTest, optimiser_training_matches_wrapped_loader)
+{
+  using DataType = typename TypeParam::Type;
+  using SizeType = fetch::math::SizeType;
+
+  auto const train = [](fetch::ml::dataloaders::DataLoader<TypeParam> &loader) {
+    auto g = std::make_shared<fetch::ml::Graph<TypeParam>>();
+
+    std::string input_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TypeParam>>("", {});
+    std::string output_name = g->template AddNode<fetch::ml::layers::FullyConnected<TypeParam>>(
+        "FC", {input_name}, 3, 1);
+    std::string label_name = g->template AddNode<fetch::ml::ops::PlaceHolder<TypeParam>>("", {});
+    std::string error_name = g->template AddNode<fetch::ml::ops::MeanSquareErrorLoss<TypeParam>>(
+        "Error", {output_name, label_name});
+
+    for (auto &weight : g->GetWeightsReferences())
+    {
+      weight.Fill(fetch::math::Type<DataType>("0.01"));
+    }
+
+    fetch::ml::optimisers::SGDOptimiser<TypeParam> optimiser(
+        g, {input_name}, label_name, error_name, fetch::math::Type<DataType>("0.0001"));
+
+    std::vector<DataType> losses;
+    for (SizeType epoch = 0; epoch < 3; ++epoch)
+    {
+      losses.emplace_back(optimiser.Run(loader, 4));
+    }
+    losses.emplace_back(optimiser.Run(loader, 3, 9));
+
+    return std::make_pair(losses, g->GetWeights());
+  };
+
+  auto expected_loader = prefetching_dataloader_details::PrepareTestLoader<TypeParam>(10);
+  fetch::ml::dataloaders::PrefetchingDataLoader<TypeParam> loader(
+      prefetching_dataloader_details::PrepareTestLoader<TypeParam>(10), 2);
+
+  auto const expected = train(*expected_loader);
+  auto const result   = train(loader);
+
+  EXPECT_EQ(result.first, expected.first);
+  ASSERT_EQ(result.second.size(), expected.second.size());
+  for (SizeType i = 0; i < result.second.size(); ++i)
+  {
+    EXPECT_TRUE(result.second.at(i).AllClose(expected.second.at(i), DataType{0}, DataType{0}));
+  }
+}
+
+}  // namespace test
+}  // namespace ml
+}  // namespace fetch
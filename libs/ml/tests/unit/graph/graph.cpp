@@ -649,6 +649,55 @@ TYPED_TEST(GraphTest, diamond_graph_backward)  // output=(input1*input2)-(input1
                                      fetch::math::function_tolerance<DataType>()));
 }
 
+TYPED_TEST(GraphTest, fan_out_graph_backward)  // output=(input+input)+input
+{
+  using DataType   = typename TypeParam::Type;
+  using TensorType = TypeParam;
+
+  TensorType data         = TensorType::FromString(R"(-1,0,1,2,3,4)");
+  TensorType error_signal = TensorType::FromString(R"(-1,0,1,2,3,4)");
+  TensorType gt           = TensorType::FromString(R"(-3,0,3,6,9,12)");
+  TensorType grad         = TensorType::FromString(R"(-3,0,3,6,9,12)");
+
+  fetch::ml::Graph<TypeParam> g;
+
+  std::string input_name =
+      g.template AddNode<fetch::ml::ops::Weights<TensorType>>("FanOut_Input", {});
+  std::string op1_name = g.template AddNode<fetch::ml::ops::Add<TensorType>>(
+      "FanOut_Op1", {input_name, input_name});
+  std::string output_name =
+      g.template AddNode<fetch::ml::ops::Add<TensorType>>("FanOut_Op2", {op1_name, input_name});
+
+  g.SetInput(input_name, data);
+  TypeParam output = g.Evaluate(output_name);
+  ASSERT_TRUE(output.AllClose(gt, fetch::math::function_tolerance<DataType>(),
+                              fetch::math::function_tolerance<DataType>()));
+
+  // the input receives the error signal three times, twice as the same tensor from Op1. The pass
+  // is repeated to check that error signals are not carried over between passes
+  for (std::size_t pass = 0; pass < 2; ++pass)
+  {
+    g.BackPropagate(output_name, error_signal);
+
+    std::vector<TypeParam> gradients = g.GetGradients();
+    ASSERT_EQ(gradients.size(), 1);
+    ASSERT_TRUE(gradients[0].AllClose(grad, fetch::math::function_tolerance<DataType>(),
+                                      fetch::math::function_tolerance<DataType>()));
+
+    g.ResetGradients();
+  }
+}
+
+TYPED_TEST(GraphTest, cyclic_graph_does_not_compile)
+{
+  fetch::ml::Graph<TypeParam> g;
+
+  g.template AddNode<fetch::ml::ops::Relu<TypeParam>>("Cycle_Op1", {"Cycle_Op2"});
+  g.template AddNode<fetch::ml::ops::Relu<TypeParam>>("Cycle_Op2", {"Cycle_Op1"});
+
+  EXPECT_THROW(g.Compile(), fetch::ml::exceptions::InvalidMode);
+}
+
 TYPED_TEST(GraphTest, compute_shapes_single_placeholder)
 {
   using TensorType = TypeParam;
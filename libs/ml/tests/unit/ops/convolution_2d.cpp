@@ -32,6 +32,91 @@ class Convolution2DTest : public ::testing::Test
 {
 };
 
+/**
+ * Computes the output and the gradients of a 2D convolution directly from its definition
+ */
+template <typename TensorType>
+std::vector<TensorType> ReferenceConvolution2D(TensorType const &input, TensorType const &kernels,
+                                               TensorType const &error_signal,
+                                               fetch::math::SizeType stride)
+{
+  using SizeType = fetch::math::SizeType;
+
+  TensorType output(error_signal.shape());
+  TensorType input_error(input.shape());
+  TensorType kernel_error(kernels.shape());
+
+  for (SizeType i_b{0}; i_b < output.shape(3); ++i_b)
+  {
+    for (SizeType j_o{0}; j_o < output.shape(2); ++j_o)
+    {
+      for (SizeType i_o{0}; i_o < output.shape(1); ++i_o)
+      {
+        for (SizeType i_oc{0}; i_oc < kernels.shape(0); ++i_oc)
+        {
+          for (SizeType i_ic{0}; i_ic < kernels.shape(1); ++i_ic)
+          {
+            for (SizeType i_k{0}; i_k < kernels.shape(2); ++i_k)
+            {
+              for (SizeType j_k{0}; j_k < kernels.shape(3); ++j_k)
+              {
+                SizeType const i_i = (i_o * stride) + i_k;
+                SizeType const j_i = (j_o * stride) + j_k;
+
+                output(i_oc, i_o, j_o, i_b) +=
+                    kernels(i_oc, i_ic, i_k, j_k, 0) * input(i_ic, i_i, j_i, i_b);
+                input_error(i_ic, i_i, j_i, i_b) +=
+                    kernels(i_oc, i_ic, i_k, j_k, 0) * error_signal(i_oc, i_o, j_o, i_b);
+                kernel_error(i_oc, i_ic, i_k, j_k, 0) +=
+                    input(i_ic, i_i, j_i, i_b) * error_signal(i_oc, i_o, j_o, i_b);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return {output, input_error, kernel_error};
+}
+
+template <typename TensorType>
+void CheckAgainstReference(fetch::math::SizeType input_channels,
+                           fetch::math::SizeType output_channels,
+                           fetch::math::SizeType kernel_height, fetch::math::SizeType kernel_width,
+                           fetch::math::SizeType stride)
+{
+  using DataType = typename TensorType::Type;
+  using SizeType = fetch::math::SizeType;
+
+  TensorType input({input_channels, 7, 6, 3});
+  TensorType kernels({output_channels, input_channels, kernel_height, kernel_width, 1});
+  input.FillUniformRandom();
+  kernels.FillUniformRandom();
+
+  fetch::ml::ops::Convolution2D<TensorType> op(stride);
+
+  using VecTensorType = typename fetch::ml::ops::Convolution2D<TensorType>::VecTensorType;
+  VecTensorType const inputs{std::make_shared<TensorType>(input),
+                             std::make_shared<TensorType>(kernels)};
+  std::vector<SizeType> const output_shape = op.ComputeOutputShape(inputs);
+
+  TensorType error_signal(output_shape);
+  error_signal.FillUniformRandom();
+
+  auto const expected = ReferenceConvolution2D(input, kernels, error_signal, stride);
+
+  TensorType output(output_shape);
+  op.Forward(inputs, output);
+  std::vector<TensorType> const gradients = op.Backward(inputs, error_signal);
+
+  DataType const tolerance =
+      fetch::math::AsType<DataType>(100) * fetch::math::function_tolerance<DataType>();
+  EXPECT_TRUE(output.AllClose(expected.at(0), tolerance, tolerance));
+  EXPECT_TRUE(gradients.at(0).AllClose(expected.at(1), tolerance, tolerance));
+  EXPECT_TRUE(gradients.at(1).AllClose(expected.at(2), tolerance, tolerance));
+}
+
 TYPED_TEST_SUITE(Convolution2DTest, fetch::math::test::TensorFloatingTypes, );
 
 TYPED_TEST(Convolution2DTest, forward_1x1x1x2_1x1x1x1x2)
@@ -161,6 +246,21 @@ TYPED_TEST(Convolution2DTest, forward_1x5x5x3_1x1x3x3x3_stride_2)
   ASSERT_EQ(output.shape(), std::vector<SizeType>({1, 2, 2, 3}));
 }
 
+TYPED_TEST(Convolution2DTest, forward_and_backward_match_reference_with_overlapping_kernels)
+{
+  CheckAgainstReference<TypeParam>(3, 4, 3, 2, 1);
+}
+
+TYPED_TEST(Convolution2DTest, forward_and_backward_match_reference_with_stride_2)
+{
+  CheckAgainstReference<TypeParam>(3, 4, 3, 3, 2);
+}
+
+TYPED_TEST(Convolution2DTest, forward_and_backward_match_reference_with_pointwise_kernels)
+{
+  CheckAgainstReference<TypeParam>(5, 2, 1, 1, 1);
+}
+
 TYPED_TEST(Convolution2DTest, backward_3x3x3x2_5x3x3x3x2)
 {
   using DataType   = typename TypeParam::Type;
@@ -684,6 +684,101 @@ TYPED_TEST(OptimisersTest, adam_optimiser_minibatch_training)
                   static_cast<double>(data.size()));
 }
 
+///////////////////////////
+/// DATA PARALLEL TESTS ///
+///////////////////////////
+
+template <typename TypeParam, typename OptimiserType>
+std::vector<TypeParam> TrainDataParallel(typename TypeParam::SizeType thread_count)
+{
+  using DataType = typename TypeParam::Type;
+
+  std::string                                  input_name;
+  std::string                                  label_name;
+  std::string                                  output_name;
+  std::shared_ptr<fetch::ml::Graph<TypeParam>> g =
+      PrepareTestGraph<TypeParam>(4, 2, input_name, label_name, output_name);
+
+  TypeParam data;
+  TypeParam gt;
+  PrepareTestDataAndLabels2D(data, gt);
+
+  OptimiserType optimiser(g, {input_name}, label_name, output_name,
+                          fetch::math::Type<DataType>("0.001"));
+  optimiser.SetThreadCount(thread_count);
+  EXPECT_EQ(optimiser.GetThreadCount(), thread_count);
+
+  DataType loss1 = optimiser.Run({data}, gt);
+  DataType loss2 = optimiser.Run({data}, gt);
+  EXPECT_LE(static_cast<double>(loss2), static_cast<double>(loss1));
+
+  return g->GetWeights();
+}
+
+template <typename TypeParam, typename OptimiserType>
+void CheckDataParallelTraining()
+{
+  using DataType = typename TypeParam::Type;
+
+  auto const tolerance = fetch::math::function_tolerance<DataType>();
+  auto const expected  = TrainDataParallel<TypeParam, OptimiserType>(1);
+
+  // the batch of 3 is split evenly across 3 threads and unevenly across 2, and 4 threads leave one
+  // replica without data
+  for (fetch::math::SizeType thread_count : {2, 3, 4})
+  {
+    auto const weights = TrainDataParallel<TypeParam, OptimiserType>(thread_count);
+
+    ASSERT_EQ(weights.size(), expected.size());
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+      EXPECT_TRUE(weights.at(i).AllClose(expected.at(i), tolerance, tolerance))
+          << "threads: " << thread_count << " weights: " << i;
+    }
+  }
+}
+
+TYPED_TEST(OptimisersTest, sgd_optimiser_data_parallel_training)
+{
+  CheckDataParallelTraining<TypeParam, fetch::ml::optimisers::SGDOptimiser<TypeParam>>();
+}
+
+TYPED_TEST(OptimisersTest, momentum_optimiser_data_parallel_training)
+{
+  CheckDataParallelTraining<TypeParam, fetch::ml::optimisers::MomentumOptimiser<TypeParam>>();
+}
+
+TYPED_TEST(OptimisersTest, adagrad_optimiser_data_parallel_training)
+{
+  CheckDataParallelTraining<TypeParam, fetch::ml::optimisers::AdaGradOptimiser<TypeParam>>();
+}
+
+TYPED_TEST(OptimisersTest, rmsprop_optimiser_data_parallel_training)
+{
+  CheckDataParallelTraining<TypeParam, fetch::ml::optimisers::RMSPropOptimiser<TypeParam>>();
+}
+
+TYPED_TEST(OptimisersTest, adam_optimiser_data_parallel_training)
+{
+  CheckDataParallelTraining<TypeParam, fetch::ml::optimisers::AdamOptimiser<TypeParam>>();
+}
+
+TYPED_TEST(OptimisersTest, data_parallel_training_is_deterministic)
+{
+  using DataType = typename TypeParam::Type;
+
+  auto const first =
+      TrainDataParallel<TypeParam, fetch::ml::optimisers::AdamOptimiser<TypeParam>>(3);
+  auto const second =
+      TrainDataParallel<TypeParam, fetch::ml::optimisers::AdamOptimiser<TypeParam>>(3);
+
+  ASSERT_EQ(first.size(), second.size());
+  for (std::size_t i = 0; i < first.size(); ++i)
+  {
+    EXPECT_TRUE(first.at(i).AllClose(second.at(i), DataType{0}, DataType{0}));
+  }
+}
+
 }  // namespace test
 }  // namespace ml
 }  // namespace fetch
@@ -228,6 +228,48 @@ TYPED_TEST(SparseOptimisersTest, adam_optimiser_training_2D)
   EXPECT_LE(static_cast<double>(loss2), static_cast<double>(loss1));
 }
 
+TYPED_TEST(SparseOptimisersTest, lazy_adam_optimiser_data_parallel_training_2D)
+{
+  using DataType = typename TypeParam::Type;
+
+  auto const train = [](math::SizeType thread_count) {
+    std::string                                  input_name;
+    std::string                                  label_name;
+    std::string                                  output_name;
+    std::shared_ptr<fetch::ml::Graph<TypeParam>> g =
+        sparse_optimiser_details::PrepareTestGraph<TypeParam>(10, 50, input_name, label_name,
+                                                              output_name);
+
+    TypeParam data_1;
+    TypeParam gt_1;
+    sparse_optimiser_details::PrepareTestDataAndLabelsFirst(data_1, gt_1);
+
+    TypeParam data_2;
+    TypeParam gt_2;
+    sparse_optimiser_details::PrepareTestDataAndLabelsSecond(data_2, gt_2);
+
+    fetch::ml::optimisers::LazyAdamOptimiser<TypeParam> optimiser(
+        g, {input_name}, label_name, output_name, fetch::math::Type<DataType>("0.01"));
+    optimiser.SetThreadCount(thread_count);
+
+    optimiser.Run({data_1}, gt_1);
+    optimiser.Run({data_2}, gt_2);
+
+    return g->GetWeights();
+  };
+
+  // the sparse gradients of the replicas only update the rows of their own slice of the batch
+  auto const expected  = train(1);
+  auto const weights   = train(3);
+  auto const tolerance = fetch::math::function_tolerance<DataType>();
+
+  ASSERT_EQ(weights.size(), expected.size());
+  for (std::size_t i = 0; i < weights.size(); ++i)
+  {
+    EXPECT_TRUE(weights.at(i).AllClose(expected.at(i), tolerance, tolerance));
+  }
+}
+
 }  // namespace test
 }  // namespace ml
 }  // namespace fetch
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle_register.hpp"
+#include "router.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "logging/logging.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "muddle/router_configuration.hpp"
+#include "muddle/subscription.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace fetch;
+using namespace fetch::muddle;
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::crypto::ECDSASigner;
+
+using PacketPtr    = std::shared_ptr<Packet>;
+using Packets      = std::vector<PacketPtr>;
+using PacketBuffer = std::vector<ByteArray>;
+
+constexpr uint16_t    SERVICE             = 42;
+constexpr std::size_t NUMBER_OF_SENDERS   = 16;
+constexpr std::size_t NUMBER_OF_CHANNELS  = 4;
+constexpr std::size_t NUMBER_OF_PACKETS   = 4096;
+constexpr std::size_t PAYLOAD_SIZE        = 256;
+constexpr uint8_t     BROADCAST_TTL       = 40;
+constexpr char const  NETWORK_NAME[4 + 1] = "BNCH";
+
+/**
+ * Generates the serialised form of the broadcast packets which are used to flood the router. Every
+ * sender uses every channel and each (sender, channel) stream has its own message counter, so that
+ * none of the packets is an echo of another.
+ */
+PacketBuffer const &GetSignedBroadcasts()
+{
+  static PacketBuffer const buffers = []() {
+    std::vector<std::unique_ptr<ECDSASigner>> senders{};
+    for (std::size_t i = 0; i < NUMBER_OF_SENDERS; ++i)
+    {
+      senders.emplace_back(std::make_unique<ECDSASigner>());
+      senders.back()->GenerateKeys();
+    }
+
+    ByteArray payload{};
+    payload.Resize(PAYLOAD_SIZE);
+
+    PacketBuffer result{};
+    for (std::size_t i = 0; i < NUMBER_OF_PACKETS; ++i)
+    {
+      auto const &sender  = *senders[i % NUMBER_OF_SENDERS];
+      auto const  channel = static_cast<uint16_t>((i / NUMBER_OF_SENDERS) % NUMBER_OF_CHANNELS);
+      auto const  counter = static_cast<uint16_t>(i / (NUMBER_OF_SENDERS * NUMBER_OF_CHANNELS));
+
+      Packet packet{sender.identity().identifier(), NetworkId{NETWORK_NAME}.value()};
+      packet.SetService(SERVICE);
+      packet.SetChannel(channel);
+      packet.SetMessageNum(counter);
+      packet.SetTTL(BROADCAST_TTL);
+      packet.SetBroadcast(true);
+      packet.SetPayload(payload);
+      packet.Sign(sender);
+
+      ByteArray buffer{};
+      buffer.Resize(packet.GetPacketSize());
+      Packet::ToBuffer(packet, buffer.pointer(), buffer.size());
+
+      result.emplace_back(std::move(buffer));
+    }
+
+    return result;
+  }();
+
+  return buffers;
+}
+
+void Router_FloodSignedBroadcasts(benchmark::State &state)
+{
+  SetGlobalLogLevel(LogLevel::ERROR);
+
+  auto const &buffers = GetSignedBroadcasts();
+
+  NetworkId const network{NETWORK_NAME};
+  ECDSASigner     certificate{};
+  certificate.GenerateKeys();
+
+  RouterConfiguration config{};
+  config.dispatch_threads = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    MuddleRegister muddle_register{network};
+    Router router(network, certificate.identity().identifier(), muddle_register, certificate, true,
+                  config);
+
+    std::atomic<std::size_t> delivered{0};
+
+    std::vector<Router::SubscriptionPtr> subscriptions{};
+    for (uint16_t channel = 0; channel < NUMBER_OF_CHANNELS; ++channel)
+    {
+      subscriptions.emplace_back(router.Subscribe(SERVICE, channel));
+      subscriptions.back()->SetMessageHandler(
+          [&delivered](Packet const & /*packet*/, Packet::Address const & /*last hop*/) {
+            ++delivered;
+          });
+    }
+
+    Packets packets{};
+    for (auto const &buffer : buffers)
+    {
+      packets.emplace_back(std::make_shared<Packet>());
+      Packet::FromBuffer(*packets.back(), buffer.pointer(), buffer.size());
+    }
+
+    router.Start();
+    state.ResumeTiming();
+
+    for (auto const &packet : packets)
+    {
+      router.Route(1, packet);
+    }
+
+    while (delivered < NUMBER_OF_PACKETS)
+    {
+      std::this_thread::yield();
+    }
+
+    state.PauseTiming();
+    router.Stop();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * NUMBER_OF_PACKETS));
+}
+
+}  // namespace
+
+BENCHMARK(Router_FloodSignedBroadcasts)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -20,6 +20,7 @@
 #include "moment/clock_interfaces.hpp"
 #include "muddle/address.hpp"
 #include "muddle/peer_selection_mode.hpp"
+#include "muddle/router_configuration.hpp"
 #include "muddle/tracker_configuration.hpp"
 #include "network/uri.hpp"
 
@@ -302,6 +303,15 @@ public:
    * @param config The configuration for the peer tracker
    */
   virtual void SetTrackerConfiguration(TrackerConfiguration const &config) = 0;
+
+  /**
+   * Sets the manner in which broadcasts on a service and channel are spread to the peers
+   *
+   * @param service The service identifier
+   * @param channel The channel identifier
+   * @param mode The broadcast mode
+   */
+  virtual void SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode) = 0;
   /// @}
 };
 
@@ -22,7 +22,7 @@
 #include "core/mutex.hpp"
 #include "core/serializers/main_serializer.hpp"
 #include "crypto/prover.hpp"
-#include "crypto/verifier.hpp"
+#include "crypto/verification_engine.hpp"
 
 #include <array>
 #include <cstdint>
@@ -159,6 +159,7 @@ public:
 
   void Sign(crypto::Prover const &prover);
   bool Verify() const;
+  bool Verify(crypto::VerificationEngine &engine) const;
 
 private:
   RoutingHeader header_{};  ///< The header containing primarily routing information
@@ -402,14 +403,20 @@ inline void Packet::Sign(crypto::Prover const &prover)
 }
 
 inline bool Packet::Verify() const
+{
+  return Verify(crypto::VerificationEngine::Default());
+}
+
+inline bool Packet::Verify(crypto::VerificationEngine &engine) const
 {
   if (!IsStamped())
   {
     return false;  // null signature is not genuine in non-trusted networks
   }
-  auto retVal = crypto::Verify(
-      GetSender(), (serializers::MsgPackSerializer() << StaticHeader() << payload_).data(), stamp_);
-  return retVal;
+
+  return engine.Verify(crypto::Identity{GetSender()},
+                       (serializers::MsgPackSerializer() << StaticHeader() << payload_).data(),
+                       stamp_);
 }
 
 inline std::size_t Packet::GetPacketSize() const
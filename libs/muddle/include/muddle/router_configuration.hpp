@@ -20,9 +20,21 @@
 #include "moment/clock_interfaces.hpp"
 #include "network/service/promise.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace fetch {
 namespace muddle {
 
+/**
+ * The manner in which broadcasts are spread to the directly connected peers
+ */
+enum class BroadcastMode : uint8_t
+{
+  FLOOD = 0,  ///< The full packet is sent to every peer
+  ANNOUNCE,   ///< Only a digest is sent to every peer, which requests the full packet if needed
+};
+
 struct RouterConfiguration
 {
   using ClockInterface = moment::ClockInterface;
@@ -30,10 +42,15 @@ struct RouterConfiguration
   using Timepoint      = ClockInterface::Timestamp;
   using Duration       = ClockInterface::Duration;
 
-  uint64_t max_delivery_attempts{3};
-  Duration temporary_connection_length{
+  uint64_t    max_delivery_attempts{3};
+  Duration    temporary_connection_length{
       std::chrono::seconds(4)};  ///< Time should be slightly longer than the retry period
-  uint32_t retry_delay_ms{2000};
+  uint32_t    retry_delay_ms{2000};
+  std::size_t dispatch_threads{0};  ///< Number of dispatch lanes, zero for the hardware concurrency
+
+  // announce mode broadcasts
+  uint32_t gossip_request_timeout_ms{1000};  ///< Wait for a requested packet before asking another
+  uint32_t gossip_retention_ms{60000};       ///< Time an announced packet is kept to serve requests
 };
 
 }  // namespace muddle
@@ -0,0 +1,94 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/map_interface.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace fetch {
+namespace muddle {
+
+/**
+ * Direct message exchanged between peers for broadcasts in the announce mode. Peers announce the
+ * digests of the broadcasts that they have and request the full packets for the digests they have
+ * not seen yet.
+ */
+struct GossipMessage
+{
+  using Digest  = uint64_t;
+  using Digests = std::vector<Digest>;
+
+  enum class Type
+  {
+    ANNOUNCE = 0,
+    REQUEST,
+
+    MAX_NUM_TYPES
+  };
+
+  Type    type{Type::ANNOUNCE};
+  Digests digests{};
+};
+
+}  // namespace muddle
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<muddle::GossipMessage, D>
+{
+public:
+  using Type       = muddle::GossipMessage;
+  using DriverType = D;
+  using EnumType   = uint64_t;
+
+  static const uint8_t TYPE    = 1;
+  static const uint8_t DIGESTS = 2;
+
+  template <typename T>
+  static void Serialize(T &map_constructor, Type const &msg)
+  {
+    auto map = map_constructor(2);
+    map.Append(TYPE, static_cast<EnumType>(msg.type));
+    map.Append(DIGESTS, msg.digests);
+  }
+
+  template <typename T>
+  static void Deserialize(T &map, Type &msg)
+  {
+    static constexpr auto MAX_TYPE_VALUE = static_cast<EnumType>(Type::Type::MAX_NUM_TYPES);
+
+    EnumType raw_type{0};
+    map.ExpectKeyGetValue(TYPE, raw_type);
+    map.ExpectKeyGetValue(DIGESTS, msg.digests);
+
+    // validate the type enum
+    if (raw_type >= MAX_TYPE_VALUE)
+    {
+      throw std::runtime_error("Invalid type value");
+    }
+
+    msg.type = static_cast<Type::Type>(raw_type);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -191,6 +191,7 @@ public:
   void SetConfidence(Addresses const &addresses, Confidence confidence) override;
   void SetConfidence(ConfidenceMap const &map) override;
   void SetTrackerConfiguration(TrackerConfiguration const &config) override;
+  void SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode) override;
   /// @}
 
   /// @name Internal Accessors
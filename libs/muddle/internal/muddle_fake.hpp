@@ -407,6 +407,12 @@ public:
   {
     throw std::runtime_error("SetTrackerConfiguration functionality not implemented");
   }
+
+  void SetBroadcastMode(uint16_t /*service*/, uint16_t /*channel*/,
+                        BroadcastMode /*mode*/) override
+  {
+    // the fake network always delivers broadcasts directly
+  }
   /// @}
 
 private:
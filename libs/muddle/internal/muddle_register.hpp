@@ -24,6 +24,7 @@
 #include "telemetry/telemetry.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -88,7 +89,7 @@ public:
   MuddleRegister &operator=(MuddleRegister &&) = delete;
 
   void              OnConnectionLeft(ConnectionLeftCallback cb);
-  void              Broadcast(ConstByteArray const &data) const;
+  std::size_t       Broadcast(ConstByteArray const &data) const;
   WeakConnectionPtr LookupConnection(ConnectionHandle handle) const;
   WeakConnectionPtr LookupConnection(Address const &address) const;
   Connections       LookupConnections(Address const &address) const;
@@ -23,6 +23,7 @@
 #include "core/mutex.hpp"
 #include "crypto/prover.hpp"
 #include "crypto/secure_channel.hpp"
+#include "crypto/verification_engine.hpp"
 #include "muddle/muddle_endpoint.hpp"
 #include "muddle/network_id.hpp"
 #include "muddle/packet.hpp"
@@ -39,12 +40,14 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace muddle {
 
 class MuddleRegister;
 class PeerTracker;
+struct GossipMessage;
 
 /**
  * The router if the fundamental object of the muddle system an routes external and internal packets
@@ -59,6 +62,7 @@ public:
   using ConnectionPtr        = std::weak_ptr<network::AbstractConnection>;
   using Handle               = network::AbstractConnection::ConnectionHandleType;
   using ThreadPool           = network::ThreadPool;
+  using ThreadPools          = std::vector<ThreadPool>;
   using HandleDirectAddrMap  = std::unordered_map<Handle, Address>;
   using Prover               = crypto::Prover;
   using DirectMessageHandler = std::function<void(Handle, PacketPtr)>;
@@ -82,7 +86,7 @@ public:
 
   // Construction / Destruction
   Router(NetworkId network_id, Address address, MuddleRegister &reg, Prover const &prover,
-         bool enable_message_signing);
+         bool enable_message_signing, RouterConfiguration const &config = RouterConfiguration{});
   Router(Router const &) = delete;
   Router(Router &&)      = delete;
   ~Router() override     = default;
@@ -132,6 +136,12 @@ public:
 
   Handle LookupHandle(Packet::RawAddress const &raw_address) const;
 
+  /// @name Broadcast Modes
+  /// @{
+  void          SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode);
+  BroadcastMode GetBroadcastMode(uint16_t service, uint16_t channel) const;
+  /// @}
+
   void SetDirectHandler(DirectMessageHandler handler)
   {
     direct_message_handler_ = std::move(handler);
@@ -145,6 +155,7 @@ public:
   EchoCache        echo_cache() const;
   NetworkId const &network() const;
   Address const &  network_address() const;
+  std::size_t      num_dispatch_threads() const;
 
   // Operators
   Router &operator=(Router const &) = delete;
@@ -161,16 +172,16 @@ private:
     UPDATED
   };
 
-  static constexpr std::size_t NUMBER_OF_ROUTER_THREADS = 1;
-
   void SendToConnection(Handle handle, PacketPtr const &packet, bool external = true,
                         bool reschedule_on_fail = false);
+  void ProcessPacket(Handle handle, PacketPtr const &packet);
   void RoutePacket(PacketPtr const &packet, bool external = true);
   void DispatchDirect(Handle handle, PacketPtr const &packet);
 
   void DispatchPacket(PacketPtr const &packet, Address const &transmitter);
 
   bool IsEcho(Packet const &packet, bool register_echo = true);
+  bool IsEcho(std::size_t index) const;
   void CleanEchoCache();
 
   PacketPtr const &Sign(PacketPtr const &p) const;
@@ -195,12 +206,58 @@ private:
   std::atomic<bool>     stopping_{false};
   RouterConfiguration   config_{};
 
+  crypto::VerificationEngine &verification_engine_{crypto::VerificationEngine::Default()};
+
   PeerTrackerPtr tracker_{nullptr};
 
   mutable Mutex echo_cache_lock_;
   EchoCache     echo_cache_;
 
-  ThreadPool dispatch_thread_pool_;
+  /// Dispatch lanes
+  /// @{
+  ThreadPools dispatch_lanes_;  ///< Single threaded pools, each executing its work in order
+
+  ThreadPool const &IngressLane(Packet const &packet) const;
+  ThreadPool const &DeliveryLane(Packet const &packet) const;
+  /// @}
+
+  /// Announce mode broadcasts
+  /// @{
+  using Digest  = uint64_t;
+  using Digests = std::vector<Digest>;
+
+  struct AnnouncedPacket
+  {
+    PacketPtr packet{};
+    Timepoint timestamp{};
+  };
+
+  struct PendingRequest
+  {
+    Handles     announcers{};  ///< The peers that have announced the packet, in order of arrival
+    std::size_t next{0};       ///< The index of the next peer to request the packet from
+  };
+
+  using BroadcastModes   = std::unordered_map<uint32_t, BroadcastMode>;
+  using AnnouncedPackets = std::unordered_map<Digest, AnnouncedPacket>;
+  using PendingRequests  = std::unordered_map<Digest, PendingRequest>;
+
+  mutable Mutex    broadcast_modes_lock_;
+  BroadcastModes   broadcast_modes_;
+  mutable Mutex    gossip_lock_;
+  AnnouncedPackets announced_packets_;
+  PendingRequests  pending_requests_;
+
+  bool      IsAnnounced(Packet const &packet) const;
+  void      AnnouncePacket(PacketPtr const &packet);
+  void      OnGossipMessage(Handle handle, PacketPtr const &packet);
+  void      OnGossipAnnounce(Handle handle, Digests const &digests);
+  void      OnGossipRequest(Handle handle, Digests const &digests);
+  void      RequestAnnouncedPacket(Digest digest);
+  void      CompleteAnnouncedRequest(Digest digest);
+  void      CleanAnnouncedPackets();
+  PacketPtr FormatGossipPacket(GossipMessage const &msg) const;
+  /// @}
 
   /// Redelivery of packages
   /// @{
@@ -257,6 +314,13 @@ private:
   telemetry::CounterPtr         speculative_routing_total_;
   telemetry::CounterPtr         failed_routing_total_;
   telemetry::CounterPtr         connection_dropped_total_;
+  telemetry::CounterPtr         gossip_announce_total_;
+  telemetry::CounterPtr         gossip_request_total_;
+  telemetry::CounterPtr         gossip_served_total_;
+  telemetry::CounterPtr         gossip_request_failures_total_;
+  telemetry::CounterPtr         gossip_flood_bytes_total_;
+  telemetry::CounterPtr         gossip_tx_bytes_total_;
+  telemetry::GaugePtr<int64_t>  gossip_bytes_saved_;
   /// @}
 
   friend class DirectMessageService;
@@ -495,6 +495,11 @@ void Muddle::SetTrackerConfiguration(TrackerConfiguration const &config)
   peer_tracker_->SetConfiguration(config);
 }
 
+void Muddle::SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode)
+{
+  router_.SetBroadcastMode(service, channel, mode);
+}
+
 /**
  * Update a map of address to confidence level
  *
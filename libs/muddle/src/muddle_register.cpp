@@ -55,8 +55,9 @@ void MuddleRegister::OnConnectionLeft(ConnectionLeftCallback cb)
  * Broadcast data to all active connections
  *
  * @param data The data to be broadcast
+ * @return The number of connections the data was sent to
  */
-void MuddleRegister::Broadcast(ConstByteArray const &data) const
+std::size_t MuddleRegister::Broadcast(ConstByteArray const &data) const
 {
   using ConnectionPtr  = std::shared_ptr<network::AbstractConnection>;
   using ConnectionPtrs = std::vector<ConnectionPtr>;
@@ -88,6 +89,8 @@ void MuddleRegister::Broadcast(ConstByteArray const &data) const
   {
     conn->Send(data);
   }
+
+  return held_connections.size();
 }
 
 /**
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "gossip_message.hpp"
 #include "kademlia/peer_tracker.hpp"
 #include "muddle_logging_name.hpp"
 #include "muddle_register.hpp"
@@ -47,6 +48,8 @@
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 
 static constexpr uint8_t DEFAULT_TTL = 40;
@@ -61,6 +64,8 @@ namespace {
 
 constexpr char const *BASE_NAME = "Router";
 
+constexpr std::size_t MAX_DEFAULT_DISPATCH_THREADS = 8;
+
 /**
  * Generate an id for echo cancellation id
  *
@@ -90,6 +95,86 @@ std::size_t GenerateEchoId(Packet const &packet)
   return out;
 }
 
+/**
+ * Generate the id used to select the dispatch lane for a packet
+ *
+ * @param packet The input packet to generate the lane id
+ * @param include_sender Signal if the sender should be part of the id
+ * @return
+ */
+std::size_t GenerateLaneId(Packet const &packet, bool include_sender)
+{
+  crypto::FNV hash;
+  hash.Reset();
+
+  auto const service = packet.GetService();
+  auto const channel = packet.GetChannel();
+
+  if (include_sender)
+  {
+    hash.Update(packet.GetSenderRaw().data(), packet.GetSenderRaw().size());
+  }
+  hash.Update(reinterpret_cast<uint8_t const *>(&service), sizeof(service));
+  hash.Update(reinterpret_cast<uint8_t const *>(&channel), sizeof(channel));
+
+  std::size_t out = 0;
+
+  static_assert(sizeof(out) == decltype(hash)::SIZE_IN_BYTES,
+                "Output type has incorrect size to contain hash");
+  hash.Final(reinterpret_cast<uint8_t *>(&out));
+
+  return out;
+}
+
+/**
+ * Generate the key under which the broadcast mode of a service and channel is stored
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @return The broadcast mode key
+ */
+uint32_t GenerateBroadcastModeKey(uint16_t service, uint16_t channel)
+{
+  return (static_cast<uint32_t>(service) << 16u) | static_cast<uint32_t>(channel);
+}
+
+/**
+ * Determine if the packet is a gossip message for the announce mode broadcasts
+ *
+ * @param packet The packet to check
+ * @return true if the packet is a gossip message, otherwise false
+ */
+bool IsGossipMessage(Packet const &packet)
+{
+  return packet.IsDirect() && (packet.GetService() == SERVICE_MUDDLE) &&
+         (packet.GetChannel() == CHANNEL_GOSSIP);
+}
+
+/**
+ * Create the single threaded dispatch lanes of the router
+ *
+ * @param config The router configuration
+ * @return The (not yet started) dispatch lanes
+ */
+Router::ThreadPools CreateDispatchLanes(RouterConfiguration const &config)
+{
+  std::size_t num_lanes = config.dispatch_threads;
+  if (num_lanes == 0)
+  {
+    num_lanes = std::min(std::max<std::size_t>(std::thread::hardware_concurrency(), 1u),
+                         MAX_DEFAULT_DISPATCH_THREADS);
+  }
+
+  Router::ThreadPools lanes{};
+  lanes.reserve(num_lanes);
+  for (std::size_t i = 0; i < num_lanes; ++i)
+  {
+    lanes.emplace_back(network::MakeThreadPool(1, "Router" + std::to_string(i)));
+  }
+
+  return lanes;
+}
+
 /**
  * Internal; Function used to compare two fixed size addresses
  *
@@ -236,9 +321,10 @@ Packet::Address Router::ConvertAddress(Packet::RawAddress const &address)
  *
  * @param address The address of the current node
  * @param reg The connection register
+ * @param config The router configuration
  */
 Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prover const &prover,
-               bool enable_message_signing)
+               bool enable_message_signing, RouterConfiguration const &config)
   : name_{GenerateLoggingName(BASE_NAME, network_id)}
   , signing_enabled_{enable_message_signing}
   , address_(std::move(address))
@@ -247,7 +333,8 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
   , registrar_(network_id)
   , network_id_(network_id)
   , prover_(prover)
-  , dispatch_thread_pool_(network::MakeThreadPool(NUMBER_OF_ROUTER_THREADS, "Router"))
+  , config_(config)
+  , dispatch_lanes_(CreateDispatchLanes(config_))
   , rx_max_packet_length(
         CreateGauge("ledger_router_rx_max_packet_length", "The max received packet length"))
   , tx_max_packet_length(
@@ -316,19 +403,41 @@ Router::Router(NetworkId network_id, Address address, MuddleRegister &reg, Prove
                       "The total number of packets that have failed to be routed"))
   , connection_dropped_total_(CreateCounter("ledger_router_connection_dropped_total",
                                             "The total number of connections dropped"))
+  , gossip_announce_total_(CreateCounter("ledger_router_gossip_announce_total",
+                                         "The total number of broadcasts sent as announcements"))
+  , gossip_request_total_(CreateCounter("ledger_router_gossip_request_total",
+                                        "The total number of announced packets requested"))
+  , gossip_served_total_(CreateCounter("ledger_router_gossip_served_total",
+                                       "The total number of announced packets sent to peers"))
+  , gossip_request_failures_total_(
+        CreateCounter("ledger_router_gossip_request_failures_total",
+                      "The total number of announced packets that could not be retrieved"))
+  , gossip_flood_bytes_total_(
+        CreateCounter("ledger_router_gossip_flood_bytes_total",
+                      "The total number of bytes announced broadcasts would use when flooded"))
+  , gossip_tx_bytes_total_(
+        CreateCounter("ledger_router_gossip_tx_bytes_total",
+                      "The total number of bytes sent for announced broadcasts"))
+  , gossip_bytes_saved_(telemetry::Registry::Instance().CreateGauge<int64_t>(
+        "ledger_router_gossip_bytes_saved",
+        "The number of bytes saved by announced broadcasts compared to flooding",
+        CreateLabels(*this)))
 {}
 
 /**
- * Starts the routers internal dispatch thread pool
+ * Starts the routers internal dispatch lanes
  */
 void Router::Start()
 {
-  dispatch_thread_pool_->Start();
+  for (auto const &lane : dispatch_lanes_)
+  {
+    lane->Start();
+  }
   stopping_ = false;
 }
 
 /**
- * Stops the routers internal dispatch thread pool
+ * Stops the routers internal dispatch lanes
  */
 void Router::Stop()
 {
@@ -339,7 +448,46 @@ void Router::Stop()
     delivery_attempts_.clear();
   }
 
-  dispatch_thread_pool_->Stop();
+  for (auto const &lane : dispatch_lanes_)
+  {
+    lane->Stop();
+  }
+
+  {
+    FETCH_LOCK(gossip_lock_);
+    announced_packets_.clear();
+    pending_requests_.clear();
+  }
+}
+
+/**
+ * Determine the lane on which an incoming packet is verified and routed. Packets from the same
+ * sender on the same service and channel always share a lane and so retain their order. Direct
+ * messages are all handled on the first lane, in the order of arrival.
+ *
+ * @param packet The incoming packet
+ * @return The dispatch lane
+ */
+Router::ThreadPool const &Router::IngressLane(Packet const &packet) const
+{
+  if (packet.IsDirect())
+  {
+    return dispatch_lanes_.front();
+  }
+
+  return dispatch_lanes_[GenerateLaneId(packet, true) % dispatch_lanes_.size()];
+}
+
+/**
+ * Determine the lane on which a packet is dispatched to the subscriptions. Subscriptions for a
+ * given service and channel are always served from the same lane.
+ *
+ * @param packet The packet to be dispatched
+ * @return The dispatch lane
+ */
+Router::ThreadPool const &Router::DeliveryLane(Packet const &packet) const
+{
+  return dispatch_lanes_[GenerateLaneId(packet, false) % dispatch_lanes_.size()];
 }
 
 bool Router::Genuine(PacketPtr const &p) const
@@ -348,7 +496,7 @@ bool Router::Genuine(PacketPtr const &p) const
 
   if (p->IsStamped() || p->IsBroadcast())
   {
-    genuine = p->Verify();
+    genuine = p->Verify(verification_engine_);
   }
 
   return genuine;
@@ -390,6 +538,26 @@ void Router::Route(Handle handle, PacketPtr const &packet)
     return;
   }
 
+  // verification and routing is performed on the dispatch lanes in order to keep the network
+  // threads free
+  IngressLane(*packet)->Post([this, handle, packet]() {
+    if (stopping_)
+    {
+      return;
+    }
+
+    ProcessPacket(handle, packet);
+  });
+}
+
+/**
+ * Verifies and then handles an incoming packet. Executed on the ingress lane for the packet.
+ *
+ * @param handle The handle of the receiving connection for the packet
+ * @param packet The input packet to route
+ */
+void Router::ProcessPacket(Handle handle, PacketPtr const &packet)
+{
   if (!Genuine(packet))
   {
     FETCH_LOG_WARN(logging_name_, "Packet's authenticity not verified:", DescribePacket(*packet));
@@ -397,7 +565,12 @@ void Router::Route(Handle handle, PacketPtr const &packet)
     return;
   }
 
-  if (packet->IsDirect())
+  if (IsGossipMessage(*packet))
+  {
+    // announcements and requests for broadcasts from a single hop peer
+    OnGossipMessage(handle, packet);
+  }
+  else if (packet->IsDirect())
   {
     // when it is a direct message we must handle this
     DispatchDirect(handle, packet);
@@ -524,6 +697,7 @@ void Router::Broadcast(uint16_t service, uint16_t channel, Payload const &payloa
 void Router::Cleanup()
 {
   CleanEchoCache();
+  CleanAnnouncedPackets();
 }
 
 /**
@@ -567,6 +741,47 @@ Router::AddressSet Router::GetDirectlyConnectedPeerSet() const
   return tracker_->directly_connected_peers();
 }
 
+/**
+ * Set the manner in which broadcasts for a given service and channel are spread to the peers. In
+ * the announce mode only the digest of a broadcast is sent to the peers, each of which requests
+ * the full packet from one of the peers that announced it. This saves bandwidth for large
+ * broadcasts at the expense of an extra round trip per hop. All the peers must support the gossip
+ * messages for broadcasts in the announce mode to be spread across the network.
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @param mode The broadcast mode
+ */
+void Router::SetBroadcastMode(uint16_t service, uint16_t channel, BroadcastMode mode)
+{
+  FETCH_LOCK(broadcast_modes_lock_);
+
+  auto const key = GenerateBroadcastModeKey(service, channel);
+  if (mode == BroadcastMode::FLOOD)
+  {
+    broadcast_modes_.erase(key);
+  }
+  else
+  {
+    broadcast_modes_[key] = mode;
+  }
+}
+
+/**
+ * Get the manner in which broadcasts for a given service and channel are spread to the peers
+ *
+ * @param service The service identifier
+ * @param channel The channel identifier
+ * @return The broadcast mode
+ */
+BroadcastMode Router::GetBroadcastMode(uint16_t service, uint16_t channel) const
+{
+  FETCH_LOCK(broadcast_modes_lock_);
+
+  auto const it = broadcast_modes_.find(GenerateBroadcastModeKey(service, channel));
+  return (it != broadcast_modes_.end()) ? it->second : BroadcastMode::FLOOD;
+}
+
 /**
  * Internal: Looks up the specified connection handle from a given address
  *
@@ -681,10 +896,16 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
     packet->SetTTL(static_cast<uint8_t>(packet->GetTTL() - 1u));
 
     // if this packet is a broadcast echo we should no longer route this packet
-    if (packet->IsBroadcast() && IsEcho(*packet))
+    if (packet->IsBroadcast())
     {
-      ClearDeliveryAttempt(packet);
-      return;
+      if (IsEcho(*packet))
+      {
+        ClearDeliveryAttempt(packet);
+        return;
+      }
+
+      // the packet might have been requested after an announcement
+      CompleteAnnouncedRequest(GenerateEchoId(*packet));
     }
   }
 
@@ -699,6 +920,14 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
       DispatchPacket(packet, address_);
     }
 
+    if (IsAnnounced(*packet))
+    {
+      // only the digest of the packet is sent to the peers
+      AnnouncePacket(packet);
+      ClearDeliveryAttempt(packet);
+      return;
+    }
+
     // serialize the packet to the buffer
     ByteArray buffer{};
     buffer.Resize(packet->GetPacketSize());
@@ -817,7 +1046,7 @@ void Router::SchedulePacketForRedelivery(PacketPtr const &packet, bool external)
 
   if (!stopping_)
   {
-    dispatch_thread_pool_->Post(
+    IngressLane(*packet)->Post(
         [this, packet, external]() {
           if (stopping_)
           {
@@ -831,7 +1060,8 @@ void Router::SchedulePacketForRedelivery(PacketPtr const &packet, bool external)
 }
 
 /**
- * Dispatch / Handle the direct packet from a single hop peer
+ * Dispatch / Handle the direct packet from a single hop peer. Executed on the first dispatch lane
+ * which handles all direct messages.
  *
  * @param handle The handle to the originating connection
  * @param packet The packet that was received
@@ -842,36 +1072,26 @@ void Router::DispatchDirect(Handle handle, PacketPtr const &packet)
   FETCH_LOG_TRACE(logging_name_, "==> Direct message sent to router");
   dispatch_enqueued_total_->increment();
 
-  if (!stopping_)
+  // Updating the association between handle and address
+  if (register_.UpdateAddress(handle, packet->GetSender()) ==
+      MuddleRegister::UpdateStatus::NEW_ADDRESS)
   {
-    dispatch_thread_pool_->Post([this, packet, handle]() {
-      if (stopping_)
-      {
-        return;
-      }
-
-      // Updating the association between handle and address
-      if (register_.UpdateAddress(handle, packet->GetSender()) ==
-          MuddleRegister::UpdateStatus::NEW_ADDRESS)
-      {
-        dispatch_thread_pool_->Post([this, packet, handle]() {
-          tracker_->DownloadPeerDetails(handle, packet->GetSender());
-        });
-      }
-
-      // dispatch to the direct message handler if needed
-      if (direct_message_handler_)
-      {
-        direct_message_handler_(handle, packet);
-      }
-      else
-      {
-        dispatch_failure_total_->increment();
-      }
-
-      dispatch_complete_total_->increment();
+    dispatch_lanes_.front()->Post([this, packet, handle]() {
+      tracker_->DownloadPeerDetails(handle, packet->GetSender());
     });
   }
+
+  // dispatch to the direct message handler if needed
+  if (direct_message_handler_)
+  {
+    direct_message_handler_(handle, packet);
+  }
+  else
+  {
+    dispatch_failure_total_->increment();
+  }
+
+  dispatch_complete_total_->increment();
 }
 
 /**
@@ -883,7 +1103,7 @@ void Router::DispatchPacket(PacketPtr const &packet, Address const &transmitter)
 {
   dispatch_enqueued_total_->increment();
 
-  dispatch_thread_pool_->Post([this, packet, transmitter]() {
+  DeliveryLane(*packet)->Post([this, packet, transmitter]() {
     // decrypt encrypted messages
     if (packet->IsEncrypted())
     {
@@ -956,6 +1176,18 @@ bool Router::IsEcho(Packet const &packet, bool register_echo)
   return is_echo;
 }
 
+/**
+ * Check to see if a packet with the specified echo id has already been seen
+ *
+ * @param index The echo id of the packet
+ * @return true if the packet has been seen, otherwise false
+ */
+bool Router::IsEcho(std::size_t index) const
+{
+  FETCH_LOCK(echo_cache_lock_);
+  return echo_cache_.find(index) != echo_cache_.end();
+}
+
 /**
  * Periodic function used to trim the echo cache
  */
@@ -988,6 +1220,278 @@ void Router::CleanEchoCache()
   }
 }
 
+/**
+ * Internal: Determine if the packet should be spread as an announcement
+ *
+ * @param packet The broadcast packet
+ * @return true if the packet should be announced, otherwise false
+ */
+bool Router::IsAnnounced(Packet const &packet) const
+{
+  return GetBroadcastMode(packet.GetService(), packet.GetChannel()) == BroadcastMode::ANNOUNCE;
+}
+
+/**
+ * Internal: Send the digest of a broadcast packet to all the peers. The packet is retained so that
+ * it can be sent to the peers which request it.
+ *
+ * @param packet The broadcast packet to be announced
+ */
+void Router::AnnouncePacket(PacketPtr const &packet)
+{
+  auto const digest = static_cast<Digest>(GenerateEchoId(*packet));
+
+  {
+    FETCH_LOCK(gossip_lock_);
+    announced_packets_[digest] = AnnouncedPacket{packet, Clock::now()};
+  }
+
+  GossipMessage msg{};
+  msg.type = GossipMessage::Type::ANNOUNCE;
+  msg.digests.push_back(digest);
+
+  auto const announcement = FormatGossipPacket(msg);
+
+  // serialize the announcement to the buffer
+  ByteArray buffer{};
+  buffer.Resize(announcement->GetPacketSize());
+  if (!Packet::ToBuffer(*announcement, buffer.pointer(), buffer.size()))
+  {
+    FETCH_LOG_WARN(logging_name_, "Failed to serialise gossip announcement to stream");
+    return;
+  }
+
+  FETCH_LOG_TRACE(logging_name_, "AX:           ", DescribePacket(*packet));
+
+  auto const num_peers = static_cast<uint64_t>(register_.Broadcast(buffer));
+
+  // compare the bandwidth used against flooding the full packet to the same peers
+  uint64_t const flood_bytes    = packet->GetPacketSize() * num_peers;
+  uint64_t const announce_bytes = buffer.size() * num_peers;
+
+  gossip_announce_total_->increment();
+  gossip_flood_bytes_total_->add(flood_bytes);
+  gossip_tx_bytes_total_->add(announce_bytes);
+  gossip_bytes_saved_->increment(static_cast<int64_t>(flood_bytes) -
+                                 static_cast<int64_t>(announce_bytes));
+}
+
+/**
+ * Internal: Handle a gossip message from a single hop peer
+ *
+ * @param handle The handle of the originating connection
+ * @param packet The packet containing the gossip message
+ */
+void Router::OnGossipMessage(Handle handle, PacketPtr const &packet)
+{
+  GossipMessage msg{};
+  if (!ExtractPayload(packet->GetPayload(), msg))
+  {
+    FETCH_LOG_WARN(logging_name_, "Unable to extract gossip message payload (conn: ", handle, ")");
+    return;
+  }
+
+  switch (msg.type)
+  {
+  case GossipMessage::Type::ANNOUNCE:
+    OnGossipAnnounce(handle, msg.digests);
+    break;
+  case GossipMessage::Type::REQUEST:
+    OnGossipRequest(handle, msg.digests);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Internal: Handle the announcement of broadcast packets by a peer. Packets which have not been
+ * seen before are requested from the first peer that announced them.
+ *
+ * @param handle The handle of the announcing connection
+ * @param digests The digests of the announced packets
+ */
+void Router::OnGossipAnnounce(Handle handle, Digests const &digests)
+{
+  for (auto const digest : digests)
+  {
+    if (IsEcho(static_cast<std::size_t>(digest)))
+    {
+      continue;
+    }
+
+    {
+      FETCH_LOCK(gossip_lock_);
+
+      // packets that we have announced ourselves are not requested
+      if (announced_packets_.find(digest) != announced_packets_.end())
+      {
+        continue;
+      }
+
+      // remember the peer, the packet is only requested from one peer at a time
+      auto &pending = pending_requests_[digest];
+      pending.announcers.push_back(handle);
+      if (pending.announcers.size() > 1)
+      {
+        continue;
+      }
+    }
+
+    RequestAnnouncedPacket(digest);
+  }
+}
+
+/**
+ * Internal: Handle the request for announced packets from a peer
+ *
+ * @param handle The handle of the requesting connection
+ * @param digests The digests of the requested packets
+ */
+void Router::OnGossipRequest(Handle handle, Digests const &digests)
+{
+  for (auto const digest : digests)
+  {
+    PacketPtr packet{};
+
+    {
+      FETCH_LOCK(gossip_lock_);
+
+      auto const it = announced_packets_.find(digest);
+      if (it != announced_packets_.end())
+      {
+        packet = it->second.packet;
+      }
+    }
+
+    if (!packet)
+    {
+      FETCH_LOG_DEBUG(logging_name_, "Unable to serve announced packet (conn: ", handle, ")");
+      continue;
+    }
+
+    SendToConnection(handle, packet, false, false);
+
+    uint64_t const packet_size = packet->GetPacketSize();
+    gossip_served_total_->increment();
+    gossip_tx_bytes_total_->add(packet_size);
+    gossip_bytes_saved_->decrement(static_cast<int64_t>(packet_size));
+  }
+}
+
+/**
+ * Internal: Request an announced packet from the next peer that announced it. When the packet has
+ * not been received after the request timeout it is requested from the following peer.
+ *
+ * @param digest The digest of the announced packet
+ */
+void Router::RequestAnnouncedPacket(Digest digest)
+{
+  Handle handle{0};
+
+  {
+    FETCH_LOCK(gossip_lock_);
+
+    auto it = pending_requests_.find(digest);
+    if (it == pending_requests_.end())
+    {
+      // the packet has been received in the meantime
+      return;
+    }
+
+    auto &pending = it->second;
+    if (pending.next >= pending.announcers.size())
+    {
+      FETCH_LOG_WARN(logging_name_, "Unable to retrieve announced packet from any peer");
+
+      pending_requests_.erase(it);
+      gossip_request_failures_total_->increment();
+      return;
+    }
+
+    handle = pending.announcers[pending.next++];
+  }
+
+  GossipMessage msg{};
+  msg.type = GossipMessage::Type::REQUEST;
+  msg.digests.push_back(digest);
+
+  auto const request = FormatGossipPacket(msg);
+  SendToConnection(handle, request);
+
+  uint64_t const request_size = request->GetPacketSize();
+  gossip_request_total_->increment();
+  gossip_tx_bytes_total_->add(request_size);
+  gossip_bytes_saved_->decrement(static_cast<int64_t>(request_size));
+
+  if (!stopping_)
+  {
+    dispatch_lanes_.front()->Post(
+        [this, digest]() {
+          if (stopping_)
+          {
+            return;
+          }
+
+          RequestAnnouncedPacket(digest);
+        },
+        config_.gossip_request_timeout_ms);
+  }
+}
+
+/**
+ * Internal: Signal that a (possibly requested) announced packet has been received
+ *
+ * @param digest The digest of the received packet
+ */
+void Router::CompleteAnnouncedRequest(Digest digest)
+{
+  FETCH_LOCK(gossip_lock_);
+  pending_requests_.erase(digest);
+}
+
+/**
+ * Periodic function used to remove the announced packets which have been retained for longer
+ * than the configured period
+ */
+void Router::CleanAnnouncedPackets()
+{
+  FETCH_LOCK(gossip_lock_);
+
+  auto const now = Clock::now();
+
+  auto it = announced_packets_.begin();
+  while (it != announced_packets_.end())
+  {
+    if ((now - it->second.timestamp) > std::chrono::milliseconds{config_.gossip_retention_ms})
+    {
+      it = announced_packets_.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+/**
+ * Internal: Generate the direct packet for a gossip message
+ *
+ * @param msg The gossip message
+ * @return The direct packet
+ */
+Router::PacketPtr Router::FormatGossipPacket(GossipMessage const &msg) const
+{
+  auto packet = std::make_shared<Packet>(address_, network_id_.value());
+  packet->SetService(SERVICE_MUDDLE);
+  packet->SetChannel(CHANNEL_GOSSIP);
+  packet->SetDirect(true);
+  packet->SetPayload(EncodePayload(msg));
+
+  // gossip messages are not signed, only the announced packets themselves are authenticated
+  return packet;
+}
+
 void Router::Blacklist(Address const &target)
 {
   blacklist_.Add(target);
@@ -1019,6 +1523,11 @@ Address const &Router::network_address() const
   return address_;
 }
 
+std::size_t Router::num_dispatch_threads() const
+{
+  return dispatch_lanes_.size();
+}
+
 telemetry::GaugePtr<uint64_t> Router::CreateGauge(char const *name, char const *description) const
 {
   return telemetry::Registry::Instance().CreateGauge<uint64_t>(name, description,
@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle_register.hpp"
+#include "router.hpp"
+
+#include "core/mutex.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "muddle/router_configuration.hpp"
+#include "muddle/subscription.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace fetch::muddle;
+
+using fetch::crypto::ECDSASigner;
+
+using PacketPtr = std::shared_ptr<Packet>;
+using StreamId  = std::pair<Packet::Address, uint16_t>;
+using Streams   = std::map<StreamId, std::vector<uint16_t>>;
+
+constexpr uint16_t    SERVICE            = 7;
+constexpr std::size_t NUMBER_OF_SENDERS  = 3;
+constexpr uint16_t    NUMBER_OF_CHANNELS = 2;
+constexpr uint16_t    NUMBER_OF_MESSAGES = 50;
+constexpr std::size_t NUMBER_OF_LANES    = 4;
+
+class RouterDispatchTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    RouterConfiguration config{};
+    config.dispatch_threads = NUMBER_OF_LANES;
+
+    certificate_.GenerateKeys();
+    router_ = std::make_unique<Router>(network_, certificate_.identity().identifier(), register_,
+                                       certificate_, true, config);
+
+    for (uint16_t channel = 0; channel < NUMBER_OF_CHANNELS; ++channel)
+    {
+      subscriptions_.emplace_back(router_->Subscribe(SERVICE, channel));
+      subscriptions_.back()->SetMessageHandler(
+          [this](Packet const &packet, Packet::Address const & /*last hop*/) {
+            FETCH_LOCK(lock_);
+            streams_[{packet.GetSender(), packet.GetChannel()}].push_back(packet.GetMessageNum());
+            ++delivered_;
+          });
+    }
+
+    router_->Start();
+  }
+
+  void TearDown() override
+  {
+    router_->Stop();
+    subscriptions_.clear();
+    router_.reset();
+  }
+
+  PacketPtr CreateBroadcast(ECDSASigner const &sender, uint16_t channel, uint16_t counter) const
+  {
+    auto packet = std::make_shared<Packet>(sender.identity().identifier(), network_.value());
+    packet->SetService(SERVICE);
+    packet->SetChannel(channel);
+    packet->SetMessageNum(counter);
+    packet->SetTTL(40);
+    packet->SetBroadcast(true);
+    packet->SetPayload("payload");
+    packet->Sign(sender);
+
+    return packet;
+  }
+
+  bool WaitForDeliveries(std::size_t count)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+      {
+        FETCH_LOCK(lock_);
+        if (delivered_ >= count)
+        {
+          return true;
+        }
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return false;
+  }
+
+  NetworkId const                      network_{"TEST"};
+  MuddleRegister                       register_{network_};
+  ECDSASigner                          certificate_{};
+  std::unique_ptr<Router>              router_;
+  std::vector<Router::SubscriptionPtr> subscriptions_;
+
+  fetch::Mutex lock_;
+  Streams      streams_;
+  std::size_t  delivered_{0};
+};
+
+TEST_F(RouterDispatchTests, CheckConfiguredNumberOfLanes)
+{
+  EXPECT_EQ(router_->num_dispatch_threads(), NUMBER_OF_LANES);
+
+  Router defaulted{network_, certificate_.identity().identifier(), register_, certificate_, true};
+  EXPECT_GE(defaulted.num_dispatch_threads(), 1u);
+}
+
+TEST_F(RouterDispatchTests, CheckPacketsFromTheSameSenderAndChannelAreDeliveredInOrder)
+{
+  std::vector<std::unique_ptr<ECDSASigner>> senders{};
+  for (std::size_t i = 0; i < NUMBER_OF_SENDERS; ++i)
+  {
+    senders.emplace_back(std::make_unique<ECDSASigner>());
+    senders.back()->GenerateKeys();
+  }
+
+  // interleave the streams from all the senders and channels
+  std::vector<PacketPtr> packets{};
+  for (uint16_t counter = 0; counter < NUMBER_OF_MESSAGES; ++counter)
+  {
+    for (uint16_t channel = 0; channel < NUMBER_OF_CHANNELS; ++channel)
+    {
+      for (auto const &sender : senders)
+      {
+        packets.emplace_back(CreateBroadcast(*sender, channel, counter));
+      }
+    }
+  }
+
+  for (auto const &packet : packets)
+  {
+    router_->Route(1, packet);
+  }
+
+  ASSERT_TRUE(WaitForDeliveries(packets.size()));
+
+  FETCH_LOCK(lock_);
+  ASSERT_EQ(streams_.size(), NUMBER_OF_SENDERS * NUMBER_OF_CHANNELS);
+  for (auto const &stream : streams_)
+  {
+    ASSERT_EQ(stream.second.size(), NUMBER_OF_MESSAGES);
+    for (uint16_t counter = 0; counter < NUMBER_OF_MESSAGES; ++counter)
+    {
+      EXPECT_EQ(stream.second[counter], counter);
+    }
+  }
+}
+
+TEST_F(RouterDispatchTests, CheckForgedPacketsAreNotDelivered)
+{
+  ECDSASigner sender{};
+  sender.GenerateKeys();
+
+  auto forged = CreateBroadcast(sender, 0, 0);
+  forged->SetPayload("forged payload");
+
+  router_->Route(1, forged);
+  router_->Route(1, CreateBroadcast(sender, 0, 1));
+
+  ASSERT_TRUE(WaitForDeliveries(1));
+
+  FETCH_LOCK(lock_);
+  ASSERT_EQ(streams_.size(), 1u);
+  EXPECT_EQ(streams_.begin()->second, std::vector<uint16_t>{1});
+}
+
+}  // namespace
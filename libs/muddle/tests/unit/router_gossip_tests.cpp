@@ -0,0 +1,277 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "muddle_register.hpp"
+#include "router.hpp"
+
+#include "core/byte_array/byte_array.hpp"
+#include "crypto/ecdsa.hpp"
+#include "muddle/network_id.hpp"
+#include "muddle/packet.hpp"
+#include "muddle/router_configuration.hpp"
+#include "muddle/subscription.hpp"
+#include "network/management/abstract_connection.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace fetch::muddle;
+
+using fetch::byte_array::ByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::network::AbstractConnection;
+using fetch::network::AbstractConnectionRegister;
+using fetch::network::MessageBuffer;
+
+constexpr uint16_t    SERVICE          = 7;
+constexpr uint16_t    CHANNEL          = 3;
+constexpr std::size_t PAYLOAD_SIZE     = 16 * 1024;
+constexpr std::size_t NUMBER_OF_NODES  = 4;
+constexpr std::size_t NUMBER_OF_ROUNDS = 5;
+
+/**
+ * Connection which delivers the sent packets directly to the router of the peer
+ */
+class LoopbackConnection : public AbstractConnection
+{
+public:
+  LoopbackConnection(Router &peer, std::atomic<std::size_t> &bytes_sent)
+    : peer_{peer}
+    , bytes_sent_{bytes_sent}
+  {}
+
+  void Connect(Router::Handle peer_handle)
+  {
+    peer_handle_ = peer_handle;
+  }
+
+  void Send(MessageBuffer const &buffer, Callback const &success,
+            Callback const & /*fail*/) override
+  {
+    bytes_sent_ += buffer.size();
+
+    auto packet = std::make_shared<Packet>();
+    if (Packet::FromBuffer(*packet, buffer.pointer(), buffer.size()))
+    {
+      peer_.Route(peer_handle_, packet);
+    }
+
+    if (success)
+    {
+      success();
+    }
+  }
+
+  uint16_t Type() const override
+  {
+    return 0xFFFF;
+  }
+
+  void Close() override
+  {}
+
+  bool Closed() const override
+  {
+    return false;
+  }
+
+  bool is_alive() const override
+  {
+    return true;
+  }
+
+private:
+  Router &                  peer_;
+  std::atomic<std::size_t> &bytes_sent_;
+  Router::Handle            peer_handle_{0};
+};
+
+struct Node
+{
+  explicit Node(NetworkId const &network)
+    : muddle_register{std::make_shared<MuddleRegister>(network)}
+  {
+    certificate.GenerateKeys();
+
+    RouterConfiguration config{};
+    config.dispatch_threads = 2;
+
+    router = std::make_unique<Router>(network, certificate.identity().identifier(),
+                                      *muddle_register, certificate, true, config);
+
+    subscription = router->Subscribe(SERVICE, CHANNEL);
+    subscription->SetMessageHandler(
+        [this](Packet const & /*packet*/, Packet::Address const & /*last hop*/) { ++delivered; });
+  }
+
+  ECDSASigner                     certificate{};
+  std::shared_ptr<MuddleRegister> muddle_register;
+  std::unique_ptr<Router>         router;
+  Router::SubscriptionPtr         subscription;
+  std::atomic<std::size_t>        delivered{0};
+};
+
+class RouterGossipTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < NUMBER_OF_NODES; ++i)
+    {
+      nodes_.emplace_back(std::make_unique<Node>(network_));
+    }
+
+    // fully connect all the nodes
+    for (std::size_t i = 0; i < NUMBER_OF_NODES; ++i)
+    {
+      for (std::size_t j = i + 1; j < NUMBER_OF_NODES; ++j)
+      {
+        Connect(*nodes_[i], *nodes_[j]);
+      }
+    }
+
+    for (auto &node : nodes_)
+    {
+      node->router->Start();
+    }
+  }
+
+  void TearDown() override
+  {
+    for (auto &node : nodes_)
+    {
+      node->router->Stop();
+    }
+
+    connections_.clear();
+    nodes_.clear();
+  }
+
+  void Connect(Node &a, Node &b)
+  {
+    auto a_to_b = std::make_shared<LoopbackConnection>(*b.router, bytes_sent_);
+    auto b_to_a = std::make_shared<LoopbackConnection>(*a.router, bytes_sent_);
+
+    // each side of the connection routes the packets it receives under its own handle
+    a_to_b->Connect(b_to_a->handle());
+    b_to_a->Connect(a_to_b->handle());
+
+    static_cast<AbstractConnectionRegister &>(*a.muddle_register).Enter(a_to_b);
+    static_cast<AbstractConnectionRegister &>(*b.muddle_register).Enter(b_to_a);
+
+    connections_.emplace_back(std::move(a_to_b));
+    connections_.emplace_back(std::move(b_to_a));
+  }
+
+  void SetBroadcastMode(BroadcastMode mode)
+  {
+    for (auto &node : nodes_)
+    {
+      node->router->SetBroadcastMode(SERVICE, CHANNEL, mode);
+    }
+  }
+
+  bool WaitForDeliveries(std::size_t count)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+      bool complete{true};
+      for (std::size_t i = 1; i < NUMBER_OF_NODES; ++i)
+      {
+        complete = complete && (nodes_[i]->delivered >= count);
+      }
+
+      if (complete)
+      {
+        return true;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    return false;
+  }
+
+  std::size_t BroadcastAndMeasure()
+  {
+    ByteArray payload{};
+    payload.Resize(PAYLOAD_SIZE);
+
+    bytes_sent_ = 0;
+    for (std::size_t round = 1; round <= NUMBER_OF_ROUNDS; ++round)
+    {
+      nodes_.front()->router->Broadcast(SERVICE, CHANNEL, payload);
+      EXPECT_TRUE(WaitForDeliveries(round));
+    }
+
+    // allow any trailing echoes to drain
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    for (std::size_t i = 1; i < NUMBER_OF_NODES; ++i)
+    {
+      EXPECT_EQ(nodes_[i]->delivered, NUMBER_OF_ROUNDS);
+      nodes_[i]->delivered = 0;
+    }
+
+    return bytes_sent_;
+  }
+
+  NetworkId const                                  network_{"TEST"};
+  std::vector<std::unique_ptr<Node>>               nodes_;
+  std::vector<std::shared_ptr<LoopbackConnection>> connections_;
+  std::atomic<std::size_t>                         bytes_sent_{0};
+};
+
+TEST_F(RouterGossipTests, CheckBroadcastModeDefaultsToFlood)
+{
+  auto &router = *nodes_.front()->router;
+
+  EXPECT_EQ(router.GetBroadcastMode(SERVICE, CHANNEL), BroadcastMode::FLOOD);
+
+  router.SetBroadcastMode(SERVICE, CHANNEL, BroadcastMode::ANNOUNCE);
+  EXPECT_EQ(router.GetBroadcastMode(SERVICE, CHANNEL), BroadcastMode::ANNOUNCE);
+  EXPECT_EQ(router.GetBroadcastMode(SERVICE, CHANNEL + 1), BroadcastMode::FLOOD);
+  EXPECT_EQ(router.GetBroadcastMode(SERVICE + 1, CHANNEL), BroadcastMode::FLOOD);
+
+  router.SetBroadcastMode(SERVICE, CHANNEL, BroadcastMode::FLOOD);
+  EXPECT_EQ(router.GetBroadcastMode(SERVICE, CHANNEL), BroadcastMode::FLOOD);
+}
+
+TEST_F(RouterGossipTests, CheckAnnouncedBroadcastsReachAllNodesWithLessTraffic)
+{
+  std::size_t const flood_bytes = BroadcastAndMeasure();
+
+  SetBroadcastMode(BroadcastMode::ANNOUNCE);
+  std::size_t const announce_bytes = BroadcastAndMeasure();
+
+  // every node receives the full payload only once instead of once per connected peer
+  EXPECT_LT(announce_bytes, flood_bytes / 2);
+  EXPECT_GE(announce_bytes, (NUMBER_OF_NODES - 1) * NUMBER_OF_ROUNDS * PAYLOAD_SIZE);
+}
+
+}  // namespace
@@ -327,6 +327,13 @@ public:
     return true;
   }
 
+  void SetSnapshotInterval(uint64_t interval, uint64_t max_snapshots)
+  {
+    FETCH_LOCK(mutex_);
+    key_index_.underlying_stack().SetSnapshotInterval(interval, max_snapshots);
+    file_object_.underlying_stack().SetSnapshotInterval(interval, max_snapshots);
+  }
+
   bool HashExists(ByteArrayType const &hash)
   {
     FETCH_LOCK(mutex_);
@@ -31,6 +31,8 @@
 #include "telemetry/utils/timer.hpp"
 
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -42,7 +44,10 @@ public:
   using LaneType             = uint32_t;  // TODO(issue 12): Fetch from some other palce
   using CallContext          = service::CallContext;
 
-  using Identifier = byte_array::ConstByteArray;
+  using Identifier    = byte_array::ConstByteArray;
+  using ResourceIDs   = std::vector<ResourceID>;
+  using Documents     = std::vector<Document>;
+  using KeyValuePairs = std::vector<std::pair<ResourceID, byte_array::ConstByteArray>>;
 
   static constexpr char const *LOGGING_NAME = "RevertibleDocumentStoreProtocol";
 
@@ -58,6 +63,9 @@ public:
     HASH_EXISTS,
     RESET,
 
+    GET_MANY,
+    SET_MANY,
+
     LOCK = 20,
     UNLOCK,
     HAS_LOCK
@@ -80,6 +88,10 @@ public:
     , unlock_count_(CreateCounter(lane, "ledger_statedb_unlock_total", "The total no. unlock ops"))
     , has_lock_count_(
           CreateCounter(lane, "ledger_statedb_has_lock_total", "The total no. has lock ops"))
+    , get_many_count_(
+          CreateCounter(lane, "ledger_statedb_get_many_total", "The total no. batched get ops"))
+    , set_many_count_(
+          CreateCounter(lane, "ledger_statedb_set_many_total", "The total no. batched set ops"))
     , get_durations_(CreateHistogram(lane, "ledger_statedb_get_request_seconds",
                                      "The histogram of get request durations"))
     , set_durations_(CreateHistogram(lane, "ledger_statedb_set_request_seconds",
@@ -88,10 +100,16 @@ public:
                                       "The histogram of lock request durations"))
     , unlock_durations_(CreateHistogram(lane, "ledger_statedb_unlock_request_seconds",
                                         "The histogram of unlock request durations"))
+    , get_many_durations_(CreateHistogram(lane, "ledger_statedb_get_many_request_seconds",
+                                          "The histogram of batched get request durations"))
+    , set_many_durations_(CreateHistogram(lane, "ledger_statedb_set_many_request_seconds",
+                                          "The histogram of batched set request durations"))
   {
     this->Expose(GET, this, &RevertibleDocumentStoreProtocol::Get);
     this->Expose(GET_OR_CREATE, this, &RevertibleDocumentStoreProtocol::GetOrCreate);
     this->Expose(SET, this, &RevertibleDocumentStoreProtocol::Set);
+    this->Expose(GET_MANY, this, &RevertibleDocumentStoreProtocol::GetMany);
+    this->Expose(SET_MANY, this, &RevertibleDocumentStoreProtocol::SetMany);
 
     // Functionality for hashing/state
     this->Expose(COMMIT, this, &RevertibleDocumentStoreProtocol::Commit);
@@ -247,6 +265,36 @@ private:
     set_count_->increment();
   }
 
+  Documents GetMany(ResourceIDs const &rids)
+  {
+    telemetry::FunctionTimer const timer{*get_many_durations_};
+
+    Documents docs{};
+    docs.reserve(rids.size());
+
+    for (auto const &rid : rids)
+    {
+      docs.emplace_back(doc_store_->Get(rid));
+    }
+
+    get_count_->add(rids.size());
+    get_many_count_->increment();
+    return docs;
+  }
+
+  void SetMany(KeyValuePairs const &values)
+  {
+    telemetry::FunctionTimer const timer{*set_many_durations_};
+
+    for (auto const &value : values)
+    {
+      doc_store_->Set(value.first, value.second);
+    }
+
+    set_count_->add(values.size());
+    set_many_count_->increment();
+  }
+
   NewRevertibleDocumentStore::Hash Commit()
   {
     auto const hash = doc_store_->Commit();
@@ -309,10 +357,14 @@ private:
   telemetry::CounterPtr   lock_count_;
   telemetry::CounterPtr   unlock_count_;
   telemetry::CounterPtr   has_lock_count_;
+  telemetry::CounterPtr   get_many_count_;
+  telemetry::CounterPtr   set_many_count_;
   telemetry::HistogramPtr get_durations_;
   telemetry::HistogramPtr set_durations_;
   telemetry::HistogramPtr lock_durations_;
   telemetry::HistogramPtr unlock_durations_;
+  telemetry::HistogramPtr get_many_durations_;
+  telemetry::HistogramPtr set_many_durations_;
 };
 
 }  // namespace storage
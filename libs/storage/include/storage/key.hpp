@@ -176,9 +176,32 @@ struct Key
     return BITS;
   }
 
+  /**
+   * Generate a hash value for the key suitable for use in hash based containers. Since the key is
+   * expected to be the output of a cryptographic hash function the first block is used directly
+   *
+   * @return: the hash value
+   */
+  std::size_t hash() const
+  {
+    return static_cast<std::size_t>(key_[0]);
+  }
+
 private:
   KeyArray key_{};
 };
 
+/**
+ * Hasher adapter to allow keys to be used in unordered containers
+ */
+struct KeyHashAdapter
+{
+  template <std::size_t V_BITS, typename BlockTypeParam>
+  std::size_t operator()(Key<V_BITS, BlockTypeParam> const &key) const
+  {
+    return key.hash();
+  }
+};
+
 }  // namespace storage
 }  // namespace fetch
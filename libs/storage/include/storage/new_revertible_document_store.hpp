@@ -36,6 +36,9 @@ public:
   using UnderlyingType = storage::Document;
   using Keys           = std::vector<ResourceID>;
 
+  // Construction / Destruction
+  NewRevertibleDocumentStore();
+
   bool New(std::string const &state, std::string const &state_history, std::string const &index,
            std::string const &index_history, bool create_if_not_exist);
   bool Load(std::string const &state, std::string const &state_history, std::string const &index,
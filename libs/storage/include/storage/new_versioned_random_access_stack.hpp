@@ -44,7 +44,14 @@
 
 #include "core/byte_array/encoders.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -71,6 +78,18 @@ struct NewBookmarkHeader
  * The history is a variant stack so as to allow different operations to be saved. However note that
  * the stack itself has elements of constant width, so no dynamically allocated memory.
  *
+ * An in memory index of the bookmarks (rebuilt from the hash history when loading) allows for
+ * constant time existence checks. Optionally, snapshots can be taken at a regular commit interval.
+ * Deep reverts will then jump to the nearest snapshot, truncating the history in one step, rather
+ * than undoing every recorded operation.
+ *
+ * Snapshots are incremental: the previous value of every element changed between two snapshots is
+ * recorded in memory on its first change, and written out when the next snapshot is taken. The
+ * cost of a snapshot is therefore proportional to the number of distinct elements changed in the
+ * interval, not to the size of the stack. Since the changes are only tracked in memory, the first
+ * snapshot after loading the stack (or after a revert past the latest snapshot) starts a new chain
+ * and discards the older snapshots.
+ *
  */
 template <typename T, typename S = RandomAccessStack<T, NewBookmarkHeader>>
 class NewVersionedRandomAccessStack
@@ -255,6 +274,51 @@ private:
     uint64_t data = 0;
   };
 
+  /**
+   * Describes a snapshot of the main stack, taken immediately after a commit. Unless it starts a
+   * chain, the snapshot records the changes needed to take the main stack back to the previous
+   * snapshot.
+   */
+  struct SnapshotRecord
+  {
+    uint64_t             position{0};        ///< The position of the bookmark in the hash history
+    VariantStack::Header history_header{};   ///< The extent of the history following the commit
+    uint64_t             num_changes{0};     ///< The number of changes since the previous snapshot
+    uint64_t             previous_size{0};   ///< The size of the stack at the previous snapshot
+    HeaderType           previous_header{};  ///< The header of the stack at the previous snapshot
+  };
+
+  /**
+   * The value of an element of the main stack at the time of the previous snapshot
+   */
+  struct SnapshotChange
+  {
+    SnapshotChange()
+    {
+      // Clear the whole structure (including padded regions) are zeroed
+      memset(this, 0, sizeof(decltype(*this)));
+    }
+
+    SnapshotChange(uint64_t i_, T const &d)
+    {
+      // Clear the whole structure (including padded regions) are zeroed
+      memset(this, 0, sizeof(decltype(*this)));
+
+      i    = i_;
+      data = d;
+    }
+
+    uint64_t i = 0;
+    T        data;
+  };
+
+  using HashIndex     = std::unordered_map<DefaultKey, std::vector<uint64_t>, KeyHashAdapter>;
+  using SnapshotList  = std::vector<SnapshotRecord>;
+  using SnapshotStack = RandomAccessStack<SnapshotChange>;
+  using ChangeMap     = std::unordered_map<uint64_t, T>;
+
+  static constexpr uint64_t DEFAULT_MAX_SNAPSHOTS = 4;
+
 public:
   using type             = T;
   using EventHandlerType = std::function<void()>;
@@ -315,19 +379,32 @@ public:
   void Load(std::string const &filename, std::string const &history,
             bool const &create_if_not_exist = true)
   {
+    history_filename_ = history;
+
     stack_.Load(filename, create_if_not_exist);
     history_.Load(history, create_if_not_exist);
 
     hash_history_.Load("hash_history_" + history, create_if_not_exist);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    RebuildHashIndex();
+    LoadSnapshots(create_if_not_exist);
   }
 
   void New(std::string const &filename, std::string const &history)
   {
+    history_filename_ = history;
+
     stack_.New(filename);
     history_.New(history);
     hash_history_.New("hash_history_" + history);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    // remove any snapshots that are left over from a previous instance
+    LoadSnapshots(true);
+    RemoveSnapshots(0);
+
+    hash_index_.clear();
   }
 
   void Clear()
@@ -337,6 +414,22 @@ public:
     hash_history_.Clear();
 
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    RemoveSnapshots(0);
+    StopTracking();
+    hash_index_.clear();
+  }
+
+  /**
+   * Enable (incremental) snapshots of the main stack to be taken at a regular commit interval.
+   *
+   * @param: interval The number of commits between snapshots, zero disables snapshots
+   * @param: max_snapshots The maximum number of snapshots to retain on disk
+   */
+  void SetSnapshotInterval(uint64_t interval, uint64_t max_snapshots = DEFAULT_MAX_SNAPSHOTS)
+  {
+    snapshot_interval_ = interval;
+    max_snapshots_     = max_snapshots;
   }
 
   type Get(std::size_t i) const
@@ -357,6 +450,7 @@ public:
     stack_.Get(i, old_data);
     if (0 != memcmp(&object, &old_data, sizeof(type)))
     {
+      TrackChange(i, old_data);
       history_.Push(HistorySet{i, old_data}, HistorySet::value);
       stack_.Set(i, object);
     }
@@ -371,6 +465,7 @@ public:
   void Pop()
   {
     type old_data = stack_.Top();
+    TrackChange(stack_.size() - 1, old_data);
     history_.Push(HistoryPop{old_data}, HistoryPop::value);
     stack_.Pop();
   }
@@ -382,6 +477,8 @@ public:
 
   void Swap(std::size_t i, std::size_t j)
   {
+    TrackChange(i);
+    TrackChange(j);
     history_.Push(HistorySwap{i, j}, HistorySwap::value);
     stack_.Swap(i, j);
   }
@@ -412,6 +509,7 @@ public:
 
     history_.Push(history_bookmark, HistoryBookmark::value);
     hash_history_.Push(history_bookmark);
+    hash_index_[key].push_back(hash_history_.size() - 1);
 
     // Update our header with this information (the bookmark index)
     HeaderType h = stack_.header_extra();
@@ -423,6 +521,11 @@ public:
     // Optionally flush since this is a checkpoint
     Flush(false);
 
+    if ((snapshot_interval_ != 0) && ((hash_history_.size() % snapshot_interval_) == 0))
+    {
+      TakeSnapshot();
+    }
+
     return internal_bookmark_index_ - 1;
   }
 
@@ -434,21 +537,7 @@ public:
       return false;
     }
 
-    uint64_t        hash_history_size = hash_history_.size();
-    HistoryBookmark book;
-
-    for (std::size_t i = 0; i < hash_history_size; ++i)
-    {
-      uint64_t reverse_index = hash_history_size - i - 1;
-      hash_history_.Get(reverse_index, book);
-
-      if (book.key == key)
-      {
-        return true;
-      }
-    }
-
-    return false;
+    return hash_index_.find(key) != hash_index_.end();
   }
 
   /**
@@ -461,6 +550,13 @@ public:
    */
   void RevertToHash(DefaultKey const &key)
   {
+    // jump as close to the target bookmark as possible using the snapshots
+    auto const it = hash_index_.find(key);
+    if (it != hash_index_.end())
+    {
+      RestoreNearestSnapshot(it->second.back());
+    }
+
     bool bookmark_found = false;
 
     while (!bookmark_found)
@@ -498,6 +594,9 @@ public:
         throw StorageException("Undefined type found when reverting in versioned history");
       }
     }
+
+    // any snapshots taken after this bookmark are no longer valid
+    RemoveSnapshots(hash_history_.size());
   }
 
   void Flush(bool lazy = true)
@@ -527,6 +626,20 @@ private:
   VariantStack                       history_;
   RandomAccessStack<HistoryBookmark> hash_history_;
   uint64_t                           internal_bookmark_index_{0};
+  HashIndex                          hash_index_;
+  std::string                        history_filename_;
+
+  /// @name Snapshots
+  /// @{
+  RandomAccessStack<SnapshotRecord> snapshot_index_;
+  SnapshotList                      snapshots_;
+  uint64_t                          snapshot_interval_{0};
+  uint64_t                          max_snapshots_{DEFAULT_MAX_SNAPSHOTS};
+  bool                              tracking_{false};   ///< Tracking changes since the latest one
+  ChangeMap                         changes_;           ///< The previous values of changed elements
+  uint64_t                          tracked_size_{0};   ///< The stack size at the latest snapshot
+  HeaderType                        tracked_header_{};  ///< The stack header at the latest snapshot
+  /// @}
 
   EventHandlerType on_file_loaded_;
   EventHandlerType on_before_flush_;
@@ -558,16 +671,329 @@ private:
         FETCH_LOG_ERROR(LOGGING_NAME, "Hash history top does not match bookmark being removed!");
       }
 
-      hash_history_.Pop();
+      PopHashHistory();
     }
 
     return key_to_compare == book.key;
   }
 
+  /**
+   * Pop the top bookmark from the hash history, keeping the index up to date
+   */
+  void PopHashHistory()
+  {
+    HistoryBookmark book;
+    hash_history_.Get(hash_history_.size() - 1, book);
+
+    auto it = hash_index_.find(book.key);
+    if (it != hash_index_.end())
+    {
+      it->second.pop_back();
+
+      if (it->second.empty())
+      {
+        hash_index_.erase(it);
+      }
+    }
+
+    hash_history_.Pop();
+  }
+
+  /**
+   * Rebuild the in memory bookmark index from the (persistent) hash history
+   */
+  void RebuildHashIndex()
+  {
+    hash_index_.clear();
+
+    HistoryBookmark book;
+    for (uint64_t i = 0, end = hash_history_.size(); i < end; ++i)
+    {
+      hash_history_.Get(i, book);
+      hash_index_[book.key].push_back(i);
+    }
+  }
+
+  std::string SnapshotFilename(uint64_t position) const
+  {
+    return "snapshot_" + std::to_string(position) + "_" + history_filename_;
+  }
+
+  std::string SnapshotIndexFilename() const
+  {
+    return "snapshot_index_" + history_filename_;
+  }
+
+  /**
+   * Load the snapshot records, discarding any which refer to bookmarks no longer in the history
+   */
+  void LoadSnapshots(bool create_if_not_exist)
+  {
+    snapshot_index_.Load(SnapshotIndexFilename(), create_if_not_exist);
+
+    snapshots_.clear();
+
+    SnapshotRecord record;
+    for (uint64_t i = 0, end = snapshot_index_.size(); i < end; ++i)
+    {
+      snapshot_index_.Get(i, record);
+      snapshots_.push_back(record);
+    }
+
+    RemoveSnapshots(hash_history_.size());
+
+    // the changes made since the latest snapshot are not known
+    StopTracking();
+  }
+
+  void WriteSnapshots()
+  {
+    snapshot_index_.Clear();
+
+    for (auto const &record : snapshots_)
+    {
+      snapshot_index_.Push(record);
+    }
+
+    snapshot_index_.Flush(false);
+  }
+
+  /**
+   * Remove all the snapshots which were taken at or above the specified hash history position
+   *
+   * @param: position The hash history position
+   */
+  void RemoveSnapshots(uint64_t position)
+  {
+    bool updated{false};
+
+    // snapshots are always in ascending order of position
+    while (!snapshots_.empty() && (snapshots_.back().position >= position))
+    {
+      std::remove(SnapshotFilename(snapshots_.back().position).c_str());
+      snapshots_.pop_back();
+      updated = true;
+    }
+
+    if (updated)
+    {
+      // the changes being tracked are relative to a snapshot which no longer exists
+      StopTracking();
+      WriteSnapshots();
+    }
+  }
+
+  /**
+   * Start tracking the changes made to the main stack relative to its current contents
+   */
+  void StartTracking()
+  {
+    tracking_       = true;
+    tracked_size_   = stack_.size();
+    tracked_header_ = stack_.header_extra();
+    changes_.clear();
+  }
+
+  void StopTracking()
+  {
+    tracking_ = false;
+    changes_.clear();
+  }
+
+  /**
+   * Record the value of an element of the main stack before it is first changed following the
+   * latest snapshot
+   *
+   * @param: i The index of the element
+   * @param: old_data The current value of the element
+   */
+  void TrackChange(uint64_t i, type const &old_data)
+  {
+    if (tracking_ && (i < tracked_size_) && (changes_.find(i) == changes_.end()))
+    {
+      changes_.emplace(i, old_data);
+    }
+  }
+
+  void TrackChange(uint64_t i)
+  {
+    if (tracking_ && (i < tracked_size_) && (changes_.find(i) == changes_.end()))
+    {
+      type old_data;
+      stack_.Get(i, old_data);
+      changes_.emplace(i, old_data);
+    }
+  }
+
+  /**
+   * Write the changes made since the previous snapshot following the latest commit. When the
+   * changes are not known, the snapshot starts a new chain instead.
+   */
+  void TakeSnapshot()
+  {
+    SnapshotRecord record;
+    record.position       = hash_history_.size() - 1;
+    record.history_header = history_.header();
+
+    if (tracking_ && !snapshots_.empty())
+    {
+      record.num_changes     = changes_.size();
+      record.previous_size   = tracked_size_;
+      record.previous_header = tracked_header_;
+
+      SnapshotStack snapshot;
+      snapshot.New(SnapshotFilename(record.position));
+
+      for (auto const &change : changes_)
+      {
+        snapshot.Push(SnapshotChange{change.first, change.second});
+      }
+
+      snapshot.Flush(false);
+    }
+    else
+    {
+      // the older snapshots can not be reached from this one
+      RemoveSnapshots(0);
+    }
+
+    snapshots_.push_back(record);
+
+    // discard the oldest snapshots
+    while (snapshots_.size() > max_snapshots_)
+    {
+      std::remove(SnapshotFilename(snapshots_.front().position).c_str());
+      snapshots_.erase(snapshots_.begin());
+    }
+
+    WriteSnapshots();
+    StartTracking();
+  }
+
+  /**
+   * Restore the main stack to the earliest snapshot at or above the target bookmark position,
+   * truncating the history to match. This is only done when applying the changes recorded by the
+   * snapshots is cheaper than undoing the history which they skip.
+   *
+   * @param: position The hash history position of the target bookmark
+   */
+  void RestoreNearestSnapshot(uint64_t position)
+  {
+    if (!tracking_)
+    {
+      return;
+    }
+
+    auto it = std::find_if(snapshots_.begin(), snapshots_.end(),
+                           [position](SnapshotRecord const &r) { return r.position >= position; });
+
+    if (it == snapshots_.end())
+    {
+      return;
+    }
+
+    SnapshotRecord const record = *it;
+
+    // the changes of all the later snapshots need to be undone
+    uint64_t cost = changes_.size();
+    for (auto later = std::next(it); later != snapshots_.end(); ++later)
+    {
+      cost += later->num_changes;
+    }
+
+    uint64_t const skipped = history_.size() - record.history_header.object_count;
+    if (skipped <= cost)
+    {
+      return;
+    }
+
+    // load the changes up front so that a missing snapshot leaves the stack untouched
+    std::vector<std::vector<SnapshotChange>> snapshot_changes{};
+    for (auto later = snapshots_.rbegin(); later->position != record.position; ++later)
+    {
+      SnapshotStack snapshot;
+      try
+      {
+        snapshot.Load(SnapshotFilename(later->position), false);
+      }
+      catch (StorageException const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Unable to load snapshot: ", ex.what());
+        return;
+      }
+
+      snapshot_changes.emplace_back(snapshot.size());
+      for (uint64_t i = 0, end = snapshot.size(); i < end; ++i)
+      {
+        snapshot.Get(i, snapshot_changes.back()[i]);
+      }
+    }
+
+    FETCH_LOG_INFO(LOGGING_NAME, "Restoring snapshot at position: ", record.position,
+                   " skipping ", skipped, " history entries");
+
+    // undo the changes since the latest snapshot, followed by those between the snapshots
+    std::vector<SnapshotChange> changes{};
+    for (auto const &change : changes_)
+    {
+      changes.emplace_back(change.first, change.second);
+    }
+    RestoreChanges(changes, tracked_size_, tracked_header_);
+
+    auto later = snapshots_.rbegin();
+    for (auto const &later_changes : snapshot_changes)
+    {
+      RestoreChanges(later_changes, later->previous_size, later->previous_header);
+      ++later;
+    }
+
+    // truncate the history back to the point the snapshot was taken
+    history_.Truncate(record.history_header);
+
+    while (hash_history_.size() > (record.position + 1))
+    {
+      PopHashHistory();
+    }
+
+    RemoveSnapshots(record.position + 1);
+    StartTracking();
+  }
+
+  /**
+   * Take the main stack back to the previous contents recorded by a set of changes
+   *
+   * @param: changes The previous values of the changed elements
+   * @param: size The previous size of the stack
+   * @param: header The previous header of the stack
+   */
+  void RestoreChanges(std::vector<SnapshotChange> const &changes, uint64_t size,
+                      HeaderType const &header)
+  {
+    while (stack_.size() > size)
+    {
+      stack_.Pop();
+    }
+
+    // every element popped since has been recorded, so these placeholders are all overwritten
+    while (stack_.size() < size)
+    {
+      stack_.Push(type{});
+    }
+
+    for (auto const &change : changes)
+    {
+      stack_.Set(change.i, change.data);
+    }
+
+    stack_.SetExtraHeader(header);
+  }
+
   void RevertSwap()
   {
     HistorySwap swap;
     history_.Top(swap);
+    TrackChange(swap.i);
+    TrackChange(swap.j);
     stack_.Swap(swap.i, swap.j);
     history_.Pop();
   }
@@ -584,6 +1010,7 @@ private:
   {
     HistoryPush push;
     history_.Top(push);
+    TrackChange(stack_.size() - 1);
     stack_.Pop();
     history_.Pop();
   }
@@ -592,6 +1019,7 @@ private:
   {
     HistorySet set;
     history_.Top(set);
+    TrackChange(set.i);
     stack_.Set(set.i, set.data);
     history_.Pop();
   }
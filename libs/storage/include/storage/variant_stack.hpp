@@ -261,6 +261,32 @@ public:
     fin.close();
   }
 
+  /**
+   * Return the header of the stack. This completely describes the current extent of the stack and
+   * can be used to truncate the stack back to this point at a later time.
+   *
+   * @return: The current header
+   */
+  Header const &header() const
+  {
+    return header_;
+  }
+
+  /**
+   * Truncate the stack back to a previously recorded header. This is a constant time operation
+   * regardless of the number of objects being removed. Unsafe if the header was not recorded from
+   * this stack or if the stack has been popped below this point since it was recorded.
+   *
+   * @param: header The previously recorded header
+   */
+  void Truncate(Header const &header)
+  {
+    assert(header.object_count <= header_.object_count);
+    assert(header.end <= header_.end);
+
+    header_ = header;
+  }
+
   bool empty() const
   {
     return header_.object_count == 0;
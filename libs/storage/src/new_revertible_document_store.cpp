@@ -30,6 +30,11 @@ using UnderlyingType = fetch::storage::NewRevertibleDocumentStore::UnderlyingTyp
 
 static constexpr char const *LOGGING_NAME = "NewRevertibleDocStore";
 
+// Incremental snapshots of the changed elements allow deep reverts without undoing the complete
+// history, each one only costs as much as the number of elements changed since the previous one
+static constexpr uint64_t SNAPSHOT_INTERVAL = 1000;
+static constexpr uint64_t MAX_SNAPSHOTS     = 2;
+
 namespace fetch {
 namespace storage {
 
@@ -52,6 +57,11 @@ bool IsAllZeros(Hash const &hash)
 }
 }  // namespace
 
+NewRevertibleDocumentStore::NewRevertibleDocumentStore()
+{
+  storage_.SetSnapshotInterval(SNAPSHOT_INTERVAL, MAX_SNAPSHOTS);
+}
+
 bool NewRevertibleDocumentStore::Load(std::string const &state, std::string const &state_history,
                                       std::string const &index, std::string const &index_history,
                                       bool create = true)
@@ -205,4 +205,140 @@ TEST(versioned_random_access_stack_gtest, loading_file)
   }
 }
 
+TEST(versioned_random_access_stack_gtest, revert_using_snapshots)
+{
+  std::vector<ByteArray> hashes;
+
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  NewVersionedRandomAccessStack<StringProxy> stack;
+  stack.New("d_main.db", "d_history.db");
+  stack.SetSnapshotInterval(1, hashes.size());
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    stack.Push(StringProxy(std::to_string(i)));
+  }
+
+  // each round rewrites the stack many times, so that the history between bookmarks is much larger
+  // than the stack itself
+  for (std::size_t round = 0; round < hashes.size(); ++round)
+  {
+    for (std::size_t pass = 0; pass < 10; ++pass)
+    {
+      for (std::size_t i = 0; i < 4; ++i)
+      {
+        stack.Set(i, StringProxy(std::to_string((round * 100) + i)));
+      }
+    }
+
+    stack.Commit(DefaultKey(hashes[round]));
+  }
+
+  EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[7])));
+
+  stack.RevertToHash(DefaultKey(hashes[2]));
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(200 + i)));
+  }
+
+  // later bookmarks are discarded while earlier ones remain
+  EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[0])));
+  EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[2])));
+  EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[3])));
+  EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[7])));
+
+  // the history remains usable after the snapshot has been restored
+  stack.RevertToHash(DefaultKey(hashes[0]));
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(i)));
+  }
+
+  EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[1])));
+}
+
+TEST(versioned_random_access_stack_gtest, revert_using_incremental_snapshots)
+{
+  std::vector<ByteArray> hashes;
+
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  NewVersionedRandomAccessStack<StringProxy> stack;
+  stack.New("e_main.db", "e_history.db");
+  stack.SetSnapshotInterval(2, hashes.size());
+
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    stack.Push(StringProxy(std::to_string(i)));
+  }
+
+  auto const contents = [&stack]() {
+    std::vector<std::string> ret;
+    for (std::size_t i = 0; i < stack.size(); ++i)
+    {
+      ret.emplace_back(stack.Get(i).string_as_chars);
+    }
+    return ret;
+  };
+
+  // each round only changes a few elements (including popped, pushed and swapped ones), however
+  // rewrites them many times, so that the history between bookmarks is much larger than the changes
+  std::vector<std::vector<std::string>> expected;
+  for (std::size_t round = 0; round < hashes.size(); ++round)
+  {
+    for (std::size_t pass = 0; pass < 20; ++pass)
+    {
+      stack.Set(round, StringProxy(std::to_string((round * 100) + pass)));
+    }
+
+    stack.Swap(round, 15 - round);
+
+    if ((round % 2) == 0)
+    {
+      stack.Pop();
+      stack.Pop();
+      stack.Push(StringProxy(std::to_string(round * 1000)));
+    }
+    else
+    {
+      stack.Push(StringProxy(std::to_string(round * 1000)));
+    }
+
+    stack.SetExtraHeader(round);
+    stack.Commit(DefaultKey(hashes[round]));
+    expected.push_back(contents());
+  }
+
+  for (std::size_t round : {5u, 2u, 0u})
+  {
+    stack.RevertToHash(DefaultKey(hashes[round]));
+
+    EXPECT_EQ(contents(), expected[round]);
+    EXPECT_EQ(stack.header_extra(), round);
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[round])));
+    EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[round + 1])));
+  }
+
+  // the stack remains usable, and is snapshotted again, after the snapshots have been restored
+  for (std::size_t round = 1; round < 4; ++round)
+  {
+    stack.Set(round, StringProxy("again"));
+    stack.Commit(DefaultKey(hashes[round]));
+    expected[round] = contents();
+  }
+
+  stack.RevertToHash(DefaultKey(hashes[1]));
+  EXPECT_EQ(contents(), expected[1]);
+}
+
 }  // namespace
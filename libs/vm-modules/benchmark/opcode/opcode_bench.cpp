@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 
@@ -808,6 +809,158 @@ void CryptoBenchmarks(benchmark::State &state)
                     baseline_map[etch_codes[etch_ind].first], bm_ind);
 }
 
+/**
+ * Compares the dispatch modes of the interpreter loop, with and without superinstructions, on
+ * opcode heavy Etch code. All static opcode charges are set to one so that the charge total counts
+ * the dispatched opcodes, which allows the time per dispatched opcode to be reported.
+ *
+ * Arg 0: index of the Etch code (0: loop, 1: branches, 2: function calls, 3: while loop)
+ * Arg 1: dispatch mode (0: indirect, 1: threaded)
+ * Arg 2: superinstructions (0: disabled, 1: enabled)
+ */
+void DispatchBenchmarks(benchmark::State &state)
+{
+  const static std::string LOOP_BODY   = "x = x + i;\n",
+                           BRANCH_BODY = IfThenElse("i % 2 == 0", "x = x + 1;\n", "x = x - 1;\n");
+
+  const static BenchmarkPair LOOP("DispatchLoop",
+                                  FunMain("var x = 0;\n" + For(LOOP_BODY, "10000")));
+  const static BenchmarkPair BRANCH("DispatchBranch",
+                                    FunMain("var x = 0;\n" + For(BRANCH_BODY, "10000")));
+  const static BenchmarkPair CALL("DispatchCall",
+                                  FunMain(For("user();\n", "10000")) + FunUser(""));
+  const static BenchmarkPair WHILE("DispatchWhile", FunMain("var i = 0;\n"
+                                                            "var x = 0;\n"
+                                                            "while (i < 10000)\n"
+                                                            "x = x + i * 2;\n"
+                                                            "i += 1;\n"
+                                                            "endwhile\n"));
+
+  std::vector<BenchmarkPair> const etch_codes = {LOOP, BRANCH, CALL, WHILE};
+
+  auto const etch_ind = static_cast<std::size_t>(state.range(0));
+  auto const mode =
+      (state.range(1) == 0) ? VM::DispatchMode::Indirect : VM::DispatchMode::Threaded;
+
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+  if (state.range(2) != 0)
+  {
+    module->EnableSuperinstructions();
+  }
+
+  Compiler compiler(module.get());
+  IR       ir;
+
+  std::vector<std::string> errors;
+  fetch::vm::SourceFiles   files = {{"default.etch", etch_codes[etch_ind].second}};
+  if (!compiler.Compile(files, "default_ir", ir, errors))
+  {
+    std::cout << "Skipping benchmark (unable to compile): " << etch_codes[etch_ind].first
+              << std::endl;
+    return;
+  }
+
+  Executable executable;
+  auto       vm = std::make_unique<VM>(module.get());
+  if (!vm->GenerateExecutable(ir, "default_exe", executable, errors))
+  {
+    std::cout << "Skipping benchmark (unable to generate IR)" << std::endl;
+    return;
+  }
+
+  // charge one unit per opcode, so that the charge total is the number of dispatched opcodes
+  std::unordered_map<std::string, fetch::vm::ChargeAmount> unit_charges;
+  for (auto const &opcode : vm->GetOpcodeInfoArray())
+  {
+    unit_charges[opcode.unique_name] = 1;
+  }
+  vm->UpdateCharges(unit_charges);
+  vm->SetDispatchMode(mode);
+
+  std::string error{};
+  Variant     output{};
+
+  auto const initial_charge = vm->GetChargeTotal();
+  double     elapsed_ns{0};
+
+  for (auto _ : state)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    vm->Execute(executable, "main", error, output);
+    elapsed_ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+                      .count();
+  }
+
+  auto const num_opcodes = static_cast<double>(vm->GetChargeTotal() - initial_charge);
+
+  state.SetLabel(etch_codes[etch_ind].first);
+  state.counters["opcodes"]       = num_opcodes / static_cast<double>(state.iterations());
+  state.counters["ns_per_opcode"] = (num_opcodes > 0) ? (elapsed_ns / num_opcodes) : 0.0;
+}
+
+/**
+ * Times hot arithmetic loops over local variables of a single numeric type. Int64 and Fixed64 are
+ * held unboxed in the stack slots, whereas Fixed128 is a reference counted object and is included
+ * as the boxed reference point.
+ *
+ * Arg 0: numeric type (0: Int64, 1: Fixed64, 2: Fixed128)
+ * Arg 1: index of the loop (0: accumulate, 1: multiply accumulate, 2: compare and branch)
+ */
+void ArithmeticLoopBenchmarks(benchmark::State &state)
+{
+  const static std::vector<std::string> types{"Int64", "Fixed64", "Fixed128"};
+  const static std::vector<std::string> ones{"1i64", "1.0fp64", "1.0fp128"};
+  const static std::vector<std::string> twos{"2i64", "2.0fp64", "2.0fp128"};
+
+  auto const type_ind = static_cast<std::size_t>(state.range(0));
+  auto const loop_ind = static_cast<std::size_t>(state.range(1));
+
+  std::string const &type = types[type_ind];
+  std::string const  decl = "var x : " + type + " = " + ones[type_ind] + ";\n" + "var y : " +
+                           type + " = " + twos[type_ind] + ";\n" + "var z : " + type + " = " +
+                           ones[type_ind] + ";\n";
+
+  std::vector<BenchmarkPair> const etch_codes = {
+      {"ArithmeticAccumulate_" + type, FunMain(decl + For("z = z + x;\n", "10000"))},
+      {"ArithmeticMultiplyAccumulate_" + type,
+       FunMain(decl + For("z = z + x * y;\nz = z - x * y;\n", "10000"))},
+      {"ArithmeticCompareBranch_" + type,
+       FunMain(decl + For(IfThenElse("x < y", "z = z + x;\n", "z = z - x;\n"), "10000"))}};
+
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+  Compiler compiler(module.get());
+  IR       ir;
+
+  std::vector<std::string> errors;
+  fetch::vm::SourceFiles   files = {{"default.etch", etch_codes[loop_ind].second}};
+  if (!compiler.Compile(files, "default_ir", ir, errors))
+  {
+    std::cout << "Skipping benchmark (unable to compile): " << etch_codes[loop_ind].first
+              << std::endl;
+    return;
+  }
+
+  Executable executable;
+  auto       vm = std::make_unique<VM>(module.get());
+  if (!vm->GenerateExecutable(ir, "default_exe", executable, errors))
+  {
+    std::cout << "Skipping benchmark (unable to generate IR)" << std::endl;
+    return;
+  }
+
+  std::string error{};
+  Variant     output{};
+
+  for (auto _ : state)
+  {
+    vm->Execute(executable, "main", error, output);
+  }
+
+  state.SetLabel(etch_codes[loop_ind].first);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 10000);
+}
+
 bool RegisterBenchmarks()
 {
   BENCHMARK(BasicBenchmarks)->DenseRange(basic_begin, basic_end - 1, 1);
@@ -817,6 +970,27 @@ bool RegisterBenchmarks()
   BENCHMARK(ArrayBenchmarks)->DenseRange(array_begin, array_end - 1, 1);
   BENCHMARK(TensorBenchmarks)->DenseRange(tensor_begin, tensor_end - 1, 1);
   BENCHMARK(CryptoBenchmarks)->DenseRange(crypto_begin, crypto_end - 1, 1);
+  BENCHMARK(ArithmeticLoopBenchmarks)->Apply([](benchmark::internal::Benchmark *b) {
+    for (int64_t type = 0; type < 3; ++type)
+    {
+      for (int64_t loop = 0; loop < 3; ++loop)
+      {
+        b->Args({type, loop});
+      }
+    }
+  });
+  BENCHMARK(DispatchBenchmarks)->Apply([](benchmark::internal::Benchmark *b) {
+    for (int64_t code = 0; code < 4; ++code)
+    {
+      for (int64_t mode = 0; mode < 2; ++mode)
+      {
+        for (int64_t superinstructions = 0; superinstructions < 2; ++superinstructions)
+        {
+          b->Args({code, mode, superinstructions});
+        }
+      }
+    }
+  });
   return true;
 }
 
@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/cached_io_observer.hpp"
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <sstream>
+
+using namespace fetch::vm;
+
+namespace {
+
+using ::testing::_;
+
+using Status = IoObserverInterface::Status;
+
+class CachedIoObserverTests : public ::testing::Test
+{
+public:
+  std::ostringstream out;
+  VmTestToolkit      toolkit{&out};
+  CachedIoObserver   cache{toolkit.observer()};
+
+  int64_t StoredInt64(std::string const &key)
+  {
+    int64_t  value{0};
+    uint64_t size{sizeof(value)};
+    EXPECT_EQ(toolkit.observer().fake_.Read(key, &value, size), Status::OK);
+    return value;
+  }
+};
+
+TEST_F(CachedIoObserverTests, state_updates_in_a_loop_are_read_once_and_written_back_once)
+{
+  static char const *TEXT = R"(
+    function main()
+      var counters = ShardedState<Int64>("counters");
+      for (i in 0:100)
+        counters.set("a", counters.get("a", 0i64) + 1i64);
+      endfor
+      print(toString(counters.get("a")));
+    endfunction
+  )";
+
+  EXPECT_CALL(toolkit.observer(), Exists(_)).Times(0);
+  EXPECT_CALL(toolkit.observer(), Read("counters.a", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("counters.a", _, _)).Times(1);
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  toolkit.vm().SetIOObserver(cache);
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(out.str(), "100");
+  EXPECT_EQ(cache.num_misses(), 1);
+
+  ASSERT_EQ(cache.Flush(), Status::OK);
+  EXPECT_EQ(StoredInt64("counters.a"), 100);
+
+  // nothing is left to write back
+  ASSERT_EQ(cache.Flush(), Status::OK);
+}
+
+TEST_F(CachedIoObserverTests, reads_are_served_from_the_underlying_observer_until_overwritten)
+{
+  int64_t const stored{42};
+  toolkit.observer().fake_.Write("value", &stored, sizeof(stored));
+
+  EXPECT_CALL(toolkit.observer(), Read("value", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Read("missing", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write("value", _, _)).Times(0);
+
+  EXPECT_EQ(cache.Exists("value"), Status::OK);
+  EXPECT_EQ(cache.Exists("missing"), Status::ERROR);
+
+  int64_t  value{0};
+  uint64_t size{1};
+  EXPECT_EQ(cache.Read("value", &value, size), Status::BUFFER_TOO_SMALL);
+  EXPECT_EQ(size, sizeof(value));
+  EXPECT_EQ(cache.Read("value", &value, size), Status::OK);
+  EXPECT_EQ(value, stored);
+
+  int64_t const updated{7};
+  EXPECT_EQ(cache.Write("value", &updated, sizeof(updated)), Status::OK);
+  EXPECT_EQ(cache.Read("value", &value, size), Status::OK);
+  EXPECT_EQ(value, updated);
+
+  // the underlying observer is unchanged until the cache is flushed
+  EXPECT_EQ(StoredInt64("value"), stored);
+}
+
+TEST_F(CachedIoObserverTests, batched_reads_only_fetch_keys_which_are_not_cached)
+{
+  int64_t const stored{1};
+  toolkit.observer().fake_.Write("a", &stored, sizeof(stored));
+  toolkit.observer().fake_.Write("b", &stored, sizeof(stored));
+
+  EXPECT_CALL(toolkit.observer(), Read("a", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Read("b", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Read("c", _, _)).Times(1);
+
+  EXPECT_EQ(cache.Exists("a"), Status::OK);
+
+  IoObserverInterface::Values values{};
+  cache.ReadMany({"a", "b", "c"}, values);
+
+  ASSERT_EQ(values.size(), 3);
+  EXPECT_EQ(values[0].first, Status::OK);
+  EXPECT_EQ(values[0].second.size(), sizeof(stored));
+  EXPECT_EQ(values[1].first, Status::OK);
+  EXPECT_EQ(values[2].first, Status::ERROR);
+  EXPECT_EQ(cache.num_misses(), 3);
+}
+
+TEST_F(CachedIoObserverTests, denied_keys_are_neither_read_again_nor_written)
+{
+  toolkit.observer().fake_.SetDenied("denied");
+
+  EXPECT_CALL(toolkit.observer(), Read("denied", _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), Write(_, _, _)).Times(0);
+
+  int64_t  value{0};
+  uint64_t size{sizeof(value)};
+  EXPECT_EQ(cache.Read("denied", &value, size), Status::PERMISSION_DENIED);
+  EXPECT_EQ(cache.Exists("denied"), Status::PERMISSION_DENIED);
+  EXPECT_EQ(cache.Write("denied", &value, sizeof(value)), Status::PERMISSION_DENIED);
+  EXPECT_EQ(cache.Flush(), Status::OK);
+}
+
+TEST_F(CachedIoObserverTests, failed_write_back_is_reported_by_flush)
+{
+  toolkit.observer().fake_.SetDenied("denied");
+
+  EXPECT_CALL(toolkit.observer(), Write("denied", _, _)).Times(1);
+
+  int64_t const value{1};
+  EXPECT_EQ(cache.Write("denied", &value, sizeof(value)), Status::OK);
+  EXPECT_EQ(cache.Flush(), Status::PERMISSION_DENIED);
+}
+
+}  // namespace
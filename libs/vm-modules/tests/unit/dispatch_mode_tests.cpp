@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace testing;
+
+using DispatchMode = fetch::vm::VM::DispatchMode;
+using Charges      = std::unordered_map<std::string, ChargeAmount>;
+
+char const *TEXT = R"(
+  function fib(n : Int32) : Int32
+    if (n < 2)
+      return n;
+    endif
+    return fib(n - 1) + fib(n - 2);
+  endfunction
+
+  function main() : Int64
+    var total = 0i64;
+    for (i in 0:20)
+      if (i == 15)
+        break;
+      endif
+      if ((i % 3 == 0) || (i % 5 == 0 && i > 0))
+        continue;
+      endif
+      var j = 0;
+      while (j < i)
+        total += toInt64(j);
+        j += 1;
+      endwhile
+    endfor
+    total += toInt64(fib(10));
+    print(total);
+    return total;
+  endfunction
+)";
+
+class DispatchModeTests : public Test
+{
+public:
+  struct Result
+  {
+    bool         success{false};
+    std::string  stdout{};
+    int64_t      output{0};
+    ChargeAmount charge{0};
+  };
+
+  static Result Execute(DispatchMode mode, ChargeAmount charge_limit = 0,
+                        char const *text = TEXT, Charges const &charges = {})
+  {
+    std::stringstream stdout;
+    VmTestToolkit     toolkit{&stdout};
+
+    // allows the program to update the charges while it is being executed
+    toolkit.module().CreateFreeFunction(
+        "updateCharges", [&charges](fetch::vm::VM *vm) { vm->UpdateCharges(charges); });
+
+    Result result{};
+    EXPECT_TRUE(toolkit.Compile(text));
+
+    toolkit.vm().SetDispatchMode(mode);
+    EXPECT_EQ(mode, toolkit.vm().GetDispatchMode());
+
+    Variant output{};
+    result.success = toolkit.Run(&output, charge_limit);
+    result.stdout  = stdout.str();
+    result.charge  = toolkit.vm().GetChargeTotal();
+
+    if (result.success)
+    {
+      result.output = output.Get<int64_t>();
+    }
+
+    return result;
+  }
+};
+
+TEST_F(DispatchModeTests, threaded_dispatch_matches_indirect_dispatch)
+{
+  auto const indirect = Execute(DispatchMode::Indirect);
+  auto const threaded = Execute(DispatchMode::Threaded);
+
+  ASSERT_TRUE(indirect.success);
+  ASSERT_TRUE(threaded.success);
+
+  EXPECT_EQ(indirect.stdout, threaded.stdout);
+  EXPECT_EQ(indirect.output, threaded.output);
+  EXPECT_EQ(indirect.charge, threaded.charge);
+  EXPECT_EQ(335, threaded.output);
+}
+
+TEST_F(DispatchModeTests, threaded_dispatch_matches_indirect_dispatch_after_updating_charges)
+{
+  // the threaded code of count is built by its first call, before the charges are updated
+  char const *text = R"(
+    function count(n : Int32) : Int32
+      var k = 0;
+      while (k < n)
+        k += 1;
+      endwhile
+      return k;
+    endfunction
+
+    function main() : Int64
+      var a = count(10);
+      updateCharges();
+      return toInt64(a + count(10));
+    endfunction
+  )";
+
+  Charges const charges{{"PrimitiveLessThan", 7}, {"LocalVariablePrimitiveInplaceAdd", 11}};
+
+  auto const defaults = Execute(DispatchMode::Threaded, 0, text);
+  auto const indirect = Execute(DispatchMode::Indirect, 0, text, charges);
+  auto const threaded = Execute(DispatchMode::Threaded, 0, text, charges);
+
+  ASSERT_TRUE(indirect.success);
+  ASSERT_TRUE(threaded.success);
+
+  EXPECT_EQ(20, threaded.output);
+  EXPECT_GT(threaded.charge, defaults.charge);
+  EXPECT_EQ(indirect.charge, threaded.charge);
+}
+
+TEST_F(DispatchModeTests, threaded_dispatch_enforces_the_charge_limit)
+{
+  auto const result = Execute(DispatchMode::Threaded, 50);
+
+  EXPECT_FALSE(result.success);
+  EXPECT_THAT(result.stdout, HasSubstr("Charge limit reached"));
+}
+
+}  // namespace
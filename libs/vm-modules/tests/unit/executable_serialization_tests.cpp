@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/generator.hpp"
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using fetch::serializers::MsgPackSerializer;
+using fetch::vm::Executable;
+using fetch::vm::VM;
+using fetch::vm::Variant;
+using fetch::vm_modules::VMFactory;
+
+char const *TEXT = R"(
+  contract other_contract
+    @action
+    function transfer(amount : UInt64) : Int64;
+  endcontract
+
+  @init
+  function setup()
+  endfunction
+
+  @action
+  function noop() : Int64
+    return 0i64;
+  endfunction
+
+  function scale(x : Int32, factor : Fixed128) : Fixed128
+    return toFixed128(x) * factor;
+  endfunction
+
+  function main() : Int64
+    var total = 0i64;
+    for (i in 0:10)
+      total += 3i64;
+    endfor
+    var fp = scale(2i32, 1.5fp128);
+    print("total=" + toString(total) + " fp=" + toString(fp) + " flag=" + toString(true));
+    return total;
+  endfunction
+)";
+
+std::string Execute(std::shared_ptr<fetch::vm::Module> const &module, Executable const &executable,
+                    Variant &output)
+{
+  std::ostringstream stdout;
+  std::string        error;
+
+  VM vm{module.get()};
+  vm.AttachOutputDevice(VM::STDOUT, stdout);
+
+  EXPECT_TRUE(vm.Execute(executable, "main", error, output)) << error;
+
+  return stdout.str();
+}
+
+TEST(ExecutableSerializationTests, CheckRoundTripExecutesIdentically)
+{
+  auto module = VMFactory::GetModule(VMFactory::USE_SMART_CONTRACTS);
+
+  Executable original{};
+  auto const errors = VMFactory::Compile(module, {{"default.etch", TEXT}}, original);
+  ASSERT_TRUE(errors.empty());
+
+  MsgPackSerializer serializer{};
+  serializer << original;
+
+  Executable        restored{};
+  MsgPackSerializer deserializer{serializer.data()};
+  deserializer >> restored;
+
+  EXPECT_EQ(original.name, restored.name);
+  EXPECT_EQ(original.num_system_types, restored.num_system_types);
+  EXPECT_EQ(original.strings, restored.strings);
+  EXPECT_EQ(original.constants.size(), restored.constants.size());
+  EXPECT_EQ(original.large_constants.size(), restored.large_constants.size());
+  EXPECT_EQ(original.types.size(), restored.types.size());
+  ASSERT_EQ(original.contracts.size(), restored.contracts.size());
+  ASSERT_EQ(original.functions.size(), restored.functions.size());
+
+  for (std::size_t i = 0; i < original.functions.size(); ++i)
+  {
+    auto const &expected = original.functions[i];
+    auto const &actual   = restored.functions[i];
+
+    EXPECT_EQ(expected.name, actual.name);
+    EXPECT_EQ(expected.kind, actual.kind);
+    EXPECT_EQ(expected.num_parameters, actual.num_parameters);
+    EXPECT_EQ(expected.num_variables, actual.num_variables);
+    EXPECT_EQ(expected.annotations.size(), actual.annotations.size());
+    EXPECT_EQ(expected.instructions.size(), actual.instructions.size());
+    EXPECT_EQ(expected.pc_to_line_map, actual.pc_to_line_map);
+  }
+
+  // both executables should behave identically
+  Variant expected_output{};
+  Variant actual_output{};
+
+  auto const expected_stdout = Execute(module, original, expected_output);
+  auto const actual_stdout   = Execute(module, restored, actual_output);
+
+  EXPECT_EQ(expected_stdout, actual_stdout);
+  EXPECT_EQ(expected_output.Get<int64_t>(), actual_output.Get<int64_t>());
+  EXPECT_EQ(30, actual_output.Get<int64_t>());
+}
+
+}  // namespace
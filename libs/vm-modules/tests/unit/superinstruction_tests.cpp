@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+using namespace testing;
+
+using DispatchMode = fetch::vm::VM::DispatchMode;
+using Charges      = std::unordered_map<std::string, ChargeAmount>;
+
+char const *LOOPS = R"(
+  function main() : Int64
+    var total = 0i64;
+    for (i in 0:100)
+      total = total + toInt64(i);
+    endfor
+    var j = 0;
+    var k = 0;
+    while (j < 100)
+      k = k + j * 2;
+      if (k % 7 == 0)
+        k = k - 1;
+      endif
+      j += 1;
+    endwhile
+    print(k);
+    return total + toInt64(k);
+  endfunction
+)";
+
+char const *DIVISION_BY_ZERO = R"(
+  function main()
+    var j = 10;
+    var k = 0;
+    while (j >= 0)
+      k = k + 100 / j;
+      j -= 1;
+    endwhile
+  endfunction
+)";
+
+class SuperinstructionTests : public Test
+{
+public:
+  struct Result
+  {
+    bool         success{false};
+    std::string  stdout{};
+    int64_t      output{0};
+    ChargeAmount charge{0};
+    std::size_t  num_instructions{0};
+  };
+
+  static Result Execute(char const *text, bool superinstructions,
+                        DispatchMode mode = DispatchMode::Indirect, Charges const &charges = {})
+  {
+    Result result{};
+
+    // count the generated instructions
+    auto module = VMFactory::GetModule(VMFactory::USE_ALL);
+    if (superinstructions)
+    {
+      module->EnableSuperinstructions();
+    }
+
+    Executable executable{};
+    EXPECT_TRUE(VMFactory::Compile(module, {{"default.etch", text}}, executable).empty());
+    result.num_instructions = executable.FindFunction("main")->instructions.size();
+
+    // execute the program
+    std::stringstream stdout;
+    VmTestToolkit     toolkit{&stdout};
+    if (superinstructions)
+    {
+      toolkit.module().EnableSuperinstructions();
+    }
+
+    EXPECT_TRUE(toolkit.Compile(text));
+    toolkit.vm().SetDispatchMode(mode);
+    toolkit.vm().UpdateCharges(charges);
+
+    Variant output{};
+    result.success = toolkit.Run(&output);
+    result.stdout  = stdout.str();
+    result.charge  = toolkit.vm().GetChargeTotal();
+
+    if (result.success && (output.type_id == fetch::vm::TypeIds::Int64))
+    {
+      result.output = output.Get<int64_t>();
+    }
+
+    return result;
+  }
+};
+
+TEST_F(SuperinstructionTests, fused_executable_has_fewer_instructions_and_same_behaviour)
+{
+  auto const plain = Execute(LOOPS, false);
+  auto const fused = Execute(LOOPS, true);
+
+  ASSERT_TRUE(plain.success);
+  ASSERT_TRUE(fused.success);
+
+  EXPECT_LT(fused.num_instructions, plain.num_instructions);
+  EXPECT_EQ(plain.stdout, fused.stdout);
+  EXPECT_EQ(plain.output, fused.output);
+
+  // with the default charges a superinstruction costs the same as the instructions it replaces
+  EXPECT_EQ(plain.charge, fused.charge);
+}
+
+TEST_F(SuperinstructionTests, fused_executable_runs_in_threaded_mode)
+{
+  auto const plain = Execute(LOOPS, false, DispatchMode::Indirect);
+  auto const fused = Execute(LOOPS, true, DispatchMode::Threaded);
+
+  ASSERT_TRUE(fused.success);
+  EXPECT_EQ(plain.stdout, fused.stdout);
+  EXPECT_EQ(plain.output, fused.output);
+  EXPECT_EQ(plain.charge, fused.charge);
+}
+
+TEST_F(SuperinstructionTests, fused_executable_has_same_charge_after_updating_charges)
+{
+  // distinct charges for each of the instructions which are fused into superinstructions
+  Charges const charges{{"PushPrimitiveLocalVariable", 3},
+                        {"PushConstant", 5},
+                        {"JumpIfFalse", 7},
+                        {"PopToPrimitiveLocalVariable", 11},
+                        {"LocalVariablePrimitiveInplaceAdd", 13},
+                        {"PrimitiveLessThan", 17},
+                        {"PrimitiveEqual", 19},
+                        {"PrimitiveAdd", 23},
+                        {"PrimitiveSubtract", 29},
+                        {"PrimitiveMultiply", 31},
+                        {"PrimitiveModulo", 37}};
+
+  auto const defaults = Execute(LOOPS, false);
+  auto const plain    = Execute(LOOPS, false, DispatchMode::Indirect, charges);
+  auto const fused    = Execute(LOOPS, true, DispatchMode::Indirect, charges);
+
+  ASSERT_TRUE(plain.success);
+  ASSERT_TRUE(fused.success);
+
+  EXPECT_GT(plain.charge, defaults.charge);
+  EXPECT_EQ(plain.charge, fused.charge);
+}
+
+TEST_F(SuperinstructionTests, runtime_errors_report_the_same_line)
+{
+  auto const plain = Execute(DIVISION_BY_ZERO, false);
+  auto const fused = Execute(DIVISION_BY_ZERO, true);
+
+  EXPECT_FALSE(plain.success);
+  EXPECT_FALSE(fused.success);
+  EXPECT_THAT(plain.stdout, HasSubstr("line 6"));
+  EXPECT_EQ(plain.stdout, fused.stdout);
+}
+
+}  // namespace
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/opcodes.hpp"
+#include "vm_test_toolkit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+
+namespace {
+
+using namespace testing;
+
+class UnboxedPrimitiveTests : public Test
+{
+public:
+  std::stringstream stdout;
+  VmTestToolkit     toolkit{&stdout};
+
+  static std::size_t CountOpcodes(char const *text, uint16_t opcode)
+  {
+    auto       module = VMFactory::GetModule(VMFactory::USE_ALL);
+    Executable executable{};
+    EXPECT_TRUE(VMFactory::Compile(module, {{"default.etch", text}}, executable).empty());
+
+    std::size_t count{0};
+    for (auto const &instruction : executable.FindFunction("main")->instructions)
+    {
+      count += static_cast<std::size_t>(instruction.opcode == opcode);
+    }
+    return count;
+  }
+};
+
+TEST_F(UnboxedPrimitiveTests, primitive_local_variables_use_unboxed_opcodes)
+{
+  static char const *TEXT = R"(
+    function main()
+      var x = 1i64;
+      var s = "abc";
+      x = x + 2i64;
+      s = s;
+    endfunction
+  )";
+
+  EXPECT_EQ(CountOpcodes(TEXT, fetch::vm::Opcodes::PushPrimitiveLocalVariable), 1);
+  EXPECT_EQ(CountOpcodes(TEXT, fetch::vm::Opcodes::PopToPrimitiveLocalVariable), 1);
+  EXPECT_EQ(CountOpcodes(TEXT, fetch::vm::Opcodes::PushLocalVariable), 1);
+  EXPECT_EQ(CountOpcodes(TEXT, fetch::vm::Opcodes::PopToLocalVariable), 1);
+}
+
+TEST_F(UnboxedPrimitiveTests, arithmetic_loops_over_unboxed_primitives)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i = 0i64;
+      var f = 0.0fp64;
+      var b = 0.0fp128;
+      var s = "";
+      for (k in 0:10)
+        i = i + 3i64 * toInt64(k);
+        f = f + 0.5fp64;
+        b = b + 0.25fp128;
+        s = s + "x";
+      endfor
+      print(i);
+      print(" ");
+      print(f);
+      print(" ");
+      print(b);
+      print(" ");
+      print(s);
+    endfunction
+  )";
+
+  ASSERT_TRUE(toolkit.Compile(TEXT));
+  ASSERT_TRUE(toolkit.Run());
+
+  EXPECT_EQ(stdout.str(), "135 5.000000000 2.5000000000000000000 xxxxxxxxxx");
+}
+
+}  // namespace
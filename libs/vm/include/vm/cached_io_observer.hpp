@@ -0,0 +1,90 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/io_observer_interface.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Per execution write-back cache in front of another IO observer. Each key is read from the
+ * underlying observer at most once, writes are buffered and only the latest value of each written
+ * key is passed on to the underlying observer when the cache is flushed. Each buffered write is
+ * still checked by the underlying observer, so that it is rejected and accounted for immediately.
+ *
+ * Since the keys are not scoped, a cache must only be used for the execution of a single contract.
+ */
+class CachedIoObserver : public IoObserverInterface
+{
+public:
+  // Construction / Destruction
+  explicit CachedIoObserver(IoObserverInterface &observer);
+  CachedIoObserver(CachedIoObserver const &) = delete;
+  CachedIoObserver(CachedIoObserver &&)      = delete;
+  ~CachedIoObserver() override               = default;
+
+  /// @name Io Observer Interface
+  /// @{
+  Status Read(std::string const &key, void *data, uint64_t &size) override;
+  Status Write(std::string const &key, void const *data, uint64_t size) override;
+  Status Exists(std::string const &key) override;
+  void   ReadMany(Keys const &keys, Values &values) override;
+  Status WriteMany(KeyValuePairs const &values) override;
+  /// @}
+
+  void   Prefetch(Keys const &keys);
+  Status Flush();
+
+  /// @name Counter Access
+  /// @{
+  uint64_t num_hits() const;
+  uint64_t num_misses() const;
+  /// @}
+
+  // Operators
+  CachedIoObserver &operator=(CachedIoObserver const &) = delete;
+  CachedIoObserver &operator=(CachedIoObserver &&) = delete;
+
+private:
+  struct Entry
+  {
+    Status         status{Status::ERROR};
+    ConstByteArray value{};
+    bool           dirty{false};
+  };
+
+  using EntryMap = std::unordered_map<std::string, Entry>;
+
+  Entry &Lookup(std::string const &key);
+  Status Store(std::string const &key, ConstByteArray const &value);
+
+  IoObserverInterface &observer_;
+  EntryMap             entries_{};
+  Keys                 dirty_keys_{};  ///< Written keys in the order of their first write
+  uint64_t             hits_{0};
+  uint64_t             misses_{0};
+};
+
+}  // namespace vm
+}  // namespace fetch
@@ -103,6 +103,7 @@ struct Executable
 
   struct Instruction
   {
+    Instruction() = default;
     explicit Instruction(uint16_t opcode__)
       : opcode{opcode__}
     {}
@@ -116,6 +117,7 @@ struct Executable
 
   struct Parameter
   {
+    Parameter() = default;
     Parameter(std::string name__, TypeId type_id__)
       : name{std::move(name__)}
       , type_id{type_id__}
@@ -127,6 +129,7 @@ struct Executable
 
   struct Variable : public Parameter
   {
+    Variable() = default;
     Variable(VariableKind kind__, std::string name, TypeId type_id, uint16_t scope_number__)
       : Parameter(std::move(name), type_id)
       , kind{kind__}
@@ -187,6 +190,7 @@ struct Executable
 
   struct Contract
   {
+    Contract() = default;
     explicit Contract(std::string name__)
       : name{std::move(name__)}
     {}
@@ -203,6 +207,7 @@ struct Executable
 
   struct UserDefinedType
   {
+    UserDefinedType() = default;
     explicit UserDefinedType(std::string name__)
       : name{std::move(name__)}
     {}
@@ -398,6 +403,7 @@ private:
 
   VM *                     vm_{};
   uint16_t                 num_system_types_{};
+  bool                     superinstructions_{};
   Executable               executable_;
   std::vector<Scope>       scopes_;
   std::vector<Loop>        loops_;
@@ -409,9 +415,10 @@ private:
   LineToPcMap              line_to_pc_map_;
   std::vector<std::string> errors_;
 
-  void          Initialise(VM *vm, uint16_t num_system_types);
+  void          Initialise(VM *vm, uint16_t num_system_types, bool superinstructions = false);
   uint16_t      AddInstruction(Executable::Instruction const &instruction, uint16_t line);
   void          AddLineNumber(uint16_t line, uint16_t pc);
+  void          FuseSuperinstructions();
   void          ResolveTypes(IR const &ir);
   void          ResolveFunctions(IR const &ir);
   void          CreateUserDefinedTemplateInstantiationTypes(IR const &ir);
@@ -17,8 +17,13 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -41,6 +46,11 @@ public:
     BUFFER_TOO_SMALL
   };
 
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Keys           = std::vector<std::string>;
+  using Values         = std::vector<std::pair<Status, ConstByteArray>>;
+  using KeyValuePairs  = std::vector<std::pair<std::string, ConstByteArray>>;
+
   /// @name Basic State Interface
   /// @{
 
@@ -77,7 +87,106 @@ public:
   virtual Status Exists(std::string const &key) = 0;
 
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual void   ReadMany(Keys const &keys, Values &values);
+  virtual Status WriteMany(KeyValuePairs const &values);
+  /// @}
+
+  /// @name Write-back Cache Interface
+  /// @{
+  virtual Status CheckWrite(std::string const &key, uint64_t size);
+  virtual Status CommitMany(KeyValuePairs const &values);
+  /// @}
 };
 
+/**
+ * Read a series of values from the state store. Implementations that are able to service these
+ * requests in bulk should override this method.
+ *
+ * @param keys The keys to be accessed
+ * @param values The status and, if successful, the value of each key in the order of the keys
+ */
+inline void IoObserverInterface::ReadMany(Keys const &keys, Values &values)
+{
+  values.clear();
+  values.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    byte_array::ByteArray buffer;
+    buffer.Resize(256);
+
+    uint64_t buffer_size = buffer.size();
+    auto     status      = Read(key, buffer.pointer(), buffer_size);
+
+    if (Status::BUFFER_TOO_SMALL == status)
+    {
+      buffer.Resize(buffer_size);
+      status = Read(key, buffer.pointer(), buffer_size);
+    }
+
+    if (Status::OK == status)
+    {
+      buffer.Resize(buffer_size);
+      values.emplace_back(status, buffer);
+    }
+    else
+    {
+      values.emplace_back(status, ConstByteArray{});
+    }
+  }
+}
+
+/**
+ * Write a series of values to the state store. Implementations that are able to service these
+ * requests in bulk should override this method.
+ *
+ * @param values The key value pairs to be written
+ * @return OK if all the writes were successful, otherwise the status of the first failed write
+ */
+inline IoObserverInterface::Status IoObserverInterface::WriteMany(KeyValuePairs const &values)
+{
+  for (auto const &value : values)
+  {
+    auto const status = Write(value.first, value.second.pointer(), value.second.size());
+    if (Status::OK != status)
+    {
+      return status;
+    }
+  }
+
+  return Status::OK;
+}
+
+/**
+ * Check a write which is buffered by a write-back cache instead of being passed on immediately.
+ * Implementations that restrict or account for writes should override this method so that the
+ * buffered write is treated exactly like a direct write, apart from not being stored.
+ *
+ * @param key The key to be accessed
+ * @param size The size in bytes of the value to be written
+ * @return OK if the write is permitted, PERMISSION_DENIED if the key is incorrect
+ */
+inline IoObserverInterface::Status IoObserverInterface::CheckWrite(std::string const & /*key*/,
+                                                                   uint64_t /*size*/)
+{
+  return Status::OK;
+}
+
+/**
+ * Write back a series of values which have all been accepted by CheckWrite. Implementations which
+ * override CheckWrite should override this method so that the writes are not checked or accounted
+ * for a second time.
+ *
+ * @param values The key value pairs to be written
+ * @return OK if all the writes were successful, otherwise the status of the first failed write
+ */
+inline IoObserverInterface::Status IoObserverInterface::CommitMany(KeyValuePairs const &values)
+{
+  return WriteMany(values);
+}
+
 }  // namespace vm
 }  // namespace fetch
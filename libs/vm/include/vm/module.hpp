@@ -485,6 +485,20 @@ public:
     return test_annotations_;
   }
 
+  /**
+   * Fuse common instruction sequences of the generated executables into superinstructions,
+   * reducing the number of instructions dispatched at runtime
+   */
+  void EnableSuperinstructions()
+  {
+    superinstructions_ = true;
+  }
+
+  bool IsUsingSuperinstructions() const
+  {
+    return superinstructions_;
+  }
+
 private:
   template <typename Estimator, typename Callable>
   void InternalCreateFreeFunction(std::string const &name, Callable callable,
@@ -556,6 +570,7 @@ private:
   CPPCopyConstructorMap cpp_copy_constructors_;
 
   bool test_annotations_{false};
+  bool superinstructions_{false};
   friend class Compiler;
   friend class VM;
 };
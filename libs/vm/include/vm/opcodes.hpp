@@ -127,7 +127,14 @@ static constexpr uint16_t MemberVariablePrimitiveInplaceModulo     = 100;
 static constexpr uint16_t PushSelf                                 = 101;
 static constexpr uint16_t InvokeUserDefinedConstructor             = 102;
 static constexpr uint16_t InvokeUserDefinedMemberFunction          = 103;
-static constexpr uint16_t NumReserved                              = 104;
+static constexpr uint16_t PushLocalVariablePushLocalVariable       = 104;
+static constexpr uint16_t PushLocalVariablePushConstant            = 105;
+static constexpr uint16_t PrimitiveRelationalOpJumpIfFalse         = 106;
+static constexpr uint16_t PrimitiveNumericOpPopToLocalVariable     = 107;
+static constexpr uint16_t LocalVariablePrimitiveInplaceAddConstant = 108;
+static constexpr uint16_t PushPrimitiveLocalVariable               = 109;
+static constexpr uint16_t PopToPrimitiveLocalVariable              = 110;
+static constexpr uint16_t NumReserved                              = 111;
 }  // namespace Opcodes
 
 }  // namespace vm
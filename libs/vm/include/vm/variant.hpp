@@ -267,6 +267,14 @@ struct Variant
     type_id   = other_type_id;
   }
 
+  // Unboxed copy for when both variants are statically known to hold primitives (or nothing),
+  // which skips the object handling of the generic copy and move operations
+  void ConstructPrimitive(Variant const &other) noexcept
+  {
+    primitive = other.primitive;
+    type_id   = other.type_id;
+  }
+
   Variant &operator=(Variant const &other) noexcept
   {
     if (this != &other)
@@ -464,6 +472,11 @@ struct Variant
     return type_id <= TypeIds::PrimitiveMaxId;
   }
 
+  constexpr void ResetPrimitive() noexcept
+  {
+    type_id = TypeIds::Unknown;
+  }
+
   constexpr void Reset() noexcept
   {
     if (!IsPrimitive())
@@ -484,6 +484,8 @@ public:
   void UnloadExecutable()
   {
     strings_.clear();
+    threaded_free_functions_.clear();
+    threaded_member_functions_.clear();
 
     std::size_t const num_local_types = executable_->types.size();
     for (std::size_t i = 0; i < num_local_types; ++i)
@@ -584,6 +586,18 @@ public:
     ChargeAmount static_charge{};
   };
 
+  /**
+   * The strategy used by the interpreter loop to dispatch instructions
+   */
+  enum class DispatchMode : uint8_t
+  {
+    /// Decode every instruction through the opcode table and charge it individually
+    Indirect = 0,
+    /// Resolve the handlers of each function once when it is first entered and charge the static
+    /// cost of each basic block as a whole on entry to the block
+    Threaded = 1
+  };
+
   ChargeAmount                   GetChargeTotal() const;
   void                           IncreaseChargeTotal(ChargeAmount amount);
   ChargeAmount                   GetChargeLimit() const;
@@ -593,6 +607,9 @@ public:
 
   void UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opcode_static_charges);
 
+  DispatchMode GetDispatchMode() const;
+  void         SetDispatchMode(DispatchMode mode);
+
 private:
   static const int FRAME_STACK_SIZE = 50;
   static const int STACK_SIZE       = 1024;
@@ -601,6 +618,20 @@ private:
   using OpcodeInfoArray = std::vector<OpcodeInfo>;
   using OpcodeMap       = std::unordered_map<std::string, uint16_t>;
 
+  /**
+   * A pre-resolved instruction. The block charge is the total static charge of the basic block
+   * starting at this instruction, or zero when the instruction is not the leader of a block
+   */
+  struct ThreadedInstruction
+  {
+    OpcodeInfo * op{};
+    ChargeAmount block_charge{};
+  };
+
+  using ThreadedCode      = std::vector<ThreadedInstruction>;
+  using ThreadedCodeArray = std::vector<ThreadedCode>;
+  using ThreadedCodeMap   = std::unordered_map<Executable::Function const *, ThreadedCode>;
+
   struct Frame
   {
     Executable::Function const *function{};
@@ -673,6 +704,10 @@ private:
   DeserializeConstructorMap      deserialization_constructors_;
   CPPCopyConstructorMap          cpp_copy_constructors_;
   OpcodeInfo *                   current_op_{};
+  OpcodeInfo                     unknown_op_;
+  DispatchMode                   dispatch_mode_{DispatchMode::Indirect};
+  ThreadedCodeArray              threaded_free_functions_;  ///< Indexed as executable functions
+  ThreadedCodeMap                threaded_member_functions_;
 
   /// @name Charges
   /// @{
@@ -687,7 +722,15 @@ private:
         OpcodeInfo(std::move(unique_name), std::move(handler), static_charge);
   }
 
+  void UpdateSuperinstructionCharges();
+  void UpdateThreadedCodeCharges();
+  bool ChargeFusedOperation(uint16_t opcode);
+
   bool Execute(std::string &error, Variant &output);
+  void DispatchIndirect();
+  void DispatchThreaded();
+  ThreadedInstruction const *GetThreadedCode(Executable::Function const &function);
+  ThreadedCode               BuildThreadedCode(Executable::Function const &function);
   void Destruct(uint16_t scope_number);
 
   TypeId FindType(std::string const &name) const
@@ -1585,7 +1628,7 @@ private:
     Variant &rhsv = Pop();
     Variant &lhsv = Top();
     ExecutePrimitiveRelationalOp<Op>(instruction_->type_id, lhsv, rhsv);
-    rhsv.Reset();
+    rhsv.ResetPrimitive();
   }
 
   template <typename Op>
@@ -1635,7 +1678,7 @@ private:
     Variant &rhsv = Pop();
     Variant &lhsv = Top();
     ExecuteIntegralOp<Op>(instruction_->type_id, lhsv, rhsv);
-    rhsv.Reset();
+    rhsv.ResetPrimitive();
   }
 
   template <typename Op>
@@ -1644,7 +1687,7 @@ private:
     Variant &rhsv = Pop();
     Variant &lhsv = Top();
     ExecuteNumericOp<Op>(instruction_->type_id, lhsv, rhsv);
-    rhsv.Reset();
+    rhsv.ResetPrimitive();
   }
 
   template <typename Op>
@@ -1891,6 +1934,8 @@ private:
   void Handler__PushConstant();
   void Handler__PushLocalVariable();
   void Handler__PopToLocalVariable();
+  void Handler__PushPrimitiveLocalVariable();
+  void Handler__PopToPrimitiveLocalVariable();
   void Handler__Inc();
   void Handler__Dec();
   void Handler__Duplicate();
@@ -1985,6 +2030,15 @@ private:
   void Handler__InvokeUserDefinedConstructor();
   void Handler__InvokeUserDefinedMemberFunction();
 
+  // superinstructions, see Generator::FuseSuperinstructions
+  void Handler__PushLocalVariablePushLocalVariable();
+  void Handler__PushLocalVariablePushConstant();
+  void Handler__PrimitiveRelationalOpJumpIfFalse();
+  void Handler__PrimitiveNumericOpPopToLocalVariable();
+  void Handler__LocalVariablePrimitiveInplaceAddConstant();
+  void PushLocalVariable(uint16_t index);
+  void PushConstant(uint16_t index);
+
   friend class Object;
   friend class Module;
   friend class Generator;
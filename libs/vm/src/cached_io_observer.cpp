@@ -0,0 +1,267 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/cached_io_observer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * Constructs a cache in front of the specified IO observer
+ *
+ * @param observer The observer to which reads and flushed writes are forwarded
+ */
+CachedIoObserver::CachedIoObserver(IoObserverInterface &observer)
+  : observer_{observer}
+{}
+
+/**
+ * Read a value from the cache, fetching it from the underlying observer on the first access
+ *
+ * @param key The key to be accessed
+ * @param data The pointer to the output buffer to be populated
+ * @param size The size of the output buffer, if successful the size of the data will be written
+ * back
+ * @return OK if the read was successful, BUFFER_TOO_SMALL if the output buffer is too small,
+ * otherwise the status reported by the underlying observer
+ */
+CachedIoObserver::Status CachedIoObserver::Read(std::string const &key, void *data,
+                                                uint64_t &size)
+{
+  Entry const &entry = Lookup(key);
+  if (Status::OK != entry.status)
+  {
+    return entry.status;
+  }
+
+  auto const orig_size{size};
+  size = entry.value.size();
+  if (orig_size < entry.value.size())
+  {
+    return Status::BUFFER_TOO_SMALL;
+  }
+
+  entry.value.ReadBytes(reinterpret_cast<uint8_t *>(data), size);
+
+  return Status::OK;
+}
+
+/**
+ * Buffer a write to the state, the value is passed on to the underlying observer on flush
+ *
+ * @param key The key to be accessed
+ * @param data The pointer to the input buffer for the data
+ * @param size The size in bytes of the input buffer
+ * @return OK if the write was buffered, otherwise the status of the check by the observer
+ */
+CachedIoObserver::Status CachedIoObserver::Write(std::string const &key, void const *data,
+                                                 uint64_t size)
+{
+  return Store(key, ConstByteArray{reinterpret_cast<uint8_t const *>(data), size});
+}
+
+/**
+ * Checks to see if the specified key exists, fetching its value on the first access so that a
+ * subsequent read is served from the cache
+ *
+ * @param key The key to be checked
+ * @return OK if the key exists, PERMISSION_DENIED if the key is inaccessible, otherwise ERROR
+ */
+CachedIoObserver::Status CachedIoObserver::Exists(std::string const &key)
+{
+  return Lookup(key).status;
+}
+
+/**
+ * Read a series of values, the keys which are not yet cached are fetched from the underlying
+ * observer in a single batch
+ *
+ * @param keys The keys to be accessed
+ * @param values The status and, if successful, the value of each key in the order of the keys
+ */
+void CachedIoObserver::ReadMany(Keys const &keys, Values &values)
+{
+  Prefetch(keys);
+
+  values.clear();
+  values.reserve(keys.size());
+  for (auto const &key : keys)
+  {
+    Entry const &entry = Lookup(key);
+    values.emplace_back(entry.status, entry.value);
+  }
+}
+
+/**
+ * Buffer a series of writes to the state
+ *
+ * @param values The key value pairs to be written
+ * @return OK if the writes were buffered, otherwise the status of the first rejected write
+ */
+CachedIoObserver::Status CachedIoObserver::WriteMany(KeyValuePairs const &values)
+{
+  for (auto const &value : values)
+  {
+    auto const status = Store(value.first, value.second);
+    if (Status::OK != status)
+    {
+      return status;
+    }
+  }
+
+  return Status::OK;
+}
+
+/**
+ * Fetch the keys which are not yet cached from the underlying observer in a single batch
+ *
+ * @param keys The keys to be fetched
+ */
+void CachedIoObserver::Prefetch(Keys const &keys)
+{
+  Keys missing{};
+  for (auto const &key : keys)
+  {
+    if (entries_.find(key) == entries_.end())
+    {
+      missing.push_back(key);
+    }
+  }
+
+  if (missing.empty())
+  {
+    return;
+  }
+
+  Values values{};
+  observer_.ReadMany(missing, values);
+
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    Entry entry{};
+    if (i < values.size())
+    {
+      entry.status = values[i].first;
+      entry.value  = values[i].second;
+    }
+
+    misses_ += static_cast<uint64_t>(entries_.emplace(missing[i], std::move(entry)).second);
+  }
+}
+
+/**
+ * Pass the latest value of each written key on to the underlying observer in a single batch. The
+ * writes have already been checked by the observer when they were buffered.
+ *
+ * @return OK if all the values were written, otherwise the status reported by the observer
+ */
+CachedIoObserver::Status CachedIoObserver::Flush()
+{
+  if (dirty_keys_.empty())
+  {
+    return Status::OK;
+  }
+
+  KeyValuePairs values{};
+  values.reserve(dirty_keys_.size());
+  for (auto const &key : dirty_keys_)
+  {
+    auto &entry = entries_[key];
+    values.emplace_back(key, entry.value);
+    entry.dirty = false;
+  }
+  dirty_keys_.clear();
+
+  return observer_.CommitMany(values);
+}
+
+uint64_t CachedIoObserver::num_hits() const
+{
+  return hits_;
+}
+
+uint64_t CachedIoObserver::num_misses() const
+{
+  return misses_;
+}
+
+CachedIoObserver::Entry &CachedIoObserver::Lookup(std::string const &key)
+{
+  auto it = entries_.find(key);
+  if (it != entries_.end())
+  {
+    ++hits_;
+    return it->second;
+  }
+
+  Values values{};
+  observer_.ReadMany({key}, values);
+
+  Entry entry{};
+  if (!values.empty())
+  {
+    entry.status = values.front().first;
+    entry.value  = values.front().second;
+  }
+
+  ++misses_;
+  return entries_.emplace(key, std::move(entry)).first->second;
+}
+
+CachedIoObserver::Status CachedIoObserver::Store(std::string const &   key,
+                                                 ConstByteArray const &value)
+{
+  auto it = entries_.find(key);
+
+  // keys which the underlying observer refused to read can not be written either
+  if ((it != entries_.end()) && (Status::PERMISSION_DENIED == it->second.status))
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  // every write is checked and accounted for by the underlying observer when it is buffered, as
+  // if it had been passed on directly, even though only the latest value is written back
+  auto const status = observer_.CheckWrite(key, value.size());
+  if (Status::OK != status)
+  {
+    return status;
+  }
+
+  if (it == entries_.end())
+  {
+    it = entries_.emplace(key, Entry{}).first;
+  }
+
+  auto &entry  = it->second;
+  entry.status = Status::OK;
+  entry.value  = value;
+  if (!entry.dirty)
+  {
+    entry.dirty = true;
+    dirty_keys_.push_back(key);
+  }
+
+  return Status::OK;
+}
+
+}  // namespace vm
+}  // namespace fetch
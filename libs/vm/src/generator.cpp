@@ -19,6 +19,7 @@
 #include "vm/generator.hpp"
 #include "vm/vm.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -29,11 +30,236 @@
 
 namespace fetch {
 namespace vm {
+namespace {
+
+using Instruction      = Executable::Instruction;
+using InstructionArray = Executable::InstructionArray;
+
+/**
+ * Determine whether the instruction transfers control to the pc held in its index field
+ */
+bool IsBranch(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::ForRangeIterate:
+  case Opcodes::PrimitiveRelationalOpJumpIfFalse:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsPrimitiveRelationalOp(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveEqual:
+  case Opcodes::PrimitiveNotEqual:
+  case Opcodes::PrimitiveLessThan:
+  case Opcodes::PrimitiveLessThanOrEqual:
+  case Opcodes::PrimitiveGreaterThan:
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsPrimitiveNumericOp(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+    return true;
+  default:
+    return false;
+  }
+}
 
-void Generator::Initialise(VM *vm, uint16_t num_system_types)
+/**
+ * Attempt to fuse a pair of consecutive instructions into a single superinstruction
+ *
+ * @param first The first instruction of the pair
+ * @param second The second instruction of the pair
+ * @param fused The resulting superinstruction
+ * @return true if the pair was fused, otherwise false
+ */
+bool Fuse(Instruction const &first, Instruction const &second, Instruction &fused)
 {
-  vm_               = vm;
-  num_system_types_ = num_system_types;
+  if ((first.opcode == Opcodes::PushPrimitiveLocalVariable) &&
+      (second.opcode == Opcodes::PushPrimitiveLocalVariable))
+  {
+    fused         = Instruction{Opcodes::PushLocalVariablePushLocalVariable};
+    fused.type_id = first.type_id;
+    fused.index   = first.index;
+    fused.data    = second.index;
+    return true;
+  }
+
+  if ((first.opcode == Opcodes::PushPrimitiveLocalVariable) &&
+      (second.opcode == Opcodes::PushConstant))
+  {
+    fused         = Instruction{Opcodes::PushLocalVariablePushConstant};
+    fused.type_id = first.type_id;
+    fused.index   = first.index;
+    fused.data    = second.index;
+    return true;
+  }
+
+  if (IsPrimitiveRelationalOp(first.opcode) && (second.opcode == Opcodes::JumpIfFalse))
+  {
+    fused         = Instruction{Opcodes::PrimitiveRelationalOpJumpIfFalse};
+    fused.type_id = first.type_id;
+    fused.index   = second.index;
+    fused.data    = first.opcode;
+    return true;
+  }
+
+  if (IsPrimitiveNumericOp(first.opcode) &&
+      (second.opcode == Opcodes::PopToPrimitiveLocalVariable))
+  {
+    fused         = Instruction{Opcodes::PrimitiveNumericOpPopToLocalVariable};
+    fused.type_id = first.type_id;
+    fused.index   = second.index;
+    fused.data    = first.opcode;
+    return true;
+  }
+
+  if ((first.opcode == Opcodes::PushConstant) &&
+      (second.opcode == Opcodes::LocalVariablePrimitiveInplaceAdd))
+  {
+    fused         = Instruction{Opcodes::LocalVariablePrimitiveInplaceAddConstant};
+    fused.type_id = second.type_id;
+    fused.index   = second.index;
+    fused.data    = first.index;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Peephole pass fusing pairs of instructions of a function into superinstructions. Pairs are never
+ * fused across a branch target (so that every target is still the start of an instruction) or
+ * across the start of a source line (so that runtime errors report the same line numbers).
+ *
+ * @param function The function to be optimised
+ */
+void FuseFunction(Executable::Function &function)
+{
+  InstructionArray const &instructions     = function.instructions;
+  std::size_t const       num_instructions = instructions.size();
+
+  // instructions which may not be fused into the preceding instruction
+  std::vector<bool> boundaries(num_instructions + 1, false);
+  for (auto const &instruction : instructions)
+  {
+    if (IsBranch(instruction.opcode) && (instruction.index <= num_instructions))
+    {
+      boundaries[instruction.index] = true;
+    }
+  }
+
+  for (auto const &entry : function.pc_to_line_map)
+  {
+    if (entry.first <= num_instructions)
+    {
+      boundaries[entry.first] = true;
+    }
+  }
+
+  InstructionArray      fused_instructions{};
+  std::vector<uint16_t> new_pcs(num_instructions + 1, 0);
+
+  fused_instructions.reserve(num_instructions);
+
+  std::size_t pc = 0;
+  while (pc < num_instructions)
+  {
+    auto const new_pc = static_cast<uint16_t>(fused_instructions.size());
+    new_pcs[pc]       = new_pc;
+
+    Instruction fused{};
+    if ((pc + 1 < num_instructions) && !boundaries[pc + 1] &&
+        Fuse(instructions[pc], instructions[pc + 1], fused))
+    {
+      // the second instruction can not be the target of a branch, however map it for completeness
+      new_pcs[pc + 1] = new_pc;
+      fused_instructions.push_back(fused);
+      pc += 2;
+    }
+    else
+    {
+      fused_instructions.push_back(instructions[pc]);
+      ++pc;
+    }
+  }
+  new_pcs[num_instructions] = static_cast<uint16_t>(fused_instructions.size());
+
+  // nothing to do when no instructions have been fused
+  if (fused_instructions.size() == num_instructions)
+  {
+    return;
+  }
+
+  // relocate the branch targets
+  for (auto &instruction : fused_instructions)
+  {
+    if (IsBranch(instruction.opcode) && (instruction.index <= num_instructions))
+    {
+      instruction.index = new_pcs[instruction.index];
+    }
+  }
+
+  Executable::PcToLineMap pc_to_line_map{};
+  for (auto const &entry : function.pc_to_line_map)
+  {
+    auto const old_pc = std::min<std::size_t>(entry.first, num_instructions);
+    pc_to_line_map.emplace(new_pcs[old_pc], entry.second);
+  }
+
+  function.instructions   = std::move(fused_instructions);
+  function.pc_to_line_map = std::move(pc_to_line_map);
+}
+
+}  // namespace
+
+void Generator::Initialise(VM *vm, uint16_t num_system_types, bool superinstructions)
+{
+  vm_                = vm;
+  num_system_types_  = num_system_types;
+  superinstructions_ = superinstructions;
+}
+
+/**
+ * Fuse common sequences of instructions in all the functions of the executable
+ */
+void Generator::FuseSuperinstructions()
+{
+  for (auto &function : executable_.functions)
+  {
+    FuseFunction(function);
+  }
+
+  for (auto &type : executable_.user_defined_types)
+  {
+    for (auto &function : type.functions)
+    {
+      FuseFunction(function);
+    }
+  }
 }
 
 bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_name,
@@ -88,6 +314,11 @@ bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_n
     errors_.emplace_back(e.message);
   }
 
+  if (superinstructions_ && errors_.empty())
+  {
+    FuseSuperinstructions();
+  }
+
   scopes_.clear();
   loops_.clear();
   strings_map_.clear();
@@ -1047,8 +1278,9 @@ void Generator::HandleVariableAssignmentStatement(IRExpressionNodePtr const &lhs
   }
   else
   {
-    // Assigning to a local variable
-    opcode = Opcodes::PopToLocalVariable;
+    // Assigning to a local variable, primitives are stored unboxed
+    opcode = variable->type->IsPrimitive() ? Opcodes::PopToPrimitiveLocalVariable
+                                           : Opcodes::PopToLocalVariable;
   }
   HandleExpression(rhs);
   Executable::Instruction instruction(opcode);
@@ -1433,7 +1665,8 @@ void Generator::HandleIdentifier(IRExpressionNodePtr const &node)
     }
     else
     {
-      opcode = Opcodes::PushLocalVariable;
+      opcode = variable->type->IsPrimitive() ? Opcodes::PushPrimitiveLocalVariable
+                                             : Opcodes::PushLocalVariable;
     }
     Executable::Instruction instruction(opcode);
     instruction.type_id = variable->type->id;
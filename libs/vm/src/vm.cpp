@@ -23,6 +23,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <utility>
 
 namespace fetch {
 namespace vm {
@@ -54,6 +56,10 @@ VM::VM(Module *module)
                 [](VM *vm) { vm->Handler__PushLocalVariable(); });
   AddOpcodeInfo(Opcodes::PopToLocalVariable, "PopToLocalVariable",
                 [](VM *vm) { vm->Handler__PopToLocalVariable(); });
+  AddOpcodeInfo(Opcodes::PushPrimitiveLocalVariable, "PushPrimitiveLocalVariable",
+                [](VM *vm) { vm->Handler__PushPrimitiveLocalVariable(); });
+  AddOpcodeInfo(Opcodes::PopToPrimitiveLocalVariable, "PopToPrimitiveLocalVariable",
+                [](VM *vm) { vm->Handler__PopToPrimitiveLocalVariable(); });
   AddOpcodeInfo(Opcodes::Inc, "Inc", [](VM *vm) { vm->Handler__Inc(); });
   AddOpcodeInfo(Opcodes::Dec, "Dec", [](VM *vm) { vm->Handler__Dec(); });
   AddOpcodeInfo(Opcodes::Duplicate, "Duplicate", [](VM *vm) { vm->Handler__Duplicate(); });
@@ -235,6 +241,22 @@ VM::VM(Module *module)
   AddOpcodeInfo(Opcodes::InvokeUserDefinedMemberFunction, "InvokeUserDefinedMemberFunction",
                 [](VM *vm) { vm->Handler__InvokeUserDefinedMemberFunction(); });
 
+  // the charges of the superinstructions are derived from the instructions they replace, see
+  // UpdateSuperinstructionCharges
+  AddOpcodeInfo(Opcodes::PushLocalVariablePushLocalVariable, "PushLocalVariablePushLocalVariable",
+                [](VM *vm) { vm->Handler__PushLocalVariablePushLocalVariable(); });
+  AddOpcodeInfo(Opcodes::PushLocalVariablePushConstant, "PushLocalVariablePushConstant",
+                [](VM *vm) { vm->Handler__PushLocalVariablePushConstant(); });
+  AddOpcodeInfo(Opcodes::PrimitiveRelationalOpJumpIfFalse, "PrimitiveRelationalOpJumpIfFalse",
+                [](VM *vm) { vm->Handler__PrimitiveRelationalOpJumpIfFalse(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNumericOpPopToLocalVariable,
+                "PrimitiveNumericOpPopToLocalVariable",
+                [](VM *vm) { vm->Handler__PrimitiveNumericOpPopToLocalVariable(); });
+  AddOpcodeInfo(Opcodes::LocalVariablePrimitiveInplaceAddConstant,
+                "LocalVariablePrimitiveInplaceAddConstant",
+                [](VM *vm) { vm->Handler__LocalVariablePrimitiveInplaceAddConstant(); });
+  UpdateSuperinstructionCharges();
+
   opcode_map_.clear();
   for (uint16_t i = 0; i < num_functions; ++i)
   {
@@ -244,7 +266,11 @@ VM::VM(Module *module)
     opcode_map_[info.unique_name] = opcode;
   }
 
-  generator_.Initialise(this, num_types);
+  // target of any instruction which can not be resolved when running in threaded mode
+  unknown_op_ =
+      OpcodeInfo("Unknown", [](VM *vm) { vm->RuntimeError("unknown opcode"); }, 1);
+
+  generator_.Initialise(this, num_types, module->IsUsingSuperinstructions());
 }
 
 bool VM::GenerateExecutable(IR const &ir, std::string const &name, Executable &executable,
@@ -272,32 +298,14 @@ bool VM::Execute(std::string &error, Variant &output)
   {
     if (sp_ < STACK_SIZE)
     {
-      do
+      if (dispatch_mode_ == DispatchMode::Threaded)
       {
-        instruction_pc_ = pc_;
-        instruction_    = &function_->instructions[pc_++];
-
-        assert(instruction_->opcode < opcode_info_array_.size());
-
-        current_op_ = &opcode_info_array_[instruction_->opcode];
-
-        if (!current_op_->handler)
-        {
-          RuntimeError("unknown opcode");
-          break;
-        }
-
-        IncreaseChargeTotal(current_op_->static_charge);
-
-        if (ChargeLimitExceeded())
-        {
-          break;
-        }
-
-        // execute the handler for the op code
-        current_op_->handler(this);
-
-      } while (!stop_);
+        DispatchThreaded();
+      }
+      else
+      {
+        DispatchIndirect();
+      }
     }
     else
     {
@@ -344,6 +352,214 @@ bool VM::Execute(std::string &error, Variant &output)
   return false;
 }
 
+void VM::DispatchIndirect()
+{
+  do
+  {
+    instruction_pc_ = pc_;
+    instruction_    = &function_->instructions[pc_++];
+
+    assert(instruction_->opcode < opcode_info_array_.size());
+
+    current_op_ = &opcode_info_array_[instruction_->opcode];
+
+    if (!current_op_->handler)
+    {
+      RuntimeError("unknown opcode");
+      break;
+    }
+
+    IncreaseChargeTotal(current_op_->static_charge);
+
+    if (ChargeLimitExceeded())
+    {
+      break;
+    }
+
+    // execute the handler for the op code
+    current_op_->handler(this);
+
+  } while (!stop_);
+}
+
+void VM::DispatchThreaded()
+{
+  Executable::Function const *current_function{nullptr};
+  ThreadedInstruction const * code{nullptr};
+
+  // the code of the previously executed function, which is typically the caller
+  Executable::Function const *previous_function{nullptr};
+  ThreadedInstruction const * previous_code{nullptr};
+
+  do
+  {
+    // the function only changes on calls and returns
+    if (function_ != current_function)
+    {
+      if (function_ == previous_function)
+      {
+        std::swap(current_function, previous_function);
+        std::swap(code, previous_code);
+      }
+      else
+      {
+        previous_function = current_function;
+        previous_code     = code;
+        current_function  = function_;
+        code              = GetThreadedCode(*function_);
+      }
+    }
+
+    instruction_pc_ = pc_;
+    instruction_    = &function_->instructions[pc_];
+
+    ThreadedInstruction const &threaded = code[pc_++];
+    current_op_                         = threaded.op;
+
+    // charge the whole basic block when entering it
+    if (threaded.block_charge != 0)
+    {
+      IncreaseChargeTotal(threaded.block_charge);
+
+      if (ChargeLimitExceeded())
+      {
+        break;
+      }
+    }
+
+    // execute the handler for the op code
+    current_op_->handler(this);
+
+  } while (!stop_);
+}
+
+/**
+ * Get (building if necessary) the pre-resolved instructions of the specified function
+ *
+ * @param function The function being executed
+ * @return The pre-resolved instructions, indexed by program counter
+ */
+VM::ThreadedInstruction const *VM::GetThreadedCode(Executable::Function const &function)
+{
+  auto const &functions = executable_->functions;
+
+  // free functions are stored contiguously in the executable, so can be looked up by index
+  if (!functions.empty() && (&function >= functions.data()) &&
+      (&function < functions.data() + functions.size()))
+  {
+    auto const index = static_cast<std::size_t>(&function - functions.data());
+
+    if (threaded_free_functions_.size() != functions.size())
+    {
+      threaded_free_functions_.resize(functions.size());
+    }
+
+    auto &code = threaded_free_functions_[index];
+    if (code.empty())
+    {
+      code = BuildThreadedCode(function);
+    }
+
+    return code.data();
+  }
+
+  auto it = threaded_member_functions_.find(&function);
+  if (it == threaded_member_functions_.end())
+  {
+    it = threaded_member_functions_.emplace(&function, BuildThreadedCode(function)).first;
+  }
+
+  return it->second.data();
+}
+
+/**
+ * Resolve the handlers of the instructions of a function and compute the static charge of each of
+ * its basic blocks
+ *
+ * @param function The function to be resolved
+ * @return The pre-resolved instructions, indexed by program counter
+ */
+VM::ThreadedCode VM::BuildThreadedCode(Executable::Function const &function)
+{
+  auto const &instructions     = function.instructions;
+  auto const  num_instructions = instructions.size();
+
+  // determine the leaders of the basic blocks, i.e. the entry point, the targets of the branches
+  // and the instructions following a transfer of control (including calls, since the callee
+  // returns to the next instruction)
+  std::vector<bool> leaders(num_instructions + 1, false);
+  leaders[0] = true;
+
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    auto const &instruction = instructions[pc];
+
+    switch (instruction.opcode)
+    {
+    case Opcodes::Break:
+    case Opcodes::Continue:
+    case Opcodes::Jump:
+    case Opcodes::JumpIfFalse:
+    case Opcodes::JumpIfTrue:
+    case Opcodes::JumpIfFalseOrPop:
+    case Opcodes::JumpIfTrueOrPop:
+    case Opcodes::ForRangeIterate:
+    case Opcodes::PrimitiveRelationalOpJumpIfFalse:
+      if (instruction.index < num_instructions)
+      {
+        leaders[instruction.index] = true;
+      }
+      leaders[pc + 1] = true;
+      break;
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+    case Opcodes::InvokeUserDefinedFreeFunction:
+    case Opcodes::InvokeUserDefinedConstructor:
+    case Opcodes::InvokeUserDefinedMemberFunction:
+      leaders[pc + 1] = true;
+      break;
+    default:
+      break;
+    }
+  }
+
+  ThreadedCode code(num_instructions);
+
+  ThreadedInstruction *leader{nullptr};
+  for (std::size_t pc = 0; pc < num_instructions; ++pc)
+  {
+    auto const opcode = instructions[pc].opcode;
+    auto &     entry  = code[pc];
+
+    if ((opcode < opcode_info_array_.size()) && opcode_info_array_[opcode].handler)
+    {
+      entry.op = &opcode_info_array_[opcode];
+    }
+    else
+    {
+      entry.op = &unknown_op_;
+    }
+
+    if (leaders[pc])
+    {
+      leader = &entry;
+    }
+
+    // accumulate the charge onto the leader of the block, in the same way as IncreaseChargeTotal
+    ChargeAmount const charge = (entry.op->static_charge == 0) ? 1u : entry.op->static_charge;
+    if ((std::numeric_limits<ChargeAmount>::max() - leader->block_charge) < charge)
+    {
+      leader->block_charge = std::numeric_limits<ChargeAmount>::max();
+    }
+    else
+    {
+      leader->block_charge += charge;
+    }
+  }
+
+  return code;
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);
@@ -431,6 +647,99 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       it->static_charge = entry.second;
     }
   }
+
+  UpdateSuperinstructionCharges();
+  UpdateThreadedCodeCharges();
+}
+
+/**
+ * Recompute the basic block charges of the threaded code built so far. The code may be in use by
+ * the current execution (when charges are updated from a binding), so it is updated in place.
+ */
+void VM::UpdateThreadedCodeCharges()
+{
+  for (std::size_t index = 0; index < threaded_free_functions_.size(); ++index)
+  {
+    auto &code = threaded_free_functions_[index];
+    if (!code.empty())
+    {
+      auto const rebuilt = BuildThreadedCode(executable_->functions[index]);
+      std::copy(rebuilt.begin(), rebuilt.end(), code.begin());
+    }
+  }
+
+  for (auto &entry : threaded_member_functions_)
+  {
+    auto const rebuilt = BuildThreadedCode(*entry.first);
+    std::copy(rebuilt.begin(), rebuilt.end(), entry.second.begin());
+  }
+}
+
+/**
+ * Derive the static charges of the superinstructions from the charges of the instructions they
+ * replace, so that fusing instructions never changes the charge of a program. The relational or
+ * numeric operation of PrimitiveRelationalOpJumpIfFalse and PrimitiveNumericOpPopToLocalVariable
+ * is only known from the instruction, so it is charged by the handler (see ChargeFusedOperation).
+ */
+void VM::UpdateSuperinstructionCharges()
+{
+  auto const charge = [this](uint16_t opcode) -> ChargeAmount {
+    ChargeAmount const static_charge = opcode_info_array_[opcode].static_charge;
+    return (static_charge == 0) ? 1u : static_charge;
+  };
+
+  auto const sum = [&charge](uint16_t first, uint16_t second) -> ChargeAmount {
+    ChargeAmount const first_charge  = charge(first);
+    ChargeAmount const second_charge = charge(second);
+    if ((std::numeric_limits<ChargeAmount>::max() - first_charge) < second_charge)
+    {
+      return std::numeric_limits<ChargeAmount>::max();
+    }
+    return first_charge + second_charge;
+  };
+
+  opcode_info_array_[Opcodes::PushLocalVariablePushLocalVariable].static_charge =
+      sum(Opcodes::PushPrimitiveLocalVariable, Opcodes::PushPrimitiveLocalVariable);
+  opcode_info_array_[Opcodes::PushLocalVariablePushConstant].static_charge =
+      sum(Opcodes::PushPrimitiveLocalVariable, Opcodes::PushConstant);
+  opcode_info_array_[Opcodes::PrimitiveRelationalOpJumpIfFalse].static_charge =
+      charge(Opcodes::JumpIfFalse);
+  opcode_info_array_[Opcodes::PrimitiveNumericOpPopToLocalVariable].static_charge =
+      charge(Opcodes::PopToPrimitiveLocalVariable);
+  opcode_info_array_[Opcodes::LocalVariablePrimitiveInplaceAddConstant].static_charge =
+      sum(Opcodes::PushConstant, Opcodes::LocalVariablePrimitiveInplaceAdd);
+}
+
+/**
+ * Charge the operation encoded in the data of a superinstruction
+ *
+ * @param opcode The opcode of the fused operation
+ * @return true if execution can continue, false if the charge limit has been reached
+ */
+bool VM::ChargeFusedOperation(uint16_t opcode)
+{
+  assert(opcode < opcode_info_array_.size());
+
+  IncreaseChargeTotal(opcode_info_array_[opcode].static_charge);
+
+  return !ChargeLimitExceeded();
+}
+
+VM::DispatchMode VM::GetDispatchMode() const
+{
+  return dispatch_mode_;
+}
+
+/**
+ * Set the dispatch mode of the interpreter. Both modes produce the same charge total for a
+ * successful execution, however in threaded mode the charge limit is enforced at the granularity
+ * of basic blocks.
+ *
+ * @param mode The dispatch mode to be used for subsequent executions
+ */
+void VM::SetDispatchMode(DispatchMode mode)
+{
+  dispatch_mode_ = mode;
 }
 
 }  // namespace vm
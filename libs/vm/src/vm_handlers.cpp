@@ -97,36 +97,67 @@ void VM::Handler__PushString()
   RuntimeError("stack overflow");
 }
 
-void VM::Handler__PushConstant()
+void VM::PushLocalVariable(uint16_t index)
 {
   if (++sp_ < STACK_SIZE)
   {
-    Variant const &constant = executable_->constants[instruction_->index];
-    Top().Construct(constant);
+    Variant const &variable = GetLocalVariable(index);
+    Top().Construct(variable);
     return;
   }
   --sp_;
   RuntimeError("stack overflow");
 }
 
-void VM::Handler__PushLocalVariable()
+void VM::PushConstant(uint16_t index)
 {
   if (++sp_ < STACK_SIZE)
   {
-    Variant const &variable = GetLocalVariable(instruction_->index);
-    Top().Construct(variable);
+    // constants are always primitives, large constants are pushed by PushLargeConstant
+    Variant const &constant = executable_->constants[index];
+    Top().ConstructPrimitive(constant);
     return;
   }
   --sp_;
   RuntimeError("stack overflow");
 }
 
+void VM::Handler__PushConstant()
+{
+  PushConstant(instruction_->index);
+}
+
+void VM::Handler__PushLocalVariable()
+{
+  PushLocalVariable(instruction_->index);
+}
+
 void VM::Handler__PopToLocalVariable()
 {
   Variant &variable = GetLocalVariable(instruction_->index);
   variable          = std::move(Pop());
 }
 
+void VM::Handler__PushPrimitiveLocalVariable()
+{
+  if (++sp_ < STACK_SIZE)
+  {
+    Variant const &variable = GetLocalVariable(instruction_->index);
+    Top().ConstructPrimitive(variable);
+    return;
+  }
+  --sp_;
+  RuntimeError("stack overflow");
+}
+
+void VM::Handler__PopToPrimitiveLocalVariable()
+{
+  Variant &top      = Pop();
+  Variant &variable = GetLocalVariable(instruction_->index);
+  variable.ConstructPrimitive(top);
+  top.ResetPrimitive();
+}
+
 void VM::Handler__Inc()
 {
   Variant &top = Top();
@@ -203,7 +234,7 @@ void VM::Handler__JumpIfFalse()
   {
     pc_ = instruction_->index;
   }
-  v.Reset();
+  v.ResetPrimitive();
 }
 
 void VM::Handler__JumpIfTrue()
@@ -213,7 +244,7 @@ void VM::Handler__JumpIfTrue()
   {
     pc_ = instruction_->index;
   }
-  v.Reset();
+  v.ResetPrimitive();
 }
 
 // NOTE: Opcodes::Return and Opcodes::ReturnValue both route through here
@@ -1093,5 +1124,112 @@ void VM::Handler__InvokeUserDefinedMemberFunction()
   RuntimeError("null reference");
 }
 
+// PushPrimitiveLocalVariable(index) + PushPrimitiveLocalVariable(data)
+void VM::Handler__PushLocalVariablePushLocalVariable()
+{
+  PushLocalVariable(instruction_->index);
+  if (!stop_)
+  {
+    PushLocalVariable(instruction_->data);
+  }
+}
+
+// PushPrimitiveLocalVariable(index) + PushConstant(data)
+void VM::Handler__PushLocalVariablePushConstant()
+{
+  PushLocalVariable(instruction_->index);
+  if (!stop_)
+  {
+    PushConstant(instruction_->data);
+  }
+}
+
+// Primitive<relational op in data>(type_id) + JumpIfFalse(index)
+void VM::Handler__PrimitiveRelationalOpJumpIfFalse()
+{
+  // the relational operation is not part of the static charge of the superinstruction
+  if (!ChargeFusedOperation(instruction_->data))
+  {
+    return;
+  }
+
+  switch (instruction_->data)
+  {
+  case Opcodes::PrimitiveEqual:
+    DoPrimitiveRelationalOp<PrimitiveEqual>();
+    break;
+  case Opcodes::PrimitiveNotEqual:
+    DoPrimitiveRelationalOp<PrimitiveNotEqual>();
+    break;
+  case Opcodes::PrimitiveLessThan:
+    DoPrimitiveRelationalOp<PrimitiveLessThan>();
+    break;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    DoPrimitiveRelationalOp<PrimitiveLessThanOrEqual>();
+    break;
+  case Opcodes::PrimitiveGreaterThan:
+    DoPrimitiveRelationalOp<PrimitiveGreaterThan>();
+    break;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    DoPrimitiveRelationalOp<PrimitiveGreaterThanOrEqual>();
+    break;
+  default:
+    RuntimeError("unknown relational operation");
+    return;
+  }
+
+  if (!stop_)
+  {
+    Handler__JumpIfFalse();
+  }
+}
+
+// Primitive<numeric op in data>(type_id) + PopToPrimitiveLocalVariable(index)
+void VM::Handler__PrimitiveNumericOpPopToLocalVariable()
+{
+  // the numeric operation is not part of the static charge of the superinstruction
+  if (!ChargeFusedOperation(instruction_->data))
+  {
+    return;
+  }
+
+  switch (instruction_->data)
+  {
+  case Opcodes::PrimitiveAdd:
+    DoNumericOp<PrimitiveAdd>();
+    break;
+  case Opcodes::PrimitiveSubtract:
+    DoNumericOp<PrimitiveSubtract>();
+    break;
+  case Opcodes::PrimitiveMultiply:
+    DoNumericOp<PrimitiveMultiply>();
+    break;
+  case Opcodes::PrimitiveDivide:
+    DoNumericOp<PrimitiveDivide>();
+    break;
+  case Opcodes::PrimitiveModulo:
+    DoIntegralOp<PrimitiveModulo>();
+    break;
+  default:
+    RuntimeError("unknown numeric operation");
+    return;
+  }
+
+  if (!stop_)
+  {
+    Handler__PopToPrimitiveLocalVariable();
+  }
+}
+
+// PushConstant(data) + LocalVariablePrimitiveInplaceAdd(index, type_id)
+void VM::Handler__LocalVariablePrimitiveInplaceAddConstant()
+{
+  PushConstant(instruction_->data);
+  if (!stop_)
+  {
+    DoLocalVariableNumericInplaceOp<PrimitiveAdd>();
+  }
+}
+
 }  // namespace vm
 }  // namespace fetch